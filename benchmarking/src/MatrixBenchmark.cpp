@@ -0,0 +1,147 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+//
+// Compares the blocked Matrix multiplication kernels against the naive
+// triple loop they replaced. Run with no arguments; prints the average time
+// per operation for a range of square matrix sizes.
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "BenchmarkTimer.h"
+#include "Matrix.h"
+
+using namespace PCOE;
+
+static volatile double sink;
+
+static Matrix randomMatrix(std::size_t m, std::size_t n, std::mt19937& rng) {
+    std::uniform_real_distribution<> dist(-1, 1);
+    Matrix result(m, n);
+    for (std::size_t i = 0; i < m; i++) {
+        for (std::size_t j = 0; j < n; j++) {
+            result[i][j] = dist(rng);
+        }
+    }
+    return result;
+}
+
+// The implementation of Matrix::operator* before the blocked kernels
+static Matrix naiveMultiply(const Matrix& lhs, const Matrix& rhs) {
+    Matrix r(lhs.rows(), rhs.cols());
+    for (std::size_t i = 0; i < lhs.rows(); i++) {
+        for (std::size_t j = 0; j < rhs.cols(); j++) {
+            double e = 0;
+            for (std::size_t k = 0; k < lhs.cols(); k++) {
+                e += (lhs[i][k] * rhs[k][j]);
+            }
+            r[i][j] = e;
+        }
+    }
+    return r;
+}
+
+// Element-wise a + 2 * b - a with a temporary for each operator, as the
+// Matrix operators were implemented before expression templates
+static Matrix naiveAxpby(const Matrix& a, const Matrix& b) {
+    Matrix scaled(b);
+    scaled *= 2.0;
+    Matrix sum(a);
+    sum += scaled;
+    Matrix result(sum);
+    result -= a;
+    return result;
+}
+
+// The implementation of Matrix::transpose before the blocked kernels
+static Matrix naiveTranspose(const Matrix& m) {
+    Matrix r(m.cols(), m.rows());
+    for (std::size_t i = 0; i < m.rows(); i++) {
+        for (std::size_t j = 0; j < m.cols(); j++) {
+            r[j][i] = m[i][j];
+        }
+    }
+    return r;
+}
+
+template <typename Fn>
+static double averageMicroseconds(std::size_t repetitions, Fn fn) {
+    BenchmarkTimer timer;
+    for (std::size_t i = 0; i < repetitions; i++) {
+        timer.start();
+        fn();
+        timer.stop();
+    }
+    return static_cast<double>(timer.getAveStepTime().count()) / 1000.0;
+}
+
+int main() {
+    std::mt19937 rng(42);
+    const std::size_t sizes[] = {4, 8, 16, 64, 256};
+
+    std::printf("%6s %12s %12s %12s %12s %12s %12s %12s %12s\n",
+                "n",
+                "naive A*B",
+                "A*B",
+                "naive A*B'",
+                "A*B'",
+                "naive L*x",
+                "L.mulAdd",
+                "naive a+2b-a",
+                "a+2b-a");
+    for (std::size_t n : sizes) {
+        Matrix a = randomMatrix(n, n, rng);
+        Matrix b = randomMatrix(n, n, rng);
+        Matrix c(n, n);
+        Matrix x = randomMatrix(n, 1, rng);
+        std::vector<double> y(n);
+        const std::size_t repetitions = n <= 16 ? 20000 : (n <= 64 ? 500 : 10);
+
+        double naiveGemm = averageMicroseconds(repetitions, [&]() {
+            sink = naiveMultiply(a, b)[0][0];
+        });
+        double gemm = averageMicroseconds(repetitions, [&]() {
+            Matrix::multiply(a, b, c);
+            sink = c[0][0];
+        });
+        double naiveGemmT = averageMicroseconds(repetitions, [&]() {
+            sink = naiveMultiply(a, naiveTranspose(b))[0][0];
+        });
+        double gemmT = averageMicroseconds(repetitions, [&]() {
+            Matrix::multiplyTransposed(a, b, c);
+            sink = c[0][0];
+        });
+        double naiveGemv = averageMicroseconds(repetitions, [&]() {
+            Matrix r = x + naiveMultiply(a, x);
+            sink = r[0][0];
+        });
+        double gemv = averageMicroseconds(repetitions, [&]() {
+            for (std::size_t i = 0; i < n; i++) {
+                y[i] = x[i][0];
+            }
+            a.multiplyAdd(x.getData(), y.data());
+            sink = y[0];
+        });
+        double naiveElementwise = averageMicroseconds(repetitions, [&]() {
+            c = naiveAxpby(a, b);
+            sink = c[0][0];
+        });
+        double elementwise = averageMicroseconds(repetitions, [&]() {
+            c = a + 2.0 * b - a;
+            sink = c[0][0];
+        });
+
+        std::printf("%6zu %10.2fus %10.2fus %10.2fus %10.2fus %10.2fus %10.2fus %10.2fus %10.2fus\n",
+                    n,
+                    naiveGemm,
+                    gemm,
+                    naiveGemmT,
+                    gemmT,
+                    naiveGemv,
+                    gemv,
+                    naiveElementwise,
+                    elementwise);
+    }
+    return 0;
+}
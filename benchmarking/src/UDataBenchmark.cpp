@@ -0,0 +1,123 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+//
+// Times the UData operations exercised by the UData tests: construction of
+// each uncertainty type, copies of single values and of state estimate
+// vectors, and element access. Run with no arguments; prints the average
+// time per operation.
+#include <cstdio>
+#include <vector>
+
+#include "BenchmarkTimer.h"
+#include "UData.h"
+
+using namespace PCOE;
+
+static volatile double sink;
+
+template <typename Fn>
+static double averageNanoseconds(std::size_t repetitions, Fn fn) {
+    BenchmarkTimer timer;
+    for (std::size_t i = 0; i < repetitions; i++) {
+        timer.start();
+        fn();
+        timer.stop();
+    }
+    return static_cast<double>(timer.getAveStepTime().count());
+}
+
+static UData makeWSamples(std::size_t count) {
+    UData result(UType::WSamples);
+    result.npoints(count);
+    for (std::size_t i = 0; i < count; i++) {
+        result[SAMPLE(i)] = static_cast<double>(i);
+        result[WEIGHT(i)] = 1.0 / static_cast<double>(count);
+    }
+    return result;
+}
+
+static std::vector<UData> makeStateEstimate(std::size_t stateSize) {
+    std::vector<UData> state(stateSize);
+    for (std::size_t i = 0; i < stateSize; i++) {
+        state[i].uncertainty(UType::MeanCovar);
+        state[i].npoints(stateSize);
+        state[i][MEAN] = static_cast<double>(i);
+        for (std::size_t j = 0; j < stateSize; j++) {
+            state[i][COVAR(j)] = i == j ? 1.0 : 0.0;
+        }
+    }
+    return state;
+}
+
+int main() {
+    const std::size_t repetitions = 100000;
+    const UType types[] = {UType::Point,
+                           UType::MeanSD,
+                           UType::MeanCovar,
+                           UType::Samples,
+                           UType::WSamples};
+    const char* typeNames[] = {"Point", "MeanSD", "MeanCovar", "Samples", "WSamples"};
+
+    std::printf("%-32s %12s\n", "operation", "time");
+    for (std::size_t t = 0; t < 5; t++) {
+        double construct = averageNanoseconds(repetitions, [&]() {
+            UData ud(types[t]);
+            sink = static_cast<double>(ud.size());
+        });
+        std::printf("construct %-22s %10.1fns\n", typeNames[t], construct);
+    }
+
+    UData point(4.2);
+    double copyPoint = averageNanoseconds(repetitions, [&]() {
+        UData copy = point;
+        sink = copy.get();
+    });
+    std::printf("%-32s %10.1fns\n", "copy Point", copyPoint);
+
+    UData samples = makeWSamples(100);
+    double copySamples = averageNanoseconds(repetitions, [&]() {
+        UData copy = samples;
+        sink = copy.get(SAMPLE(99));
+    });
+    std::printf("%-32s %10.1fns\n", "copy WSamples (100)", copySamples);
+
+    std::vector<UData> state = makeStateEstimate(8);
+    double copyState = averageNanoseconds(repetitions, [&]() {
+        std::vector<UData> copy = state;
+        sink = copy.back().get(COVAR(7));
+    });
+    std::printf("%-32s %10.1fns\n", "copy MeanCovar state (8)", copyState);
+
+    double growState = averageNanoseconds(repetitions / 10, [&]() {
+        std::vector<UData> grown;
+        for (std::size_t i = 0; i < 64; i++) {
+            grown.push_back(state[i % state.size()]);
+        }
+        sink = grown.back().get();
+    });
+    std::printf("%-32s %10.1fns\n", "grow MeanCovar vector (64)", growState);
+
+    double readSamples = averageNanoseconds(repetitions, [&]() {
+        double sum = 0;
+        for (std::size_t i = 0; i < 100; i++) {
+            sum += samples[SAMPLE(i)] * samples[WEIGHT(i)];
+        }
+        sink = sum;
+    });
+    std::printf("%-32s %10.1fns\n", "read WSamples (100)", readSamples);
+
+    double writeSamples = averageNanoseconds(repetitions, [&]() {
+        for (std::size_t i = 0; i < 100; i++) {
+            samples.set(SAMPLE(i), static_cast<double>(i));
+        }
+        sink = samples.get(SAMPLE(0));
+    });
+    std::printf("%-32s %10.1fns\n", "write WSamples (100)", writeSamples);
+
+    double getVec = averageNanoseconds(repetitions, [&]() {
+        sink = state[3].getVec(COVAR(0))[3];
+    });
+    std::printf("%-32s %10.1fns\n", "getVec MeanCovar (8)", getVec);
+    return 0;
+}
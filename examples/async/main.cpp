@@ -2,66 +2,20 @@
 // be explicitely (un)licensed as public domain or CC0.
 #include <chrono>
 #include <ctime>
-#include <fstream>
 #include <iomanip>
+#include <iostream>
 #include <map>
-#include <sstream>
+#include <thread>
 #include <vector>
 
 #include "Messages/MessageBus.h"
 #include "Messages/ProgEventMessage.h"
 #include "Messages/ScalarMessage.h"
 #include "ModelBasedAsyncPrognoserBuilder.h"
+#include "TelemetryReader.h"
 
 using namespace PCOE;
 
-// This function is a quick and dirty reader for the example data files.
-// For production-ready applications, a complete and well-tested CSV library
-// should be used.
-std::vector<std::vector<std::shared_ptr<DoubleMessage>>> read_file(const std::string& filename,
-                                                                   const std::string& src) {
-    using namespace std::chrono;
-    std::ifstream file(filename);
-    if (file.fail()) {
-        std::cerr << "Unable to open data file" << std::endl;
-    }
-    // Skip header line
-    file.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-    auto now = MessageClock::now();
-
-    std::vector<std::vector<std::shared_ptr<DoubleMessage>>> result;
-    while (file.good()) {
-        std::vector<std::shared_ptr<DoubleMessage>> data;
-        std::string line;
-        std::getline(file, line);
-        if (line.empty()) {
-            continue;
-        }
-        std::stringstream line_stream(line);
-
-        std::string cell;
-        std::getline(line_stream, cell, ',');
-        double file_time = std::stod(cell);
-        auto timestamp = now + milliseconds(static_cast<unsigned>(file_time * 1000));
-
-        std::getline(line_stream, cell, ',');
-        double power = std::stod(cell);
-
-        std::getline(line_stream, cell, ',');
-        double temperature = std::stod(cell);
-
-        std::getline(line_stream, cell, ',');
-        double voltage = std::stod(cell);
-
-        data.push_back(std::make_shared<DoubleMessage>(MessageId::Watts, src, timestamp, power));
-        data.push_back(
-            std::make_shared<DoubleMessage>(MessageId::Centigrade, src, timestamp, temperature));
-        data.push_back(std::make_shared<DoubleMessage>(MessageId::Volts, src, timestamp, voltage));
-        result.push_back(data);
-    }
-    return result;
-}
-
 // The PredictionPrinter class subscribes to the battery EoD event message and
 // prints each event as it is received.
 class PredictionPrinter : public IMessageProcessor {
@@ -98,13 +52,13 @@ public:
         }
 
         // Get the event for battery EoD
-        auto eod_event = prediction_msg->getValue();
+        const ProgEvent& eod_event = prediction_msg->getValue();
 
         // The time of event is a `UData` structure, which represents a data
         // point while maintaining uncertainty. For the MonteCarlo predictor
         // used by this example, the uncertainty is captured by storing the
         // result of each particle used in the prediction.
-        UData eod_time = eod_event.getTOE();
+        const UData& eod_time = eod_event.getTOE();
         if (eod_time.uncertainty() != UType::Samples) {
             std::cerr << "Unexpected uncertainty type for EoD prediction" << std::endl;
             return std::exit(1);
@@ -137,8 +91,9 @@ int main() {
     // identifier for each component.
     std::string src = "sensor";
 
-    // Read battery data from a file.
-    auto data = read_file("data_const_load.csv", src);
+    // Open the battery data file. The reader maps the file into memory and
+    // parses one row at a time as the data is published below.
+    TelemetryReader data("data_const_load.csv");
 
     // Read the configuration from a file.
     ConfigMap config("example.cfg");
@@ -170,20 +125,27 @@ int main() {
     auto prognoser = builder.build(bus, src, "trajectory");
 
     // For each line of data in the example file, run a single prediction step.
-    for (const auto& line : data) {
+    // The columns of the file are time in seconds, power, temperature and
+    // voltage.
+    using std::chrono::milliseconds;
+    auto start = MessageClock::now();
+    std::vector<double> row;
+    while (data.next(row)) {
+        auto timestamp = start + milliseconds(static_cast<unsigned>(row[0] * 1000));
+
         // Sleep until the timestamp specified by the file. While the main
         // thread is sleeping, worker threads owned by the message bus are
         // processing messages and the prediction printer may be printing
         // the results.
-        std::this_thread::sleep_until(line.front()->getTimestamp());
+        std::this_thread::sleep_until(timestamp);
 
         // Publish all of the data in the line. This will trigger the components
         // contructed by the builder to run a prediction, ultimately triggering
         // the prediction printer to print the result.
         std::cout << "Publishing sensor data" << std::endl;
-        for (const auto& msg : line) {
-            bus.publish(msg);
-        }
+        bus.publish(std::make_shared<DoubleMessage>(MessageId::Watts, src, timestamp, row[1]));
+        bus.publish(std::make_shared<DoubleMessage>(MessageId::Centigrade, src, timestamp, row[2]));
+        bus.publish(std::make_shared<DoubleMessage>(MessageId::Volts, src, timestamp, row[3]));
     }
 
     // Before exiting, wait for the bus to finish processing all messages to
@@ -0,0 +1,95 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#ifndef PCOE_ALIASTABLE_H
+#define PCOE_ALIASTABLE_H
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include "MatrixView.h"
+
+namespace PCOE {
+    /**
+     * An index over a set of weights that draws the index of a weight with
+     * probability proportional to that weight in constant time, using Vose's
+     * alias method. Building the table takes time linear in the number of
+     * weights.
+     *
+     * @remarks
+     * Each slot of the table holds the probability of keeping the slot's own
+     * index and an alias that is used otherwise, so a draw is a single
+     * uniform random number, one table lookup and one comparison.
+     *
+     * @since 1.2
+     **/
+    class AliasTable {
+    public:
+        /**
+         * Constructs an empty table. {@code build} must be called before
+         * drawing from it.
+         **/
+        AliasTable() = default;
+
+        /**
+         * Constructs a table for the given weights.
+         *
+         * @param weights A row or column view of the weights. The weights
+         *                do not need to be normalized.
+         * @exception std::domain_error If there are no weights, a weight is
+         *            negative, or the weights sum to zero.
+         **/
+        explicit AliasTable(const ConstMatrixView& weights);
+
+        /**
+         * Rebuilds the table for the given weights, reusing the existing
+         * storage when possible.
+         *
+         * @param weights A row or column view of the weights. The weights
+         *                do not need to be normalized.
+         * @exception std::domain_error If there are no weights, a weight is
+         *            negative, or the weights sum to zero.
+         **/
+        void build(const ConstMatrixView& weights);
+
+        /**
+         * Gets the number of weights in the table.
+         **/
+        inline std::size_t size() const {
+            return probability.size();
+        }
+
+        /**
+         * Maps a number uniformly distributed in [0, 1) to an index.
+         **/
+        inline std::size_t sample(double u) const {
+            const double scaled = u * static_cast<double>(size());
+            std::size_t i = static_cast<std::size_t>(scaled);
+            if (i >= size()) {
+                i = size() - 1;
+            }
+            return scaled - static_cast<double>(i) < probability[i] ? i : alias[i];
+        }
+
+        /**
+         * Draws an index with probability proportional to its weight.
+         *
+         * @param rng A uniform random bit generator.
+         **/
+        template <class URNG>
+        inline std::size_t operator()(URNG& rng) const {
+            std::uniform_real_distribution<> distribution(0.0, 1.0);
+            return sample(distribution(rng));
+        }
+
+    private:
+        std::vector<double> probability;
+        std::vector<std::size_t> alias;
+        std::vector<double> scaled;
+        std::vector<std::size_t> small;
+        std::vector<std::size_t> large;
+    };
+}
+
+#endif
@@ -38,6 +38,14 @@ namespace PCOE {
         /// @brief      Constructor- Set defaults
         DataPoint();
 
+        /** @brief      Constructor- Set defaults, allocating the data of
+         *              each timestamp with the given allocator
+         *  @param      allocator   The allocator used for the data
+         *
+         *  @note       Copies of the data point allocate from the heap
+         **/
+        explicit DataPoint(const UData::allocator_type& allocator);
+
         /** @brief      Set the number of timestamps for which prognostic relevant prognostic data will be recorded
          *  @param      nTimesIn        Number of timestamps
          *
@@ -74,6 +82,12 @@ namespace PCOE {
          **/
         UData & operator[](const std::size_t index);
 
+        /** @brief      Access operator by number
+         *  @param      index       Index of element
+         *  @return     Desired element
+         **/
+        const UData & operator[](const std::size_t index) const;
+
         /** @brief      Get the number of points considered
          *  @return     The number of points considered
          *
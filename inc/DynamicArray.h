@@ -6,6 +6,11 @@
 
 #include <algorithm>
 #include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace PCOE {
@@ -14,15 +19,21 @@ namespace PCOE {
      * {@code std::array}, the size of {@code Dynamic} array is determined when
      * the dynamic array is created.
      *
-     * This class is essentially a wrapper around a {@code std::vector} that
-     * provides the same interface as {@code std::array}.
+     * This class provides the same interface as {@code std::array}. Arrays
+     * with up to {@code InlineCapacity} elements store them inside the array
+     * object itself, so small arrays such as the state, input and output
+     * vectors of most models do not allocate. Larger arrays allocate their
+     * elements with {@code Allocator}.
      *
-     * @paramt T The type of the elements contained by the array.
+     * @paramt T              The type of the elements contained by the array.
+     * @paramt Allocator      The allocator used for arrays that do not fit
+     *                        inline.
+     * @paramt InlineCapacity The largest number of elements stored inline.
      *
      * @author Jason Watkins
      * @since 1.2
      **/
-    template <class T, class Allocator = std::allocator<T>>
+    template <class T, class Allocator = std::allocator<T>, std::size_t InlineCapacity = 16>
     class DynamicArray {
     public:
         using value_type = T;
@@ -32,15 +43,15 @@ namespace PCOE {
         using const_reference = const value_type&;
         using pointer = value_type*;
         using const_pointer = const value_type*;
-        using iterator = typename std::vector<T, Allocator>::iterator;
-        using const_iterator = typename std::vector<T, Allocator>::const_iterator;
-        using reverse_iterator = typename std::vector<T, Allocator>::reverse_iterator;
-        using const_reverse_iterator = typename std::vector<T, Allocator>::const_reverse_iterator;
+        using iterator = pointer;
+        using const_iterator = const_pointer;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
         /**
          * Constructs an empty {@code DynamicArray}.
          **/
-        DynamicArray() = default;
+        DynamicArray() : alloc(), elements(inlineData()), count(0) {}
 
         /**
          * Constructs a new {@code DynamicArray}, copying size and contents of
@@ -48,15 +59,28 @@ namespace PCOE {
          *
          * @param other The array to copy from.
          **/
-        DynamicArray(const DynamicArray& other) = default;
+        DynamicArray(const DynamicArray& other)
+            : alloc(alloc_traits::select_on_container_copy_construction(other.alloc)),
+              elements(inlineData()),
+              count(0) {
+            construct(other.count, other.elements);
+        }
 
         /**
          * Constructs a new {@code DynamicArray}, moving the contents of
          * {@param other} into the new instance.
          *
+         * @remarks
+         * If {@param other} stores its elements inline, they are moved
+         * individually. Otherwise, the new instance takes its storage. In
+         * either case, {@param other} is left empty.
+         *
          * @param other The array to move from.
          **/
-        DynamicArray(DynamicArray&& other) = default;
+        DynamicArray(DynamicArray&& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+            : alloc(std::move(other.alloc)), elements(inlineData()), count(0) {
+            take(other);
+        }
 
         /**
          * Constructs a new {@code DynamicArray} with the specified number of
@@ -68,8 +92,8 @@ namespace PCOE {
          *              constructed allocator is used.
          **/
         explicit DynamicArray(size_type size, const Allocator& alloc = Allocator())
-            : storage(alloc) {
-            storage.resize(size);
+            : alloc(alloc), elements(inlineData()), count(0) {
+            construct(size, static_cast<const T*>(nullptr));
         }
 
         /**
@@ -79,7 +103,9 @@ namespace PCOE {
          * @param source The array to copy from.
          **/
         explicit DynamicArray(std::initializer_list<T> source, const Allocator& alloc = Allocator())
-            : storage(source, alloc) {}
+            : alloc(alloc), elements(inlineData()), count(0) {
+            construct(source.size(), source.begin());
+        }
 
         /**
          * Constructs a new {@code DynamicArray}, copying size and contents of
@@ -92,7 +118,9 @@ namespace PCOE {
          **/
         explicit DynamicArray(const std::vector<T, Allocator>& source,
                               const Allocator& alloc = Allocator())
-            : storage(source, alloc) {}
+            : alloc(alloc), elements(inlineData()), count(0) {
+            construct(source.size(), source.data());
+        }
 
         /**
          * Constructs a new {@code DynamicArray}, moving the contents of
@@ -100,13 +128,23 @@ namespace PCOE {
          *
          * @param source The vector to move from.
          **/
-        explicit DynamicArray(std::vector<T, Allocator>&& source) : storage(source) {}
+        explicit DynamicArray(std::vector<T, Allocator>&& source)
+            : alloc(source.get_allocator()), elements(inlineData()), count(0) {
+            construct(source.size(), std::make_move_iterator(source.begin()));
+        }
 
         /**
-         * Virtual destructor allows derived classes to be safely destroyed via
-         * a pointer to the base type.
-         **/
-        virtual ~DynamicArray() = default;
+         * Destroys the elements of the array and releases its storage.
+         *
+         * @remarks
+         * The destructor is not virtual, so arrays carry no vtable pointer.
+         * Types derived from {@code DynamicArray} must not add members that
+         * need to be destroyed, and must not be deleted through a pointer to
+         * {@code DynamicArray}.
+         **/
+        ~DynamicArray() {
+            reset();
+        }
 
         /**
          * Replaces the contents of the current instance with the contents of
@@ -126,8 +164,22 @@ namespace PCOE {
          *
          * @param other Contains the contents to assign to the current instance.
          **/
-        void swap(DynamicArray& other) noexcept {
-            storage.swap(other.storage);
+        void swap(DynamicArray& other) noexcept(std::is_nothrow_move_constructible<T>::value) {
+            using std::swap;
+            if (!isInline() && !other.isInline()) {
+                swap(elements, other.elements);
+                swap(count, other.count);
+                swap(alloc, other.alloc);
+            }
+            else {
+                // Inline elements have to be moved one at a time, and each
+                // allocator has to follow the storage it allocated.
+                DynamicArray tmp(std::move(other));
+                other.take(*this);
+                take(tmp);
+                swap(alloc, tmp.alloc);
+                swap(other.alloc, tmp.alloc);
+            }
         }
 
         /**
@@ -137,10 +189,9 @@ namespace PCOE {
          * @param first The first instance.
          * @param second The second instance.
          **/
-        friend void swap(DynamicArray& first, DynamicArray& second) {
-            using std::swap;
-
-            swap(first.storage, second.storage);
+        friend void swap(DynamicArray& first, DynamicArray& second) noexcept(
+            std::is_nothrow_move_constructible<T>::value) {
+            first.swap(second);
         }
 
         /**
@@ -148,14 +199,14 @@ namespace PCOE {
          * same elements.
          **/
         friend bool operator==(const DynamicArray& lhs, const DynamicArray& rhs) {
-            return lhs.storage == rhs.storage;
+            return lhs.count == rhs.count && std::equal(lhs.cbegin(), lhs.cend(), rhs.cbegin());
         }
 
         /**
          * Checks whether the given arrays differ in size or elements conatined.
          **/
         friend bool operator!=(const DynamicArray& lhs, const DynamicArray& rhs) {
-            return lhs.storage != rhs.storage;
+            return !(lhs == rhs);
         }
 
         /**
@@ -168,7 +219,10 @@ namespace PCOE {
          * @exception std::out_of_range If {@param pos} is out of range.
          **/
         reference at(size_type pos) {
-            return storage.at(pos);
+            if (pos >= count) {
+                throw std::out_of_range("DynamicArray index out of range");
+            }
+            return elements[pos];
         }
 
         /**
@@ -181,7 +235,10 @@ namespace PCOE {
          * @exception std::out_of_range If {@param pos} is out of range.
          **/
         const_reference at(size_type pos) const {
-            return storage.at(pos);
+            if (pos >= count) {
+                throw std::out_of_range("DynamicArray index out of range");
+            }
+            return elements[pos];
         }
 
         /**
@@ -192,7 +249,7 @@ namespace PCOE {
          * @return    A reference to the element at the given position.
          **/
         reference operator[](size_type pos) {
-            return storage[pos];
+            return elements[pos];
         }
 
         /**
@@ -203,7 +260,7 @@ namespace PCOE {
          * @return    A cosnt reference to the element at the given position.
          **/
         const_reference operator[](size_type pos) const {
-            return storage[pos];
+            return elements[pos];
         }
 
         /**
@@ -213,7 +270,7 @@ namespace PCOE {
          * @return A reference to the first element of the array.
          **/
         reference front() {
-            return storage.front();
+            return elements[0];
         }
 
         /**
@@ -223,7 +280,7 @@ namespace PCOE {
          * @return A const reference to the first element of the array.
          **/
         const_reference front() const {
-            return storage.front();
+            return elements[0];
         }
 
         /**
@@ -233,7 +290,7 @@ namespace PCOE {
          * @return A reference to the last element of the array.
          **/
         reference back() {
-            return storage.back();
+            return elements[count - 1];
         }
 
         /**
@@ -243,109 +300,204 @@ namespace PCOE {
          * @return A const reference to the last element of the array.
          **/
         const_reference back() const {
-            return storage.back();
+            return elements[count - 1];
         }
 
         /**
          * Gets a pointer to the underlying storage of the array.
          **/
         pointer data() noexcept {
-            return storage.data();
+            return elements;
         }
 
         /**
          * Gets a pointer to the underlying storage of the array.
          **/
         const_pointer data() const noexcept {
-            return storage.data();
+            return elements;
         }
 
         /**
-         * Gets a reference to the underlying vector of the array.
+         * Gets a copy of the elements of the array as a vector.
          **/
-        const std::vector<T>& vec() const {
-            return storage;
+        std::vector<T> vec() const {
+            return std::vector<T>(cbegin(), cend());
         }
 
         /**
          * Returns an iterator to the first element of the array.
          **/
         iterator begin() {
-            return storage.begin();
+            return elements;
         }
 
         /**
          * Returns an iterator one past the last element of the array.
          **/
         iterator end() {
-            return storage.end();
+            return elements + count;
         }
 
         /**
          * Returns an constant iterator to the first element of the array.
          **/
         const_iterator cbegin() const {
-            return storage.cbegin();
+            return elements;
         }
 
         /**
          * Returns an constant iterator one past the last element of the array.
          **/
         const_iterator cend() const {
-            return storage.cend();
+            return elements + count;
         }
 
         /**
-         * Returns an iterator to the first element of the array.
+         * Returns a reverse iterator to the last element of the array.
          **/
-        iterator rbegin() {
-            return storage.begin();
+        reverse_iterator rbegin() {
+            return reverse_iterator(end());
         }
 
         /**
-         * Returns an iterator one past the last element of the array.
+         * Returns a reverse iterator one before the first element of the array.
          **/
-        iterator rend() {
-            return storage.end();
+        reverse_iterator rend() {
+            return reverse_iterator(begin());
         }
 
         /**
-         * Returns an constant iterator to the first element of the array.
+         * Returns a constant reverse iterator to the last element of the array.
          **/
-        const_iterator crbegin() const {
-            return storage.cbegin();
+        const_reverse_iterator crbegin() const {
+            return const_reverse_iterator(cend());
         }
 
         /**
-         * Returns an constant iterator one past the last element of the array.
+         * Returns a constant reverse iterator one before the first element of
+         * the array.
          **/
-        const_iterator crend() const {
-            return storage.cend();
+        const_reverse_iterator crend() const {
+            return const_reverse_iterator(cbegin());
         }
 
         /**
          * Returns a value indicating whether the array has no elements.
          **/
         bool empty() const noexcept {
-            return storage.empty();
+            return count == 0;
         }
 
         /**
          * Returns the number of elements in the array.
          **/
         size_type size() const {
-            return storage.size();
+            return count;
         }
 
         /**
          * Copies the provided value to all elements of the array.
          **/
         void fill(const T& value) noexcept {
-            std::fill(storage.begin(), storage.end(), value);
+            std::fill(elements, elements + count, value);
         }
 
     private:
-        std::vector<T, Allocator> storage;
+        using alloc_traits = std::allocator_traits<Allocator>;
+
+        inline T* inlineData() noexcept {
+            return reinterpret_cast<T*>(&buffer);
+        }
+
+        inline bool isInline() const noexcept {
+            return elements == reinterpret_cast<const T*>(&buffer);
+        }
+
+        /**
+         * Gets storage for {@param size} elements and constructs them from
+         * {@param source}, or value-initializes them if {@param source} is
+         * null. The array must be empty.
+         **/
+        template <class RandomIt>
+        void construct(size_type size, RandomIt source) {
+            if (size > InlineCapacity) {
+                elements = alloc_traits::allocate(alloc, size);
+            }
+            size_type i = 0;
+            try {
+                for (; i < size; ++i) {
+                    constructAt(i, source);
+                }
+            }
+            catch (...) {
+                for (size_type j = 0; j < i; ++j) {
+                    alloc_traits::destroy(alloc, elements + j);
+                }
+                if (!isInline()) {
+                    alloc_traits::deallocate(alloc, elements, size);
+                    elements = inlineData();
+                }
+                throw;
+            }
+            count = size;
+        }
+
+        inline void constructAt(size_type i, const T* source) {
+            if (source == nullptr) {
+                alloc_traits::construct(alloc, elements + i);
+            }
+            else {
+                alloc_traits::construct(alloc, elements + i, source[i]);
+            }
+        }
+
+        template <class RandomIt>
+        inline void constructAt(size_type i, RandomIt source) {
+            alloc_traits::construct(alloc,
+                                    elements + i,
+                                    *(source + static_cast<difference_type>(i)));
+        }
+
+        /**
+         * Takes the elements of {@param other}, leaving it empty. The array
+         * must be empty, and must be able to deallocate the storage of
+         * {@param other}.
+         **/
+        void take(DynamicArray& other) noexcept(std::is_nothrow_move_constructible<T>::value) {
+            if (other.isInline()) {
+                for (size_type i = 0; i < other.count; ++i) {
+                    alloc_traits::construct(alloc, elements + i, std::move(other.elements[i]));
+                }
+                count = other.count;
+                other.reset();
+            }
+            else {
+                elements = other.elements;
+                count = other.count;
+                other.elements = other.inlineData();
+                other.count = 0;
+            }
+        }
+
+        /**
+         * Destroys the elements of the array and releases its storage,
+         * leaving it empty.
+         **/
+        void reset() noexcept {
+            for (size_type i = 0; i < count; ++i) {
+                alloc_traits::destroy(alloc, elements + i);
+            }
+            if (!isInline()) {
+                alloc_traits::deallocate(alloc, elements, count);
+            }
+            elements = inlineData();
+            count = 0;
+        }
+
+        typename std::aligned_storage<sizeof(T) * InlineCapacity, alignof(T)>::type buffer;
+        Allocator alloc;
+        T* elements;
+        size_type count;
     };
 }
 #endif
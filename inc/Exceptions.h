@@ -1,6 +1,8 @@
 // Copyright(c) 2018 United States Government as represented by the
 // Administrator of the National Aeronautics and Space Administration.
 // All Rights Reserved.
+#ifndef PCOE_EXCEPTIONS_H
+#define PCOE_EXCEPTIONS_H
 
 #include <stdexcept>
 #include <sstream>
@@ -22,3 +24,5 @@ namespace PCOE {
         using std::runtime_error::runtime_error;
     };
 }
+
+#endif
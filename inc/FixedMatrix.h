@@ -0,0 +1,292 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#ifndef PCOE_FIXEDMATRIX_H
+#define PCOE_FIXEDMATRIX_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+
+#include "Matrix.h"
+
+namespace PCOE {
+    /**
+     * An R x C matrix of doubles whose dimensions are known at compile time.
+     * The elements are stored inline in row-major order, so a
+     * {@code FixedMatrix} never allocates, and every loop over its elements
+     * has a constant trip count that the compiler can unroll.
+     *
+     * @remarks
+     * {@code FixedMatrix} is intended for the small matrices used by models
+     * whose sizes are known at compile time. See {@code ModelTraits}. It can
+     * be converted to and from {@code Matrix} for use with code that works on
+     * matrices of any size.
+     *
+     * @since 1.2
+     **/
+    template <std::size_t R, std::size_t C>
+    class FixedMatrix final {
+        static_assert(R > 0 && C > 0, "FixedMatrix dimensions must be positive");
+
+    public:
+        /**
+         * Constructs a new matrix with all elements set to zero.
+         **/
+        FixedMatrix() : data() {}
+
+        /**
+         * Constructs a new matrix with all elements set to the given value.
+         **/
+        explicit FixedMatrix(double value) {
+            std::fill(data, data + R * C, value);
+        }
+
+        /**
+         * Constructs a new matrix from a list of elements in row-major order.
+         *
+         * @exception std::domain_error If the list does not have R * C
+         *            elements.
+         **/
+        FixedMatrix(std::initializer_list<double> l) {
+            if (l.size() != R * C) {
+                throw std::domain_error("Invalid initializer list size.");
+            }
+            std::copy(l.begin(), l.end(), data);
+        }
+
+        /**
+         * Constructs a new matrix with the elements of a {@code Matrix}.
+         *
+         * @exception std::domain_error If {@p m} is not R x C.
+         **/
+        explicit FixedMatrix(const Matrix& m) {
+            if (m.rows() != R || m.cols() != C) {
+                throw std::domain_error("Matrix is not the same size");
+            }
+            std::copy(m.getData(), m.getData() + R * C, data);
+        }
+
+        /**
+         * Copies the elements of the matrix into a new {@code Matrix}.
+         **/
+        explicit operator Matrix() const {
+            Matrix result(R, C);
+            for (std::size_t i = 0; i < R; i++) {
+                for (std::size_t j = 0; j < C; j++) {
+                    result[i][j] = (*this)[i][j];
+                }
+            }
+            return result;
+        }
+
+        static constexpr std::size_t rows() {
+            return R;
+        }
+
+        static constexpr std::size_t cols() {
+            return C;
+        }
+
+        /**
+         * Gets a pointer to the given row, so that elements can be accessed
+         * as {@code m[i][j]}. No bounds checking is performed.
+         **/
+        inline double* operator[](std::size_t i) {
+            return data + i * C;
+        }
+
+        inline const double* operator[](std::size_t i) const {
+            return data + i * C;
+        }
+
+        /**
+         * Gets the element at the given position.
+         *
+         * @exception std::out_of_range If the position is outside the matrix.
+         **/
+        double& at(std::size_t i, std::size_t j) {
+            if (i >= R || j >= C) {
+                throw std::out_of_range("Index out of range");
+            }
+            return data[i * C + j];
+        }
+
+        double at(std::size_t i, std::size_t j) const {
+            if (i >= R || j >= C) {
+                throw std::out_of_range("Index out of range");
+            }
+            return data[i * C + j];
+        }
+
+        inline const double* getData() const {
+            return data;
+        }
+
+        /***********************************************************************/
+        /* Arithmetic Operators                                                */
+        /***********************************************************************/
+        FixedMatrix& operator+=(const FixedMatrix& rhs) {
+            for (std::size_t i = 0; i < R * C; i++) {
+                data[i] += rhs.data[i];
+            }
+            return *this;
+        }
+
+        FixedMatrix& operator-=(const FixedMatrix& rhs) {
+            for (std::size_t i = 0; i < R * C; i++) {
+                data[i] -= rhs.data[i];
+            }
+            return *this;
+        }
+
+        FixedMatrix& operator*=(double rhs) {
+            for (std::size_t i = 0; i < R * C; i++) {
+                data[i] *= rhs;
+            }
+            return *this;
+        }
+
+        inline friend FixedMatrix operator+(FixedMatrix lhs, const FixedMatrix& rhs) {
+            return lhs += rhs;
+        }
+
+        inline friend FixedMatrix operator-(FixedMatrix lhs, const FixedMatrix& rhs) {
+            return lhs -= rhs;
+        }
+
+        inline friend FixedMatrix operator*(FixedMatrix lhs, double rhs) {
+            return lhs *= rhs;
+        }
+
+        inline friend FixedMatrix operator*(double lhs, FixedMatrix rhs) {
+            return rhs *= lhs;
+        }
+
+        /**
+         * Multiplies the current matrix by another matrix. The number of rows
+         * of the argument is checked at compile time.
+         **/
+        template <std::size_t K>
+        FixedMatrix<R, K> operator*(const FixedMatrix<C, K>& rhs) const {
+            FixedMatrix<R, K> result;
+            for (std::size_t i = 0; i < R; i++) {
+                for (std::size_t p = 0; p < C; p++) {
+                    const double a = (*this)[i][p];
+                    for (std::size_t j = 0; j < K; j++) {
+                        result[i][j] += a * rhs[p][j];
+                    }
+                }
+            }
+            return result;
+        }
+
+        bool operator==(const FixedMatrix& rhs) const {
+            return std::equal(data, data + R * C, rhs.data);
+        }
+
+        bool operator!=(const FixedMatrix& rhs) const {
+            return !(*this == rhs);
+        }
+
+        /***********************************************************************/
+        /* Operations                                                          */
+        /***********************************************************************/
+        FixedMatrix<C, R> transpose() const {
+            FixedMatrix<C, R> result;
+            for (std::size_t i = 0; i < R; i++) {
+                for (std::size_t j = 0; j < C; j++) {
+                    result[j][i] = (*this)[i][j];
+                }
+            }
+            return result;
+        }
+
+        /**
+         * Calculates the lower-triangular Cholesky factor of the matrix.
+         *
+         * @exception std::domain_error If the matrix is not symmetric and
+         *            positive definite.
+         **/
+        FixedMatrix chol() const {
+            static_assert(R == C, "Cholesky decomposition requires a square matrix");
+            FixedMatrix result;
+            for (std::size_t k = 0; k < R; k++) {
+                for (std::size_t j = 0; j < k; j++) {
+                    if (std::abs((*this)[k][j] - (*this)[j][k]) > 1e-15) {
+                        throw std::domain_error("Matrix is not positive definite");
+                    }
+                }
+                double sum = (*this)[k][k];
+                for (std::size_t p = 0; p < k; p++) {
+                    sum -= result[k][p] * result[k][p];
+                }
+                if (!(sum > 0.0)) {
+                    throw std::domain_error("Matrix is not positive definite");
+                }
+                result[k][k] = std::sqrt(sum);
+                for (std::size_t i = k + 1; i < R; i++) {
+                    double s = (*this)[i][k];
+                    for (std::size_t p = 0; p < k; p++) {
+                        s -= result[i][p] * result[k][p];
+                    }
+                    result[i][k] = s / result[k][k];
+                }
+            }
+            return result;
+        }
+
+        /**
+         * Solves AX = B for X, where A is the current matrix, using its
+         * Cholesky decomposition.
+         *
+         * @exception std::domain_error If the matrix is not symmetric and
+         *            positive definite.
+         **/
+        template <std::size_t K>
+        FixedMatrix<R, K> cholSolve(const FixedMatrix<R, K>& b) const {
+            FixedMatrix L = chol();
+            FixedMatrix<R, K> x = b;
+            for (std::size_t i = 0; i < R; i++) {
+                for (std::size_t p = 0; p < i; p++) {
+                    for (std::size_t j = 0; j < K; j++) {
+                        x[i][j] -= L[i][p] * x[p][j];
+                    }
+                }
+                for (std::size_t j = 0; j < K; j++) {
+                    x[i][j] /= L[i][i];
+                }
+            }
+            for (std::size_t i = R; i-- > 0;) {
+                for (std::size_t p = i + 1; p < R; p++) {
+                    for (std::size_t j = 0; j < K; j++) {
+                        x[i][j] -= L[p][i] * x[p][j];
+                    }
+                }
+                for (std::size_t j = 0; j < K; j++) {
+                    x[i][j] /= L[i][i];
+                }
+            }
+            return x;
+        }
+
+        /***********************************************************************/
+        /* Static Operations                                                   */
+        /***********************************************************************/
+        static FixedMatrix identity() {
+            static_assert(R == C, "Identity matrix must be square");
+            FixedMatrix result;
+            for (std::size_t i = 0; i < R; i++) {
+                result[i][i] = 1.0;
+            }
+            return result;
+        }
+
+    private:
+        double data[R * C];
+    };
+}
+
+#endif
@@ -0,0 +1,60 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#ifndef PCOE_MAPPEDFILE_H
+#define PCOE_MAPPEDFILE_H
+#include <cstddef>
+#include <string>
+
+namespace PCOE {
+    /**
+     * Maps a file into memory read-only for the lifetime of the object.
+     *
+     * @remarks
+     * Pages of the file are loaded by the operating system as they are
+     * accessed, so mapping a large file is cheap and reading it sequentially
+     * does not copy it through an intermediate buffer.
+     *
+     * @since 1.2
+     **/
+    class MappedFile {
+    public:
+        /**
+         * Maps the file with the given name.
+         *
+         * @exception std::system_error If the file cannot be opened or
+         *            mapped.
+         **/
+        explicit MappedFile(const std::string& filename);
+
+        MappedFile(const MappedFile&) = delete;
+
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        /**
+         * Unmaps the file.
+         **/
+        ~MappedFile();
+
+        /**
+         * Gets a pointer to the first byte of the file, or {@code nullptr} if
+         * the file is empty.
+         **/
+        inline const char* data() const {
+            return mapping;
+        }
+
+        /**
+         * Gets the size of the file in bytes.
+         **/
+        inline std::size_t size() const {
+            return length;
+        }
+
+    private:
+        const char* mapping;
+        std::size_t length;
+    };
+}
+
+#endif
@@ -8,8 +8,13 @@
 #include <cstddef>
 #include <initializer_list>
 #include <iostream>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "MatrixExpression.h"
+#include "MatrixView.h"
+
 namespace PCOE {
 #undef minor
 
@@ -151,6 +156,43 @@ namespace PCOE {
          */
         Matrix& operator=(Matrix other);
 
+        /** @brief Constructs a new Matrix by evaluating an element-wise
+         *         expression.
+         *
+         *  @param expr The expression to evaluate.
+         */
+        template <class E>
+        Matrix(const MatrixExpression<E>& expr)
+            : M(expr.rows()), N(expr.cols()), data(new double[expr.rows() * expr.cols()]) {
+            for (std::size_t i = 0; i < M * N; i++) {
+                data[i] = expr.element(i);
+            }
+        }
+
+        /** @brief Evaluates an element-wise expression into the current
+         *         Matrix. If the expression is the same size as the current
+         *         Matrix, the existing storage is reused.
+         *
+         *  @remarks Each element of an expression depends only on the
+         *           elements at the same position in its operands, so the
+         *           expression may refer to the current Matrix.
+         *
+         *  @param expr The expression to evaluate.
+         *  @returns    A reference to the current Matrix.
+         */
+        template <class E>
+        Matrix& operator=(const MatrixExpression<E>& expr) {
+            if (M != expr.rows() || N != expr.cols()) {
+                Matrix result(expr);
+                swap(*this, result);
+                return *this;
+            }
+            for (std::size_t i = 0; i < M * N; i++) {
+                data[i] = expr.element(i);
+            }
+            return *this;
+        }
+
         /** @brief Exchanges the underlying data of two Matrices.
          *
          *  @param a The first matrix to swap.
@@ -309,6 +351,49 @@ namespace PCOE {
          */
         void row(std::size_t m, const std::vector<double>& value);
 
+        /** @brief Gets a view of the n-th column of the matrix, without
+         *         copying its elements.
+         *
+         *  @param n The zero-based column of the matrix to view.
+         *  @returns An M by 1 view whose elements are N apart.
+         *  @exception std::out_of_range If @p n is larger than the number of
+         *             columns in the matrix.
+         */
+        MatrixView colView(std::size_t n);
+
+        /** @copydoc colView(std::size_t) */
+        ConstMatrixView colView(std::size_t n) const;
+
+        /** @brief Gets a view of the m-th row of the matrix, without
+         *         copying its elements.
+         *
+         *  @param m The zero-based row of the matrix to view.
+         *  @returns A 1 by N view of contiguous elements.
+         *  @exception std::out_of_range If @p m is larger than the number of
+         *             rows in the matrix.
+         */
+        MatrixView rowView(std::size_t m);
+
+        /** @copydoc rowView(std::size_t) */
+        ConstMatrixView rowView(std::size_t m) const;
+
+        /** @brief Gets a view of a rectangular block of the matrix, without
+         *         copying its elements.
+         *
+         *  @param m0   The zero-based row of the first element of the block.
+         *  @param n0   The zero-based column of the first element of the
+         *              block.
+         *  @param rows The number of rows in the block.
+         *  @param cols The number of columns in the block.
+         *  @exception std::out_of_range If the block extends outside of the
+         *             matrix.
+         */
+        MatrixView blockView(std::size_t m0, std::size_t n0, std::size_t rows, std::size_t cols);
+
+        /** @copydoc blockView(std::size_t, std::size_t, std::size_t, std::size_t) */
+        ConstMatrixView
+        blockView(std::size_t m0, std::size_t n0, std::size_t rows, std::size_t cols) const;
+
         /**
          * Copies the elements of the matrix to a std::vector<double>.
          **/
@@ -326,13 +411,6 @@ namespace PCOE {
         /***********************************************************************/
         /* Arithmetic operators                                                */
         /***********************************************************************/
-        /**
-         * Negates each element of the matrix.
-         *
-         * @return A new matrix in which each element has been negated.
-         **/
-        Matrix operator-();
-
         /**
          * Adds the specified matrix to the current matrix.
          *
@@ -344,15 +422,22 @@ namespace PCOE {
         Matrix& operator+=(const Matrix& rhs);
 
         /**
-         * Adds two matrices.
+         * Adds the result of an element-wise expression to the current matrix.
          *
-         * @param lhs The first matrix to add.
-         * @param rhs The second matrix to add.
-         * @returns   A new matrix containing the result.
-         * @exception std::domain_error If @p lhs and @p rhs are not the same size.
+         * @param rhs The expression to add.
+         * @returns   A reference to the current matrix.
+         * @exception std::domain_error If @p rhs is not the same size as the
+         *            current matrix.
          */
-        inline friend Matrix operator+(Matrix lhs, const Matrix& rhs) {
-            return lhs += rhs;
+        template <class E>
+        Matrix& operator+=(const MatrixExpression<E>& rhs) {
+            if (M != rhs.rows() || N != rhs.cols()) {
+                throw std::domain_error("Matrices are different sizes.");
+            }
+            for (std::size_t i = 0; i < M * N; i++) {
+                data[i] += rhs.element(i);
+            }
+            return *this;
         }
 
         /**
@@ -363,28 +448,6 @@ namespace PCOE {
          */
         Matrix& operator+=(double rhs);
 
-        /**
-         * Adds a scalar to a matrix.
-         *
-         * @param lhs The matrix to add to
-         * @param rhs The scalar to add.
-         * @returns   A new matrix containing the result.
-         */
-        inline friend Matrix operator+(Matrix lhs, double rhs) {
-            return lhs += rhs;
-        }
-
-        /**
-         * Adds a scalar to a matrix.
-         *
-         * @param lhs The scalar to add.
-         * @param rhs The matrix to add to
-         * @returns   A new matrix containing the result.
-         */
-        inline friend Matrix operator+(double lhs, Matrix rhs) {
-            return rhs += lhs;
-        }
-
         /**
          * Subtracts the specified matrix to the current matrix.
          *
@@ -395,15 +458,24 @@ namespace PCOE {
          */
         Matrix& operator-=(const Matrix& rhs);
 
-        /** @brief Subtracts two matrices.
+        /**
+         * Subtracts the result of an element-wise expression from the current
+         * matrix.
          *
-         * @param lhs The first matrix to subtract.
-         * @param rhs The second matrix to subtract.
-         * @returns   A new matrix containing the result.
-         * @exception std::domain_error If @p lhs and @p rhs are not the same size.
+         * @param rhs The expression to subtract.
+         * @returns   A reference to the current matrix.
+         * @exception std::domain_error If @p rhs is not the same size as the
+         *            current matrix.
          */
-        inline friend Matrix operator-(Matrix lhs, const Matrix& rhs) {
-            return lhs -= rhs;
+        template <class E>
+        Matrix& operator-=(const MatrixExpression<E>& rhs) {
+            if (M != rhs.rows() || N != rhs.cols()) {
+                throw std::domain_error("Matrices are different sizes.");
+            }
+            for (std::size_t i = 0; i < M * N; i++) {
+                data[i] -= rhs.element(i);
+            }
+            return *this;
         }
 
         /**
@@ -414,17 +486,6 @@ namespace PCOE {
          */
         Matrix& operator-=(double other);
 
-        /**
-         * Subtracts a scalar from a matrix.
-         *
-         * @param lhs The matrix to subtract from
-         * @param rhs The scalar to subtract.
-         * @returns   A new matrix containing the result.
-         */
-        inline friend Matrix operator-(Matrix lhs, double rhs) {
-            return lhs -= rhs;
-        }
-
         /**
          * Multiplies the current matrix by another matrix.
          *
@@ -436,53 +497,54 @@ namespace PCOE {
         Matrix operator*(const Matrix& rhs) const;
 
         /**
-         *  Multiplies the current matrix by a scalar.
+         * Multiplies the current matrix by the transpose of another matrix,
+         * without forming the transpose.
          *
-         * @param rhs The scalar to multiply by.
-         * @returns   A reference to the current matrix.
+         * @param rhs The matrix whose transpose to multiply by.
+         * @returns   A new matrix containing the product {@code *this * rhs'}.
+         * @exception std::domain_error If the number of columns in the
+         *            argument does not match the number of columns in the
+         *            current matrix.
          */
-        Matrix& operator*=(double rhs);
+        Matrix multiplyTransposed(const Matrix& rhs) const;
 
         /**
-         * Mulitiplies a matrix by a scalar.
+         * Multiplies the transpose of the current matrix by another matrix,
+         * without forming the transpose.
          *
-         * @param lhs The matrix to multiply.
-         * @param rhs The scalar to multiply by.
-         * @returns   A new matrix containing the result.
+         * @param rhs The matrix to multiply by.
+         * @returns   A new matrix containing the product {@code *this' * rhs}.
+         * @exception std::domain_error If the number of rows in the argument
+         *            does not match the number of rows in the current matrix.
          */
-        inline friend Matrix operator*(Matrix lhs, double rhs) {
-            return lhs *= rhs;
-        }
+        Matrix transposeMultiply(const Matrix& rhs) const;
 
         /**
-         * Mulitiplies a matrix by a scalar.
+         * Multiplies the current matrix by a vector and accumulates the
+         * result, {@code y = alpha * (*this) * x + y}.
          *
-         * @param lhs The scalar to multiply by.
-         * @param rhs The matrix to multiply.
-         * @returns   A new matrix containing the result.
+         * @param x     The vector to multiply by, with one element per column.
+         * @param y     The vector to accumulate into, with one element per row.
+         *              Must not overlap {@p x}.
+         * @param alpha The scale factor applied to the product.
          */
-        inline friend Matrix operator*(double lhs, Matrix rhs) {
-            return rhs *= lhs;
-        }
+        void multiplyAdd(const double* x, double* y, double alpha = 1.0) const;
 
         /**
-         * Divides the current matrix by a scalar.
+         *  Multiplies the current matrix by a scalar.
          *
-         * @param rhs The scalar to divide by.
+         * @param rhs The scalar to multiply by.
          * @returns   A reference to the current matrix.
          */
-        Matrix& operator/=(double rhs);
+        Matrix& operator*=(double rhs);
 
         /**
-         * Divides a matrix by a scalar.
+         * Divides the current matrix by a scalar.
          *
-         * @param lhs The matrix to divide.
          * @param rhs The scalar to divide by.
-         * @returns   A new matrix containing the result.
+         * @returns   A reference to the current matrix.
          */
-        inline friend Matrix operator/(Matrix lhs, double rhs) {
-            return lhs /= rhs;
-        }
+        Matrix& operator/=(double rhs);
 
         /**
          * Applies modulo to each element inplace
@@ -557,6 +619,16 @@ namespace PCOE {
          */
         Matrix chol() const;
 
+        /** @brief Calculates the Cholesky decomposition of the matrix into an
+         *         existing matrix, without allocating.
+         *
+         *  @param result The matrix to store the lower-triangular factor in.
+         *                Must be the same size as the current matrix.
+         *  @exception std::domain_error If the matrix is not square, or is
+         *             not symmetric and positive definite.
+         */
+        void chol(Matrix& result) const;
+
         /** @brief Calculates the i,j-th cofactor of the matrix.
          *
          *  @param m The row of the elment to calculate the cofactor for.
@@ -575,12 +647,12 @@ namespace PCOE {
 
         /** @brief Calculates the determinant of the matrix.
          *
-         *  @remarks The current implementation uses Cholesky decomposition if the
-         *           Cholesky decomposition is defined, since the Cholesky
-         *           decomposition is more numerically stable than Crout. If the
-         *           Cholesky decomposition is not defined, then Crout decomposition
-         *           is used. Finally, if the Crout decomposition is not possible,
-         *           Laplace expansion is used.
+         *  @remarks The determinant is calculated from the LU decomposition of
+         *           the matrix with partial pivoting. To calculate several
+         *           quantities from the same matrix, or to avoid overflow in
+         *           the determinant of a large matrix, use
+         *           {@code LUDecomposition} or {@code CholeskyDecomposition}
+         *           directly.
          *
          *  @returns The determinant of the matrix.
          *  @exception std::domain_error If the matrix is not square.
@@ -594,9 +666,16 @@ namespace PCOE {
         Matrix diagonal() const;
 
         /** @brief Computes the inverse of a square matrix.
+         *
+         *  @remarks The inverse is calculated from the LU decomposition of the
+         *           matrix. To solve a linear system, prefer the {@code solve}
+         *           method of {@code LUDecomposition} or
+         *           {@code CholeskyDecomposition}, which is both faster and
+         *           more accurate than multiplying by the inverse.
          *
          *  @returns A Matrix containing the inverse of the current matrix.
-         *  @exception std::domain_error If the matrix is not square.
+         *  @exception std::domain_error If the matrix is not square, or is
+         *             singular.
          */
         Matrix inverse() const;
 
@@ -638,16 +717,52 @@ namespace PCOE {
          */
         Matrix transpose() const;
 
+        /** @brief Stores the transpose of the current matrix in an existing
+         *         matrix, without allocating.
+         *
+         *  @param result The matrix to store the transpose in. Must have as
+         *                many rows as the current matrix has columns and as
+         *                many columns as the current matrix has rows, and must
+         *                not be the current matrix.
+         *  @exception std::domain_error If the result matrix is not the right
+         *             size.
+         */
+        void transpose(Matrix& result) const;
+
+        /** @brief Returns the weighted covariance of the columns of the
+         *         current matrix, treating each column as a sigma point.
+         *
+         *  @param w     A column vector with a weight for each column.
+         *  @param alpha Sigma point scaling parameter. Defaults to 1.
+         *  @param beta  Sigma point scaling parameter. Defaults to 0.
+         *  @remarks The term {@code 1 - alpha^2 + beta} is added to the
+         *           weight of the first column, which is assumed to be the
+         *           central sigma point. With the default values there is no
+         *           correction.
+         *  @exception std::domain_error If @p w is not a column vector with
+         *             a row for each column of the current matrix.
+         */
         Matrix weightedCovariance(const Matrix& w,
                                   const double alpha = 1,
                                   const double beta = 0) const;
 
+        /** @brief Returns the weighted mean of the columns of the current
+         *         matrix as a column vector.
+         *
+         *  @param w A column vector with a weight for each column.
+         *  @exception std::domain_error If @p w is not a column vector with
+         *             a row for each column of the current matrix.
+         */
         Matrix weightedMean(const Matrix& w) const;
 
         inline const double* getData() const {
             return data;
         }
 
+        inline double* getData() {
+            return data;
+        }
+
         /***********************************************************************/
         /* Static Operations                                                   */
         /***********************************************************************/
@@ -657,6 +772,89 @@ namespace PCOE {
          */
         static Matrix identity(std::size_t m);
 
+        /** @brief Multiplies two matrices into an existing matrix, without
+         *         allocating.
+         *
+         *  @param lhs    The matrix to multiply.
+         *  @param rhs    The matrix to multiply by.
+         *  @param result The matrix to store {@code lhs * rhs} in. Must have
+         *                the rows of @p lhs and the columns of @p rhs, and
+         *                must not be either argument.
+         *  @exception std::domain_error If the sizes are not compatible.
+         */
+        static void multiply(const Matrix& lhs, const Matrix& rhs, Matrix& result);
+
+        /** @brief Multiplies a matrix by the transpose of another matrix into
+         *         an existing matrix, without allocating.
+         *
+         *  @param lhs    The matrix to multiply.
+         *  @param rhs    The matrix whose transpose to multiply by.
+         *  @param result The matrix to store {@code lhs * rhs'} in. Must not
+         *                be either argument.
+         *  @exception std::domain_error If the sizes are not compatible.
+         */
+        static void multiplyTransposed(const Matrix& lhs, const Matrix& rhs, Matrix& result);
+
+        /** @brief Multiplies the transpose of a matrix by another matrix into
+         *         an existing matrix, without allocating.
+         *
+         *  @param lhs    The matrix whose transpose to multiply.
+         *  @param rhs    The matrix to multiply by.
+         *  @param result The matrix to store {@code lhs' * rhs} in. Must not
+         *                be either argument.
+         *  @exception std::domain_error If the sizes are not compatible.
+         */
+        static void transposeMultiply(const Matrix& lhs, const Matrix& rhs, Matrix& result);
+
+        /** @brief Accumulates a scaled vector, {@code y = alpha * x + y}.
+         *
+         *  @param n     The number of elements in each vector.
+         *  @param alpha The scale factor applied to @p x.
+         *  @param x     The vector to scale.
+         *  @param y     The vector to accumulate into. Must not overlap @p x.
+         */
+        static void axpy(std::size_t n, double alpha, const double* x, double* y);
+
+        /** @brief Computes the weighted mean of a set of samples, without
+         *         allocating.
+         *
+         *  @param samples A matrix with one sample in each column.
+         *  @param w       The weight of each sample. Must have an element for
+         *                 each column of @p samples.
+         *  @param mean    The vector to store the mean in. Must have an
+         *                 element for each row of @p samples.
+         */
+        static void weightedMean(const Matrix& samples, const double* w, double* mean);
+
+        /** @brief Computes the weighted mean and covariance of a set of
+         *         samples, without allocating.
+         *
+         *  The mean and covariance are computed in a single pass over the
+         *  samples, as a symmetric rank-k update over the deviations of the
+         *  samples from the first sample that is then corrected to the
+         *  mean. Only the upper triangle is computed, and is then copied to
+         *  the lower triangle.
+         *
+         *  @param samples       A matrix with one sample in each column.
+         *  @param w             The weight of each sample. Must have an
+         *                       element for each column of @p samples.
+         *  @param mean          The vector to store the mean in. Must have
+         *                       an element for each row of @p samples.
+         *  @param covariance    The matrix to store the covariance in. Must
+         *                       be square with a row for each row of
+         *                       @p samples.
+         *  @param centralWeight An additional weight applied to the first
+         *                       sample in the covariance only. For sigma
+         *                       points this is {@code 1 - alpha^2 + beta}.
+         *  @exception std::domain_error If the covariance matrix is not the
+         *             right size.
+         */
+        static void weightedMoments(const Matrix& samples,
+                                    const double* w,
+                                    double* mean,
+                                    Matrix& covariance,
+                                    double centralWeight = 0.0);
+
         /***********************************************************************/
         /* Steam Insertion                                                     */
         /***********************************************************************/
@@ -694,10 +892,7 @@ namespace PCOE {
         /* Internal implementation helpers                                     */
         /* !!!WARNING: These function do not do any error checking!!!          */
         /***********************************************************************/
-        double laplaceDet() const;
-
         bool cholInternal(Matrix& r) const;
-        bool croutInternal(Matrix& r, double& mult) const;
 
         /***********************************************************************/
         /* Class data members                                                  */
@@ -706,6 +901,235 @@ namespace PCOE {
         std::size_t N;
         double* data;
     };
+
+    /***********************************************************************/
+    /* Element-wise expression operators                                   */
+    /***********************************************************************/
+    // The arithmetic operators below build a MatrixExpression instead of
+    // computing a new Matrix, so that a compound expression is evaluated in
+    // one loop into its destination. Matrix multiplication is not
+    // element-wise, so its operands are evaluated first and the product is
+    // computed eagerly.
+
+    /**
+     * An expression that owns a temporary matrix, so that an expression built
+     * from a temporary does not outlive its operand.
+     **/
+    class MatrixTemporary final : public MatrixExpression<MatrixTemporary> {
+    public:
+        explicit MatrixTemporary(Matrix m) : value(std::move(m)) {}
+
+        inline std::size_t rows() const {
+            return value.rows();
+        }
+
+        inline std::size_t cols() const {
+            return value.cols();
+        }
+
+        inline double element(std::size_t i) const {
+            return value.getData()[i];
+        }
+
+    private:
+        Matrix value;
+    };
+
+    /**
+     * Maps the operand types of the matrix operators, as deduced for a
+     * forwarding reference, to the expression type that reads them. Named
+     * matrices are read in place and temporary matrices are moved into the
+     * expression. Other types have no {@code type} member, which removes the
+     * operators from overload resolution.
+     **/
+    template <class T, class Enable = void>
+    struct MatrixExpressionType {};
+
+    template <>
+    struct MatrixExpressionType<Matrix&> {
+        using type = MatrixOperand;
+    };
+
+    template <>
+    struct MatrixExpressionType<const Matrix&> {
+        using type = MatrixOperand;
+    };
+
+    template <>
+    struct MatrixExpressionType<Matrix> {
+        using type = MatrixTemporary;
+    };
+
+    template <>
+    struct MatrixExpressionType<const Matrix> {
+        using type = MatrixTemporary;
+    };
+
+    template <class T>
+    struct MatrixExpressionType<
+        T,
+        typename std::enable_if<
+            std::is_base_of<MatrixExpression<typename std::decay<T>::type>,
+                            typename std::decay<T>::type>::value>::type> {
+        using type = typename std::decay<T>::type;
+    };
+
+    template <class T>
+    struct IsMatrixOperand
+        : std::integral_constant<bool,
+                                 std::is_same<T, Matrix>::value ||
+                                     std::is_base_of<MatrixExpression<T>, T>::value> {};
+
+    inline MatrixOperand asExpression(const Matrix& m) {
+        return MatrixOperand(m.getData(), m.rows(), m.cols());
+    }
+
+    inline MatrixTemporary asExpression(Matrix&& m) {
+        return MatrixTemporary(std::move(m));
+    }
+
+    inline MatrixTemporary asExpression(const Matrix&& m) {
+        return MatrixTemporary(m);
+    }
+
+    template <class E>
+    inline E asExpression(const MatrixExpression<E>& e) {
+        return e.self();
+    }
+
+    template <class E>
+    inline E asExpression(MatrixExpression<E>&& e) {
+        return std::move(static_cast<E&>(e));
+    }
+
+    template <class L, class R>
+    inline MatrixBinaryExpression<typename MatrixExpressionType<L>::type,
+                                  typename MatrixExpressionType<R>::type,
+                                  AddOperation>
+    operator+(L&& lhs, R&& rhs) {
+        return {asExpression(std::forward<L>(lhs)), asExpression(std::forward<R>(rhs))};
+    }
+
+    template <class L, class R>
+    inline MatrixBinaryExpression<typename MatrixExpressionType<L>::type,
+                                  typename MatrixExpressionType<R>::type,
+                                  SubtractOperation>
+    operator-(L&& lhs, R&& rhs) {
+        return {asExpression(std::forward<L>(lhs)), asExpression(std::forward<R>(rhs))};
+    }
+
+    template <class T>
+    inline MatrixNegateExpression<typename MatrixExpressionType<T>::type> operator-(T&& m) {
+        return MatrixNegateExpression<typename MatrixExpressionType<T>::type>(
+            asExpression(std::forward<T>(m)));
+    }
+
+    template <class T>
+    inline MatrixScalarExpression<typename MatrixExpressionType<T>::type, AddOperation, false>
+    operator+(T&& lhs, double rhs) {
+        return {asExpression(std::forward<T>(lhs)), rhs};
+    }
+
+    template <class T>
+    inline MatrixScalarExpression<typename MatrixExpressionType<T>::type, AddOperation, true>
+    operator+(double lhs, T&& rhs) {
+        return {asExpression(std::forward<T>(rhs)), lhs};
+    }
+
+    template <class T>
+    inline MatrixScalarExpression<typename MatrixExpressionType<T>::type, SubtractOperation, false>
+    operator-(T&& lhs, double rhs) {
+        return {asExpression(std::forward<T>(lhs)), rhs};
+    }
+
+    template <class T>
+    inline MatrixScalarExpression<typename MatrixExpressionType<T>::type, MultiplyOperation, false>
+    operator*(T&& lhs, double rhs) {
+        return {asExpression(std::forward<T>(lhs)), rhs};
+    }
+
+    template <class T>
+    inline MatrixScalarExpression<typename MatrixExpressionType<T>::type, MultiplyOperation, true>
+    operator*(double lhs, T&& rhs) {
+        return {asExpression(std::forward<T>(rhs)), lhs};
+    }
+
+    template <class T>
+    inline MatrixScalarExpression<typename MatrixExpressionType<T>::type, DivideOperation, false>
+    operator/(T&& lhs, double rhs) {
+        return {asExpression(std::forward<T>(lhs)), rhs};
+    }
+
+    /**
+     * Evaluates an operand of a matrix product. Matrices are used in place.
+     **/
+    inline const Matrix& evaluate(const Matrix& m) {
+        return m;
+    }
+
+    template <class E>
+    inline Matrix evaluate(const MatrixExpression<E>& e) {
+        return Matrix(e);
+    }
+
+    /**
+     * Multiplies two matrices when at least one of them is an expression.
+     **/
+    template <class L, class R>
+    inline typename std::enable_if<IsMatrixOperand<L>::value && IsMatrixOperand<R>::value &&
+                                       !(std::is_same<L, Matrix>::value &&
+                                         std::is_same<R, Matrix>::value),
+                                   Matrix>::type
+    operator*(const L& lhs, const R& rhs) {
+        const Matrix& l = evaluate(lhs);
+        const Matrix& r = evaluate(rhs);
+        return l * r;
+    }
+
+    template <class E>
+    inline double MatrixExpression<E>::at(std::size_t m, std::size_t n) const {
+        return Matrix(*this).at(m, n);
+    }
+
+    template <class E>
+    inline Matrix MatrixExpression<E>::col(std::size_t n) const {
+        return Matrix(*this).col(n);
+    }
+
+    template <class E>
+    inline Matrix MatrixExpression<E>::row(std::size_t m) const {
+        return Matrix(*this).row(m);
+    }
+
+    template <class E>
+    inline Matrix MatrixExpression<E>::adjoint() const {
+        return Matrix(*this).adjoint();
+    }
+
+    template <class E>
+    inline Matrix MatrixExpression<E>::chol() const {
+        return Matrix(*this).chol();
+    }
+
+    template <class E>
+    inline double MatrixExpression<E>::determinant() const {
+        return Matrix(*this).determinant();
+    }
+
+    template <class E>
+    inline Matrix MatrixExpression<E>::diagonal() const {
+        return Matrix(*this).diagonal();
+    }
+
+    template <class E>
+    inline Matrix MatrixExpression<E>::inverse() const {
+        return Matrix(*this).inverse();
+    }
+
+    template <class E>
+    inline Matrix MatrixExpression<E>::transpose() const {
+        return Matrix(*this).transpose();
+    }
 }
 
 #endif
@@ -0,0 +1,214 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#ifndef PCOE_MATRIXDECOMPOSITION_H
+#define PCOE_MATRIXDECOMPOSITION_H
+
+#include <cstddef>
+#include <vector>
+
+#include "Matrix.h"
+
+namespace PCOE {
+    /**
+     * The LU decomposition with partial pivoting of a square matrix, PA = LU,
+     * where L is unit lower-triangular and U is upper-triangular. Once a
+     * matrix is factored, linear systems, the inverse and the determinant are
+     * computed from the factors in O(n^2) or O(n^3) time.
+     *
+     * @remarks
+     * The factors are stored packed in a single matrix. Calling
+     * {@code factorize} on a matrix with the same size as the last one reuses
+     * the existing storage, so a decomposition can be kept in a workspace and
+     * refactored each step without allocating.
+     *
+     * @since 1.2
+     **/
+    class LUDecomposition final {
+    public:
+        /**
+         * Constructs an empty decomposition. {@code factorize} must be called
+         * before any other member.
+         **/
+        LUDecomposition() = default;
+
+        /**
+         * Constructs the decomposition of the given matrix.
+         *
+         * @param A The matrix to factor.
+         * @exception std::domain_error If {@p A} is not square.
+         **/
+        explicit LUDecomposition(const Matrix& A);
+
+        /**
+         * Factors the given matrix, replacing the current factorization.
+         *
+         * @param A The matrix to factor.
+         * @exception std::domain_error If {@p A} is not square.
+         **/
+        void factorize(const Matrix& A);
+
+        /**
+         * Gets the size of the factored matrix.
+         **/
+        inline std::size_t size() const {
+            return lu.rows();
+        }
+
+        /**
+         * Checks whether the factored matrix is singular to working
+         * precision.
+         **/
+        bool isSingular() const;
+
+        /**
+         * Calculates the determinant of the factored matrix.
+         **/
+        double determinant() const;
+
+        /**
+         * Calculates the natural log of the absolute value of the determinant
+         * of the factored matrix. Unlike {@code determinant}, the result does
+         * not overflow or underflow for large matrices.
+         *
+         * @returns The log of the absolute value of the determinant, which is
+         *          -infinity if the matrix is singular.
+         **/
+        double logDeterminant() const;
+
+        /**
+         * Gets the sign of the determinant of the factored matrix.
+         *
+         * @returns 1 or -1, or 0 if the matrix is singular.
+         **/
+        int determinantSign() const;
+
+        /**
+         * Solves AX = B for X.
+         *
+         * @param B The right hand side, with one column per system.
+         * @returns The solution X, which is the same size as {@p B}.
+         * @exception std::domain_error If the factored matrix is singular, or
+         *            if {@p B} does not have the same number of rows.
+         **/
+        Matrix solve(const Matrix& B) const;
+
+        /**
+         * Solves AX = B for X into an existing matrix, without allocating.
+         *
+         * @param B The right hand side, with one column per system.
+         * @param X The matrix to store the solution in. Must be the same size
+         *          as {@p B}, and may be {@p B} itself.
+         * @exception std::domain_error If the factored matrix is singular, or
+         *            if the sizes do not match.
+         **/
+        void solve(const Matrix& B, Matrix& X) const;
+
+        /**
+         * Calculates the inverse of the factored matrix.
+         *
+         * @exception std::domain_error If the factored matrix is singular.
+         **/
+        Matrix inverse() const;
+
+    private:
+        Matrix lu;
+        std::vector<std::size_t> pivots;
+        int pivotSign = 1;
+        bool singular = false;
+    };
+
+    /**
+     * The Cholesky decomposition of a symmetric positive definite matrix,
+     * A = LL', where L is lower-triangular. The Cholesky decomposition takes
+     * half the work of an LU decomposition, and is the preferred way to solve
+     * systems involving covariance matrices.
+     *
+     * @remarks
+     * Calling {@code factorize} on a matrix with the same size as the last
+     * one reuses the existing storage.
+     *
+     * @since 1.2
+     **/
+    class CholeskyDecomposition final {
+    public:
+        /**
+         * Constructs an empty decomposition. {@code factorize} must be called
+         * before any other member.
+         **/
+        CholeskyDecomposition() = default;
+
+        /**
+         * Constructs the decomposition of the given matrix.
+         *
+         * @param A The matrix to factor.
+         * @exception std::domain_error If {@p A} is not square, or is not
+         *            symmetric and positive definite.
+         **/
+        explicit CholeskyDecomposition(const Matrix& A);
+
+        /**
+         * Factors the given matrix, replacing the current factorization.
+         *
+         * @param A The matrix to factor.
+         * @exception std::domain_error If {@p A} is not square, or is not
+         *            symmetric and positive definite.
+         **/
+        void factorize(const Matrix& A);
+
+        /**
+         * Gets the size of the factored matrix.
+         **/
+        inline std::size_t size() const {
+            return l.rows();
+        }
+
+        /**
+         * Gets the lower-triangular factor L.
+         **/
+        inline const Matrix& getLower() const {
+            return l;
+        }
+
+        /**
+         * Calculates the determinant of the factored matrix.
+         **/
+        double determinant() const;
+
+        /**
+         * Calculates the natural log of the determinant of the factored
+         * matrix, which is twice the sum of the logs of the diagonal of L.
+         **/
+        double logDeterminant() const;
+
+        /**
+         * Solves AX = B for X.
+         *
+         * @param B The right hand side, with one column per system.
+         * @returns The solution X, which is the same size as {@p B}.
+         * @exception std::domain_error If {@p B} does not have the same number
+         *            of rows as the factored matrix.
+         **/
+        Matrix solve(const Matrix& B) const;
+
+        /**
+         * Solves AX = B for X into an existing matrix, without allocating.
+         *
+         * @param B The right hand side, with one column per system.
+         * @param X The matrix to store the solution in. Must be the same size
+         *          as {@p B}, and may be {@p B} itself.
+         * @exception std::domain_error If the sizes do not match.
+         **/
+        void solve(const Matrix& B, Matrix& X) const;
+
+        /**
+         * Calculates the inverse of the factored matrix.
+         **/
+        Matrix inverse() const;
+
+    private:
+        Matrix l;
+    };
+}
+
+#endif
@@ -0,0 +1,204 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#ifndef PCOE_MATRIXEXPRESSION_H
+#define PCOE_MATRIXEXPRESSION_H
+
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+
+namespace PCOE {
+    class Matrix;
+
+    /**
+     * The base of the lazily evaluated element-wise expressions created by the
+     * arithmetic operators of {@code Matrix}. An expression records its
+     * operands instead of computing a result, so that a compound expression
+     * such as {@code a + b * 2.0 - c} is evaluated in a single loop when it is
+     * assigned to a {@code Matrix}, without allocating a temporary matrix for
+     * each operator.
+     *
+     * @remarks
+     * Expressions refer to the named matrices they were built from, and must
+     * be evaluated before those matrices are destroyed or resized. Temporary
+     * matrices, such as the result of a product, are moved into the
+     * expression, so {@code auto e = a * b + c} remains valid for as long as
+     * {@code c} does.
+     *
+     * @since 1.2
+     **/
+    template <class E>
+    class MatrixExpression {
+    public:
+        inline const E& self() const {
+            return static_cast<const E&>(*this);
+        }
+
+        inline std::size_t rows() const {
+            return self().rows();
+        }
+
+        inline std::size_t cols() const {
+            return self().cols();
+        }
+
+        /**
+         * Evaluates the element at the given row-major index.
+         **/
+        inline double element(std::size_t i) const {
+            return self().element(i);
+        }
+
+        /**
+         * The members below evaluate the expression into a new matrix and
+         * call the {@code Matrix} member of the same name on it.
+         **/
+        double at(std::size_t m, std::size_t n) const;
+        Matrix col(std::size_t n) const;
+        Matrix row(std::size_t m) const;
+        Matrix adjoint() const;
+        Matrix chol() const;
+        double determinant() const;
+        Matrix diagonal() const;
+        Matrix inverse() const;
+        Matrix transpose() const;
+
+    protected:
+        MatrixExpression() = default;
+    };
+
+    /**
+     * An expression that reads the elements of an existing matrix.
+     **/
+    class MatrixOperand final : public MatrixExpression<MatrixOperand> {
+    public:
+        MatrixOperand(const double* data, std::size_t m, std::size_t n)
+            : data(data), m(m), n(n) {}
+
+        inline std::size_t rows() const {
+            return m;
+        }
+
+        inline std::size_t cols() const {
+            return n;
+        }
+
+        inline double element(std::size_t i) const {
+            return data[i];
+        }
+
+    private:
+        const double* data;
+        std::size_t m;
+        std::size_t n;
+    };
+
+    struct AddOperation {
+        static inline double apply(double a, double b) {
+            return a + b;
+        }
+    };
+
+    struct SubtractOperation {
+        static inline double apply(double a, double b) {
+            return a - b;
+        }
+    };
+
+    struct MultiplyOperation {
+        static inline double apply(double a, double b) {
+            return a * b;
+        }
+    };
+
+    struct DivideOperation {
+        static inline double apply(double a, double b) {
+            return a / b;
+        }
+    };
+
+    /**
+     * Combines the corresponding elements of two expressions of the same
+     * size.
+     **/
+    template <class L, class R, class Op>
+    class MatrixBinaryExpression final : public MatrixExpression<MatrixBinaryExpression<L, R, Op>> {
+    public:
+        MatrixBinaryExpression(L l, R r) : lhs(std::move(l)), rhs(std::move(r)) {
+            if (lhs.rows() != rhs.rows() || lhs.cols() != rhs.cols()) {
+                throw std::domain_error("Matrices are different sizes.");
+            }
+        }
+
+        inline std::size_t rows() const {
+            return lhs.rows();
+        }
+
+        inline std::size_t cols() const {
+            return lhs.cols();
+        }
+
+        inline double element(std::size_t i) const {
+            return Op::apply(lhs.element(i), rhs.element(i));
+        }
+
+    private:
+        L lhs;
+        R rhs;
+    };
+
+    /**
+     * Combines each element of an expression with a scalar. When
+     * {@code ScalarFirst} is set, the scalar is the left operand.
+     **/
+    template <class E, class Op, bool ScalarFirst>
+    class MatrixScalarExpression final
+        : public MatrixExpression<MatrixScalarExpression<E, Op, ScalarFirst>> {
+    public:
+        MatrixScalarExpression(E e, double scalar) : expr(std::move(e)), scalar(scalar) {}
+
+        inline std::size_t rows() const {
+            return expr.rows();
+        }
+
+        inline std::size_t cols() const {
+            return expr.cols();
+        }
+
+        inline double element(std::size_t i) const {
+            return ScalarFirst ? Op::apply(scalar, expr.element(i))
+                               : Op::apply(expr.element(i), scalar);
+        }
+
+    private:
+        E expr;
+        double scalar;
+    };
+
+    /**
+     * Negates each element of an expression.
+     **/
+    template <class E>
+    class MatrixNegateExpression final : public MatrixExpression<MatrixNegateExpression<E>> {
+    public:
+        explicit MatrixNegateExpression(E e) : expr(std::move(e)) {}
+
+        inline std::size_t rows() const {
+            return expr.rows();
+        }
+
+        inline std::size_t cols() const {
+            return expr.cols();
+        }
+
+        inline double element(std::size_t i) const {
+            return -expr.element(i);
+        }
+
+    private:
+        E expr;
+    };
+}
+
+#endif
@@ -0,0 +1,219 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#ifndef PCOE_MATRIXVIEW_H
+#define PCOE_MATRIXVIEW_H
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "MatrixExpression.h"
+
+namespace PCOE {
+    /**
+     * A non-owning view of a rectangular block of a row-major matrix. The
+     * rows of the block are {@code stride} elements apart, so a view can
+     * refer to a single column, a single row, or any submatrix without
+     * copying its elements.
+     *
+     * Views are element-wise expressions, so they can be used with the
+     * arithmetic operators of {@code Matrix} and converted to a
+     * {@code Matrix}. Assigning an expression to a mutable view writes its
+     * elements into the viewed matrix.
+     *
+     * @remarks
+     * A view refers to the storage of the matrix it was created from, and is
+     * invalidated when that matrix is destroyed or resized.
+     *
+     * @paramt T {@code double} for a view that can modify the matrix, or
+     *           {@code const double} for a read-only view.
+     *
+     * @since 1.2
+     **/
+    template <class T>
+    class BasicMatrixView final : public MatrixExpression<BasicMatrixView<T>> {
+    public:
+        /**
+         * Constructs a view of an m by n block whose first element is at
+         * {@p data} and whose rows are {@p stride} elements apart.
+         **/
+        BasicMatrixView(T* data, std::size_t m, std::size_t n, std::size_t stride)
+            : ptr(data), m(m), n(n), stride(stride) {}
+
+        /**
+         * Converts a mutable view to a read-only view of the same block.
+         **/
+        template <class U,
+                  class = typename std::enable_if<std::is_same<const U, T>::value &&
+                                                  !std::is_same<U, T>::value>::type>
+        BasicMatrixView(const BasicMatrixView<U>& other)
+            : ptr(other.data()), m(other.rows()), n(other.cols()), stride(other.rowStride()) {}
+
+        BasicMatrixView(const BasicMatrixView& other) = default;
+
+        /**
+         * Copies the elements of another view of the same size into the
+         * block referred to by the current view.
+         *
+         * @exception std::domain_error If the views are different sizes.
+         **/
+        BasicMatrixView& operator=(const BasicMatrixView& other) {
+            return assign(other);
+        }
+
+        /**
+         * Evaluates an element-wise expression or matrix of the same size
+         * into the block referred to by the current view.
+         *
+         * @remarks
+         * The expression may refer to the viewed elements only at the same
+         * positions, such as {@code v = v * 2.0}.
+         *
+         * @exception std::domain_error If the sizes are different.
+         **/
+        template <class E>
+        BasicMatrixView& operator=(const E& expr) {
+            return assign(asExpression(expr));
+        }
+
+        template <class E>
+        BasicMatrixView& operator+=(const E& expr) {
+            return update(asExpression(expr), AddOperation());
+        }
+
+        template <class E>
+        BasicMatrixView& operator-=(const E& expr) {
+            return update(asExpression(expr), SubtractOperation());
+        }
+
+        BasicMatrixView& operator*=(double rhs) {
+            for (std::size_t i = 0; i < m; i++) {
+                T* row = ptr + i * stride;
+                for (std::size_t j = 0; j < n; j++) {
+                    row[j] *= rhs;
+                }
+            }
+            return *this;
+        }
+
+        inline std::size_t rows() const {
+            return m;
+        }
+
+        inline std::size_t cols() const {
+            return n;
+        }
+
+        /**
+         * Gets the number of elements in the view.
+         **/
+        inline std::size_t size() const {
+            return m * n;
+        }
+
+        /**
+         * Gets the distance between the first elements of consecutive rows.
+         **/
+        inline std::size_t rowStride() const {
+            return stride;
+        }
+
+        inline T* data() const {
+            return ptr;
+        }
+
+        /**
+         * Gets the element at the given row and column of the view. No
+         * bounds checking is performed.
+         **/
+        inline T& operator()(std::size_t i, std::size_t j) const {
+            return ptr[i * stride + j];
+        }
+
+        /**
+         * Gets the i-th element of a row or column view, or the i-th element
+         * in row-major order of any other view. No bounds checking is
+         * performed.
+         **/
+        inline T& operator[](std::size_t i) const {
+            if (n == 1) {
+                return ptr[i * stride];
+            }
+            if (stride == n || m == 1) {
+                return ptr[i];
+            }
+            return ptr[(i / n) * stride + i % n];
+        }
+
+        inline double element(std::size_t i) const {
+            return (*this)[i];
+        }
+
+        /**
+         * Copies the elements of the view in row-major order to
+         * {@p destination}, which must have room for {@code size()} elements.
+         **/
+        void copyTo(double* destination) const {
+            for (std::size_t i = 0; i < m; i++) {
+                const T* row = ptr + i * stride;
+                for (std::size_t j = 0; j < n; j++) {
+                    *destination++ = row[j];
+                }
+            }
+        }
+
+        /**
+         * Copies the elements of the view in row-major order to a
+         * std::vector<double>.
+         **/
+        explicit operator std::vector<double>() const {
+            std::vector<double> result(size());
+            copyTo(result.data());
+            return result;
+        }
+
+    private:
+        template <class E>
+        BasicMatrixView& assign(const E& expr) {
+            checkSize(expr);
+            for (std::size_t i = 0; i < m; i++) {
+                T* row = ptr + i * stride;
+                for (std::size_t j = 0; j < n; j++) {
+                    row[j] = expr.element(i * n + j);
+                }
+            }
+            return *this;
+        }
+
+        template <class E, class Op>
+        BasicMatrixView& update(const E& expr, Op) {
+            checkSize(expr);
+            for (std::size_t i = 0; i < m; i++) {
+                T* row = ptr + i * stride;
+                for (std::size_t j = 0; j < n; j++) {
+                    row[j] = Op::apply(row[j], expr.element(i * n + j));
+                }
+            }
+            return *this;
+        }
+
+        template <class E>
+        void checkSize(const E& expr) const {
+            if (expr.rows() != m || expr.cols() != n) {
+                throw std::domain_error("Matrices are different sizes.");
+            }
+        }
+
+        T* ptr;
+        std::size_t m;
+        std::size_t n;
+        std::size_t stride;
+    };
+
+    using MatrixView = BasicMatrixView<double>;
+    using ConstMatrixView = BasicMatrixView<const double>;
+}
+
+#endif
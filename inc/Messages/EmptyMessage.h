@@ -3,7 +3,10 @@
 // All Rights Reserved.
 #ifndef PCOE_EMPTYMESSAGE_H
 #define PCOE_EMPTYMESSAGE_H
+#include <memory>
+
 #include "Messages/Message.h"
+#include "Messages/SerializedMessage.h"
 
 namespace PCOE {
     /**
@@ -32,8 +35,13 @@ namespace PCOE {
          **/
         EmptyMessage(MessageId id, std::string source, time_point timestamp);
 
+        /**
+         * Constructs a new message from its serialized form.
+         **/
+        static std::unique_ptr<EmptyMessage> deserialize(const SerializedMessage& message);
+
     protected:
-        inline std::uint16_t getPayloadSize() const override final {
+        inline std::uint32_t getPayloadSize() const override final {
             return 0;
         }
 
@@ -3,6 +3,7 @@
 // All Rights Reserved.
 #ifndef PCOE_MESSAGE_H
 #define PCOE_MESSAGE_H
+#include <cstdint>
 #include <iosfwd>
 #include <string>
 
@@ -73,12 +74,38 @@ namespace PCOE {
 
         /**
          * Serializes the message to the provided stream.
+         *
+         * @remarks
+         * A serialized message starts with a 24 byte header holding, in
+         * order, the 16-bit format version, the 16-bit length of the source,
+         * the 32-bit length of the payload, the 64-bit message id and the
+         * 64-bit timestamp in ticks of {@code MessageClock}. The header is
+         * followed by the source and then the payload, each padded with zeros
+         * to a multiple of 8 bytes. All values are written in native byte
+         * order.
+         *
+         * @remarks
+         * Because the total size is a multiple of 8 bytes, messages written
+         * back to back into an 8 byte aligned buffer keep the header and
+         * payload of each message aligned.
          **/
         void serialize(std::ostream& os) const;
 
+        /**
+         * Gets the number of bytes written by {@code serialize}, including
+         * padding.
+         **/
+        std::size_t getSerializedSize() const;
+
     protected:
-        virtual std::uint16_t getPayloadSize() const = 0;
+        /**
+         * Gets the number of bytes written by {@code serializePayload}.
+         **/
+        virtual std::uint32_t getPayloadSize() const = 0;
 
+        /**
+         * Writes the payload of the message to the provided stream.
+         **/
         virtual void serializePayload(std::ostream& os) const = 0;
 
     private:
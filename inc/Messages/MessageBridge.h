@@ -0,0 +1,92 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#ifndef PCOE_MESSAGEBRIDGE_H
+#define PCOE_MESSAGEBRIDGE_H
+#include <string>
+
+#include "Messages/IMessageProcessor.h"
+#include "Messages/IMessagePublisher.h"
+
+namespace PCOE {
+    /**
+     * Forwards selected messages between a local publisher, usually a
+     * {@code MessageBus}, and a remote publisher, usually a
+     * {@code SharedMemoryPublisher} connecting the local process to other
+     * processes.
+     *
+     * @remarks
+     * Messages are forwarded by pointer, so no copies are made by the bridge
+     * itself. A given source and id should not be both exported and imported
+     * through the same pair of publishers, since each forwarded message would
+     * then be forwarded back.
+     *
+     * @example @code
+     * MessageBus bus;
+     * SharedMemoryPublisher ring("/gsap-bus", 1 << 20);
+     * MessageBridge bridge(bus, ring);
+     * bridge.exportMessages("battery", MessageId::BatteryEod);
+     * @endcode
+     *
+     * @since 1.2
+     **/
+    class MessageBridge {
+    public:
+        /**
+         * Constructs a new bridge. Both publishers must outlive the bridge.
+         *
+         * @param local  The publisher used by the local process.
+         * @param remote The publisher shared with other processes.
+         **/
+        MessageBridge(IMessagePublisher& local, IMessagePublisher& remote);
+
+        MessageBridge(const MessageBridge&) = delete;
+
+        MessageBridge& operator=(const MessageBridge&) = delete;
+
+        /**
+         * Unsubscribes the bridge from both publishers.
+         **/
+        ~MessageBridge();
+
+        /**
+         * Forwards messages with the given source and id from the local
+         * publisher to the remote publisher.
+         *
+         * @param source The source of the messages to forward.
+         * @param id     The id of the messages to forward. By default, all
+         *               messages from the source are forwarded.
+         **/
+        void exportMessages(const std::string& source, MessageId id = MessageId::All);
+
+        /**
+         * Forwards messages with the given source and id from the remote
+         * publisher to the local publisher.
+         *
+         * @param source The source of the messages to forward.
+         * @param id     The id of the messages to forward. By default, all
+         *               messages from the source are forwarded.
+         **/
+        void importMessages(const std::string& source, MessageId id = MessageId::All);
+
+    private:
+        class Forwarder final : public IMessageProcessor {
+        public:
+            explicit Forwarder(IMessagePublisher& target) : target(target) {}
+
+            void processMessage(const std::shared_ptr<Message>& message) override {
+                target.publish(message);
+            }
+
+        private:
+            IMessagePublisher& target;
+        };
+
+        IMessagePublisher& local;
+        IMessagePublisher& remote;
+        Forwarder toRemote;
+        Forwarder toLocal;
+    };
+}
+
+#endif
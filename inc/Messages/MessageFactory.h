@@ -0,0 +1,135 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#ifndef PCOE_MESSAGEFACTORY_H
+#define PCOE_MESSAGEFACTORY_H
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <memory>
+#include <unordered_map>
+
+#include "Messages/Message.h"
+#include "Messages/MessageId.h"
+#include "Messages/SerializedMessage.h"
+#include "Singleton.h"
+
+namespace PCOE {
+    /**
+     * Creates messages from their serialized form.
+     *
+     * @remarks
+     * The type of message created is chosen by the message id. Types
+     * registered for a specific id take priority. Otherwise the payload type
+     * encoded in the id is used, so scalar, vector and empty messages with any
+     * id can be deserialized without being registered. See
+     * {@code MessageId} for the list of payload types.
+     *
+     * @example @code
+     * MessageFactory& factory = MessageFactory::instance();
+     * factory.Register<ProgEventMessage>(MyEventId);
+     * std::unique_ptr<Message> message = factory.deserialize(buffer, size);
+     * @endcode
+     *
+     * @since 1.2
+     **/
+    class MessageFactory : public Singleton<MessageFactory> {
+        friend class Singleton<MessageFactory>; // Needed for singleton
+    public:
+        /**
+         * The owned pointer type returned by the @{code Create} method and the
+         * @{code create_fn} function wrapper.
+         **/
+        using unique_ptr = std::unique_ptr<Message>;
+
+        /**
+         * A function wrapper whose target is capable of constructing a message
+         * from its serialized form.
+         **/
+        using create_fn = std::function<unique_ptr(const SerializedMessage&)>;
+
+        /**
+         * Registers a message type for a specific message id. The type must
+         * have a static {@code deserialize} method taking a
+         * {@code SerializedMessage}.
+         *
+         * @tparam TDerived The message type being registered.
+         *
+         * @param id The message id.
+         **/
+        template <class TDerived>
+        void Register(MessageId id) {
+            Register(id, Create<TDerived>);
+        }
+
+        /**
+         * Registers a creation function for a specific message id.
+         *
+         * @param id The message id.
+         * @param fn A function that constructs the message from its
+         *           serialized form.
+         **/
+        void Register(MessageId id, create_fn fn);
+
+        /**
+         * Registers a creation function used for message ids that are not
+         * registered individually and whose payload type matches.
+         *
+         * @param payloadType The third most significant byte of the id.
+         * @param fn          A function that constructs the message from its
+         *                    serialized form.
+         **/
+        void RegisterPayloadType(std::uint8_t payloadType, create_fn fn);
+
+        /**
+         * Constructs a new message from its serialized form.
+         *
+         * @exception std::out_of_range If no type is registered for the id or
+         *            the payload type of the message.
+         * @exception FormatError If the payload is malformed.
+         **/
+        unique_ptr Create(const SerializedMessage& message) const;
+
+        /**
+         * Constructs a new message from the serialized message at the start
+         * of {@p buffer}.
+         *
+         * @param buffer The serialized message.
+         * @param size   The number of bytes available in the buffer.
+         * @exception FormatError If the buffer does not hold a complete
+         *            message of a supported version.
+         **/
+        unique_ptr deserialize(const char* buffer, std::size_t size) const;
+
+        /**
+         * Reads a single serialized message from a stream.
+         *
+         * @returns The message, or null if the stream is at its end.
+         * @exception FormatError If the stream ends part way through a
+         *            message, or the header claims a message larger than
+         *            {@code MaxMessageSize}.
+         **/
+        unique_ptr deserialize(std::istream& is) const;
+
+    private:
+        /**
+         * Creates a new instance of the @{code MessageFactory} with the
+         * message types defined by GSAP registered. This constructor should
+         * only be called once, from the parent @{code Singleton} class.
+         **/
+        MessageFactory();
+
+        template <class TDerived>
+        static unique_ptr Create(const SerializedMessage& message) {
+            return unique_ptr(TDerived::deserialize(message));
+        }
+
+        template <class T>
+        void RegisterPayloadTypes(std::uint8_t scalarType, std::uint8_t vectorType);
+
+        std::unordered_map<std::uint64_t, create_fn> registered;
+        std::unordered_map<std::uint8_t, create_fn> payloadTypes;
+    };
+}
+
+#endif
@@ -18,9 +18,9 @@ namespace PCOE {
      *
      * @remarks The third most significant byte encodes the payload of the
      * message as described in the following tables. All scalar payloads are
-     * serialized directly. All vector payloads are serialized as a 16-bit
-     * unsigned integer describing the number of elements followed by the
-     * elements themselves.
+     * serialized directly. All vector payloads are serialized as a 32-bit
+     * unsigned integer describing the number of elements and 4 bytes of
+     * padding, followed by the elements themselves.
      *
      * | Value | Meaning                                                       |
      * |------:|:--------------------------------------------------------------|
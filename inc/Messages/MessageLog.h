@@ -0,0 +1,90 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#ifndef PCOE_MESSAGELOG_H
+#define PCOE_MESSAGELOG_H
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#include "Messages/MessageClock.h"
+
+namespace PCOE {
+    /**
+     * Describes the on-disk format shared by {@code MessageRecorder} and
+     * {@code MessageReplayer}.
+     *
+     * @remarks
+     * A message log at a given path consists of an index file named
+     * "<path>.idx" and one or more segment files named "<path>.000000.seg",
+     * "<path>.000001.seg" and so on. Each segment starts with a
+     * {@code SegmentHeader} followed by messages in the format written by
+     * {@code Message::serialize}. The index file starts with an
+     * {@code IndexHeader} followed by {@code IndexEntry} records, including
+     * one for the first message of each segment. All values are stored in
+     * native byte order.
+     *
+     * @since 1.2
+     **/
+    namespace MessageLog {
+        const std::uint32_t SegmentMagic = 0x47534C53;
+        const std::uint32_t IndexMagic = 0x47534C49;
+        const std::uint16_t Version = 1;
+
+        /**
+         * Written at the start of each segment file. {@code size} is the
+         * number of bytes of messages following the header.
+         **/
+        struct SegmentHeader {
+            std::uint32_t magic;
+            std::uint16_t version;
+            std::uint16_t reserved;
+            std::uint64_t size;
+        };
+
+        /**
+         * Written at the start of the index file.
+         **/
+        struct IndexHeader {
+            std::uint32_t magic;
+            std::uint16_t version;
+            std::uint16_t reserved;
+        };
+
+        /**
+         * Locates the message at byte {@code offset} past the header of
+         * segment {@code segment}. {@code ticks} is the latest timestamp of
+         * that message and every message recorded before it. Messages are
+         * recorded in the order they are received, which need not be
+         * timestamp order, so the entries are sorted by {@code ticks} even
+         * when the messages are not, and every message before an entry has
+         * a timestamp no later than its {@code ticks}.
+         **/
+        struct IndexEntry {
+            MessageClock::rep ticks;
+            std::uint32_t segment;
+            std::uint32_t reserved;
+            std::uint64_t offset;
+        };
+
+        /**
+         * Gets the name of the index file of the log at {@p path}.
+         **/
+        inline std::string indexPath(const std::string& path) {
+            return path + ".idx";
+        }
+
+        /**
+         * Gets the name of the segment file with the given number of the log
+         * at {@p path}.
+         **/
+        inline std::string segmentPath(const std::string& path, std::uint32_t segment) {
+            char suffix[16];
+            std::snprintf(suffix, sizeof(suffix), ".%06u.seg", segment);
+            return path + suffix;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,115 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#ifndef PCOE_MESSAGERECORDER_H
+#define PCOE_MESSAGERECORDER_H
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+
+#include "Messages/IMessageProcessor.h"
+#include "Messages/IMessagePublisher.h"
+#include "Messages/MessageLog.h"
+#include "Messages/WireFormat.h"
+
+namespace PCOE {
+    /**
+     * Records messages from a publisher to a segmented, memory-mapped log
+     * that can be played back with a {@code MessageReplayer}.
+     *
+     * @remarks
+     * Messages are serialized directly into the mapped segment in the order
+     * they are received. When a message does not fit in the current segment,
+     * the segment is truncated to the bytes written and a new segment is
+     * started. An index entry is written for the first message of each
+     * segment and for the first message at least one index interval after the
+     * previous entry, so that a replayer can seek to a time without reading
+     * the messages before it.
+     *
+     * @example @code
+     * MessageBus bus;
+     * MessageRecorder recorder(bus, "flight-12");
+     * recorder.record("battery");
+     * @endcode
+     *
+     * @since 1.2
+     **/
+    class MessageRecorder final : public IMessageProcessor {
+    public:
+        static const std::size_t DefaultSegmentSize = 64 * 1024 * 1024;
+
+        /**
+         * Creates a new log at {@p path}, replacing any existing log there.
+         *
+         * @param publisher     The publisher to record messages from. The
+         *                      publisher must outlive the recorder.
+         * @param path          The path of the log, to which the suffixes
+         *                      described in {@code MessageLog} are added.
+         * @param segmentSize   The maximum size of a segment file in bytes.
+         *                      Must be at least 4096.
+         * @param indexInterval The amount of message time between index
+         *                      entries.
+         **/
+        MessageRecorder(IMessagePublisher& publisher,
+                        const std::string& path,
+                        std::size_t segmentSize = DefaultSegmentSize,
+                        MessageClock::duration indexInterval = std::chrono::seconds(1));
+
+        MessageRecorder(const MessageRecorder&) = delete;
+
+        MessageRecorder& operator=(const MessageRecorder&) = delete;
+
+        /**
+         * Unsubscribes from the publisher and closes the log.
+         **/
+        ~MessageRecorder();
+
+        /**
+         * Records all messages from the given source.
+         **/
+        void record(const std::string& source);
+
+        /**
+         * Appends a message to the log. Messages that are larger than a
+         * segment, or that cannot be written, are logged and dropped.
+         **/
+        void processMessage(const std::shared_ptr<Message>& message) override;
+
+        /**
+         * Gets the number of messages recorded.
+         **/
+        std::size_t messageCount() const;
+
+        /**
+         * Gets the number of segment files written so far.
+         **/
+        std::size_t segmentCount() const;
+
+    private:
+        void openSegment();
+        void closeSegment();
+        void writeIndex(MessageClock::rep ticks);
+
+        IMessagePublisher& publisher;
+        std::string path;
+        std::size_t segmentSize;
+        MessageClock::duration indexInterval;
+
+        mutable std::mutex mutex;
+        int indexFd;
+        int segmentFd;
+        std::uint32_t segment;
+        char* mapping;
+        std::size_t used;
+        bool indexed;
+        MessageClock::rep nextIndexTicks;
+        MessageClock::rep latestTicks;
+        std::size_t messages;
+        MemoryStreamBuf buffer;
+        std::ostream stream;
+    };
+}
+
+#endif
@@ -0,0 +1,128 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#ifndef PCOE_MESSAGEREPLAYER_H
+#define PCOE_MESSAGEREPLAYER_H
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Messages/IMessagePublisher.h"
+#include "Messages/MessageLog.h"
+#include "Messages/SerializedMessage.h"
+
+namespace PCOE {
+    /**
+     * Reads and publishes the messages in a log written by a
+     * {@code MessageRecorder}.
+     *
+     * @remarks
+     * Each segment of the log is memory-mapped when the replayer is
+     * constructed, so only the pages holding messages that are actually read
+     * are loaded from disk. Seeking uses the log's index to skip the messages
+     * that all precede the requested time and reads forward from there.
+     *
+     * @example @code
+     * MessageBus bus;
+     * MessageReplayer replayer("flight-12");
+     * replayer.seek(replayer.getStartTime() + std::chrono::hours(7));
+     * replayer.replay(bus, 10.0);
+     * @endcode
+     *
+     * @since 1.2
+     **/
+    class MessageReplayer {
+    public:
+        using time_point = MessageClock::time_point;
+
+        /**
+         * Opens the log at {@p path}.
+         *
+         * @exception FormatError If the index or a segment is malformed.
+         **/
+        explicit MessageReplayer(const std::string& path);
+
+        MessageReplayer(const MessageReplayer&) = delete;
+
+        MessageReplayer& operator=(const MessageReplayer&) = delete;
+
+        /**
+         * Unmaps the log.
+         **/
+        ~MessageReplayer();
+
+        /**
+         * Gets the timestamp of the first message in the log, or the epoch if
+         * the log is empty.
+         **/
+        time_point getStartTime() const;
+
+        /**
+         * Moves to the first message in the log.
+         **/
+        void rewind();
+
+        /**
+         * Moves to the first message, in the order the messages were
+         * recorded, with a timestamp at or after {@p time}.
+         **/
+        void seek(time_point time);
+
+        /**
+         * Reads the next message without deserializing it, returning
+         * {@code false} at the end of the log.
+         *
+         * @param fn A function called with a {@code SerializedMessage} that
+         *           views the message in the mapped log. The view remains
+         *           valid for the lifetime of the replayer.
+         **/
+        template <class Fn>
+        bool read(Fn fn) {
+            std::size_t available;
+            const char* data = peek(available);
+            if (data == nullptr) {
+                return false;
+            }
+            SerializedMessage message(data, available);
+            offset += message.size();
+            fn(message);
+            return true;
+        }
+
+        /**
+         * Reads and deserializes the next message, returning {@code nullptr}
+         * at the end of the log.
+         **/
+        std::shared_ptr<Message> next();
+
+        /**
+         * Publishes messages from the current position to the end of the log.
+         *
+         * @param publisher The publisher to publish the messages to.
+         * @param speed     The rate at which message time passes relative to
+         *                  real time. A speed of 1 reproduces the original
+         *                  pacing of the messages and a speed of 10 plays
+         *                  them back ten times faster. A speed of 0 publishes
+         *                  the messages as fast as possible.
+         * @returns         The number of messages published.
+         **/
+        std::size_t replay(IMessagePublisher& publisher, double speed = 1.0);
+
+    private:
+        struct Segment {
+            const char* mapping;
+            std::size_t length;
+            std::size_t size;
+        };
+
+        const char* peek(std::size_t& available);
+
+        std::vector<MessageLog::IndexEntry> index;
+        std::vector<Segment> segments;
+        std::size_t segment;
+        std::size_t offset;
+    };
+}
+
+#endif
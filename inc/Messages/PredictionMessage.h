@@ -1,14 +1,45 @@
-// Copyright (c) 2018 United States Government as represented by the
+// Copyright (c) 2018-2019 United States Government as represented by the
 // Administrator of the National Aeronautics and Space Administration.
 // All Rights Reserved.
 #ifndef PCOE_MESSAGES_PREDICTION_H
 #define PCOE_MESSAGES_PREDICTION_H
 
+#include <memory>
+
+#include "DataPoint.h"
+#include "Messages/ProgEventMessage.h"
 #include "Messages/ScalarMessage.h"
+#include "Messages/SerializedMessage.h"
+#include "Messages/WireFormat.h"
 #include "Predictors/Predictor.h"
 #include "ProgEvent.h"
 
 namespace PCOE {
+    /**
+     * Writes a DataPoint as its uncertainty type, number of points and
+     * number of times, followed by the value at each time.
+     **/
+    template <>
+    struct WireCodec<DataPoint> {
+        static std::size_t size(const DataPoint& value);
+
+        static void write(std::ostream& os, const DataPoint& value);
+
+        static DataPoint read(WireReader& reader);
+    };
+
+    /**
+     * Writes a Prediction as its events followed by its observables.
+     **/
+    template <>
+    struct WireCodec<Prediction> {
+        static std::size_t size(const Prediction& value);
+
+        static void write(std::ostream& os, const Prediction& value);
+
+        static Prediction read(WireReader& reader);
+    };
+
     /**
      * A message the carries a single PredictionMessage.
      *
@@ -26,28 +57,68 @@ namespace PCOE {
          *                  by the message was generated.
          * @param value     The value of the message.
          **/
-        PredictionMessage(std::string source, time_point timestamp, const Prediction& value)
-            : Message(MessageId::Prediction, source, timestamp), value(value) {}
+        PredictionMessage(std::string source, time_point timestamp, Prediction value)
+            : Message(MessageId::Prediction, source, timestamp),
+              value(std::make_shared<const Prediction>(std::move(value))) {}
+
+        /**
+         * Constructs a new instance of @{code PredictionMessage} that shares
+         * ownership of an existing prediction.
+         *
+         * @param source    The source of the message.
+         * @param timestamp The time at which the message or the data contained
+         *                  by the message was generated.
+         * @param value     The value of the message.
+         **/
+        PredictionMessage(std::string source,
+                          time_point timestamp,
+                          std::shared_ptr<const Prediction> value)
+            : Message(MessageId::Prediction, source, timestamp), value(std::move(value)) {
+            Expect(this->value != nullptr, "Prediction is null");
+        }
 
         /**
          * Gets the value associated with the message.
          **/
         inline const Prediction& getValue() const {
+            return *value;
+        }
+
+        /**
+         * Gets shared ownership of the value associated with the message, which
+         * keeps the prediction and the memory holding its samples alive after
+         * the message is destroyed.
+         **/
+        inline const std::shared_ptr<const Prediction>& getSharedValue() const {
             return value;
         }
 
+        /**
+         * Constructs a new message from its serialized form.
+         *
+         * @exception FormatError If the payload is malformed.
+         **/
+        static std::unique_ptr<PredictionMessage> deserialize(const SerializedMessage& message) {
+            WireReader reader = message.payloadReader();
+            return std::unique_ptr<PredictionMessage>(
+                new PredictionMessage(message.getSource(),
+                                      message.getTimestamp(),
+                                      WireCodec<Prediction>::read(reader)));
+        }
+
     protected:
-        std::uint16_t getPayloadSize() const override final {
-            throw std::domain_error("Serialization not supported");
+        std::uint32_t getPayloadSize() const override final {
+            std::size_t size = WireCodec<Prediction>::size(*value);
+            Expect(size <= std::numeric_limits<std::uint32_t>::max(), "Payload size too big");
+            return static_cast<std::uint32_t>(size);
         }
 
         void serializePayload(std::ostream& os) const override final {
-            (void)os;
-            throw std::domain_error("Serialization not supported");
+            WireCodec<Prediction>::write(os, *value);
         }
 
     private:
-        Prediction value;
+        std::shared_ptr<const Prediction> value;
     };
 }
 
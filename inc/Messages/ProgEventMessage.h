@@ -1,16 +1,37 @@
-// Copyright (c) 2018 United States Government as represented by the
+// Copyright (c) 2018-2019 United States Government as represented by the
 // Administrator of the National Aeronautics and Space Administration.
 // All Rights Reserved.
 #ifndef PCOE_MESSAGES_PROGEVENT_H
 #define PCOE_MESSAGES_PROGEVENT_H
 
+#include <memory>
+
 #include "Messages/ScalarMessage.h"
+#include "Messages/SerializedMessage.h"
+#include "Messages/UDataMessage.h"
+#include "Messages/WireFormat.h"
 #include "ProgEvent.h"
 
 namespace PCOE {
+    /**
+     * Writes a ProgEvent as its id, tag, time of event, state and points.
+     **/
+    template <>
+    struct WireCodec<ProgEvent> {
+        static std::size_t size(const ProgEvent& value);
+
+        static void write(std::ostream& os, const ProgEvent& value);
+
+        static ProgEvent read(WireReader& reader);
+    };
+
     /**
      * A message the carries a single ProgEvent.
      *
+     * @remarks
+     * The event is held by shared ownership, so that an event that is part of
+     * a larger prediction can be published without copying it.
+     *
      * @author Jason Watkins
      * @since 1.2
      **/
@@ -25,34 +46,74 @@ namespace PCOE {
          *                  by the message was generated.
          * @param value     The value of the message.
          **/
+        ProgEventMessage(MessageId id, std::string source, time_point timestamp, ProgEvent value)
+            : Message(id, source, timestamp),
+              value(std::make_shared<const ProgEvent>(std::move(value))) {
+            Expect((static_cast<std::uint64_t>(id) & 0x0000300000000000L) > 0,
+                   "Message id is not scalar");
+        }
+
+        /**
+         * Constructs a new instance of @{code ProgEventMessage} that shares
+         * ownership of an existing event.
+         *
+         * @param id        The id of the message.
+         * @param source    The source of the message.
+         * @param timestamp The time at which the message or the data contained
+         *                  by the message was generated.
+         * @param value     The value of the message.
+         **/
         ProgEventMessage(MessageId id,
                          std::string source,
                          time_point timestamp,
-                         const ProgEvent& value)
-            : Message(id, source, timestamp), value(value) {
+                         std::shared_ptr<const ProgEvent> value)
+            : Message(id, source, timestamp), value(std::move(value)) {
             Expect((static_cast<std::uint64_t>(id) & 0x0000300000000000L) > 0,
                    "Message id is not scalar");
+            Expect(this->value != nullptr, "Event is null");
         }
 
         /**
          * Gets the value associated with the message.
          **/
         inline const ProgEvent& getValue() const {
+            return *value;
+        }
+
+        /**
+         * Gets shared ownership of the value associated with the message.
+         **/
+        inline const std::shared_ptr<const ProgEvent>& getSharedValue() const {
             return value;
         }
 
+        /**
+         * Constructs a new message from its serialized form.
+         *
+         * @exception FormatError If the payload is malformed.
+         **/
+        static std::unique_ptr<ProgEventMessage> deserialize(const SerializedMessage& message) {
+            WireReader reader = message.payloadReader();
+            return std::unique_ptr<ProgEventMessage>(
+                new ProgEventMessage(message.getMessageId(),
+                                     message.getSource(),
+                                     message.getTimestamp(),
+                                     WireCodec<ProgEvent>::read(reader)));
+        }
+
     protected:
-        std::uint16_t getPayloadSize() const override final {
-            throw std::domain_error("Serialization not supported");
+        std::uint32_t getPayloadSize() const override final {
+            std::size_t size = WireCodec<ProgEvent>::size(*value);
+            Expect(size <= std::numeric_limits<std::uint32_t>::max(), "Payload size too big");
+            return static_cast<std::uint32_t>(size);
         }
 
         void serializePayload(std::ostream& os) const override final {
-            (void)os;
-            throw std::domain_error("Serialization not supported");
+            WireCodec<ProgEvent>::write(os, *value);
         }
 
     private:
-        ProgEvent value;
+        std::shared_ptr<const ProgEvent> value;
     };
 }
 
@@ -4,9 +4,13 @@
 #ifndef PCOE_SCALARMESSAGE_H
 #define PCOE_SCALARMESSAGE_H
 #include <iostream>
+#include <limits>
+#include <memory>
 
 #include "Contracts.h"
 #include "Messages/Message.h"
+#include "Messages/SerializedMessage.h"
+#include "Messages/WireFormat.h"
 
 namespace PCOE {
     /**
@@ -27,8 +31,8 @@ namespace PCOE {
          *                  by the message was generated.
          * @param value     The value of the message.
          **/
-        ScalarMessage(MessageId id, std::string source, time_point timestamp, const T& value)
-            : Message(id, source, timestamp), value(value) {
+        ScalarMessage(MessageId id, std::string source, time_point timestamp, T value)
+            : Message(id, source, timestamp), value(std::move(value)) {
             Expect((static_cast<std::uint64_t>(id) & 0x0000300000000000L) > 0,
                    "Message id is not scalar");
         }
@@ -40,13 +44,28 @@ namespace PCOE {
             return value;
         }
 
+        /**
+         * Constructs a new message from its serialized form.
+         *
+         * @exception FormatError If the payload is malformed.
+         **/
+        static std::unique_ptr<ScalarMessage> deserialize(const SerializedMessage& message) {
+            WireReader reader = message.payloadReader();
+            return std::unique_ptr<ScalarMessage>(new ScalarMessage(message.getMessageId(),
+                                                                    message.getSource(),
+                                                                    message.getTimestamp(),
+                                                                    WireCodec<T>::read(reader)));
+        }
+
     protected:
-        std::uint16_t getPayloadSize() const override final {
-            return sizeof(T);
+        std::uint32_t getPayloadSize() const override final {
+            std::size_t size = WireCodec<T>::size(value);
+            Expect(size <= std::numeric_limits<std::uint32_t>::max(), "Payload size too big");
+            return static_cast<std::uint32_t>(size);
         }
 
         void serializePayload(std::ostream& os) const override final {
-            os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+            WireCodec<T>::write(os, value);
         }
 
     private:
@@ -0,0 +1,124 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#ifndef PCOE_SERIALIZEDMESSAGE_H
+#define PCOE_SERIALIZEDMESSAGE_H
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "MatrixView.h"
+#include "Messages/Message.h"
+#include "Messages/WireFormat.h"
+
+namespace PCOE {
+    /**
+     * A read-only view of a message serialized by {@code Message::serialize}.
+     * Constructing the view validates the header but does not copy the
+     * source or the payload.
+     *
+     * @remarks
+     * The view refers to the buffer it was created from, and is invalidated
+     * when that buffer is modified or freed.
+     *
+     * @since 1.2
+     **/
+    class SerializedMessage {
+    public:
+        /**
+         * Constructs a view of the message at the start of {@p buffer}. The
+         * buffer may contain further data after the message.
+         *
+         * @param buffer The serialized message.
+         * @param size   The number of bytes available in the buffer.
+         * @exception FormatError If the buffer is shorter than the message or
+         *            the message was written with a different format version.
+         **/
+        SerializedMessage(const char* buffer, std::size_t size);
+
+        /**
+         * Reads the size of a serialized message from its header.
+         *
+         * @param header The first {@code MessageHeaderSize} bytes of a
+         *               serialized message.
+         * @returns      The total size of the message, including padding.
+         * @exception FormatError If the message was written with a different
+         *            format version.
+         **/
+        static std::size_t readSize(const char* header);
+
+        /**
+         * Gets the id of the message.
+         **/
+        inline MessageId getMessageId() const {
+            return id;
+        }
+
+        /**
+         * Gets a copy of the source of the message.
+         **/
+        inline std::string getSource() const {
+            return std::string(source, sourceLength);
+        }
+
+        /**
+         * Gets the timestamp of the message.
+         **/
+        inline Message::time_point getTimestamp() const {
+            return timestamp;
+        }
+
+        /**
+         * Gets a pointer to the first byte of the payload.
+         **/
+        inline const char* getPayload() const {
+            return payload;
+        }
+
+        /**
+         * Gets the size of the payload in bytes, excluding padding.
+         **/
+        inline std::uint32_t getPayloadSize() const {
+            return payloadSize;
+        }
+
+        /**
+         * Gets a reader over the payload.
+         **/
+        inline WireReader payloadReader() const {
+            return WireReader(payload, payloadSize);
+        }
+
+        /**
+         * Gets the total size of the message in bytes, including padding. The
+         * next message in a buffer of back to back messages starts this many
+         * bytes after the current one.
+         **/
+        inline std::size_t size() const {
+            return totalSize;
+        }
+
+        /**
+         * Gets a view of the elements of a vector of doubles directly in the
+         * serialized buffer, without copying them.
+         *
+         * @returns An n by 1 view of the elements.
+         * @exception std::domain_error If the payload of the message is not a
+         *            vector of doubles.
+         * @exception FormatError If the payload is truncated, or the elements
+         *            are not aligned because the buffer is not 8 byte aligned.
+         **/
+        ConstMatrixView getDoubleVector() const;
+
+    private:
+        MessageId id;
+        const char* source;
+        std::size_t sourceLength;
+        Message::time_point timestamp;
+        const char* payload;
+        std::uint32_t payloadSize;
+        std::size_t totalSize;
+    };
+}
+
+#endif
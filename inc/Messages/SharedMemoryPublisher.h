@@ -0,0 +1,143 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#ifndef PCOE_SHAREDMEMORYPUBLISHER_H
+#define PCOE_SHAREDMEMORYPUBLISHER_H
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "Messages/IMessagePublisher.h"
+#include "Messages/SharedMemoryRing.h"
+
+namespace PCOE {
+    /**
+     * Publishes messages between processes through a
+     * {@code SharedMemoryRing}.
+     *
+     * @remarks
+     * The process that creates the ring publishes to it. Subscribers in any
+     * process that has the ring open, including the process that created it,
+     * receive the messages published to the ring after their first
+     * subscription, in the order they were published.
+     *
+     * @remarks
+     * Subscribers are called on a thread owned by the publisher, which polls
+     * the ring, yielding between polls while messages are arriving and
+     * sleeping briefly once the ring has been idle for a while. Only messages
+     * whose source and id have a subscriber are deserialized. Deserializing
+     * copies the message out of the shared memory, and subscribers are called
+     * after the copy is made, so they may publish to the same ring. To read
+     * messages in place without copying them, use a
+     * {@code SharedMemoryReader} directly.
+     *
+     * @since 1.2
+     **/
+    class SharedMemoryPublisher final : public IMessagePublisher {
+    public:
+        /**
+         * Creates a new ring and a publisher that publishes to it.
+         *
+         * @param name     The name of the shared memory object, which should
+         *                 start with a slash, such as "/gsap-bus".
+         * @param capacity The number of bytes available for messages. Must be
+         *                 a power of two and at least 4096.
+         **/
+        SharedMemoryPublisher(const std::string& name, std::size_t capacity);
+
+        /**
+         * Opens a ring created by a publisher in another process. Messages
+         * cannot be published to a ring that was opened rather than created.
+         *
+         * @param name The name of the shared memory object.
+         **/
+        explicit SharedMemoryPublisher(const std::string& name);
+
+        SharedMemoryPublisher(const SharedMemoryPublisher&) = delete;
+
+        SharedMemoryPublisher& operator=(const SharedMemoryPublisher&) = delete;
+
+        /**
+         * Stops the polling thread and detaches from the ring.
+         **/
+        ~SharedMemoryPublisher();
+
+        /**
+         * Registers the given consumer to receive messages with the given Id
+         * that are published to the ring.
+         *
+         * @param consumer A pointer to a message consumer. The pointer is a
+         *                 raw, unmanaged pointer, which the publisher assumes
+         *                 will be valid for its lifetime.
+         * @param source   The source of messages that the consumer is
+         *                 interested in.
+         * @param id       The id of the message the consumer is interested in.
+         *                 if no {@p id} is specified, the consumer will receive
+         *                 all messages from the source.
+         **/
+        void subscribe(IMessageProcessor* consumer,
+                       std::string source,
+                       MessageId id = MessageId::All) override;
+
+        /**
+         * Unsubscribes the given consumer from all messages.
+         *
+         * @param consumer The consumer to unsubscribe.
+         **/
+        void unsubscribe(IMessageProcessor* consumer) override;
+
+        /**
+         * Unsubscribes the given consumer from messages from the specified
+         * source.
+         *
+         * @param consumer The consumer to unsubscribe.
+         * @param source   The source the consumer is no longer interested in.
+         **/
+        void unsubscribe(IMessageProcessor* consumer, const std::string& source) override;
+
+        /**
+         * Writes a message to the ring, waiting for readers to make room for
+         * it if necessary.
+         *
+         * @remarks
+         * When called by a subscriber of this publisher, the polling thread
+         * cannot make room in the ring, so the message is written only if
+         * there is room for it already.
+         *
+         * @param message A pointer to a message to publish.
+         * @exception std::domain_error If the ring was opened rather than
+         *            created by this publisher.
+         * @exception std::runtime_error If called by a subscriber of this
+         *            publisher while the ring is full.
+         **/
+        void publish(std::shared_ptr<Message> message) override;
+
+        /**
+         * Gets the ring that the publisher reads and writes.
+         **/
+        inline SharedMemoryRing& getRing() {
+            return ring;
+        }
+
+    private:
+        void run();
+        std::shared_ptr<Message> deserialize(const SerializedMessage& message,
+                                             std::vector<IMessageProcessor*>& consumers);
+
+        using callback_pair = std::pair<MessageId, IMessageProcessor*>;
+
+        SharedMemoryRing ring;
+        std::unique_ptr<SharedMemoryReader> reader;
+        std::thread thread;
+        std::atomic<bool> running;
+
+        std::unordered_map<std::string, std::vector<callback_pair>> subscribers;
+        std::recursive_mutex subs_mutex;
+    };
+}
+
+#endif
@@ -0,0 +1,233 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#ifndef PCOE_SHAREDMEMORYRING_H
+#define PCOE_SHAREDMEMORYRING_H
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+
+#include "Messages/Message.h"
+#include "Messages/SerializedMessage.h"
+#include "Messages/WireFormat.h"
+
+namespace PCOE {
+    /**
+     * A single producer, multiple consumer ring buffer of serialized messages
+     * in POSIX shared memory. The process that creates the ring writes to it,
+     * and any number of processes, up to {@code MaxReaders} readers in
+     * total, read every message from it through a {@code SharedMemoryReader}.
+     *
+     * @remarks
+     * Each reader publishes its position and process id in the shared
+     * memory, and the writer never overwrites a message that an attached
+     * reader has not read. When a reader holds up the writer, the writer
+     * detaches every reader whose process no longer exists, so a reader
+     * process that crashes or is killed does not block the writer. A reader
+     * whose process is still running but has stopped reading does.
+     *
+     * @remarks
+     * Messages are written with {@code Message::serialize} directly into the
+     * shared memory. A message that does not fit before the end of the ring
+     * is written at its start, after a marker telling readers to wrap.
+     *
+     * @since 1.2
+     **/
+    class SharedMemoryRing {
+    public:
+        /**
+         * The maximum number of readers that can be attached at once.
+         **/
+        static constexpr std::size_t MaxReaders = 16;
+
+        /**
+         * Creates a new ring. The shared memory object is removed when the
+         * ring is destroyed, but processes that have already opened it can
+         * continue to use it.
+         *
+         * @param name     The name of the shared memory object, which should
+         *                 start with a slash, such as "/gsap-bus".
+         * @param capacity The number of bytes available for messages. Must be
+         *                 a power of two and at least 4096.
+         * @exception std::domain_error If the capacity is invalid.
+         * @exception std::system_error If the shared memory object already
+         *            exists or cannot be created.
+         **/
+        SharedMemoryRing(const std::string& name, std::size_t capacity);
+
+        /**
+         * Opens a ring created by another {@code SharedMemoryRing}, usually
+         * in another process, for reading.
+         *
+         * @param name The name of the shared memory object.
+         * @exception std::system_error If the shared memory object does not
+         *            exist or cannot be mapped.
+         * @exception std::runtime_error If the object is not a ring.
+         **/
+        explicit SharedMemoryRing(const std::string& name);
+
+        SharedMemoryRing(const SharedMemoryRing&) = delete;
+
+        SharedMemoryRing& operator=(const SharedMemoryRing&) = delete;
+
+        ~SharedMemoryRing();
+
+        /**
+         * Gets the number of bytes available for messages.
+         **/
+        inline std::size_t capacity() const {
+            return ringCapacity;
+        }
+
+        /**
+         * Gets a value indicating whether the current process created the
+         * ring, and can therefore write to it.
+         **/
+        inline bool isWriter() const {
+            return owner;
+        }
+
+        /**
+         * Gets the number of readers currently attached to the ring.
+         **/
+        std::size_t readers() const;
+
+        /**
+         * Writes a message to the ring if there is room for it.
+         *
+         * @returns True if the message was written; false if the slowest
+         *          reader has not yet read enough of the ring, after
+         *          detaching readers whose process has exited.
+         * @exception std::domain_error If the current process did not create
+         *            the ring, or the message is larger than half of the
+         *            ring.
+         **/
+        bool tryWrite(const Message& message);
+
+        /**
+         * Writes a message to the ring, yielding until there is room for it.
+         *
+         * @exception std::domain_error If the current process did not create
+         *            the ring, or the message is larger than half of the
+         *            ring.
+         **/
+        void write(const Message& message);
+
+    private:
+        friend class SharedMemoryReader;
+        struct Header;
+        static const std::size_t HeaderSize;
+
+        void map(int fd, std::size_t size);
+        std::uint64_t oldestReadPosition(std::uint64_t writePosition) const;
+        bool reclaimReaders();
+
+        std::string name;
+        bool owner;
+        void* mapping;
+        std::size_t mappingSize;
+        Header* header;
+        char* data;
+        std::size_t ringCapacity;
+
+        std::mutex writeMutex;
+        MemoryStreamBuf buffer;
+        std::ostream stream;
+    };
+
+    /**
+     * Reads every message written to a {@code SharedMemoryRing} after the
+     * reader was attached, in the order they were written.
+     *
+     * @remarks
+     * Messages are read in place. The {@code SerializedMessage} passed to the
+     * read callback refers directly to the shared memory, which the writer
+     * will not reuse until the callback returns.
+     *
+     * @remarks
+     * A reader may be used by one thread at a time.
+     *
+     * @since 1.2
+     **/
+    class SharedMemoryReader {
+    public:
+        /**
+         * Attaches a new reader to a ring. The ring must outlive the reader.
+         *
+         * @exception std::runtime_error If {@code SharedMemoryRing::MaxReaders}
+         *            readers are already attached.
+         **/
+        explicit SharedMemoryReader(SharedMemoryRing& ring);
+
+        SharedMemoryReader(const SharedMemoryReader&) = delete;
+
+        SharedMemoryReader& operator=(const SharedMemoryReader&) = delete;
+
+        /**
+         * Detaches the reader from the ring.
+         **/
+        ~SharedMemoryReader();
+
+        /**
+         * Reads the next message, if one is available, and passes it to
+         * {@p fn}. The message is consumed even if {@p fn} throws.
+         *
+         * @remarks
+         * The writer does not reuse the message until {@p fn} returns, so
+         * {@p fn} must not write to the same ring from the thread that is
+         * reading it. Once the ring is full, such a write would wait for the
+         * reader forever.
+         *
+         * @param fn A function taking a {@code const SerializedMessage&}.
+         * @returns  True if a message was read.
+         * @exception FormatError If the ring does not contain a valid message
+         *            at the reader's position. The size of the invalid record
+         *            is unknown, so the reader skips everything written to
+         *            the ring so far.
+         **/
+        template <class Fn>
+        bool tryRead(Fn fn) {
+            std::size_t available;
+            const char* next = peek(available);
+            if (next == nullptr) {
+                return false;
+            }
+            std::size_t size = 0;
+            try {
+                SerializedMessage message(next, available);
+                size = message.size();
+                fn(message);
+            }
+            catch (...) {
+                if (size == 0) {
+                    skipPending();
+                }
+                else {
+                    advance(size);
+                }
+                throw;
+            }
+            advance(size);
+            return true;
+        }
+
+        /**
+         * Gets the number of bytes written to the ring that the reader has
+         * not yet read.
+         **/
+        std::size_t pending() const;
+
+    private:
+        const char* peek(std::size_t& available);
+        void advance(std::size_t size);
+        void skipPending();
+
+        SharedMemoryRing& ring;
+        std::size_t slot;
+        std::uint64_t position;
+    };
+}
+
+#endif
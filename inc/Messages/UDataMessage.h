@@ -1,4 +1,4 @@
-// Copyright (c) 2018 United States Government as represented by the
+// Copyright (c) 2018-2019 United States Government as represented by the
 // Administrator of the National Aeronautics and Space Administration.
 // All Rights Reserved.
 #ifndef PCOE_MESSAGES_UDATAMESSAGE_H
@@ -6,9 +6,29 @@
 
 #include "Messages/ScalarMessage.h"
 #include "Messages/VectorMessage.h"
+#include "Messages/WireFormat.h"
 #include "UData.h"
 
 namespace PCOE {
+    /**
+     * Writes a UData as its uncertainty type, sample layout, distribution,
+     * validity and number of points, followed by its update time and its data
+     * in storage order.
+     **/
+    template <>
+    struct WireCodec<UData> {
+        /**
+         * The number of bytes written before the data.
+         **/
+        static constexpr std::size_t HeaderSize = 16;
+
+        static std::size_t size(const UData& value);
+
+        static void write(std::ostream& os, const UData& value);
+
+        static UData read(WireReader& reader);
+    };
+
     using UDataMessage = ScalarMessage<UData>;
     using UDataVecMessage = VectorMessage<UData>;
 }
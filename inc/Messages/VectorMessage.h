@@ -4,15 +4,25 @@
 #ifndef PCOE_VECTORMESSAGE_H
 #define PCOE_VECTORMESSAGE_H
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <type_traits>
 #include <vector>
 
 #include "Contracts.h"
 #include "Messages/Message.h"
+#include "Messages/SerializedMessage.h"
+#include "Messages/WireFormat.h"
 
 namespace PCOE {
     /**
      * A message the carries a vector of values.
      *
+     * @remarks
+     * The values are immutable once the message is constructed, and are held
+     * by shared ownership so that a vector can be passed between messages, or
+     * kept by a subscriber after the message is destroyed, without copying it.
+     *
      * @author Jason Watkins
      * @since 1.2
      **/
@@ -33,7 +43,8 @@ namespace PCOE {
                       std::string source,
                       time_point timestamp,
                       const std::vector<T>& values)
-            : Message(id, source, timestamp), values(values) {
+            : Message(id, source, timestamp),
+              values(std::make_shared<const std::vector<T>>(values)) {
             Expect((static_cast<std::uint64_t>(id) & 0x0000C00000000000L) > 0,
                    "Message id is not vector");
         }
@@ -52,7 +63,8 @@ namespace PCOE {
                       std::string source,
                       time_point timestamp,
                       std::vector<T>&& values)
-            : Message(id, source, timestamp), values(values) {
+            : Message(id, source, timestamp),
+              values(std::make_shared<const std::vector<T>>(std::move(values))) {
             Expect((static_cast<std::uint64_t>(id) & 0x0000C00000000000L) > 0,
                    "Message id is not vector");
         }
@@ -71,36 +83,128 @@ namespace PCOE {
                       std::string source,
                       time_point timestamp,
                       std::initializer_list<T> values)
-            : Message(id, source, timestamp), values(values) {
+            : Message(id, source, timestamp),
+              values(std::make_shared<const std::vector<T>>(values)) {
+            Expect((static_cast<std::uint64_t>(id) & 0x0000C00000000000L) > 0,
+                   "Message id is not vector");
+        }
+
+        /**
+         * Constructs a new instance of @{code VectorMessage} that shares
+         * ownership of an existing vector.
+         *
+         * @param id        The id of the message.
+         * @param source    The source of the message.
+         * @param timestamp The time at which the message or the data contained
+         *                  by the message was generated.
+         * @param value     The value of the message.
+         **/
+        VectorMessage(MessageId id,
+                      std::string source,
+                      time_point timestamp,
+                      std::shared_ptr<const std::vector<T>> values)
+            : Message(id, source, timestamp), values(std::move(values)) {
             Expect((static_cast<std::uint64_t>(id) & 0x0000C00000000000L) > 0,
                    "Message id is not vector");
+            Expect(this->values != nullptr, "Vector is null");
         }
 
         /**
          * Gets the value associated with the message.
          **/
         inline const std::vector<T>& getValue() const {
+            return *values;
+        }
+
+        /**
+         * Gets shared ownership of the value associated with the message.
+         **/
+        inline const std::shared_ptr<const std::vector<T>>& getSharedValue() const {
             return values;
         }
 
+        /**
+         * Constructs a new message from its serialized form.
+         *
+         * @remarks
+         * To read a vector of doubles without copying it, use
+         * {@code SerializedMessage::getDoubleVector} instead.
+         *
+         * @exception FormatError If the payload is malformed.
+         **/
+        static std::unique_ptr<VectorMessage> deserialize(const SerializedMessage& message) {
+            WireReader reader = message.payloadReader();
+            std::uint32_t count = reader.read<std::uint32_t>();
+            reader.skip(sizeof(std::uint32_t));
+            std::vector<T> values;
+            readValues(reader, count, values, std::is_arithmetic<T>());
+            return std::unique_ptr<VectorMessage>(new VectorMessage(message.getMessageId(),
+                                                                    message.getSource(),
+                                                                    message.getTimestamp(),
+                                                                    std::move(values)));
+        }
+
     protected:
-        std::uint16_t getPayloadSize() const override final {
-            std::size_t size = 2 + values.size() * sizeof(T);
-            Expect(size < std::numeric_limits<std::uint16_t>::max(), "Payload size too big");
-            return static_cast<std::uint16_t>(size);
+        // The element count is followed by 4 bytes of padding so that 8 byte
+        // elements are aligned within the message.
+        std::uint32_t getPayloadSize() const override final {
+            std::size_t size = 2 * sizeof(std::uint32_t) + valuesSize(std::is_arithmetic<T>());
+            Expect(size <= std::numeric_limits<std::uint32_t>::max(), "Payload size too big");
+            return static_cast<std::uint32_t>(size);
         }
 
         void serializePayload(std::ostream& os) const override final {
-            Expect(values.size() < std::numeric_limits<std::uint16_t>::max(), "Vector size");
-            std::uint16_t size = static_cast<std::uint16_t>(values.size());
-            os.write(reinterpret_cast<const char*>(&size), 2);
-            for (const T& value : values) {
-                os.write(reinterpret_cast<const char*>(&value), sizeof(T));
-            }
+            Expect(values->size() <= std::numeric_limits<std::uint32_t>::max(), "Vector size");
+            wireWrite(os, static_cast<std::uint32_t>(values->size()));
+            wirePad(os, sizeof(std::uint32_t));
+            writeValues(os, std::is_arithmetic<T>());
         }
 
     private:
-        std::vector<T> values;
+        std::size_t valuesSize(std::true_type) const {
+            return values->size() * sizeof(T);
+        }
+
+        std::size_t valuesSize(std::false_type) const {
+            std::size_t size = 0;
+            for (const T& value : *values) {
+                size += WireCodec<T>::size(value);
+            }
+            return size;
+        }
+
+        void writeValues(std::ostream& os, std::true_type) const {
+            os.write(reinterpret_cast<const char*>(values->data()),
+                     static_cast<std::streamsize>(values->size() * sizeof(T)));
+        }
+
+        void writeValues(std::ostream& os, std::false_type) const {
+            for (const T& value : *values) {
+                WireCodec<T>::write(os, value);
+            }
+        }
+
+        static void readValues(WireReader& reader,
+                               std::uint32_t count,
+                               std::vector<T>& values,
+                               std::true_type) {
+            if (count > reader.remaining() / sizeof(T)) {
+                throw FormatError("Message truncated");
+            }
+            values.resize(count);
+            reader.read(values.data(), count);
+        }
+
+        static void readValues(WireReader& reader,
+                               std::uint32_t count,
+                               std::vector<T>& values,
+                               std::false_type) {
+            for (std::uint32_t i = 0; i < count; i++) {
+                values.push_back(WireCodec<T>::read(reader));
+            }
+        }
+
+        std::shared_ptr<const std::vector<T>> values;
     };
 
     using U8VecMessage = VectorMessage<std::uint8_t>;
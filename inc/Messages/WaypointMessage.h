@@ -3,8 +3,11 @@
 // All Rights Reserved.
 #ifndef PCOE_WAYPOINTMESSAGE_H
 #define PCOE_WAYPOINTMESSAGE_H
+#include <memory>
+
 #include "Messages/Message.h"
 #include "Messages/MessageId.h"
+#include "Messages/SerializedMessage.h"
 #include "Point3D.h"
 
 namespace PCOE {
@@ -71,8 +74,15 @@ namespace PCOE {
             return point.getAltitude();
         }
 
+        /**
+         * Constructs a new message from its serialized form.
+         *
+         * @exception FormatError If the payload is malformed.
+         **/
+        static std::unique_ptr<WaypointMessage> deserialize(const SerializedMessage& message);
+
     protected:
-        std::uint16_t getPayloadSize() const override final;
+        std::uint32_t getPayloadSize() const override final;
 
         void serializePayload(std::ostream& os) const override final;
 
@@ -0,0 +1,236 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#ifndef PCOE_WIREFORMAT_H
+#define PCOE_WIREFORMAT_H
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <type_traits>
+
+#include "Exceptions.h"
+
+namespace PCOE {
+    /**
+     * The version of the binary message format written by
+     * {@code Message::serialize}.
+     **/
+    constexpr std::uint16_t MessageWireVersion = 1;
+
+    /**
+     * The size in bytes of the fixed part of a serialized message header.
+     **/
+    constexpr std::size_t MessageHeaderSize = 24;
+
+    /**
+     * The largest serialized message, in bytes, that
+     * {@code MessageFactory::deserialize} will read from a stream. Larger
+     * sizes in a header are treated as corrupt.
+     **/
+    constexpr std::size_t MaxMessageSize = 256 * 1024 * 1024;
+
+    /**
+     * The alignment in bytes of the source, the payload and the total size of
+     * a serialized message.
+     **/
+    constexpr std::size_t MessageWireAlignment = 8;
+
+    /**
+     * Rounds {@p size} up to the next multiple of
+     * {@code MessageWireAlignment}.
+     **/
+    inline std::size_t wireAlign(std::size_t size) {
+        return (size + MessageWireAlignment - 1) & ~(MessageWireAlignment - 1);
+    }
+
+    /**
+     * Writes the bytes of a trivially copyable value to a stream.
+     **/
+    template <class T>
+    inline void wireWrite(std::ostream& os, const T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "Type is not trivially copyable");
+        os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    /**
+     * Writes {@p count} zero bytes to a stream.
+     **/
+    inline void wirePad(std::ostream& os, std::size_t count) {
+        static const char zeros[MessageWireAlignment] = {};
+        while (count > 0) {
+            std::size_t n = count < MessageWireAlignment ? count : MessageWireAlignment;
+            os.write(zeros, static_cast<std::streamsize>(n));
+            count -= n;
+        }
+    }
+
+    /**
+     * A stream buffer that writes to a fixed region of memory, so that
+     * messages can be serialized in place into shared or mapped memory.
+     * Writes past the end of the region fail and set the stream's bad bit.
+     *
+     * @since 1.2
+     **/
+    class MemoryStreamBuf final : public std::streambuf {
+    public:
+        MemoryStreamBuf() = default;
+
+        /**
+         * Constructs a stream buffer that writes to {@p size} bytes starting
+         * at {@p data}.
+         **/
+        MemoryStreamBuf(char* data, std::size_t size) {
+            reset(data, size);
+        }
+
+        /**
+         * Directs subsequent writes to {@p size} bytes starting at
+         * {@p data}.
+         **/
+        inline void reset(char* data, std::size_t size) {
+            setp(data, data + size);
+        }
+
+        /**
+         * Gets the number of bytes written since the last reset.
+         **/
+        inline std::size_t written() const {
+            return static_cast<std::size_t>(pptr() - pbase());
+        }
+    };
+
+    /**
+     * Reads values from a buffer holding part of a serialized message. All
+     * reads are bounds checked and copy the bytes out of the buffer, so the
+     * buffer does not need to be aligned.
+     *
+     * @since 1.2
+     **/
+    class WireReader {
+    public:
+        /**
+         * Constructs a reader over {@p size} bytes starting at {@p data}. The
+         * reader does not copy or take ownership of the buffer.
+         **/
+        WireReader(const char* data, std::size_t size) : begin(data), pos(data), end(data + size) {}
+
+        /**
+         * Gets the number of bytes that have not been read.
+         **/
+        inline std::size_t remaining() const {
+            return static_cast<std::size_t>(end - pos);
+        }
+
+        /**
+         * Gets the number of bytes that have been read.
+         **/
+        inline std::size_t position() const {
+            return static_cast<std::size_t>(pos - begin);
+        }
+
+        /**
+         * Reads a trivially copyable value.
+         *
+         * @exception FormatError If the buffer is too short.
+         **/
+        template <class T>
+        inline T read() {
+            static_assert(std::is_trivially_copyable<T>::value, "Type is not trivially copyable");
+            T value;
+            std::memcpy(&value, skip(sizeof(T)), sizeof(T));
+            return value;
+        }
+
+        /**
+         * Copies {@p count} trivially copyable values to {@p destination}.
+         *
+         * @exception FormatError If the buffer is too short.
+         **/
+        template <class T>
+        inline void read(T* destination, std::size_t count) {
+            static_assert(std::is_trivially_copyable<T>::value, "Type is not trivially copyable");
+            if (count > remaining() / sizeof(T)) {
+                throw FormatError("Message truncated");
+            }
+            std::memcpy(destination, skip(count * sizeof(T)), count * sizeof(T));
+        }
+
+        /**
+         * Reads a string written as a 32-bit length followed by its
+         * characters.
+         *
+         * @exception FormatError If the buffer is too short.
+         **/
+        inline std::string readString() {
+            std::uint32_t length = read<std::uint32_t>();
+            const char* chars = skip(length);
+            return std::string(chars, length);
+        }
+
+        /**
+         * Advances past {@p count} bytes and returns a pointer to the first of
+         * them.
+         *
+         * @exception FormatError If the buffer is too short.
+         **/
+        inline const char* skip(std::size_t count) {
+            if (count > remaining()) {
+                throw FormatError("Message truncated");
+            }
+            const char* result = pos;
+            pos += count;
+            return result;
+        }
+
+    private:
+        const char* begin;
+        const char* pos;
+        const char* end;
+    };
+
+    /**
+     * Describes how values of type {@code T} are written to and read from the
+     * payload of a serialized message. Arithmetic types are written as their
+     * bytes in native byte order. Other types used as message payloads
+     * specialize this template next to the message type that carries them.
+     *
+     * @since 1.2
+     **/
+    template <class T, class Enable = void>
+    struct WireCodec;
+
+    template <class T>
+    struct WireCodec<T, typename std::enable_if<std::is_arithmetic<T>::value>::type> {
+        static std::size_t size(const T&) {
+            return sizeof(T);
+        }
+
+        static void write(std::ostream& os, const T& value) {
+            wireWrite(os, value);
+        }
+
+        static T read(WireReader& reader) {
+            return reader.read<T>();
+        }
+    };
+
+    template <>
+    struct WireCodec<std::string> {
+        static std::size_t size(const std::string& value) {
+            return sizeof(std::uint32_t) + value.size();
+        }
+
+        static void write(std::ostream& os, const std::string& value) {
+            wireWrite(os, static_cast<std::uint32_t>(value.size()));
+            os.write(value.data(), static_cast<std::streamsize>(value.size()));
+        }
+
+        static std::string read(WireReader& reader) {
+            return reader.readString();
+        }
+    };
+}
+
+#endif
@@ -8,6 +8,8 @@
 #include <vector>
 
 #include "ConfigMap.h"
+#include "FixedMatrix.h"
+#include "Models/ModelTraits.h"
 #include "PrognosticsModel.h"
 
 // Default parameter values
@@ -148,6 +150,50 @@ public:
      **/
     output_type outputEqn(double t, const state_type& x, const noise_type& n) const override;
 
+    /**
+     * Calculate the Jacobian of the state equation analytically.
+     *
+     * @param t  Time
+     * @param x  The model state vector at the current time step.
+     * @param u  The model input vector at the current time step.
+     * @param dt The size of the time step to calculate
+     * @param F  An 8 x 8 matrix that receives the Jacobian.
+     **/
+    void stateJacobian(double t,
+                       const state_type& x,
+                       const input_type& u,
+                       double dt,
+                       PCOE::Matrix& F) const override;
+
+    /**
+     * Calculate the Jacobian of the output equation analytically.
+     *
+     * @param t  Time
+     * @param x  The model state vector at the current time step.
+     * @param H  A 2 x 8 matrix that receives the Jacobian.
+     **/
+    void outputJacobian(double t, const state_type& x, PCOE::Matrix& H) const override;
+
+    /**
+     * Calculate the Jacobian of the state equation analytically into a
+     * fixed-size matrix.
+     *
+     * @see stateJacobian(double, const state_type&, const input_type&, double, PCOE::Matrix&)
+     **/
+    void stateJacobian(double t,
+                       const state_type& x,
+                       const input_type& u,
+                       double dt,
+                       PCOE::FixedMatrix<8, 8>& F) const;
+
+    /**
+     * Calculate the Jacobian of the output equation analytically into a
+     * fixed-size matrix.
+     *
+     * @see outputJacobian(double, const state_type&, PCOE::Matrix&)
+     **/
+    void outputJacobian(double t, const state_type& x, PCOE::FixedMatrix<2, 8>& H) const;
+
     /**
      * Initialize the model state.
      *
@@ -170,5 +216,28 @@ public:
 
     // Set default parameters, based on 18650 cells
     void setParameters(const double qMobile = QMOBILE_DEFAULT_VALUE, const double Vol = 2e-5);
+
+private:
+    template <class TMatrix>
+    void computeStateJacobian(const state_type& x,
+                              const input_type& u,
+                              double dt,
+                              TMatrix& F) const;
+
+    template <class TMatrix>
+    void computeOutputJacobian(const state_type& x, TMatrix& H) const;
 };
+
+namespace PCOE {
+    /**
+     * The battery model has 8 states, 1 input and 2 outputs.
+     **/
+    template <>
+    struct ModelTraits<BatteryModel> {
+        static const bool isFixedSize = true;
+        static const std::size_t stateSize = 8;
+        static const std::size_t inputSize = 1;
+        static const std::size_t outputSize = 2;
+    };
+}
 #endif
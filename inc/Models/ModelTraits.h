@@ -0,0 +1,26 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#ifndef PCOE_MODELTRAITS_H
+#define PCOE_MODELTRAITS_H
+
+#include <cstddef>
+
+namespace PCOE {
+    /**
+     * Describes properties of a model type that are known at compile time.
+     * By default, the sizes of a model are only known at run time. Models
+     * whose state, input and output sizes are fixed specialize
+     * {@code ModelTraits} with {@code isFixedSize} set to true and the sizes
+     * as {@code stateSize}, {@code inputSize} and {@code outputSize}, so that
+     * algorithms templated on the model can use {@code FixedMatrix}.
+     *
+     * @since 1.2
+     **/
+    template <class TModel>
+    struct ModelTraits {
+        static const bool isFixedSize = false;
+    };
+}
+
+#endif
@@ -34,6 +34,16 @@ namespace PCOE {
     public:
         using DynamicArray::DynamicArray;
 
+        /**
+         * Constructs a new {@code StateVector} from the elements of a matrix
+         * view, such as a column of sigma points, in row-major order.
+         *
+         * @param source The view to copy from.
+         **/
+        explicit StateVector(const ConstMatrixView& source) : DynamicArray(source.size()) {
+            source.copyTo(data());
+        }
+
         using DynamicArray::operator=;
 
         using DynamicArray::operator[];
@@ -189,6 +199,38 @@ namespace PCOE {
          **/
         virtual state_type initialize(const input_type& u, const output_type& z) const = 0;
 
+        /**
+         * Calculate the Jacobian of the state equation with respect to the
+         * state, evaluated without process noise. The default implementation
+         * uses central finite differences, which costs two evaluations of
+         * the state equation per state. Models that can compute the Jacobian
+         * analytically should override this method.
+         *
+         * @param t  Time
+         * @param x  The model state vector at the current time step.
+         * @param u  The model input vector at the current time step.
+         * @param dt The size of the time step to calculate.
+         * @param F  A stateSize x stateSize matrix that receives the Jacobian.
+         **/
+        virtual void stateJacobian(const double t,
+                                   const state_type& x,
+                                   const input_type& u,
+                                   const double dt,
+                                   Matrix& F) const;
+
+        /**
+         * Calculate the Jacobian of the output equation with respect to the
+         * state, evaluated without sensor noise. The default implementation
+         * uses central finite differences. Models that can compute the
+         * Jacobian analytically should override this method.
+         *
+         * @param t  Time
+         * @param x  The model state vector at the current time step.
+         * @param H  An outputSize x stateSize matrix that receives the
+         *           Jacobian.
+         **/
+        virtual void outputJacobian(const double t, const state_type& x, Matrix& H) const;
+
         /**
          * Gets an empty state vector of the correct size for the current model.
          **/
@@ -0,0 +1,155 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#ifndef PCOE_MONOTONICARENA_H
+#define PCOE_MONOTONICARENA_H
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+namespace PCOE {
+    /**
+     * Hands out memory from large blocks and releases it all at once when the
+     * arena is destroyed.
+     *
+     * @remarks
+     * Memory allocated from the arena is never reused, so allocation is a
+     * pointer bump and deallocation is free. The arena is intended for groups
+     * of objects that are created together and destroyed together, such as
+     * the results of a single prediction. The arena is not thread safe.
+     *
+     * @since 1.2
+     **/
+    class MonotonicArena {
+    public:
+        /**
+         * Constructs a new arena.
+         *
+         * @param initialSize The size in bytes of the first block. If the
+         *                    total size of the allocations is known, passing
+         *                    it here makes the arena a single allocation.
+         **/
+        explicit MonotonicArena(std::size_t initialSize = 4096);
+
+        MonotonicArena(const MonotonicArena&) = delete;
+
+        MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+        /**
+         * Frees all of the memory allocated from the arena.
+         **/
+        ~MonotonicArena();
+
+        /**
+         * Allocates memory from the arena, adding a new block if the current
+         * block is full.
+         *
+         * @param size      The number of bytes to allocate.
+         * @param alignment The alignment of the allocation, which must be a
+         *                  power of two no larger than
+         *                  {@code alignof(std::max_align_t)}.
+         **/
+        void* allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+
+        /**
+         * Gets the number of bytes allocated from the arena.
+         **/
+        inline std::size_t used() const {
+            return usedBytes;
+        }
+
+        /**
+         * Gets the number of blocks the arena has allocated.
+         **/
+        inline std::size_t blockCount() const {
+            return blocks;
+        }
+
+    private:
+        struct Block;
+
+        void addBlock(std::size_t size);
+
+        Block* head;
+        char* current;
+        char* end;
+        std::size_t nextSize;
+        std::size_t usedBytes;
+        std::size_t blocks;
+    };
+
+    /**
+     * An allocator that allocates from a shared {@code MonotonicArena}, or
+     * from the heap if it has no arena.
+     *
+     * @remarks
+     * Each allocator holds shared ownership of its arena, so containers that
+     * use the arena keep it alive, and the arena is freed when the last of
+     * them is destroyed. Copies of a container are allocated on the heap
+     * rather than in the arena of the original, while moving a container
+     * moves its arena with it.
+     *
+     * @since 1.2
+     **/
+    template <class T>
+    class ArenaAllocator {
+    public:
+        using value_type = T;
+        using propagate_on_container_copy_assignment = std::false_type;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap = std::true_type;
+
+        /**
+         * Constructs an allocator that allocates from the heap.
+         **/
+        ArenaAllocator() = default;
+
+        /**
+         * Constructs an allocator that allocates from the given arena.
+         **/
+        explicit ArenaAllocator(std::shared_ptr<MonotonicArena> arena) : arena(std::move(arena)) {}
+
+        template <class U>
+        ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.getArena()) {}
+
+        T* allocate(std::size_t n) {
+            if (arena) {
+                return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));
+            }
+            return std::allocator<T>().allocate(n);
+        }
+
+        void deallocate(T* p, std::size_t n) {
+            if (!arena) {
+                std::allocator<T>().deallocate(p, n);
+            }
+        }
+
+        ArenaAllocator select_on_container_copy_construction() const {
+            return ArenaAllocator();
+        }
+
+        /**
+         * Gets the arena used by the allocator, or {@code nullptr} if the
+         * allocator allocates from the heap.
+         **/
+        inline const std::shared_ptr<MonotonicArena>& getArena() const {
+            return arena;
+        }
+
+    private:
+        std::shared_ptr<MonotonicArena> arena;
+    };
+
+    template <class T, class U>
+    inline bool operator==(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs) {
+        return lhs.getArena() == rhs.getArena();
+    }
+
+    template <class T, class U>
+    inline bool operator!=(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs) {
+        return !(lhs == rhs);
+    }
+}
+
+#endif
@@ -0,0 +1,91 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#ifndef PCOE_ASYNCFLEETOBSERVER_H
+#define PCOE_ASYNCFLEETOBSERVER_H
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Messages/IMessageProcessor.h"
+#include "Messages/MessageBus.h"
+#include "Messages/MessageWatcher.h"
+#include "Observers/BatchUnscentedKalmanFilter.h"
+
+namespace PCOE {
+    /**
+     * Provides an event-driven wrapper around a batched UKF that observes a
+     * fleet of assets, each published to the message bus under its own
+     * source. Like the {@code AsyncObserver}, the fleet observer listens for
+     * the inputs and outputs of each asset and publishes a state estimate for
+     * the asset after each step.
+     *
+     * @remarks
+     * Complete sets of data are queued as they arrive. Whichever thread finds
+     * the filter idle steps every queued asset in a single batch, so assets
+     * whose data arrives while a batch is running are stepped together in the
+     * next one. If a second set of data arrives for an asset before it is
+     * stepped, the newer set replaces the older one.
+     *
+     * @since 1.2
+     **/
+    class AsyncFleetObserver final : public IMessageProcessor {
+    public:
+        /**
+         * Constructs a new {@code AsyncFleetObserver}.
+         *
+         * @param messageBus The message bus on which to listen for and publish
+         *                   messages.
+         * @param filter     The batched filter used to observe the fleet.
+         * @param sources    The name of the source of each asset in the fleet,
+         *                   in the order of the assets in {@p filter}.
+         **/
+        AsyncFleetObserver(MessageBus& messageBus,
+                           std::unique_ptr<BatchUnscentedKalmanFilter>&& filter,
+                           std::vector<std::string> sources);
+
+        /**
+         * Unsubscribes the {@code AsyncFleetObserver} from the message bus.
+         **/
+        ~AsyncFleetObserver();
+
+        /**
+         * Handles messages representing updates to the model inputs and
+         * outputs of each asset. When a full set of new data is collected for
+         * an asset, queues the asset to be stepped and steps the queued assets
+         * if the filter is idle.
+         *
+         * @param message. The message to process.
+         **/
+        void processMessage(const std::shared_ptr<Message>& message) override;
+
+    private:
+        void stepFleet();
+
+        using mutex = std::mutex;
+        using lock_guard = std::lock_guard<mutex>;
+        using unique_lock = std::unique_lock<mutex>;
+
+        mutable mutex m; // guards the message and queue state below
+        mutable mutex stepMutex; // held while the filter is stepped
+        MessageBus& bus;
+        std::unique_ptr<BatchUnscentedKalmanFilter> filter;
+        std::vector<std::string> sources;
+        std::unordered_map<std::string, std::size_t> assetIndices;
+        std::vector<std::unique_ptr<MessageWatcher<double>>> watchers;
+        std::vector<std::shared_ptr<Message>> inputMsgs;
+        std::vector<std::shared_ptr<Message>> outputMsgs;
+        std::vector<BatchUnscentedKalmanFilter::Update> queued;
+        std::vector<Message::time_point> queuedTimes;
+        std::vector<std::size_t> queuedIndices; // position in queued, or npos
+        std::vector<BatchUnscentedKalmanFilter::Update> batch;
+        std::vector<Message::time_point> batchTimes;
+        std::vector<double> lastTimes;
+        bool hasInputs;
+        bool hasOutputs;
+    };
+}
+
+#endif
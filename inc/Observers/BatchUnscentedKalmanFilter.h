@@ -0,0 +1,176 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#ifndef PCOE_BATCHUNSCENTEDKALMANFILTER_H
+#define PCOE_BATCHUNSCENTEDKALMANFILTER_H
+
+#include <cstddef>
+#include <vector>
+
+#include "Matrix.h"
+#include "Models/SystemModel.h"
+#include "UData.h"
+#include "UnscentedTransform.h"
+
+namespace PCOE {
+    /**
+     * Runs a fleet of UKF state estimators that share a single model and
+     * noise covariance, one for each asset in the fleet. Assets that have new
+     * data are stepped together in a single call.
+     *
+     * @remarks
+     * The filter state of every asset is stored in structure-of-arrays form,
+     * with the asset index as the fastest-varying dimension. The covariance,
+     * Cholesky and Kalman gain kernels therefore run over contiguous lanes of
+     * assets, which the compiler can vectorize, and a step of the whole batch
+     * does not allocate matrices. Only the model equations are evaluated one
+     * asset at a time.
+     *
+     * As in {@code UnscentedKalmanFilter}, sigma points are spread by the
+     * process noise covariance, so each asset produces the same estimates as
+     * a separate {@code UnscentedKalmanFilter}.
+     *
+     * @since 1.2
+     **/
+    class BatchUnscentedKalmanFilter final {
+    public:
+        /**
+         * New model inputs and outputs for a single asset.
+         **/
+        struct Update {
+            std::size_t asset;
+            double time;
+            SystemModel::input_type u;
+            SystemModel::output_type z;
+        };
+
+        /**
+         * Constructs a new {@code BatchUnscentedKalmanFilter} with the given
+         * model and covariance matrices.
+         *
+         * @param m          The model on which state estimation will be
+         *                   performed. The filter does not take ownership of
+         *                   the model.
+         * @param assetCount The number of assets in the fleet.
+         * @param Q          Process noise covariance matrix
+         * @param R          Sensor noise covariance matrix
+         **/
+        BatchUnscentedKalmanFilter(const SystemModel& m,
+                                   std::size_t assetCount,
+                                   const Matrix& Q,
+                                   const Matrix& R);
+
+        /**
+         * Sets the initial state of a single asset. The initial state
+         * covariance is the process noise covariance.
+         *
+         * @param asset The index of the asset to initialize.
+         * @param t0    Initial time
+         * @param x0    Initial model state
+         * @param u0    Initial model input
+         **/
+        void initialize(std::size_t asset,
+                        double t0,
+                        const SystemModel::state_type& x0,
+                        const SystemModel::input_type& u0);
+
+        /**
+         * Performs a single state estimation for each of the given assets.
+         * Each asset may appear at most once, and must already be initialized.
+         *
+         * @param updates The model inputs and outputs of each asset to step.
+         * @return        The assets that could not be stepped because their
+         *                predicted output covariance is not positive
+         *                definite. These assets keep their previous estimate
+         *                and time. All other assets are stepped normally.
+         **/
+        std::vector<std::size_t> step(const std::vector<Update>& updates);
+
+        /**
+         * Returns the current state estimate of an asset, including
+         * uncertainty.
+         *
+         * @param asset The index of the asset.
+         * @return      The last state estimate calculated for the asset.
+         **/
+        std::vector<UData> getStateEstimate(std::size_t asset) const;
+
+        /**
+         * Gets a value indicating whether an asset has been initialized.
+         **/
+        inline bool isInitialized(std::size_t asset) const {
+            return initialized[asset];
+        }
+
+        /**
+         * Gets the number of assets in the fleet.
+         **/
+        inline std::size_t getAssetCount() const {
+            return assetCount;
+        }
+
+        /**
+         * Gets the model shared by every asset in the fleet.
+         **/
+        inline const SystemModel& getModel() const {
+            return model;
+        }
+
+        inline void setKappa(double value) {
+            sigma.kappa = value;
+        }
+
+        inline void setAlpha(double value) {
+            sigma.alpha = value;
+        }
+
+        inline void setBeta(double value) {
+            sigma.beta = value;
+        }
+
+    private:
+        const SystemModel& model;
+        const std::size_t assetCount;
+        Matrix Q;
+        Matrix R;
+        Matrix sqrtQ; // Cholesky factor of Q, used to spread the sigma points
+        SigmaPoints sigma;
+
+        /**
+         * Per-asset filter state. Element (i, j) of asset a is stored at
+         * [(i * cols + j) * assetCount + a].
+         **/
+        std::vector<bool> initialized;
+        std::vector<double> lastTime;
+        std::vector<SystemModel::input_type> uPrev;
+        std::vector<double> x; // stateSize x 1
+        std::vector<double> P; // stateSize x stateSize
+
+        /**
+         * Buffers used by {@code step}, laid out like the per-asset state but
+         * indexed by position in the batch rather than by asset. They are
+         * sized for the whole fleet, so that a step does not allocate.
+         **/
+        struct Workspace {
+            std::vector<char> inBatch; // whether each asset is in the batch
+            SystemModel::state_type xk; // single sigma point
+            std::vector<double> zeroNoise; // zero process noise
+            std::vector<double> zeroNoiseZ; // zero sensor noise
+            std::vector<double> wc; // covariance weights
+            std::vector<double> dt; // time step of each lane
+            std::vector<char> failed; // whether each lane failed to factor Pzz
+            std::vector<double> X; // stateSize x sigmaPointCount
+            std::vector<double> dX; // stateSize x sigmaPointCount
+            std::vector<double> dZ; // outputSize x sigmaPointCount
+            std::vector<double> xkk1; // stateSize x 1
+            std::vector<double> zkk1; // outputSize x 1
+            std::vector<double> Pkk1; // stateSize x stateSize
+            std::vector<double> Pzz; // outputSize x outputSize
+            std::vector<double> Pxz; // stateSize x outputSize
+            std::vector<double> Lzz; // outputSize x outputSize
+            std::vector<double> Kk; // stateSize x outputSize
+        } ws;
+    };
+}
+
+#endif
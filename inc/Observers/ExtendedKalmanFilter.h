@@ -0,0 +1,122 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#ifndef PCOE_EXTENDEDKALMANFILTER_H
+#define PCOE_EXTENDEDKALMANFILTER_H
+
+#include <vector>
+
+#include "Matrix.h"
+#include "Observers/Observer.h"
+
+namespace PCOE {
+    class ConfigMap;
+
+    /**
+     * Implements the EKF state estimation algorithm for mildly non-linear
+     * models. Each step evaluates the state and output equations once, and
+     * propagates the covariance through their Jacobians, which are provided
+     * by {@code SystemModel::stateJacobian} and
+     * {@code SystemModel::outputJacobian}. Models that do not compute their
+     * Jacobians analytically fall back to finite differences.
+     *
+     * @since 1.2
+     **/
+    class ExtendedKalmanFilter final : public Observer {
+    private:
+        /**
+         * Constructs a new @{code ExtendedKalmanFilter} instance and
+         * initializes the model. This constructor is only intended to be used
+         * by other constructors to set up model-related parameters.
+         *
+         * @param m The model on which state estimation will be performed.
+         **/
+        explicit ExtendedKalmanFilter(const SystemModel& m);
+
+    public:
+        /**
+         * Constructs a new @{code ExtendedKalmanFilter} instance with the
+         * given model and covariance matrices.
+         *
+         * @param m The model on which state estimation will be performed. The
+         *          filter does not take ownership of the model.
+         * @param Q Process noise covariance matrix
+         * @param R Sensor noise covariance matrix
+         **/
+        ExtendedKalmanFilter(const SystemModel& m, Matrix Q, Matrix R);
+
+        /**
+         * Constructs a new @{code ExtendedKalmanFilter} instance with the
+         * given model and with covariance matrices read from the provided
+         * config.
+         *
+         * @param m      The model on which state estimation will be performed.
+         *               The filter does not take ownership of the model.
+         * @param config A configuration from which to read covariance matrices.
+         **/
+        ExtendedKalmanFilter(const SystemModel& m, const ConfigMap& config);
+
+        /**
+         * Sets the initial model state. The initial state covariance is the
+         * process noise covariance.
+         *
+         * @param t0 Initial time
+         * @param x0 Initial model state
+         * @param u0 Initial model input
+         **/
+        void initialize(double t0,
+                        const SystemModel::state_type& x0,
+                        const SystemModel::input_type& u0) override;
+
+        /**
+         * Performs a single state estimation with the given model inputs and
+         * outputs.
+         *
+         * @param t The time at which to make a prediction.
+         * @param u The model input vector at time @{code t}.
+         * @param z The model output vector at time @{code t}.
+         **/
+        void step(double t, const SystemModel::input_type& u, const SystemModel::output_type& z) override;
+
+        /**
+         * Returns the current state estimate of the observer, including
+         * uncertainty.
+         *
+         * @return The last calculated state estimate calcualted by the
+         *         observer.
+         **/
+        std::vector<UData> getStateEstimate() const override;
+
+        /**
+         * Gets the state covariance matrix.
+         **/
+        const Matrix& getStateCovariance() const {
+            return P;
+        }
+
+    private:
+        SystemModel::state_type xEstimated;
+        Matrix Q;
+        Matrix R;
+        Matrix P;
+
+        /**
+         * Buffers used by {@code step}, sized once from the model dimensions
+         * so that the filter update does not allocate matrices.
+         **/
+        struct Workspace {
+            std::vector<double> zeroNoise; // zero process noise
+            std::vector<double> zeroNoiseZ; // zero sensor noise
+            Matrix F; // state Jacobian
+            Matrix H; // output Jacobian
+            Matrix FP; // F * P
+            Matrix Pkk1; // predicted state covariance
+            Matrix Pxz; // state-output cross-covariance, Pkk1 * H'
+            Matrix Pzz; // output covariance
+            Matrix Lzz; // Cholesky factor of the output covariance
+            Matrix Kk; // Kalman gain
+        } ws;
+    };
+}
+
+#endif
@@ -0,0 +1,178 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#ifndef PCOE_FIXEDEXTENDEDKALMANFILTER_H
+#define PCOE_FIXEDEXTENDEDKALMANFILTER_H
+
+#include <vector>
+
+#include "FixedMatrix.h"
+#include "Matrix.h"
+#include "Models/ModelTraits.h"
+#include "Observers/Observer.h"
+
+namespace PCOE {
+    /**
+     * Implements the same EKF state estimation algorithm as
+     * {@code ExtendedKalmanFilter} for a model type whose sizes are known at
+     * compile time. All of the covariance and Jacobian matrices are
+     * {@code FixedMatrix} instances sized from {@code ModelTraits}, so a step
+     * does not allocate any matrices.
+     *
+     * @remarks
+     * The model type must specialize {@code ModelTraits} and provide
+     * {@code stateJacobian} and {@code outputJacobian} overloads that take
+     * {@code FixedMatrix} arguments of the corresponding sizes.
+     *
+     * @since 1.2
+     **/
+    template <class TModel>
+    class FixedExtendedKalmanFilter final : public Observer {
+        static_assert(ModelTraits<TModel>::isFixedSize,
+                      "FixedExtendedKalmanFilter requires a model with fixed sizes");
+
+    public:
+        static const std::size_t stateSize = ModelTraits<TModel>::stateSize;
+        static const std::size_t outputSize = ModelTraits<TModel>::outputSize;
+
+        using state_matrix = FixedMatrix<stateSize, stateSize>;
+        using output_matrix = FixedMatrix<outputSize, outputSize>;
+        using output_state_matrix = FixedMatrix<outputSize, stateSize>;
+
+        /**
+         * Constructs a new @{code FixedExtendedKalmanFilter} instance with
+         * the given model and covariance matrices.
+         *
+         * @param m The model on which state estimation will be performed. The
+         *          filter does not take ownership of the model.
+         * @param Q Process noise covariance matrix
+         * @param R Sensor noise covariance matrix
+         * @exception std::domain_error If the sizes of Q or R do not match the
+         *            model.
+         **/
+        FixedExtendedKalmanFilter(const TModel& m, const Matrix& Q, const Matrix& R)
+            : Observer(m),
+              fixedModel(m),
+              zeroNoise(stateSize),
+              zeroNoiseZ(outputSize),
+              Q(Q),
+              R(R) {
+            Expect(m.getStateSize() == stateSize, "Model state size does not match traits");
+            Expect(m.getOutputSize() == outputSize, "Model output size does not match traits");
+            xEstimated = model.getStateVector();
+            uPrev = model.getInputVector();
+        }
+
+        /**
+         * Sets the initial model state. The initial state covariance is the
+         * process noise covariance.
+         *
+         * @param t0 Initial time
+         * @param x0 Initial model state
+         * @param u0 Initial model input
+         **/
+        void initialize(double t0,
+                        const SystemModel::state_type& x0,
+                        const SystemModel::input_type& u0) override {
+            lastTime = t0;
+            xEstimated = x0;
+            uPrev = u0;
+            P = Q;
+            initialized = true;
+        }
+
+        /**
+         * Performs a single state estimation with the given model inputs and
+         * outputs.
+         *
+         * @param t The time at which to make a prediction.
+         * @param u The model input vector at time @{code t}.
+         * @param z The model output vector at time @{code t}.
+         **/
+        void step(double timestamp,
+                  const SystemModel::input_type& u,
+                  const SystemModel::output_type& z) override {
+            Expect(isInitialized(), "Not initialized");
+            Expect(timestamp - lastTime > 0, "Time has not advanced");
+
+            double dt = timestamp - lastTime;
+            lastTime = timestamp;
+
+            // 1. Predict
+            state_matrix F;
+            fixedModel.stateJacobian(timestamp, xEstimated, uPrev, dt, F);
+            auto xkk1 = model.stateEqn(timestamp, xEstimated, uPrev, zeroNoise, dt);
+            state_matrix Pkk1 = F * P * F.transpose() + Q;
+
+            output_state_matrix H;
+            fixedModel.outputJacobian(timestamp, xkk1, H);
+            auto zkk1 = model.outputEqn(timestamp, xkk1, zeroNoiseZ);
+            output_state_matrix Pzx = H * Pkk1;
+            output_matrix Pzz = Pzx * H.transpose() + R;
+
+            // 2. Update
+            // The transpose of the Kalman gain solves Pzz * Kk' = Pzx
+            output_state_matrix KkT = Pzz.cholSolve(Pzx);
+            for (std::size_t i = 0; i < stateSize; i++) {
+                double correction = 0;
+                for (std::size_t j = 0; j < outputSize; j++) {
+                    correction += KkT[j][i] * (z[j] - zkk1[j]);
+                }
+                xEstimated[i] = xkk1[i] + correction;
+            }
+
+            // P = Pkk1 - Kk * Pzz * Kk', where Kk * Pzz = Pzx'
+            for (std::size_t i = 0; i < stateSize; i++) {
+                for (std::size_t j = i; j < stateSize; j++) {
+                    double sum = Pkk1[i][j];
+                    for (std::size_t l = 0; l < outputSize; l++) {
+                        sum -= Pzx[l][i] * KkT[l][j];
+                    }
+                    P[i][j] = sum;
+                    P[j][i] = sum;
+                }
+            }
+
+            uPrev = u;
+        }
+
+        /**
+         * Returns the current state estimate of the observer, including
+         * uncertainty.
+         **/
+        std::vector<UData> getStateEstimate() const override {
+            std::vector<UData> state(stateSize);
+            for (std::size_t i = 0; i < stateSize; i++) {
+                state[i].uncertainty(UType::MeanCovar);
+                state[i].npoints(stateSize);
+                state[i][MEAN] = xEstimated[i];
+                state[i][COVAR()] = std::vector<double>(P[i], P[i] + stateSize);
+            }
+            return state;
+        }
+
+        /**
+         * Gets the state covariance matrix.
+         **/
+        const state_matrix& getStateCovariance() const {
+            return P;
+        }
+
+    private:
+        const TModel& fixedModel;
+        SystemModel::noise_type zeroNoise;
+        SystemModel::noise_type zeroNoiseZ;
+        SystemModel::state_type xEstimated;
+        state_matrix Q;
+        output_matrix R;
+        state_matrix P;
+    };
+
+    template <class TModel>
+    const std::size_t FixedExtendedKalmanFilter<TModel>::stateSize;
+
+    template <class TModel>
+    const std::size_t FixedExtendedKalmanFilter<TModel>::outputSize;
+}
+
+#endif
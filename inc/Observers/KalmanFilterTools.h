@@ -0,0 +1,59 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#ifndef PCOE_KALMANFILTERTOOLS_H
+#define PCOE_KALMANFILTERTOOLS_H
+
+#include <cstddef>
+#include <string>
+
+#include "Matrix.h"
+
+namespace PCOE {
+    class ConfigMap;
+
+    /**
+     * Reads a square matrix stored in row-major order from the given key.
+     *
+     * @param config The config to read from.
+     * @param key    The key holding the matrix elements.
+     * @exception    AssertException if the number of values is not a square.
+     **/
+    Matrix readSquareMatrix(const ConfigMap& config, const std::string& key);
+
+    /**
+     * Computes the Kalman gain K = Pxz * Pzz^-1 from the lower-triangular
+     * Cholesky factor of Pzz, by solving Pzz * K' = Pxz' with two triangular
+     * solves for each row of K. Pzz is never inverted.
+     *
+     * @param Lzz The lower-triangular Cholesky factor of Pzz.
+     * @param Pxz The state-output cross-covariance.
+     * @param K   The matrix to store the gain in. Must be the same size as
+     *            {@p Pxz}.
+     **/
+    void kalmanGain(const Matrix& Lzz, const Matrix& Pxz, Matrix& K);
+
+    /**
+     * Computes the Kalman gain for each lane of a batch of filters whose
+     * matrices are stored interleaved, where element (i, j) of lane b of an
+     * m x n matrix is at [(i * n + j) * stride + b]. Lanes are solved side by
+     * side, so the innermost loops run over contiguous lanes.
+     *
+     * @param Lzz        The Cholesky factors of Pzz, outputSize x outputSize.
+     * @param Pxz        The cross-covariances, stateSize x outputSize.
+     * @param K          Receives the gains, stateSize x outputSize.
+     * @param stateSize  The number of states.
+     * @param outputSize The number of outputs.
+     * @param stride     The distance between consecutive elements of a lane.
+     * @param lanes      The number of lanes to solve.
+     **/
+    void kalmanGain(const double* Lzz,
+                    const double* Pxz,
+                    double* K,
+                    std::size_t stateSize,
+                    std::size_t outputSize,
+                    std::size_t stride,
+                    std::size_t lanes);
+}
+
+#endif
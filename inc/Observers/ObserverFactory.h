@@ -5,8 +5,10 @@
 #define PCOE_OBSERVERFACTORY_H
 
 #include "Factory.h"
+#include "Observers/ExtendedKalmanFilter.h"
 #include "Observers/Observer.h"
 #include "Observers/ParticleFilter.h"
+#include "Observers/SquareRootUnscentedKalmanFilter.h"
 #include "Observers/UnscentedKalmanFilter.h"
 #include "Singleton.h"
 
@@ -30,6 +32,8 @@ namespace PCOE {
         ObserverFactory() {
             Register<UnscentedKalmanFilter>("UKF");
             Register<ParticleFilter>("PF");
+            Register<SquareRootUnscentedKalmanFilter>("SRUKF");
+            Register<ExtendedKalmanFilter>("EKF");
         }
     };
 }
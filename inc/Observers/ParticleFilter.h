@@ -1,22 +1,49 @@
-// Copyright (c) 2017-2018 United States Government as represented by the
+// Copyright (c) 2017-2019 United States Government as represented by the
 // Administrator of the National Aeronautics and Space Administration.
 // All Rights Reserved.
 #ifndef PCOE_ParticleFilter_H
 #define PCOE_ParticleFilter_H
 
+#include <cstdint>
+#include <memory>
 #include <random>
+#include <set>
 #include <vector>
 
 #include "Matrix.h"
 #include "Observers/Observer.h"
+#include "WorkerPool.h"
 
 namespace PCOE {
     class ConfigMap;
 
+    /**
+     * Methods for drawing a new set of particles from the weighted particles.
+     **/
+    enum class ResamplingScheme { Systematic, Stratified, Residual, Multinomial };
+
+    /**
+     * Parameters for KLD-sampling, which adapts the number of particles to the
+     * spread of the posterior. The state space is divided into bins of size
+     * {@code binSize}, and particles are drawn until the number of particles
+     * bounds the Kullback-Leibler divergence between the sampled and true
+     * posterior by {@code epsilon} with probability 1 - delta, where
+     * {@code quantile} is the upper 1 - delta quantile of the standard normal
+     * distribution.
+     **/
+    struct KLDSampling {
+        std::vector<double> binSize; // bin size in each state dimension
+        std::size_t minCount; // minimum number of particles
+        std::size_t maxCount; // maximum number of particles
+        double epsilon; // bound on the KL divergence
+        double quantile; // standard normal quantile of 1 - delta
+    };
+
     struct Particles {
-        Matrix X; // state matrix, numStates x particleCount
+        Matrix X; // state matrix, particleCount x numStates (one row per particle)
         Matrix Z; // output matrix, numOutputs x particleCount
-        std::vector<double> w; // weights
+        std::vector<double> w; // normalized weights
+        std::vector<double> logW; // log of the normalized weights
     };
 
     /**
@@ -92,6 +119,56 @@ namespace PCOE {
             minEffective = value;
         }
 
+        /**
+         * Sets the method used to resample the particles.
+         **/
+        inline void setResamplingScheme(ResamplingScheme value) {
+            resamplingScheme = value;
+        }
+
+        /**
+         * Gets the method used to resample the particles.
+         **/
+        inline ResamplingScheme getResamplingScheme() const {
+            return resamplingScheme;
+        }
+
+        /**
+         * Enables KLD-sampling. When enabled, the particles are resampled on
+         * every step, and the number of particles drawn grows or shrinks with
+         * the number of bins the posterior occupies. The resampling scheme is
+         * not used while KLD-sampling is enabled.
+         **/
+        void enableKLDSampling(const KLDSampling& params);
+
+        /**
+         * Disables KLD-sampling. The particle count remains at its current
+         * value.
+         **/
+        inline void disableKLDSampling() {
+            adaptive = false;
+        }
+
+        /**
+         * Gets a value indicating whether KLD-sampling is enabled.
+         **/
+        inline bool isAdaptive() const {
+            return adaptive;
+        }
+
+        /**
+         * Sets the maximum number of threads used to propagate particles.
+         * Defaults to the number of hardware threads available.
+         **/
+        void setThreadCount(std::size_t value);
+
+        /**
+         * Gets the maximum number of threads used to propagate particles.
+         **/
+        inline std::size_t getThreadCount() const {
+            return threadCount;
+        }
+
         /**
          * Returns the current state estimate of the observer, including
          * uncertainty.
@@ -102,7 +179,8 @@ namespace PCOE {
         std::vector<UData> getStateEstimate() const override;
 
         /**
-         * Gets the number of particles used by the particle filter.
+         * Gets the number of particles used by the particle filter. When
+         * KLD-sampling is enabled, this may change after each step.
          **/
         inline std::size_t getParticleCount() const {
             return particleCount;
@@ -123,25 +201,100 @@ namespace PCOE {
             return sensorNoiseVariance;
         }
 
+        /**
+         * Selects particles in proportion to their weights.
+         *
+         * @param scheme  The resampling scheme used to select the particles.
+         * @param w       The normalized particle weights.
+         * @param count   The number of particles to select.
+         * @param rng     The random number generator used by the scheme.
+         * @param indices Receives the indices of the selected particles.
+         * @param buffer  Scratch space for cumulative weights. Resized to
+         *                the number of weights if needed.
+         **/
+        static void selectParticles(ResamplingScheme scheme,
+                                    const std::vector<double>& w,
+                                    std::size_t count,
+                                    std::mt19937& rng,
+                                    std::vector<std::size_t>& indices,
+                                    std::vector<double>& buffer);
+
     private:
         std::size_t particleCount;
         std::size_t minEffective;
+        std::size_t threadCount;
+        ResamplingScheme resamplingScheme;
+        bool adaptive;
+        KLDSampling kld;
+        std::set<std::vector<std::int64_t>> kldBins;
+        std::vector<std::size_t> resampleIndices;
         Particles particles;
+        Particles resampled; // back buffer for resampling
         std::vector<double> processNoiseVariance;
         std::vector<double> sensorNoiseVariance;
         Matrix R;
+        Matrix RInvChol; // inverse of the lower Cholesky factor of R
+        double logNormalizer; // log of the Gaussian normalizing constant for R
+        bool sensorCovarianceValid;
+        std::vector<double> likelihoodBuffer;
+        std::vector<double> innovationBuffer; // one whitened row for each particle
         std::mt19937 rng;
+        std::vector<std::mt19937> blockRngs; // one generator per propagation block
+        std::unique_ptr<WorkerPool> workers; // started on the first parallel step
+
+        /**
+         * Normalizes the log weights using log-sum-exp, updates the linear
+         * weights to match, and computes the effective number of particles.
+         * The sums needed for both are accumulated in a single pass over the
+         * log weights.
+         *
+         * @return The effective number of particles, 1/sum(w^2).
+         **/
+        double normalize();
+
+        void resample(double nEffective);
 
-        void normalize();
+        /**
+         * Fills resampleIndices using KLD-sampling.
+         **/
+        void kldResample();
 
-        void resample();
+        /**
+         * Replaces the particles with the particles at resampleIndices, and
+         * resets the weights to be equal. The number of particles becomes the
+         * number of indices.
+         **/
+        void applyResample();
+
+        /**
+         * Sizes the particle buffers for the current particle count.
+         **/
+        void allocateParticles();
 
-        void systematicResample();
+        /**
+         * Propagates the particles in the range [{@code begin}, {@code end})
+         * to time {@code t} and computes their predicted outputs. Distinct
+         * ranges may be propagated concurrently.
+         **/
+        void propagate(double t, double dt, std::size_t begin, std::size_t end, std::mt19937& gen);
 
-        void generateProcessNoise(std::vector<double>& noise);
+        void generateProcessNoise(std::vector<double>& noise, std::mt19937& gen);
 
-        double likelihood(const SystemModel::output_type& zActual, const SystemModel::output_type& zPredicted);
+        /**
+         * Computes the log-likelihood of the actual output given the predicted
+         * output of each particle, and stores the result in {@code result}.
+         *
+         * @remarks
+         * The innovation of each particle is whitened using the precomputed
+         * inverse Cholesky factor of the sensor covariance, so no matrices are
+         * allocated or inverted during the evaluation.
+         **/
+        void logLikelihood(const SystemModel::output_type& zActual, std::vector<double>& result);
 
+        /**
+         * Builds the sensor covariance from the sensor noise variance and
+         * precomputes the quantities needed to evaluate the likelihood.
+         **/
         void setSensorCovariance();
 
         SystemModel::state_type weightedMean(const Matrix& M, const std::vector<double>& weights);
@@ -0,0 +1,154 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#ifndef PCOE_SQUAREROOTUNSCENTEDKALMANFILTER_H
+#define PCOE_SQUAREROOTUNSCENTEDKALMANFILTER_H
+
+#include <vector>
+
+#include "Matrix.h"
+#include "Observers/Observer.h"
+#include "UnscentedTransform.h"
+
+namespace PCOE {
+    class ConfigMap;
+
+    /**
+     * Implements the square-root form of the UKF state estimation algorithm
+     * for non-linear models. Rather than the state covariance, the filter
+     * carries its lower-triangular Cholesky factor S, where P = S * S'. The
+     * factor is updated directly using QR decomposition and rank-one Cholesky
+     * updates and downdates, so the covariance is never refactored and stays
+     * positive definite.
+     *
+     * @since 1.2
+     **/
+    class SquareRootUnscentedKalmanFilter final : public Observer {
+    private:
+        /**
+         * Constructs a new @{code SquareRootUnscentedKalmanFilter} instance
+         * and initializes the model. This constructor is only intended to be
+         * used by other constructors to set up model-related parameters.
+         *
+         * @param m The model on which state estimation will be performed.
+         **/
+        explicit SquareRootUnscentedKalmanFilter(const SystemModel& m);
+
+    public:
+        /**
+         * Constructs a new @{code SquareRootUnscentedKalmanFilter} instance
+         * with the given model and covariance matrices.
+         *
+         * @param m The model on which state estimation will be performed. The
+         *          filter does not take ownership of the model.
+         * @param Q Process noise covariance matrix
+         * @param R Sensor noise covariance matrix
+         **/
+        SquareRootUnscentedKalmanFilter(const SystemModel& m, const Matrix& Q, const Matrix& R);
+
+        /**
+         * Constructs a new @{code SquareRootUnscentedKalmanFilter} instance
+         * with the given model and with covariance matrices read from the
+         * provided config. Uses the same configuration keys as the
+         * @{code UnscentedKalmanFilter}.
+         *
+         * @param m      The model on which state estimation will be performed.
+         *               The filter does not take ownership of the model.
+         * @param config A configuration from which to read covariance matrices.
+         **/
+        SquareRootUnscentedKalmanFilter(const SystemModel& m, const ConfigMap& config);
+
+        /**
+         * Sets the initial model state. The initial state covariance is the
+         * process noise covariance.
+         *
+         * @param t0 Initial time
+         * @param x0 Initial model state
+         * @param u0 Initial model input
+         **/
+        void initialize(double t0,
+                        const SystemModel::state_type& x0,
+                        const SystemModel::input_type& u0) override;
+
+        /**
+         * Performs a single state estimation with the given model inputs and
+         * outputs.
+         *
+         * @param t The time at which to make a prediction.
+         * @param u The model input vector at time @{code t}.
+         * @param z The model output vector at time @{code t}.
+         **/
+        void step(double t, const SystemModel::input_type& u, const SystemModel::output_type& z) override;
+
+        inline void setKappa(double value) {
+            sigmaX.kappa = value;
+        }
+
+        inline void setAlpha(double value) {
+            sigmaX.alpha = value;
+        }
+
+        inline void setBeta(double value) {
+            sigmaX.beta = value;
+        }
+
+        /**
+         * Returns the current state estimate of the observer, including
+         * uncertainty.
+         *
+         * @return The last calculated state estimate calcualted by the
+         *         observer.
+         **/
+        std::vector<UData> getStateEstimate() const override;
+
+        /**
+         * Gets the lower-triangular Cholesky factor S of the state
+         * covariance, where P = S * S'.
+         **/
+        inline const Matrix& getStateCovarianceRoot() const {
+            return S;
+        }
+
+        /**
+         * Computes the state covariance from its Cholesky factor.
+         **/
+        Matrix getStateCovariance() const;
+
+    private:
+        /**
+         * Sets the process and sensor noise covariance, and computes their
+         * Cholesky factors.
+         **/
+        void setNoiseCovariance(const Matrix& Q, const Matrix& R);
+
+        SystemModel::state_type xEstimated;
+        SystemModel::output_type zEstimated;
+        Matrix sqrtQ;
+        Matrix sqrtR;
+        Matrix S;
+        SigmaPoints sigmaX;
+
+        /**
+         * Buffers used by {@code step}, sized once from the model dimensions
+         * so that the filter update does not allocate matrices.
+         **/
+        struct Workspace {
+            SystemModel::state_type x; // single sigma point
+            std::vector<double> zeroNoise; // zero process noise
+            std::vector<double> zeroNoiseZ; // zero sensor noise
+            std::vector<double> xkk1; // predicted state mean
+            std::vector<double> zkk1; // predicted output mean
+            std::vector<double> v; // state update or downdate vector
+            std::vector<double> vz; // output update vector
+            Matrix dX; // predicted state deviations, numStates x sigmaPointCount
+            Matrix dZ; // predicted output deviations, numOutputs x sigmaPointCount
+            Matrix Cx; // compound matrix for the QR of the state covariance
+            Matrix Cz; // compound matrix for the QR of the output covariance
+            Matrix Sz; // Cholesky factor of the output covariance
+            Matrix Pxz; // state-output cross-covariance
+            Matrix Kk; // Kalman gain
+        } ws;
+    };
+}
+
+#endif
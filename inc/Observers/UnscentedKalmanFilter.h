@@ -1,4 +1,4 @@
-// Copyright (c) 2016-2018 United States Government as represented by the
+// Copyright (c) 2016-2019 United States Government as represented by the
 // Administrator of the National Aeronautics and Space Administration.
 // All Rights Reserved.
 #ifndef PCOE_UNSCENTEDKALMANFILTER_H
@@ -9,18 +9,11 @@
 
 #include "Matrix.h"
 #include "Observers/Observer.h"
+#include "UnscentedTransform.h"
 
 namespace PCOE {
     class ConfigMap;
 
-    struct SigmaPoints {
-        Matrix M; // data matrix
-        std::vector<double> w; // weights
-        double kappa; // tuning parameter
-        double alpha; // scaling parameter
-        double beta; // scaling parameter
-    };
-
     /**
      * Implements UKF state estimation algorithm for non-linear models.
      *
@@ -138,6 +131,25 @@ namespace PCOE {
         Matrix R;
         Matrix P;
         struct SigmaPoints sigmaX;
+
+        /**
+         * Buffers used by {@code step}, sized once from the model dimensions
+         * so that the filter update does not allocate matrices.
+         **/
+        struct Workspace {
+            SystemModel::state_type x; // single sigma point
+            std::vector<double> zeroNoise; // zero process noise
+            std::vector<double> zeroNoiseZ; // zero sensor noise
+            std::vector<double> xkk1; // predicted state mean
+            std::vector<double> zkk1; // predicted output mean
+            Matrix dX; // predicted state deviations, numStates x sigmaPointCount
+            Matrix dZ; // predicted output deviations, numOutputs x sigmaPointCount
+            Matrix Pkk1; // predicted state covariance
+            Matrix Pzz; // predicted output covariance
+            Matrix Pxz; // state-output cross-covariance
+            Matrix Lzz; // Cholesky factor of Pzz
+            Matrix Kk; // Kalman gain
+        } ws;
     };
 }
 
@@ -4,6 +4,7 @@
 #ifndef PCOE_PREDICTOR_H
 #define PCOE_PREDICTOR_H
 
+#include <limits>
 #include <string>
 #include <vector>
 
@@ -40,6 +41,19 @@ namespace PCOE {
 	    std::vector<DataPoint> observables;
     };
 
+    /**
+     * Gets the earliest update time of the given state estimate.
+     **/
+    inline UData::time_ticks getLowestTimestamp(const std::vector<UData>& data) {
+        UData::time_ticks result = std::numeric_limits<UData::time_ticks>::max();
+        for (const UData& entry : data) {
+            if (entry.updated() < result) {
+                result = entry.updated();
+            }
+        }
+        return result;
+    }
+
     /**
      * Represents a model-based predictor.
      *
@@ -8,6 +8,7 @@
 #include "MonteCarloPredictor.h"
 #include "Predictor.h"
 #include "Singleton.h"
+#include "UnscentedPredictor.h"
 
 namespace PCOE {
     /**
@@ -33,6 +34,7 @@ namespace PCOE {
          **/
         PredictorFactory() {
             Register<MonteCarloPredictor>("MC");
+            Register<UnscentedPredictor>("UT");
         }
     };
 }
@@ -0,0 +1,63 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#ifndef PCOE_UNSCENTEDPREDICTOR_H
+#define PCOE_UNSCENTEDPREDICTOR_H
+
+#include <string>
+#include <vector>
+
+#include "Predictors/Predictor.h"
+#include "UnscentedTransform.h"
+
+namespace PCOE {
+    /**
+     * A predictor that uses the unscented transform. Rather than simulating a
+     * large number of random samples, the predictor simulates the 2n+1 sigma
+     * points of the state distribution and recombines the results into a
+     * mean and standard deviation for each event and observable.
+     *
+     * @remarks
+     * The unscented transform assumes the state distribution is reasonably
+     * well described by its mean and covariance. Sigma points are propagated
+     * without process noise, so all of the uncertainty in the prediction comes
+     * from the uncertainty in the initial state.
+     *
+     * @since 1.2
+     **/
+    class UnscentedPredictor final : public Predictor {
+    public:
+        /**
+         * Initializes a new @{code UnscentedPredictor}.
+         *
+         * @param m      The model used by the predictor.
+         * @param le     The load estimator used by the predictor.
+         * @param ts     The trajectory service used by the predictor.
+         * @param config Configuration map specifying predictor parameters.
+         **/
+        UnscentedPredictor(const PrognosticsModel& m,
+                           LoadEstimator& le,
+                           const TrajectoryService& ts,
+                           const ConfigMap& config);
+
+        /**
+         * Predict future events and values of system variables
+         *
+         * @remarks
+         * A state without uncertainty, such as a Point state, is predicted
+         * from its value alone, and every result has a standard deviation of
+         * zero.
+         *
+         * @param t     Time of prediction
+         * @param state State of system at time of prediction
+         * @exception std::domain_error If the covariance of the state is
+         *            neither zero nor positive definite.
+         **/
+        Prediction predict(double t, const std::vector<UData>& state) override;
+
+    private:
+        double horizon; // time span of prediction
+        SigmaPoints sigma;
+    };
+}
+#endif
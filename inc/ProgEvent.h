@@ -48,7 +48,7 @@ namespace PCOE {
                   std::string tag = "")
             : eventId(id),
               eventState(std::move(state)),
-              toe(toe),
+              toe(std::move(toe)),
               points(std::move(points)),
               tag(std::move(tag)) {}
 
@@ -76,7 +76,7 @@ namespace PCOE {
         /**
          * Gets the set of state associated with the event.
          **/
-        inline const std::vector<Point4D<MessageClock>> getPoints() const {
+        inline const std::vector<Point4D<MessageClock>>& getPoints() const {
             return points;
         }
 
@@ -0,0 +1,108 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#ifndef PCOE_TELEMETRYCACHE_H
+#define PCOE_TELEMETRYCACHE_H
+#include <string>
+#include <vector>
+
+#include "MappedFile.h"
+#include "MatrixView.h"
+#include "TelemetryReader.h"
+
+namespace PCOE {
+    /**
+     * A binary, column-oriented copy of a telemetry file that can be
+     * memory-mapped and used directly, without parsing.
+     *
+     * @remarks
+     * The cache holds the values of each column contiguously as doubles. The
+     * first column is treated as the timestamp of each row and serves as the
+     * index used by {@code findRow}, so the rows of the original file must be
+     * in timestamp order for {@code findRow} to be meaningful.
+     *
+     * @example @code
+     * TelemetryReader reader("data.csv");
+     * TelemetryCache::create(reader, "data.cache");
+     * TelemetryCache cache("data.cache");
+     * ConstMatrixView voltage = cache.getColumn(3);
+     * @endcode
+     *
+     * @since 1.2
+     **/
+    class TelemetryCache {
+    public:
+        /**
+         * Maps an existing cache file.
+         *
+         * @exception FormatError If the file is not a telemetry cache or is
+         *            truncated.
+         **/
+        explicit TelemetryCache(const std::string& filename);
+
+        /**
+         * Writes a cache file holding all of the rows of a telemetry file. The
+         * reader is rewound before and after the rows are read. Rows are
+         * converted in blocks, so memory use does not depend on the size of
+         * the file.
+         *
+         * @param reader   The reader for the telemetry file.
+         * @param filename The name of the cache file to write.
+         **/
+        static void create(TelemetryReader& reader, const std::string& filename);
+
+        /**
+         * Gets the names of the columns in the cache.
+         **/
+        inline const std::vector<std::string>& getColumnNames() const {
+            return columns;
+        }
+
+        /**
+         * Gets the number of columns in the cache.
+         **/
+        inline std::size_t columnCount() const {
+            return columns.size();
+        }
+
+        /**
+         * Gets the number of rows in the cache.
+         **/
+        inline std::size_t rowCount() const {
+            return rows;
+        }
+
+        /**
+         * Gets a view of all of the values in a column, directly in the
+         * mapped file.
+         *
+         * @returns An n by 1 view, where n is the number of rows.
+         * @exception std::out_of_range If the column does not exist.
+         **/
+        ConstMatrixView getColumn(std::size_t column) const;
+
+        /**
+         * Reads the values of a row.
+         *
+         * @param row    The row to read.
+         * @param result Receives the values. The vector is resized to the
+         *               number of columns.
+         * @exception std::out_of_range If the row does not exist.
+         **/
+        void getRow(std::size_t row, std::vector<double>& result) const;
+
+        /**
+         * Finds the first row with a timestamp at or after {@p time}, or the
+         * number of rows if there is none.
+         **/
+        std::size_t findRow(double time) const;
+
+    private:
+        MappedFile file;
+        std::vector<std::string> columns;
+        std::size_t rows;
+        const double* values;
+    };
+}
+
+#endif
@@ -0,0 +1,92 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#ifndef PCOE_TELEMETRYREADER_H
+#define PCOE_TELEMETRYREADER_H
+#include <string>
+#include <vector>
+
+#include "MappedFile.h"
+
+namespace PCOE {
+    /**
+     * Reads rows of numbers from a delimited telemetry file, such as a CSV
+     * file, with a header line naming the columns.
+     *
+     * @remarks
+     * The file is memory-mapped and parsed in place. Rows are parsed directly
+     * into a caller-provided vector, so reading a file does not allocate once
+     * the vector has grown to the number of columns.
+     *
+     * @remarks
+     * Blank lines are skipped. Empty fields and fields missing from the end
+     * of a row are read as NaN, and fields past the last column are ignored.
+     * Text following a number in a field, such as units, is ignored.
+     *
+     * @example @code
+     * TelemetryReader reader("data.csv");
+     * std::vector<double> row;
+     * while (reader.next(row)) {
+     *     double time = row[0];
+     * }
+     * @endcode
+     *
+     * @since 1.2
+     **/
+    class TelemetryReader {
+    public:
+        /**
+         * Opens a telemetry file and reads its header.
+         *
+         * @param filename  The name of the file to read.
+         * @param delimiter The character that separates fields in a row.
+         * @exception FormatError If the file does not have a header.
+         **/
+        explicit TelemetryReader(const std::string& filename, char delimiter = ',');
+
+        /**
+         * Gets the names of the columns listed in the header, with leading and
+         * trailing whitespace removed.
+         **/
+        inline const std::vector<std::string>& getColumnNames() const {
+            return columns;
+        }
+
+        /**
+         * Gets the number of columns listed in the header.
+         **/
+        inline std::size_t columnCount() const {
+            return columns.size();
+        }
+
+        /**
+         * Reads the next row of the file.
+         *
+         * @param row Receives the values of the row. The vector is resized to
+         *            the number of columns.
+         * @returns   {@code false} if there are no more rows in the file.
+         * @exception FormatError If a field does not start with a number.
+         **/
+        bool next(std::vector<double>& row);
+
+        /**
+         * Moves back to the first row of the file.
+         **/
+        void rewind();
+
+        /**
+         * Counts the rows in the file, without parsing them.
+         **/
+        std::size_t countRows() const;
+
+    private:
+        MappedFile file;
+        char delimiter;
+        const char* begin;
+        const char* position;
+        const char* end;
+        std::vector<std::string> columns;
+    };
+}
+
+#endif
@@ -24,7 +24,9 @@
 #include <cmath>
 #include <vector>
 
-#include "UDataInterfaces.h" // The interfaces
+#include "MatrixView.h"
+#include "MonotonicArena.h"
+#include "UDataInterfaces.h" // Key identifiers
 
 using namespace PCOE;
 
@@ -47,6 +49,18 @@ namespace PCOE {
         UnweightedSamples = Samples,
     };
 
+    /** @enum       SampleLayout
+     *  @brief      The order in which weighted samples are stored. The keys
+     *              used to access samples and weights are the same for both
+     *              layouts.
+     */
+    enum class SampleLayout {
+        /** Each sample is followed by its weight. */
+        Interleaved,
+        /** All of the samples are followed by all of the weights. */
+        Columnar,
+    };
+
     /** @enum       DIST
      *  @brief      Distribution Type
      */
@@ -78,14 +92,17 @@ namespace PCOE {
         using time_point = clock::time_point;
         using time_ticks = time_point::rep;
 
-        using difference_type = std::vector<double>::difference_type;
+        using allocator_type = ArenaAllocator<double>;
+        using storage_type = std::vector<double, allocator_type>;
 
-        using size_type = std::vector<double>::size_type;
+        using difference_type = storage_type::difference_type;
+
+        using size_type = storage_type::size_type;
 
         class iterator;
-        using const_iterator = std::vector<double>::const_iterator;
-        using reverse_iterator = std::vector<double>::reverse_iterator;
-        using const_reverse_iterator = std::vector<double>::const_reverse_iterator;
+        using const_iterator = storage_type::const_iterator;
+        using reverse_iterator = storage_type::reverse_iterator;
+        using const_reverse_iterator = storage_type::const_reverse_iterator;
 
         //*------------------------------*
         //|        Constructors          |
@@ -103,6 +120,18 @@ namespace PCOE {
          **/
         explicit UData(const UType uType);
 
+        /** @brief Constructs a new instance of UData using the specified
+         *         uncertainty type, whose data is allocated by the given
+         *         allocator.
+         *
+         *  @remarks Copies of the new object allocate their data from the
+         *           heap, while moving it keeps the original allocator.
+         *
+         *  @param uType     The uncertainty type to use.
+         *  @param allocator The allocator used for the data.
+         **/
+        UData(const UType uType, const allocator_type& allocator);
+
         /**
          * Constructs a new instance of UData with the UType::Point type and the
          * given value.
@@ -122,14 +151,17 @@ namespace PCOE {
          *
          *  @param other The UData object to copy.
          **/
-        UData(const UData& other);
+        UData(const UData& other) = default;
 
         /** @brief Constructs a new instance of UData by taking the data of the
          *         given UData object.
          *
+         *  @remarks After the move, @p other has no data and may only be
+         *           assigned to or destroyed.
+         *
          *  @param other The UData object to take data from.
          **/
-        UData(UData&& other);
+        UData(UData&& other) noexcept = default;
 
         /** @brief Copies the data of another UData object, overwriting the
          *         current UData object.
@@ -140,7 +172,7 @@ namespace PCOE {
         UData& operator=(UData other);
 
         /** @brief Releases resources used by the current UData object. */
-        ~UData();
+        ~UData() = default;
 
         /** @brief Swaps the data contained by two UData objects.
          *
@@ -179,7 +211,7 @@ namespace PCOE {
         }
 
         /** @brief Gets the distribution type of the current object. */
-        inline DIST_TYPE dist() {
+        inline DIST_TYPE dist() const {
             return m_dist;
         }
 
@@ -192,10 +224,15 @@ namespace PCOE {
         }
 
         /** @brief Gets the size of the data vector. */
-        inline std::vector<double>::size_type size() const {
+        inline size_type size() const {
             return m_data.size();
         }
 
+        /** @brief Gets the allocator used for the data. */
+        inline allocator_type allocator() const {
+            return m_data.get_allocator();
+        }
+
         /** @brief Set the type of uncertainty to be used. */
         void uncertainty(const UType value);
 
@@ -204,6 +241,55 @@ namespace PCOE {
             return m_uncertainty;
         }
 
+        /** @brief Sets the layout used to store weighted samples. Existing
+         *         data is reordered to the new layout.
+         *
+         *  @remarks The layout only affects the order of the data vector,
+         *           which is visible through iterators. Keys such as
+         *           SAMPLE(n) and WEIGHT(n) refer to the same values in
+         *           either layout.
+         */
+        void layout(const SampleLayout value);
+
+        /** @brief Gets the layout used to store weighted samples. */
+        inline SampleLayout layout() const {
+            return m_layout;
+        }
+
+        /** @brief Gets a view of the sample values of a Samples or WSamples
+         *         object, without copying them. With the columnar layout,
+         *         the samples are contiguous.
+         *
+         *  @returns An npoints by 1 view of the samples.
+         *  @exception std::domain_error If the object does not contain
+         *             samples.
+         */
+        ConstMatrixView samples() const;
+
+        /** @brief Gets a mutable view of the sample values, and marks the
+         *         current object as valid and updated.
+         *
+         *  @copydetails samples() const
+         */
+        MatrixView samples();
+
+        /** @brief Gets a view of the weights of a WSamples object, without
+         *         copying them. With the columnar layout, the weights are
+         *         contiguous.
+         *
+         *  @returns An npoints by 1 view of the weights.
+         *  @exception std::domain_error If the object does not contain
+         *             weighted samples.
+         */
+        ConstMatrixView weights() const;
+
+        /** @brief Gets a mutable view of the weights, and marks the current
+         *         object as valid and updated.
+         *
+         *  @copydetails weights() const
+         */
+        MatrixView weights();
+
         /**
          * @brief Gets the time that the current object was last updated.
          */
@@ -228,7 +314,7 @@ namespace PCOE {
 
         /** @brief Gets the validity of the current object. */
         inline bool valid() const {
-            return m_valid && !std::isnan(m_interface->get(0, m_data));
+            return m_valid && !m_data.empty() && !std::isnan(m_data[0]);
         }
 
         /** @brief Gets the validity of the current object. */
@@ -343,7 +429,7 @@ namespace PCOE {
          *  @returns   The requested data element.
          **/
         inline double get(const size_type key = 0) const {
-            return m_interface->get(key, m_data);
+            return m_data.at(storageIndex(key));
         }
 
         /** @brief Set a value in the current object's data.
@@ -476,14 +562,45 @@ namespace PCOE {
         }
 
     private:
+        /** @brief Determines whether the data is stored in the columnar
+         *         weighted sample layout. */
+        inline bool columnar() const {
+            return m_layout == SampleLayout::Columnar && m_uncertainty == UType::WSamples;
+        }
+
+        /** @brief Gets the position in the data vector of the given key.
+         *         Keys that are out of range are returned unchanged. */
+        inline size_type storageIndex(const size_type key) const {
+            if (!columnar() || key >= m_data.size()) {
+                return key;
+            }
+            return key % 2 == 0 ? key / 2 : m_npoints + key / 2;
+        }
+
+        /** @brief Gets the key of the given position in the data vector. */
+        inline size_type keyAt(const size_type position) const {
+            if (!columnar()) {
+                return position;
+            }
+            return position < m_npoints ? SAMPLE(position) : WEIGHT(position - m_npoints);
+        }
+
+        /** @brief Marks the current object as valid and updated now. */
+        void touch();
+
         //*------------------------------*
         //|             Data             |
         //*------------------------------*
-        std::vector<double> m_data;
+        // The layout of m_data for each uncertainty type is described by the
+        // key identifiers in UDataInterfaces.h, except for columnar weighted
+        // samples, whose keys are translated by storageIndex. Behavior that
+        // depends on the type is dispatched on m_uncertainty, so copying a
+        // UData only copies m_data.
+        storage_type m_data;
         DIST_TYPE m_dist;
-        UDataInterface* m_interface;
         size_type m_npoints;
         UType m_uncertainty;
+        SampleLayout m_layout;
         time_ticks m_updated;
         bool m_valid;
 
@@ -536,10 +653,11 @@ namespace PCOE {
             friend class UData;
 
         public:
-            using difference_type = std::vector<double>::iterator::difference_type;
+            using difference_type = storage_type::iterator::difference_type;
 
             inline Proxy operator*() {
-                return Proxy(source, static_cast<size_type>(base - source->m_data.begin()));
+                return Proxy(source,
+                             source->keyAt(static_cast<size_type>(base - source->m_data.begin())));
             }
 
             inline iterator& operator++() {
@@ -623,10 +741,10 @@ namespace PCOE {
             }
 
         private:
-            iterator(UData* s, std::vector<double>::iterator b) : source(s), base(b) {}
+            iterator(UData* s, storage_type::iterator b) : source(s), base(b) {}
 
             UData* source;
-            std::vector<double>::iterator base;
+            storage_type::iterator base;
         };
     };
 }
@@ -0,0 +1,109 @@
+// Copyright (c) 2016-2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#ifndef PCOE_UNSCENTEDTRANSFORM_H
+#define PCOE_UNSCENTEDTRANSFORM_H
+
+#include <cstddef>
+#include <vector>
+
+#include "Matrix.h"
+
+namespace PCOE {
+    /**
+     * A set of sigma points and their associated weights, together with the
+     * tuning parameters used to generate them.
+     **/
+    struct SigmaPoints {
+        Matrix M; // data matrix
+        std::vector<double> w; // weights
+        Matrix sqrtP; // scratch space for the matrix square root
+        double kappa; // tuning parameter
+        double alpha; // scaling parameter
+        double beta; // scaling parameter
+    };
+
+    /**
+     * Sizes the sigma point matrix and weight vector for a symmetric unscented
+     * transform of a state of size {@p n} (2n+1 points), and sets the default
+     * tuning parameters.
+     *
+     * @param n     The size of the state vector.
+     * @param sigma The sigma points to set up.
+     **/
+    void initSigmaPoints(std::size_t n, SigmaPoints& sigma);
+
+    /**
+     * Compute sigma points given mean vector and covariance matrix.
+     * Implements symmetric unscented transform.
+     *
+     * @remarks
+     * The sigma points must already be sized for the state vector, as done by
+     * {@code initSigmaPoints}. No memory is allocated.
+     *
+     * @param mx    Mean vector
+     * @param Pxx   Covariance matrix
+     * @param sigma Sigma points
+     **/
+    void computeSigmaPoints(const std::vector<double>& mx, const Matrix& Pxx, SigmaPoints& sigma);
+
+    /**
+     * Compute sigma points given a mean vector of {@p n} elements stored at
+     * {@p mx} and a covariance matrix. Used by filters whose state is not a
+     * {@code std::vector}, so the mean does not have to be copied.
+     *
+     * @param mx    Mean vector
+     * @param n     The number of elements in the mean vector
+     * @param Pxx   Covariance matrix
+     * @param sigma Sigma points
+     **/
+    void computeSigmaPoints(const double* mx, std::size_t n, const Matrix& Pxx, SigmaPoints& sigma);
+
+    /**
+     * Compute sigma points given mean vector and a lower-triangular square
+     * root of the covariance matrix, such that Pxx = sqrtPxx * sqrtPxx'.
+     *
+     * @param mx      Mean vector
+     * @param sqrtPxx Square root of the covariance matrix
+     * @param sigma   Sigma points
+     **/
+    void computeSigmaPointsFromRoot(const std::vector<double>& mx,
+                                    const Matrix& sqrtPxx,
+                                    SigmaPoints& sigma);
+
+    /**
+     * Compute sigma points given a mean vector of {@p n} elements stored at
+     * {@p mx} and a lower-triangular square root of the covariance matrix.
+     *
+     * @param mx      Mean vector
+     * @param n       The number of elements in the mean vector
+     * @param sqrtPxx Square root of the covariance matrix
+     * @param sigma   Sigma points
+     **/
+    void computeSigmaPointsFromRoot(const double* mx,
+                                    std::size_t n,
+                                    const Matrix& sqrtPxx,
+                                    SigmaPoints& sigma);
+
+    /**
+     * Computes the sigma point weights from the tuning parameters, without
+     * computing the sigma points themselves.
+     *
+     * @param n     The size of the state vector.
+     * @param sigma The sigma points whose weights are set.
+     **/
+    void computeSigmaPointWeights(std::size_t n, SigmaPoints& sigma);
+
+    /**
+     * Computes the weighted variance of a scalar function of the sigma points,
+     * including the alpha/beta correction applied to the central point.
+     *
+     * @param y     The value of the function at each sigma point.
+     * @param sigma The sigma points from which {@p y} was computed.
+     * @param mean  The weighted mean of {@p y}.
+     * @return      The weighted variance of {@p y}.
+     **/
+    double sigmaPointVariance(const std::vector<double>& y, const SigmaPoints& sigma, double mean);
+}
+
+#endif
@@ -0,0 +1,85 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#ifndef PCOE_WORKERPOOL_H
+#define PCOE_WORKERPOOL_H
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace PCOE {
+    /**
+     * A fixed set of worker threads that repeatedly run batches of indexed
+     * tasks.
+     *
+     * @remarks
+     * The threads are started when the pool is constructed and joined when it
+     * is destroyed, so code that splits work into a few tasks on every step
+     * does not pay to create and join threads each time. A pool runs one
+     * batch at a time; {@code run} is not reentrant.
+     *
+     * @since 1.2
+     **/
+    class WorkerPool {
+    public:
+        using task_type = std::function<void(std::size_t)>;
+
+        /**
+         * Starts the worker threads.
+         *
+         * @param threadCount The number of worker threads. Batches of up to
+         *                    {@code threadCount + 1} tasks run in parallel,
+         *                    since the calling thread runs the first task.
+         **/
+        explicit WorkerPool(std::size_t threadCount);
+
+        WorkerPool(const WorkerPool&) = delete;
+
+        WorkerPool& operator=(const WorkerPool&) = delete;
+
+        /**
+         * Stops and joins the worker threads.
+         **/
+        ~WorkerPool();
+
+        /**
+         * Gets the number of worker threads.
+         **/
+        inline std::size_t size() const {
+            return threads.size();
+        }
+
+        /**
+         * Calls {@code task(i)} for each i in [0, {@code count}) and waits for
+         * all of the calls to complete. Index 0 runs on the calling thread,
+         * and each other index runs on its own worker thread.
+         *
+         * @param count The number of tasks, which must be no more than one
+         *              greater than the number of worker threads.
+         * @param task  The task to run.
+         * @exception   If any of the tasks throws, the first exception caught
+         *              is rethrown after all of the tasks complete.
+         **/
+        void run(std::size_t count, const task_type& task);
+
+    private:
+        void work(std::size_t index);
+
+        std::vector<std::thread> threads;
+        std::mutex mutex;
+        std::condition_variable ready;
+        std::condition_variable done;
+        const task_type* task;
+        std::size_t taskCount;
+        std::size_t pending;
+        std::size_t generation;
+        bool stopping;
+        std::exception_ptr error;
+    };
+}
+
+#endif
@@ -0,0 +1,72 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#include <stdexcept>
+
+#include "AliasTable.h"
+
+namespace PCOE {
+    AliasTable::AliasTable(const ConstMatrixView& weights) {
+        build(weights);
+    }
+
+    void AliasTable::build(const ConstMatrixView& weights) {
+        const std::size_t n = weights.size();
+        if (n == 0) {
+            throw std::domain_error("No weights");
+        }
+
+        double sum = 0.0;
+        for (std::size_t i = 0; i < n; i++) {
+            if (weights[i] < 0.0) {
+                throw std::domain_error("Negative weight");
+            }
+            sum += weights[i];
+        }
+        if (!(sum > 0.0)) {
+            throw std::domain_error("Weights sum to zero");
+        }
+
+        probability.resize(n);
+        alias.resize(n);
+        scaled.resize(n);
+        small.clear();
+        large.clear();
+
+        // Scale the weights so that their mean is one, then pair each slot
+        // whose weight is less than one with a slot whose weight is at least
+        // one, which donates the remainder of the slot to it.
+        const double scale = static_cast<double>(n) / sum;
+        for (std::size_t i = 0; i < n; i++) {
+            scaled[i] = weights[i] * scale;
+            if (scaled[i] < 1.0) {
+                small.push_back(i);
+            }
+            else {
+                large.push_back(i);
+            }
+        }
+        while (!small.empty() && !large.empty()) {
+            std::size_t s = small.back();
+            small.pop_back();
+            std::size_t l = large.back();
+            probability[s] = scaled[s];
+            alias[s] = l;
+            scaled[l] = (scaled[l] + scaled[s]) - 1.0;
+            if (scaled[l] < 1.0) {
+                large.pop_back();
+                small.push_back(l);
+            }
+        }
+
+        // Whatever remains is one up to rounding error
+        for (std::size_t i : large) {
+            probability[i] = 1.0;
+            alias[i] = i;
+        }
+        for (std::size_t i : small) {
+            probability[i] = 1.0;
+            alias[i] = i;
+        }
+    }
+}
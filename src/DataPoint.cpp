@@ -27,15 +27,22 @@ namespace PCOE {
     // |     Public Functions   |
     // *------------------------*
 
-    DataPoint::DataPoint() : uType(UType::Point),
+    DataPoint::DataPoint() : DataPoint(UData::allocator_type()) {}
+
+    DataPoint::DataPoint(const UData::allocator_type& allocator) : uType(UType::Point),
         nPoints(0) {
-        setNumTimes(0);  // Default = 1 timestep (NOW)
+        data.emplace_back(uType, allocator);  // Default = 1 timestep (NOW)
+        data.front().npoints(nPoints);
     }
 
     UData& DataPoint::operator[](const std::size_t index) {
         return data.at(index);
     }
 
+    const UData& DataPoint::operator[](const std::size_t index) const {
+        return data.at(index);
+    }
+
     void DataPoint::setUncertainty(const UType uncertType) {
         uType = uncertType;
         for (auto & it : data) {
@@ -48,7 +55,17 @@ namespace PCOE {
     }
 
     void DataPoint::setNumTimes(const unsigned int nTimesIn) {
-        data.resize(nTimesIn + 1, UData(uType));
+        // New timestamps use the allocator of the first, so that a data
+        // point built in an arena stays in it
+        UData::allocator_type allocator;
+        if (!data.empty()) {
+            allocator = data.front().allocator();
+        }
+        data.reserve(nTimesIn + 1);
+        while (data.size() < nTimesIn + 1) {
+            data.emplace_back(uType, allocator);
+        }
+        data.erase(data.begin() + nTimesIn + 1, data.end());
         for (auto & it : data) {
             it.npoints(nPoints);
         }
@@ -0,0 +1,98 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#include <cerrno>
+#include <system_error>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "MappedFile.h"
+
+namespace PCOE {
+#ifdef _WIN32
+    MappedFile::MappedFile(const std::string& filename) : mapping(nullptr), length(0) {
+        HANDLE file = CreateFileA(filename.c_str(),
+                                  GENERIC_READ,
+                                  FILE_SHARE_READ,
+                                  nullptr,
+                                  OPEN_EXISTING,
+                                  FILE_FLAG_SEQUENTIAL_SCAN,
+                                  nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            throw std::system_error(GetLastError(), std::system_category(), "CreateFile");
+        }
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size)) {
+            DWORD error = GetLastError();
+            CloseHandle(file);
+            throw std::system_error(error, std::system_category(), "GetFileSizeEx");
+        }
+        length = static_cast<std::size_t>(size.QuadPart);
+        if (length == 0) {
+            CloseHandle(file);
+            return;
+        }
+
+        HANDLE section = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        DWORD error = GetLastError();
+        CloseHandle(file);
+        if (section == nullptr) {
+            throw std::system_error(error, std::system_category(), "CreateFileMapping");
+        }
+        void* view = MapViewOfFile(section, FILE_MAP_READ, 0, 0, 0);
+        error = GetLastError();
+        CloseHandle(section);
+        if (view == nullptr) {
+            throw std::system_error(error, std::system_category(), "MapViewOfFile");
+        }
+        mapping = static_cast<const char*>(view);
+    }
+
+    MappedFile::~MappedFile() {
+        if (mapping != nullptr) {
+            UnmapViewOfFile(mapping);
+        }
+    }
+#else
+    MappedFile::MappedFile(const std::string& filename) : mapping(nullptr), length(0) {
+        int fd = open(filename.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "open");
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            int error = errno;
+            close(fd);
+            throw std::system_error(error, std::generic_category(), "fstat");
+        }
+        length = static_cast<std::size_t>(info.st_size);
+        if (length == 0) {
+            close(fd);
+            return;
+        }
+
+        void* result = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        int error = errno;
+        close(fd);
+        if (result == MAP_FAILED) {
+            throw std::system_error(error, std::generic_category(), "mmap");
+        }
+        mapping = static_cast<const char*>(result);
+    }
+
+    MappedFile::~MappedFile() {
+        if (mapping != nullptr) {
+            munmap(const_cast<char*>(mapping), length);
+        }
+    }
+#endif
+}
@@ -10,8 +10,171 @@
 #include <stdexcept>
 
 #include "Contracts.h"
+#include "MatrixDecomposition.h"
 
 namespace PCOE {
+    /***********************************************************************/
+    /* Multiplication kernels                                              */
+    /***********************************************************************/
+    // The kernels below work on raw row-major arrays. Each one keeps its
+    // innermost loop running along a contiguous row so that the compiler can
+    // vectorize it, and updates several rows of the result at once so that each
+    // element loaded from the right hand side is reused from a register. The
+    // sum for each element is accumulated in the same order as the naive triple
+    // loop, so the results are unchanged.
+    static const std::size_t TILE_ROWS = 4;
+    static const std::size_t BLOCK_COLS = 256;
+    static const std::size_t BLOCK_DEPTH = 128;
+    static const std::size_t TRANSPOSE_BLOCK = 16;
+
+    /**
+     * Computes c = a * b, where a is m x k and b is k x n. The right hand side
+     * is processed in blocks of columns and rows small enough to stay in
+     * cache while every row of a is passed over it.
+     **/
+    static void gemm(const double* a,
+                     const double* b,
+                     double* c,
+                     std::size_t m,
+                     std::size_t k,
+                     std::size_t n) {
+        std::fill(c, c + m * n, 0.0);
+        for (std::size_t j0 = 0; j0 < n; j0 += BLOCK_COLS) {
+            const std::size_t width = std::min(n - j0, BLOCK_COLS);
+            for (std::size_t p0 = 0; p0 < k; p0 += BLOCK_DEPTH) {
+                const std::size_t p1 = std::min(k, p0 + BLOCK_DEPTH);
+                std::size_t i = 0;
+                for (; i + TILE_ROWS <= m; i += TILE_ROWS) {
+                    const double* a0 = a + i * k;
+                    const double* a1 = a0 + k;
+                    const double* a2 = a1 + k;
+                    const double* a3 = a2 + k;
+                    double* c0 = c + i * n + j0;
+                    double* c1 = c0 + n;
+                    double* c2 = c1 + n;
+                    double* c3 = c2 + n;
+                    for (std::size_t p = p0; p < p1; p++) {
+                        const double* bp = b + p * n + j0;
+                        const double x0 = a0[p];
+                        const double x1 = a1[p];
+                        const double x2 = a2[p];
+                        const double x3 = a3[p];
+                        for (std::size_t j = 0; j < width; j++) {
+                            const double bj = bp[j];
+                            c0[j] += x0 * bj;
+                            c1[j] += x1 * bj;
+                            c2[j] += x2 * bj;
+                            c3[j] += x3 * bj;
+                        }
+                    }
+                }
+                for (; i < m; i++) {
+                    const double* ai = a + i * k;
+                    double* ci = c + i * n + j0;
+                    for (std::size_t p = p0; p < p1; p++) {
+                        const double* bp = b + p * n + j0;
+                        const double x = ai[p];
+                        for (std::size_t j = 0; j < width; j++) {
+                            ci[j] += x * bp[j];
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * Computes c = a * b', where a is m x k and b is n x k. Every element of
+     * the result is the dot product of two contiguous rows, and each row of
+     * a is reused for several rows of b at once.
+     **/
+    static void gemmTransposed(const double* a,
+                               const double* b,
+                               double* c,
+                               std::size_t m,
+                               std::size_t k,
+                               std::size_t n) {
+        for (std::size_t i = 0; i < m; i++) {
+            const double* ai = a + i * k;
+            double* ci = c + i * n;
+            std::size_t j = 0;
+            for (; j + TILE_ROWS <= n; j += TILE_ROWS) {
+                const double* b0 = b + j * k;
+                const double* b1 = b0 + k;
+                const double* b2 = b1 + k;
+                const double* b3 = b2 + k;
+                double s0 = 0.0;
+                double s1 = 0.0;
+                double s2 = 0.0;
+                double s3 = 0.0;
+                for (std::size_t p = 0; p < k; p++) {
+                    const double x = ai[p];
+                    s0 += x * b0[p];
+                    s1 += x * b1[p];
+                    s2 += x * b2[p];
+                    s3 += x * b3[p];
+                }
+                ci[j] = s0;
+                ci[j + 1] = s1;
+                ci[j + 2] = s2;
+                ci[j + 3] = s3;
+            }
+            for (; j < n; j++) {
+                const double* bj = b + j * k;
+                double sum = 0.0;
+                for (std::size_t p = 0; p < k; p++) {
+                    sum += ai[p] * bj[p];
+                }
+                ci[j] = sum;
+            }
+        }
+    }
+
+    /**
+     * Computes c = a' * b, where a is k x m and b is k x n, as a sequence of
+     * rank one updates with the rows of a and b.
+     **/
+    static void gemmTransposeLeft(const double* a,
+                                  const double* b,
+                                  double* c,
+                                  std::size_t m,
+                                  std::size_t k,
+                                  std::size_t n) {
+        std::fill(c, c + m * n, 0.0);
+        for (std::size_t j0 = 0; j0 < n; j0 += BLOCK_COLS) {
+            const std::size_t width = std::min(n - j0, BLOCK_COLS);
+            for (std::size_t p = 0; p < k; p++) {
+                const double* ap = a + p * m;
+                const double* bp = b + p * n + j0;
+                std::size_t i = 0;
+                for (; i + TILE_ROWS <= m; i += TILE_ROWS) {
+                    double* c0 = c + i * n + j0;
+                    double* c1 = c0 + n;
+                    double* c2 = c1 + n;
+                    double* c3 = c2 + n;
+                    const double x0 = ap[i];
+                    const double x1 = ap[i + 1];
+                    const double x2 = ap[i + 2];
+                    const double x3 = ap[i + 3];
+                    for (std::size_t j = 0; j < width; j++) {
+                        const double bj = bp[j];
+                        c0[j] += x0 * bj;
+                        c1[j] += x1 * bj;
+                        c2[j] += x2 * bj;
+                        c3[j] += x3 * bj;
+                    }
+                }
+                for (; i < m; i++) {
+                    double* ci = c + i * n + j0;
+                    const double x = ap[i];
+                    for (std::size_t j = 0; j < width; j++) {
+                        ci[j] += x * bp[j];
+                    }
+                }
+            }
+        }
+    }
+
     /***********************************************************************/
     /* Constructors, Destructor and Assignment Operator                    */
     /***********************************************************************/
@@ -226,14 +389,7 @@ namespace PCOE {
     }
 
     Matrix Matrix::col(std::size_t n) const {
-        if (n >= N) {
-            throw std::out_of_range("n out of range.");
-        }
-        Matrix r(M, 1);
-        for (std::size_t i = 0; i < M; ++i) {
-            r[i][0] = (*this)[i][n];
-        }
-        return r;
+        return Matrix(colView(n));
     }
 
     void Matrix::col(std::size_t n, const Matrix& value) {
@@ -264,14 +420,7 @@ namespace PCOE {
     }
 
     Matrix Matrix::row(std::size_t m) const {
-        if (m >= M) {
-            throw std::out_of_range("m out of range.");
-        }
-        Matrix r(1, N);
-        for (std::size_t i = 0; i < N; ++i) {
-            r[0][i] = (*this)[m][i];
-        }
-        return r;
+        return Matrix(rowView(m));
     }
 
     void Matrix::row(std::size_t m, const Matrix& value) {
@@ -301,6 +450,50 @@ namespace PCOE {
         }
     }
 
+    MatrixView Matrix::colView(std::size_t n) {
+        if (n >= N) {
+            throw std::out_of_range("n out of range.");
+        }
+        return MatrixView(data + n, M, 1, N);
+    }
+
+    ConstMatrixView Matrix::colView(std::size_t n) const {
+        if (n >= N) {
+            throw std::out_of_range("n out of range.");
+        }
+        return ConstMatrixView(data + n, M, 1, N);
+    }
+
+    MatrixView Matrix::rowView(std::size_t m) {
+        if (m >= M) {
+            throw std::out_of_range("m out of range.");
+        }
+        return MatrixView(data + m * N, 1, N, N);
+    }
+
+    ConstMatrixView Matrix::rowView(std::size_t m) const {
+        if (m >= M) {
+            throw std::out_of_range("m out of range.");
+        }
+        return ConstMatrixView(data + m * N, 1, N, N);
+    }
+
+    MatrixView
+    Matrix::blockView(std::size_t m0, std::size_t n0, std::size_t rows, std::size_t cols) {
+        if (m0 > M || rows > M - m0 || n0 > N || cols > N - n0) {
+            throw std::out_of_range("Block out of range.");
+        }
+        return MatrixView(data + m0 * N + n0, rows, cols, N);
+    }
+
+    ConstMatrixView
+    Matrix::blockView(std::size_t m0, std::size_t n0, std::size_t rows, std::size_t cols) const {
+        if (m0 > M || rows > M - m0 || n0 > N || cols > N - n0) {
+            throw std::out_of_range("Block out of range.");
+        }
+        return ConstMatrixView(data + m0 * N + n0, rows, cols, N);
+    }
+
     Matrix::operator std::vector<double>() const {
         if (M != 1 && N != 1) {
             throw std::domain_error("Matrix is not a vector.");
@@ -326,14 +519,6 @@ namespace PCOE {
     /***********************************************************************/
     /* Arithmetic operators                                                */
     /***********************************************************************/
-    Matrix Matrix::operator-() {
-        Matrix result = *this;
-        for (std::size_t i = 0; i < M * N; i++) {
-            result.data[i] = -result.data[i];
-        }
-        return result;
-    }
-
     Matrix& Matrix::operator+=(const Matrix& rhs) {
         if (M != rhs.M || N != rhs.N) {
             throw std::domain_error("Matrices are different sizes.");
@@ -373,16 +558,31 @@ namespace PCOE {
             throw std::domain_error("Matrices are compatible.");
         }
         Matrix r(M, rhs.N);
+        gemm(data, rhs.data, r.data, M, N, rhs.N);
+        return r;
+    }
+
+    Matrix Matrix::multiplyTransposed(const Matrix& rhs) const {
+        Matrix r(M, rhs.M);
+        multiplyTransposed(*this, rhs, r);
+        return r;
+    }
+
+    Matrix Matrix::transposeMultiply(const Matrix& rhs) const {
+        Matrix r(N, rhs.N);
+        transposeMultiply(*this, rhs, r);
+        return r;
+    }
+
+    void Matrix::multiplyAdd(const double* x, double* y, double alpha) const {
         for (std::size_t i = 0; i < M; i++) {
-            for (std::size_t j = 0; j < rhs.N; j++) {
-                double e = 0;
-                for (std::size_t k = 0; k < N; k++) {
-                    e += ((*this)[i][k] * rhs[k][j]);
-                }
-                r[i][j] = e;
+            const double* row = data + i * N;
+            double sum = 0.0;
+            for (std::size_t j = 0; j < N; j++) {
+                sum += row[j] * x[j];
             }
+            y[i] += alpha * sum;
         }
-        return r;
     }
 
     Matrix& Matrix::operator*=(double rhs) {
@@ -441,6 +641,20 @@ namespace PCOE {
         return r;
     }
 
+    void Matrix::chol(Matrix& result) const {
+        if (M != N) {
+            throw std::domain_error("Matrix must be square");
+        }
+        if (result.M != M || result.N != N) {
+            throw std::domain_error("Result matrix is not the same size");
+        }
+
+        std::fill(result.data, result.data + M * N, 0.0);
+        if (!cholInternal(result)) {
+            throw std::domain_error("Matrix is not positive definite");
+        }
+    }
+
     double Matrix::cofactor(std::size_t i, std::size_t j) const {
         return minor(i, j) * std::pow(-1, i + j + 2);
     }
@@ -459,24 +673,7 @@ namespace PCOE {
         if (M != N) {
             throw std::domain_error("Matrix must be square");
         }
-
-        // Try to do a crout decomposition. If the decomposition isn't possible,
-        // fall back to laplace expansion to calculate the determinant.
-        double r = 1;
-        Matrix A(M, N);
-        // if (cholInternal(A)) {
-        //    for (std::size_t i = 0; i < N; i++) {
-        //	    r *= A(i, i) * A[i][i];
-        //    }
-        //    return r;
-        //}
-        if (croutInternal(A, r)) {
-            for (std::size_t i = 0; i < N; i++) {
-                r *= A[i][i];
-            }
-            return r;
-        }
-        return laplaceDet();
+        return LUDecomposition(*this).determinant();
     }
 
     Matrix Matrix::diagonal() const {
@@ -492,13 +689,7 @@ namespace PCOE {
         if (M != N) {
             throw std::domain_error("Matrix must be square");
         }
-
-        double d = determinant();
-        if (std::abs(d) < 1e-15) {
-            throw std::domain_error("Matrix is singular.");
-        }
-
-        return adjoint() / d;
+        return LUDecomposition(*this).inverse();
     }
 
     double Matrix::minor(std::size_t m, std::size_t n) const {
@@ -543,19 +734,32 @@ namespace PCOE {
 
     Matrix Matrix::transpose() const {
         Matrix r(N, M);
-        for (std::size_t i = 0; i < M; i++) {
-            for (std::size_t j = 0; j < N; j++) {
-                r[j][i] = (*this)[i][j];
+        transpose(r);
+        return r;
+    }
+
+    void Matrix::transpose(Matrix& result) const {
+        if (result.M != N || result.N != M) {
+            throw std::domain_error("Result matrix is not the right size");
+        }
+        if (&result == this) {
+            throw std::domain_error("Result matrix can not be the current matrix");
+        }
+        // Transpose in square tiles so that both the reads and the writes
+        // stay within a few cache lines
+        for (std::size_t i0 = 0; i0 < M; i0 += TRANSPOSE_BLOCK) {
+            const std::size_t i1 = std::min(M, i0 + TRANSPOSE_BLOCK);
+            for (std::size_t j0 = 0; j0 < N; j0 += TRANSPOSE_BLOCK) {
+                const std::size_t j1 = std::min(N, j0 + TRANSPOSE_BLOCK);
+                for (std::size_t i = i0; i < i1; i++) {
+                    for (std::size_t j = j0; j < j1; j++) {
+                        result.data[j * M + i] = data[i * N + j];
+                    }
+                }
             }
         }
-        return r;
     }
 
-    // Weighted covariance. Alpha is a scaling factor and defaults to 1.
-    // Beta is also a scaling parameter and defaults to 0. For default values
-    // there will be no scaling.
-    // Note that weighted covariance function differs for sigma
-    // points vs other samples, and this one is assuming sigma points.
     Matrix Matrix::weightedCovariance(const Matrix& w,
                                       const double alpha,
                                       const double beta) const {
@@ -564,25 +768,8 @@ namespace PCOE {
         }
 
         Matrix result(M, M);
-
-        Matrix wmean = weightedMean(w);
-
-        // Compute covariance
-        for (std::size_t i = 0; i < N; ++i) {
-            Matrix column = col(i);
-            Matrix diff = column - wmean;
-            Matrix diffT = diff.transpose();
-            Matrix temp = diff * diffT;
-            result = result + temp * w[i][0];
-
-            // Offset with alpha term
-            column = col(0);
-            diff = column - wmean;
-            diffT = diff.transpose();
-            temp = diff * diffT;
-            result += temp * (1 - alpha * alpha + beta);
-        }
-
+        std::vector<double> mean(M);
+        weightedMoments(*this, w.data, mean.data(), result, 1 - alpha * alpha + beta);
         return result;
     }
 
@@ -590,7 +777,9 @@ namespace PCOE {
         if (w.M != N || w.N != 1) {
             throw std::domain_error("w is not a column vector with M rows.");
         }
-        return (*this) * w;
+        Matrix result(M, 1);
+        weightedMean(*this, w.data, result.data);
+        return result;
     }
 
     /***********************************************************************/
@@ -604,6 +793,140 @@ namespace PCOE {
         return r;
     }
 
+    void Matrix::multiply(const Matrix& lhs, const Matrix& rhs, Matrix& result) {
+        if (lhs.N != rhs.M) {
+            throw std::domain_error("Matrices are not compatible");
+        }
+        if (result.M != lhs.M || result.N != rhs.N) {
+            throw std::domain_error("Result matrix is not the right size");
+        }
+        if (&result == &lhs || &result == &rhs) {
+            throw std::domain_error("Result matrix can not be an argument");
+        }
+        gemm(lhs.data, rhs.data, result.data, lhs.M, lhs.N, rhs.N);
+    }
+
+    void Matrix::multiplyTransposed(const Matrix& lhs, const Matrix& rhs, Matrix& result) {
+        if (lhs.N != rhs.N) {
+            throw std::domain_error("Matrices are not compatible");
+        }
+        if (result.M != lhs.M || result.N != rhs.M) {
+            throw std::domain_error("Result matrix is not the right size");
+        }
+        if (&result == &lhs || &result == &rhs) {
+            throw std::domain_error("Result matrix can not be an argument");
+        }
+        gemmTransposed(lhs.data, rhs.data, result.data, lhs.M, lhs.N, rhs.M);
+    }
+
+    void Matrix::transposeMultiply(const Matrix& lhs, const Matrix& rhs, Matrix& result) {
+        if (lhs.M != rhs.M) {
+            throw std::domain_error("Matrices are not compatible");
+        }
+        if (result.M != lhs.N || result.N != rhs.N) {
+            throw std::domain_error("Result matrix is not the right size");
+        }
+        if (&result == &lhs || &result == &rhs) {
+            throw std::domain_error("Result matrix can not be an argument");
+        }
+        gemmTransposeLeft(lhs.data, rhs.data, result.data, lhs.N, lhs.M, rhs.N);
+    }
+
+    void Matrix::axpy(std::size_t n, double alpha, const double* x, double* y) {
+        for (std::size_t i = 0; i < n; i++) {
+            y[i] += alpha * x[i];
+        }
+    }
+
+    void Matrix::weightedMean(const Matrix& samples, const double* w, double* mean) {
+        const std::size_t k = samples.N;
+        for (std::size_t i = 0; i < samples.M; i++) {
+            const double* xi = samples.data + i * k;
+            double sum = 0.0;
+            for (std::size_t p = 0; p < k; p++) {
+                sum += w[p] * xi[p];
+            }
+            mean[i] = sum;
+        }
+    }
+
+    void Matrix::weightedMoments(const Matrix& samples,
+                                 const double* w,
+                                 double* mean,
+                                 Matrix& covariance,
+                                 double centralWeight) {
+        const std::size_t n = samples.M;
+        const std::size_t k = samples.N;
+        if (covariance.M != n || covariance.N != n) {
+            throw std::domain_error("Covariance matrix is not the right size");
+        }
+
+        if (k == 0) {
+            std::fill(mean, mean + n, 0.0);
+            std::fill(covariance.data, covariance.data + n * n, 0.0);
+            return;
+        }
+
+        double totalWeight = 0.0;
+        for (std::size_t p = 0; p < k; p++) {
+            totalWeight += w[p];
+        }
+
+        // The samples are read once. Each row is shifted by its first
+        // sample, which for sigma points is the central point and so is
+        // close to the mean, and the shifted sums are corrected to the mean
+        // afterwards. Because the shifted first sample is zero, the central
+        // weight only enters through the correction. An incremental (West)
+        // update would divide by the running sum of the weights, which can
+        // be zero partway through when the central sigma point weight is
+        // negative.
+        for (std::size_t i = 0; i < n; i++) {
+            const double* xi = samples.data + i * k;
+            const double ki = xi[0];
+            double* ci = covariance.data + i * n;
+            double first = 0.0;
+            double second = 0.0;
+            for (std::size_t p = 1; p < k; p++) {
+                const double d = xi[p] - ki;
+                first += w[p] * d;
+                second += w[p] * d * d;
+            }
+            mean[i] = first;
+            ci[i] = second;
+            for (std::size_t j = i + 1; j < n; j++) {
+                const double* xj = samples.data + j * k;
+                const double kj = xj[0];
+                double sum = 0.0;
+                for (std::size_t p = 1; p < k; p++) {
+                    sum += w[p] * (xi[p] - ki) * (xj[p] - kj);
+                }
+                ci[j] = sum;
+            }
+        }
+
+        // mean holds the weighted sums of the shifted samples. The offset of
+        // the mean from the shift is delta = (W - 1) * x0 + sum.
+        const double scale = totalWeight + centralWeight;
+        for (std::size_t i = 0; i < n; i++) {
+            const double ai = mean[i];
+            const double di = (totalWeight - 1) * samples.data[i * k] + ai;
+            double* ci = covariance.data + i * n;
+            for (std::size_t j = i; j < n; j++) {
+                const double aj = mean[j];
+                const double dj = (totalWeight - 1) * samples.data[j * k] + aj;
+                ci[j] += scale * di * dj - di * aj - ai * dj;
+            }
+        }
+        for (std::size_t i = 1; i < n; i++) {
+            for (std::size_t j = 0; j < i; j++) {
+                covariance.data[i * n + j] = covariance.data[j * n + i];
+            }
+        }
+        for (std::size_t i = 0; i < n; i++) {
+            mean[i] = totalWeight * samples.data[i * k] + mean[i];
+        }
+    }
+
     /***********************************************************************/
     /* Steam Insertion                                                     */
     /***********************************************************************/
@@ -617,27 +940,6 @@ namespace PCOE {
         return os;
     }
 
-    double Matrix::laplaceDet() const {
-        if (M != N) {
-            throw std::domain_error("Matrix must be square");
-        }
-        if (rows() == 1) {
-            return *data;
-        }
-        if (rows() == 2) {
-            return (data[0] * data[3] - data[1] * data[2]);
-        }
-
-        double r = 0;
-        for (std::size_t i = 0; i < rows(); i++) {
-            double f = std::pow(-1.0, i) * (*this)[i][0];
-            Matrix sub = submatrix(i, 0);
-            double d = sub.determinant();
-            r += f * d;
-        }
-        return r;
-    }
-
     bool Matrix::cholInternal(Matrix& r) const {
         for (std::size_t i = 1; i < M; ++i) {
             for (std::size_t j = 0; j < i; ++j) {
@@ -669,65 +971,4 @@ namespace PCOE {
         }
         return true;
     }
-
-    bool Matrix::croutInternal(Matrix& r, double& mult) const {
-        // If the first element of the matrix is 0, we have to interchange two
-        // rows or columns so that the first element is non-zero, or the LU
-        // decomposition algorithm will fail.
-        // Each interchange flips the sign of the detrminant, so we start with a
-        // result of 1, and change the result to -1 if we need to perform an
-        // interchange. This result is later multiplied with the element along the
-        // diagonal of the decomposed matrix.
-        mult = 1;
-        r = (*this);
-        if (std::abs((*this)[0][0]) < 1e-15) {
-            std::size_t i;
-            for (i = 0; i < N; ++i) {
-                if (std::abs(r[i][0]) > 1e-15) {
-                    Matrix tmp = r.row(0);
-                    r.row(0, r.row(i));
-                    r.row(i, tmp);
-                    mult = -1;
-                    break;
-                }
-            }
-            if (i == N) { // Failed to find a row with non-zero in first column
-                std::size_t j;
-                for (j = 0; j < M; ++j) {
-                    if (std::abs(r[0][j]) > 1e-15) {
-                        Matrix tmp = r.col(0);
-                        r.col(0, r.col(j));
-                        r.col(j, tmp);
-                        mult = -1;
-                        break;
-                    }
-                }
-                if (j == M) { // Failed to find a column with non-zero first row
-                    return false;
-                }
-            }
-        }
-
-        // Crout decomposition. Both L and U can be placed in the original copy
-        // without overwriting and values from the original matrix that are still
-        // needed by the algorithm.
-        for (std::size_t k = 0; k < N; ++k) {
-            for (std::size_t i = k; i < N; ++i) {
-                double sum = 0;
-                for (std::size_t p = 0; p < k; ++p) {
-                    sum += r[i][p] * r[p][k];
-                }
-                r[i][k] = r[i][k] - sum;
-            }
-            for (std::size_t j = k + 1; j < N; ++j) {
-                double sum = 0;
-                for (std::size_t p = 0; p < k; ++p) {
-                    sum += r[k][p] * r[p][j];
-                }
-                r[k][j] = (r[k][j] - sum) / r[k][k];
-            }
-        }
-
-        return true;
-    }
 }
@@ -0,0 +1,277 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include "MatrixDecomposition.h"
+
+namespace PCOE {
+    /**
+     * Copies {@p source} into {@p target}, reusing the storage of
+     * {@p target} if it is already the right size.
+     **/
+    static void assign(Matrix& target, const Matrix& source) {
+        if (target.rows() != source.rows() || target.cols() != source.cols()) {
+            target = source;
+        }
+        else if (source.rows() * source.cols() > 0) {
+            std::copy(source.getData(),
+                      source.getData() + source.rows() * source.cols(),
+                      &target[0][0]);
+        }
+    }
+
+    /**
+     * Solves LY = B and then UX = Y in place in {@p X}, where L is
+     * lower-triangular and U is upper-triangular. L and U are given as
+     * row-major arrays and may be the same packed array. The forward pass
+     * divides by the diagonal of L unless {@p unitLower} is set, and U may
+     * be given transposed, in which case its elements are read from the lower
+     * triangle.
+     **/
+    static void triangularSolve(const double* L,
+                                bool unitLower,
+                                const double* U,
+                                bool transposeU,
+                                std::size_t n,
+                                std::size_t cols,
+                                double* X) {
+        // Work on whole rows of X so that every system is solved in the same
+        // pass over the factors
+        for (std::size_t i = 0; i < n; i++) {
+            double* xi = X + i * cols;
+            for (std::size_t k = 0; k < i; k++) {
+                const double c = L[i * n + k];
+                const double* xk = X + k * cols;
+                for (std::size_t j = 0; j < cols; j++) {
+                    xi[j] -= c * xk[j];
+                }
+            }
+            if (!unitLower) {
+                const double d = L[i * n + i];
+                for (std::size_t j = 0; j < cols; j++) {
+                    xi[j] /= d;
+                }
+            }
+        }
+        for (std::size_t i = n; i-- > 0;) {
+            double* xi = X + i * cols;
+            for (std::size_t k = i + 1; k < n; k++) {
+                const double c = transposeU ? U[k * n + i] : U[i * n + k];
+                const double* xk = X + k * cols;
+                for (std::size_t j = 0; j < cols; j++) {
+                    xi[j] -= c * xk[j];
+                }
+            }
+            const double d = U[i * n + i];
+            for (std::size_t j = 0; j < cols; j++) {
+                xi[j] /= d;
+            }
+        }
+    }
+
+    /***********************************************************************/
+    /* LUDecomposition                                                     */
+    /***********************************************************************/
+    LUDecomposition::LUDecomposition(const Matrix& A) {
+        factorize(A);
+    }
+
+    void LUDecomposition::factorize(const Matrix& A) {
+        if (A.rows() != A.cols()) {
+            throw std::domain_error("Matrix must be square");
+        }
+
+        const std::size_t n = A.rows();
+        assign(lu, A);
+        pivots.resize(n);
+        pivotSign = 1;
+        singular = false;
+        if (n == 0) {
+            return;
+        }
+
+        double* a = &lu[0][0];
+        double scale = 0.0;
+        for (std::size_t i = 0; i < n * n; i++) {
+            scale = std::max(scale, std::abs(a[i]));
+        }
+        const double tolerance = n * std::numeric_limits<double>::epsilon() * scale;
+
+        for (std::size_t k = 0; k < n; k++) {
+            // Choose the largest remaining element in the column as the pivot
+            std::size_t p = k;
+            double pivotAbs = std::abs(a[k * n + k]);
+            for (std::size_t i = k + 1; i < n; i++) {
+                double v = std::abs(a[i * n + k]);
+                if (v > pivotAbs) {
+                    pivotAbs = v;
+                    p = i;
+                }
+            }
+            pivots[k] = p;
+            if (p != k) {
+                std::swap_ranges(a + k * n, a + (k + 1) * n, a + p * n);
+                pivotSign = -pivotSign;
+            }
+            if (pivotAbs <= tolerance) {
+                singular = true;
+            }
+            if (!(pivotAbs > 0.0)) {
+                // The rest of the column is already zero
+                continue;
+            }
+
+            const double* ak = a + k * n;
+            for (std::size_t i = k + 1; i < n; i++) {
+                double* ai = a + i * n;
+                const double c = ai[k] / ak[k];
+                ai[k] = c;
+                for (std::size_t j = k + 1; j < n; j++) {
+                    ai[j] -= c * ak[j];
+                }
+            }
+        }
+    }
+
+    bool LUDecomposition::isSingular() const {
+        return singular;
+    }
+
+    double LUDecomposition::determinant() const {
+        double result = pivotSign;
+        for (std::size_t i = 0; i < lu.rows(); i++) {
+            result *= lu.at(i, i);
+        }
+        return result;
+    }
+
+    double LUDecomposition::logDeterminant() const {
+        double result = 0.0;
+        for (std::size_t i = 0; i < lu.rows(); i++) {
+            result += std::log(std::abs(lu.at(i, i)));
+        }
+        return result;
+    }
+
+    int LUDecomposition::determinantSign() const {
+        int sign = pivotSign;
+        for (std::size_t i = 0; i < lu.rows(); i++) {
+            double d = lu.at(i, i);
+            if (d < 0.0) {
+                sign = -sign;
+            }
+            else if (!(d > 0.0)) {
+                return 0;
+            }
+        }
+        return sign;
+    }
+
+    Matrix LUDecomposition::solve(const Matrix& B) const {
+        Matrix X(B.rows(), B.cols());
+        solve(B, X);
+        return X;
+    }
+
+    void LUDecomposition::solve(const Matrix& B, Matrix& X) const {
+        const std::size_t n = lu.rows();
+        if (B.rows() != n) {
+            throw std::domain_error("Right hand side does not have the same number of rows");
+        }
+        if (X.rows() != B.rows() || X.cols() != B.cols()) {
+            throw std::domain_error("Result matrix is not the same size");
+        }
+        if (singular) {
+            throw std::domain_error("Matrix is singular.");
+        }
+        if (n == 0 || B.cols() == 0) {
+            return;
+        }
+
+        if (&X != &B) {
+            assign(X, B);
+        }
+        double* x = &X[0][0];
+        const std::size_t cols = X.cols();
+        for (std::size_t k = 0; k < n; k++) {
+            if (pivots[k] != k) {
+                std::swap_ranges(x + k * cols, x + (k + 1) * cols, x + pivots[k] * cols);
+            }
+        }
+        triangularSolve(lu.getData(), true, lu.getData(), false, n, cols, x);
+    }
+
+    Matrix LUDecomposition::inverse() const {
+        Matrix result = Matrix::identity(lu.rows());
+        solve(result, result);
+        return result;
+    }
+
+    /***********************************************************************/
+    /* CholeskyDecomposition                                               */
+    /***********************************************************************/
+    CholeskyDecomposition::CholeskyDecomposition(const Matrix& A) {
+        factorize(A);
+    }
+
+    void CholeskyDecomposition::factorize(const Matrix& A) {
+        if (A.rows() != A.cols()) {
+            throw std::domain_error("Matrix must be square");
+        }
+        if (l.rows() != A.rows() || l.cols() != A.cols()) {
+            l = Matrix(A.rows(), A.cols());
+        }
+        A.chol(l);
+    }
+
+    double CholeskyDecomposition::determinant() const {
+        double result = 1.0;
+        for (std::size_t i = 0; i < l.rows(); i++) {
+            result *= l.at(i, i);
+        }
+        return result * result;
+    }
+
+    double CholeskyDecomposition::logDeterminant() const {
+        double result = 0.0;
+        for (std::size_t i = 0; i < l.rows(); i++) {
+            result += std::log(l.at(i, i));
+        }
+        return 2.0 * result;
+    }
+
+    Matrix CholeskyDecomposition::solve(const Matrix& B) const {
+        Matrix X(B.rows(), B.cols());
+        solve(B, X);
+        return X;
+    }
+
+    void CholeskyDecomposition::solve(const Matrix& B, Matrix& X) const {
+        const std::size_t n = l.rows();
+        if (B.rows() != n) {
+            throw std::domain_error("Right hand side does not have the same number of rows");
+        }
+        if (X.rows() != B.rows() || X.cols() != B.cols()) {
+            throw std::domain_error("Result matrix is not the same size");
+        }
+        if (n == 0 || B.cols() == 0) {
+            return;
+        }
+
+        if (&X != &B) {
+            assign(X, B);
+        }
+        triangularSolve(l.getData(), false, l.getData(), true, n, X.cols(), &X[0][0]);
+    }
+
+    Matrix CholeskyDecomposition::inverse() const {
+        Matrix result = Matrix::identity(l.rows());
+        solve(result, result);
+        return result;
+    }
+}
@@ -10,4 +10,9 @@ namespace PCOE {
         Expect((static_cast<std::uint64_t>(id) & 0x0000FF0000000000L) == 0,
                "Message id is not empty");
     }
+
+    std::unique_ptr<EmptyMessage> EmptyMessage::deserialize(const SerializedMessage& message) {
+        return std::unique_ptr<EmptyMessage>(
+            new EmptyMessage(message.getMessageId(), message.getSource(), message.getTimestamp()));
+    }
 }
@@ -5,21 +5,29 @@
 
 #include "Contracts.h"
 #include "Messages/Message.h"
+#include "Messages/WireFormat.h"
 
 namespace PCOE {
     void Message::serialize(std::ostream& os) const {
         Expect(source.length() < std::numeric_limits<std::uint16_t>::max(), "Source length");
-        os.write(reinterpret_cast<const char*>(&id), 8);
-
         std::uint16_t sourceLen = static_cast<std::uint16_t>(source.length());
-        os.write(reinterpret_cast<const char*>(&sourceLen), 2);
-        os.write(source.c_str(), sourceLen);
-
+        std::uint32_t payloadLen = getPayloadSize();
         std::int64_t raw_time = timestamp.time_since_epoch().count();
-        os.write(reinterpret_cast<const char*>(&raw_time), 8);
 
-        std::uint16_t payloadLen = getPayloadSize();
-        os.write(reinterpret_cast<const char*>(&payloadLen), 2);
+        wireWrite(os, MessageWireVersion);
+        wireWrite(os, sourceLen);
+        wireWrite(os, payloadLen);
+        wireWrite(os, static_cast<std::uint64_t>(id));
+        wireWrite(os, raw_time);
+
+        os.write(source.c_str(), sourceLen);
+        wirePad(os, wireAlign(sourceLen) - sourceLen);
+
         serializePayload(os);
+        wirePad(os, wireAlign(payloadLen) - payloadLen);
+    }
+
+    std::size_t Message::getSerializedSize() const {
+        return MessageHeaderSize + wireAlign(source.length()) + wireAlign(getPayloadSize());
     }
 }
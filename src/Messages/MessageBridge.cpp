@@ -0,0 +1,22 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#include "Messages/MessageBridge.h"
+
+namespace PCOE {
+    MessageBridge::MessageBridge(IMessagePublisher& local, IMessagePublisher& remote)
+        : local(local), remote(remote), toRemote(remote), toLocal(local) {}
+
+    MessageBridge::~MessageBridge() {
+        local.unsubscribe(&toRemote);
+        remote.unsubscribe(&toLocal);
+    }
+
+    void MessageBridge::exportMessages(const std::string& source, MessageId id) {
+        local.subscribe(&toRemote, source, id);
+    }
+
+    void MessageBridge::importMessages(const std::string& source, MessageId id) {
+        remote.subscribe(&toLocal, source, id);
+    }
+}
@@ -0,0 +1,113 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#include "Messages/EmptyMessage.h"
+#include "Messages/MessageFactory.h"
+#include "Messages/PredictionMessage.h"
+#include "Messages/ProgEventMessage.h"
+#include "Messages/ScalarMessage.h"
+#include "Messages/UDataMessage.h"
+#include "Messages/VectorMessage.h"
+#include "Messages/WaypointMessage.h"
+
+namespace PCOE {
+    // The number of bytes of a message body read from a stream at a time.
+    // Must be a multiple of MessageWireAlignment.
+    static const std::size_t StreamChunkSize = 1024 * 1024;
+
+    MessageFactory::MessageFactory() {
+        RegisterPayloadType(0x00, Create<EmptyMessage>);
+        RegisterPayloadTypes<std::uint8_t>(0x11, 0x41);
+        RegisterPayloadTypes<std::uint16_t>(0x12, 0x42);
+        RegisterPayloadTypes<std::uint32_t>(0x13, 0x43);
+        RegisterPayloadTypes<std::uint64_t>(0x14, 0x44);
+        RegisterPayloadTypes<std::int8_t>(0x21, 0x81);
+        RegisterPayloadTypes<std::int16_t>(0x22, 0x82);
+        RegisterPayloadTypes<std::int32_t>(0x23, 0x83);
+        RegisterPayloadTypes<std::int64_t>(0x24, 0x84);
+        RegisterPayloadTypes<float>(0x31, 0xC1);
+        RegisterPayloadTypes<double>(0x32, 0xC2);
+
+        Register<UDataVecMessage>(MessageId::ModelStateEstimate);
+        Register<WaypointMessage>(MessageId::RouteSetWP);
+        Register<ProgEventMessage>(MessageId::BatteryEod);
+        Register<ProgEventMessage>(MessageId::BatteryEol);
+        Register<ProgEventMessage>(MessageId::TestEvent0);
+        Register<PredictionMessage>(MessageId::Prediction);
+    }
+
+    template <class T>
+    void MessageFactory::RegisterPayloadTypes(std::uint8_t scalarType, std::uint8_t vectorType) {
+        RegisterPayloadType(scalarType, Create<ScalarMessage<T>>);
+        RegisterPayloadType(vectorType, Create<VectorMessage<T>>);
+    }
+
+    void MessageFactory::Register(MessageId id, create_fn fn) {
+        registered[static_cast<std::uint64_t>(id)] = fn;
+    }
+
+    void MessageFactory::RegisterPayloadType(std::uint8_t payloadType, create_fn fn) {
+        payloadTypes[payloadType] = fn;
+    }
+
+    MessageFactory::unique_ptr MessageFactory::Create(const SerializedMessage& message) const {
+        std::uint64_t id = static_cast<std::uint64_t>(message.getMessageId());
+        auto byId = registered.find(id);
+        if (byId != registered.end()) {
+            return byId->second(message);
+        }
+
+        std::uint8_t payloadType = static_cast<std::uint8_t>(id >> 40);
+        auto byPayload = payloadTypes.find(payloadType);
+        if (byPayload != payloadTypes.end()) {
+            return byPayload->second(message);
+        }
+        throw std::out_of_range("Message id not registered");
+    }
+
+    MessageFactory::unique_ptr MessageFactory::deserialize(const char* buffer,
+                                                           std::size_t size) const {
+        return Create(SerializedMessage(buffer, size));
+    }
+
+    MessageFactory::unique_ptr MessageFactory::deserialize(std::istream& is) const {
+        // The buffer is allocated as 64-bit words so that the payload is
+        // aligned in the same way it is when the message is read from an
+        // aligned buffer.
+        std::vector<std::uint64_t> buffer(MessageHeaderSize / sizeof(std::uint64_t));
+        char* bytes = reinterpret_cast<char*>(buffer.data());
+        is.read(bytes, MessageHeaderSize);
+        if (is.gcount() == 0 && is.eof()) {
+            return nullptr;
+        }
+        if (static_cast<std::size_t>(is.gcount()) != MessageHeaderSize) {
+            throw FormatError("Message truncated");
+        }
+
+        std::size_t size = SerializedMessage::readSize(bytes);
+        if (size > MaxMessageSize) {
+            throw FormatError("Message too large");
+        }
+
+        // The buffer grows as the message is read, so a corrupt size in the
+        // header of a short stream does not allocate the whole claimed size.
+        std::size_t received = MessageHeaderSize;
+        while (received < size) {
+            std::size_t chunk = std::min(size - received, StreamChunkSize);
+            buffer.resize((received + chunk) / sizeof(std::uint64_t));
+            bytes = reinterpret_cast<char*>(buffer.data());
+            is.read(bytes + received, static_cast<std::streamsize>(chunk));
+            if (static_cast<std::size_t>(is.gcount()) != chunk) {
+                throw FormatError("Message truncated");
+            }
+            received += chunk;
+        }
+        return deserialize(bytes, size);
+    }
+}
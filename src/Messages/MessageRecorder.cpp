@@ -0,0 +1,195 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <stdexcept>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "Contracts.h"
+#include "Messages/MessageRecorder.h"
+#include "ThreadSafeLog.h"
+
+namespace PCOE {
+    static const Log& log = Log::Instance();
+    static const std::string MODULE_NAME = "M-REC";
+    static const std::size_t SegmentHeaderSize = sizeof(MessageLog::SegmentHeader);
+
+    static void writeAll(int fd, const void* data, std::size_t size) {
+        const char* next = static_cast<const char*>(data);
+        while (size > 0) {
+            ssize_t written = ::write(fd, next, size);
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw std::system_error(errno, std::generic_category(), "write");
+            }
+            next += written;
+            size -= static_cast<std::size_t>(written);
+        }
+    }
+
+    MessageRecorder::MessageRecorder(IMessagePublisher& publisher,
+                                     const std::string& path,
+                                     std::size_t segmentSize,
+                                     MessageClock::duration indexInterval)
+        : publisher(publisher),
+          path(path),
+          segmentSize(segmentSize),
+          indexInterval(indexInterval),
+          indexFd(-1),
+          segmentFd(-1),
+          segment(0),
+          mapping(nullptr),
+          used(0),
+          indexed(false),
+          nextIndexTicks(0),
+          latestTicks(0),
+          messages(0),
+          stream(&buffer) {
+        if (segmentSize < 4096) {
+            throw std::domain_error("Segment size must be at least 4096");
+        }
+
+        // Segments left over from a longer log at the same path are removed so
+        // that the log on disk is self-consistent.
+        for (std::uint32_t i = 0; std::remove(MessageLog::segmentPath(path, i).c_str()) == 0;
+             ++i) {
+        }
+
+        indexFd = open(MessageLog::indexPath(path).c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (indexFd < 0) {
+            throw std::system_error(errno, std::generic_category(), "open");
+        }
+        MessageLog::IndexHeader header = {MessageLog::IndexMagic, MessageLog::Version, 0};
+        try {
+            writeAll(indexFd, &header, sizeof(header));
+        }
+        catch (...) {
+            close(indexFd);
+            throw;
+        }
+    }
+
+    MessageRecorder::~MessageRecorder() {
+        publisher.unsubscribe(this);
+        std::lock_guard<std::mutex> lock(mutex);
+        if (mapping != nullptr) {
+            try {
+                closeSegment();
+            }
+            catch (const std::exception& ex) {
+                log.FormatLine(LOG_ERROR, MODULE_NAME, "Error closing segment: %s", ex.what());
+            }
+        }
+        close(indexFd);
+    }
+
+    void MessageRecorder::record(const std::string& source) {
+        publisher.subscribe(this, source);
+    }
+
+    void MessageRecorder::processMessage(const std::shared_ptr<Message>& message) {
+        // Messages are recorded from inside bus dispatch, where an exception
+        // would reach the publisher rather than the recorder's owner, so
+        // messages that cannot be recorded are logged and dropped.
+        std::size_t size = message->getSerializedSize();
+        if (size > segmentSize - SegmentHeaderSize) {
+            log.FormatLine(LOG_ERROR,
+                           MODULE_NAME,
+                           "Dropped message of %u bytes, which is larger than a log segment",
+                           static_cast<unsigned int>(size));
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        try {
+            if (mapping != nullptr && used + size > segmentSize - SegmentHeaderSize) {
+                closeSegment();
+            }
+            if (mapping == nullptr) {
+                openSegment();
+            }
+
+            MessageClock::rep ticks = message->getTimestamp().time_since_epoch().count();
+            latestTicks = messages == 0 ? ticks : std::max(latestTicks, ticks);
+            if (!indexed || latestTicks >= nextIndexTicks) {
+                writeIndex(latestTicks);
+            }
+
+            buffer.reset(mapping + SegmentHeaderSize + used, size);
+            stream.clear();
+            message->serialize(stream);
+            Ensure(buffer.written() == size, "Serialized size");
+            used += size;
+            reinterpret_cast<MessageLog::SegmentHeader*>(mapping)->size = used;
+            ++messages;
+        }
+        catch (const std::exception& ex) {
+            log.FormatLine(LOG_ERROR, MODULE_NAME, "Dropped message: %s", ex.what());
+        }
+    }
+
+    std::size_t MessageRecorder::messageCount() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return messages;
+    }
+
+    std::size_t MessageRecorder::segmentCount() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return segment + (mapping == nullptr ? 0 : 1);
+    }
+
+    void MessageRecorder::openSegment() {
+        std::string name = MessageLog::segmentPath(path, segment);
+        segmentFd = open(name.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (segmentFd < 0) {
+            throw std::system_error(errno, std::generic_category(), "open");
+        }
+        if (ftruncate(segmentFd, static_cast<off_t>(segmentSize)) != 0) {
+            int error = errno;
+            close(segmentFd);
+            throw std::system_error(error, std::generic_category(), "ftruncate");
+        }
+        void* result = mmap(nullptr, segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, segmentFd, 0);
+        if (result == MAP_FAILED) {
+            int error = errno;
+            close(segmentFd);
+            throw std::system_error(error, std::generic_category(), "mmap");
+        }
+
+        mapping = static_cast<char*>(result);
+        used = 0;
+        indexed = false;
+        MessageLog::SegmentHeader header = {MessageLog::SegmentMagic, MessageLog::Version, 0, 0};
+        *reinterpret_cast<MessageLog::SegmentHeader*>(mapping) = header;
+    }
+
+    void MessageRecorder::closeSegment() {
+        munmap(mapping, segmentSize);
+        mapping = nullptr;
+        // Segments are mapped at full size while they are being written and
+        // truncated to the bytes used once closed.
+        int result = ftruncate(segmentFd, static_cast<off_t>(SegmentHeaderSize + used));
+        int error = errno;
+        close(segmentFd);
+        segmentFd = -1;
+        ++segment;
+        if (result != 0) {
+            throw std::system_error(error, std::generic_category(), "ftruncate");
+        }
+    }
+
+    void MessageRecorder::writeIndex(MessageClock::rep ticks) {
+        MessageLog::IndexEntry entry = {ticks, segment, 0, used};
+        writeAll(indexFd, &entry, sizeof(entry));
+        indexed = true;
+        nextIndexTicks = ticks + indexInterval.count();
+    }
+}
@@ -0,0 +1,186 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <fstream>
+#include <system_error>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Contracts.h"
+#include "Exceptions.h"
+#include "Messages/MessageFactory.h"
+#include "Messages/MessageReplayer.h"
+
+namespace PCOE {
+    static const std::size_t SegmentHeaderSize = sizeof(MessageLog::SegmentHeader);
+
+    static const char* mapSegment(const std::string& name, std::size_t& length) {
+        int fd = open(name.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "open");
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            int error = errno;
+            close(fd);
+            throw std::system_error(error, std::generic_category(), "fstat");
+        }
+        length = static_cast<std::size_t>(info.st_size);
+        if (length < SegmentHeaderSize) {
+            close(fd);
+            throw FormatError("Log segment truncated");
+        }
+        void* result = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+        int error = errno;
+        close(fd);
+        if (result == MAP_FAILED) {
+            throw std::system_error(error, std::generic_category(), "mmap");
+        }
+        return static_cast<const char*>(result);
+    }
+
+    MessageReplayer::MessageReplayer(const std::string& path) : segment(0), offset(0) {
+        std::ifstream file(MessageLog::indexPath(path), std::ios::binary);
+        if (!file) {
+            throw std::system_error(errno, std::generic_category(), "open");
+        }
+        MessageLog::IndexHeader header;
+        if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+            header.magic != MessageLog::IndexMagic || header.version != MessageLog::Version) {
+            throw FormatError("Not a message log index");
+        }
+        MessageLog::IndexEntry entry;
+        while (file.read(reinterpret_cast<char*>(&entry), sizeof(entry))) {
+            index.push_back(entry);
+        }
+        std::size_t segmentCount = index.empty() ? 0 : index.back().segment + 1;
+
+        try {
+            for (std::uint32_t i = 0; i < segmentCount; i++) {
+                Segment s = {nullptr, 0, 0};
+                s.mapping = mapSegment(MessageLog::segmentPath(path, i), s.length);
+                segments.push_back(s);
+
+                auto segmentHeader = reinterpret_cast<const MessageLog::SegmentHeader*>(s.mapping);
+                if (segmentHeader->magic != MessageLog::SegmentMagic ||
+                    segmentHeader->version != MessageLog::Version) {
+                    throw FormatError("Not a message log segment");
+                }
+                if (segmentHeader->size > s.length - SegmentHeaderSize) {
+                    throw FormatError("Log segment truncated");
+                }
+                segments.back().size = static_cast<std::size_t>(segmentHeader->size);
+            }
+        }
+        catch (...) {
+            for (const Segment& s : segments) {
+                munmap(const_cast<char*>(s.mapping), s.length);
+            }
+            throw;
+        }
+    }
+
+    MessageReplayer::~MessageReplayer() {
+        for (const Segment& s : segments) {
+            munmap(const_cast<char*>(s.mapping), s.length);
+        }
+    }
+
+    MessageReplayer::time_point MessageReplayer::getStartTime() const {
+        if (index.empty()) {
+            return time_point();
+        }
+        return time_point(time_point::duration(index.front().ticks));
+    }
+
+    void MessageReplayer::rewind() {
+        segment = 0;
+        offset = 0;
+    }
+
+    void MessageReplayer::seek(time_point time) {
+        MessageClock::rep ticks = time.time_since_epoch().count();
+        // Every message before the last entry whose ticks are earlier than
+        // the requested time is also earlier, so reading can start there.
+        auto entry = std::lower_bound(index.begin(),
+                                      index.end(),
+                                      ticks,
+                                      [](const MessageLog::IndexEntry& e, MessageClock::rep t) {
+                                          return e.ticks < t;
+                                      });
+        if (entry == index.begin()) {
+            rewind();
+            return;
+        }
+        --entry;
+        segment = entry->segment;
+        offset = static_cast<std::size_t>(entry->offset);
+
+        std::size_t available;
+        const char* data;
+        while ((data = peek(available)) != nullptr) {
+            SerializedMessage message(data, available);
+            if (message.getTimestamp() >= time) {
+                break;
+            }
+            offset += message.size();
+        }
+    }
+
+    std::shared_ptr<Message> MessageReplayer::next() {
+        std::size_t available;
+        const char* data = peek(available);
+        if (data == nullptr) {
+            return nullptr;
+        }
+        SerializedMessage message(data, available);
+        offset += message.size();
+        return MessageFactory::instance().Create(message);
+    }
+
+    std::size_t MessageReplayer::replay(IMessagePublisher& publisher, double speed) {
+        Expect(speed >= 0.0, "Negative speed");
+        using std::chrono::steady_clock;
+
+        std::size_t count = 0;
+        steady_clock::time_point start = steady_clock::now();
+        time_point first;
+        std::size_t available;
+        const char* data;
+        while ((data = peek(available)) != nullptr) {
+            SerializedMessage message(data, available);
+            offset += message.size();
+            if (count == 0) {
+                first = message.getTimestamp();
+            }
+            else if (speed > 0.0) {
+                std::chrono::duration<double> elapsed = message.getTimestamp() - first;
+                std::this_thread::sleep_until(
+                    start + std::chrono::duration_cast<steady_clock::duration>(elapsed / speed));
+            }
+            publisher.publish(MessageFactory::instance().Create(message));
+            ++count;
+        }
+        return count;
+    }
+
+    const char* MessageReplayer::peek(std::size_t& available) {
+        while (segment < segments.size()) {
+            const Segment& s = segments[segment];
+            if (offset < s.size) {
+                available = s.size - offset;
+                return s.mapping + SegmentHeaderSize + offset;
+            }
+            ++segment;
+            offset = 0;
+        }
+        return nullptr;
+    }
+}
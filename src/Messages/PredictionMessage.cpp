@@ -0,0 +1,91 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#include "Messages/PredictionMessage.h"
+
+namespace PCOE {
+    std::size_t WireCodec<DataPoint>::size(const DataPoint& value) {
+        std::size_t size = 3 * sizeof(std::uint32_t);
+        for (std::size_t i = 0; i <= value.getNumTimes(); i++) {
+            size += WireCodec<UData>::size(value[i]);
+        }
+        return size;
+    }
+
+    void WireCodec<DataPoint>::write(std::ostream& os, const DataPoint& value) {
+        wireWrite(os, static_cast<std::uint32_t>(value.getUncertainty()));
+        wireWrite(os, static_cast<std::uint32_t>(value.getNPoints()));
+        wireWrite(os, static_cast<std::uint32_t>(value.getNumTimes()));
+        for (std::size_t i = 0; i <= value.getNumTimes(); i++) {
+            WireCodec<UData>::write(os, value[i]);
+        }
+    }
+
+    DataPoint WireCodec<DataPoint>::read(WireReader& reader) {
+        std::uint32_t uncertainty = reader.read<std::uint32_t>();
+        std::uint32_t npoints = reader.read<std::uint32_t>();
+        std::uint32_t times = reader.read<std::uint32_t>();
+        if (uncertainty > static_cast<std::uint32_t>(UType::WSamples)) {
+            throw FormatError("Invalid DataPoint");
+        }
+
+        // Each time is stored as a UData, which takes at least as many bytes as
+        // its header, so a larger count cannot be valid.
+        if (times >= reader.remaining() / WireCodec<UData>::HeaderSize ||
+            npoints > reader.remaining() / sizeof(double)) {
+            throw FormatError("Message truncated");
+        }
+
+        DataPoint result;
+        result.setUncertainty(static_cast<UType>(uncertainty));
+        result.setNPoints(npoints);
+        result.setNumTimes(times);
+        for (std::size_t i = 0; i <= times; i++) {
+            result[i] = WireCodec<UData>::read(reader);
+        }
+        return result;
+    }
+
+    std::size_t WireCodec<Prediction>::size(const Prediction& value) {
+        std::size_t size = 2 * sizeof(std::uint32_t);
+        for (const ProgEvent& event : value.getEvents()) {
+            size += WireCodec<ProgEvent>::size(event);
+        }
+        for (const DataPoint& observable : value.getObservables()) {
+            size += WireCodec<DataPoint>::size(observable);
+        }
+        return size;
+    }
+
+    void WireCodec<Prediction>::write(std::ostream& os, const Prediction& value) {
+        const std::vector<ProgEvent>& events = value.getEvents();
+        const std::vector<DataPoint>& observables = value.getObservables();
+        Expect(events.size() <= std::numeric_limits<std::uint32_t>::max(), "Event count");
+        Expect(observables.size() <= std::numeric_limits<std::uint32_t>::max(),
+               "Observable count");
+
+        wireWrite(os, static_cast<std::uint32_t>(events.size()));
+        for (const ProgEvent& event : events) {
+            WireCodec<ProgEvent>::write(os, event);
+        }
+        wireWrite(os, static_cast<std::uint32_t>(observables.size()));
+        for (const DataPoint& observable : observables) {
+            WireCodec<DataPoint>::write(os, observable);
+        }
+    }
+
+    Prediction WireCodec<Prediction>::read(WireReader& reader) {
+        std::uint32_t eventCount = reader.read<std::uint32_t>();
+        std::vector<ProgEvent> events;
+        for (std::uint32_t i = 0; i < eventCount; i++) {
+            events.push_back(WireCodec<ProgEvent>::read(reader));
+        }
+
+        std::uint32_t observableCount = reader.read<std::uint32_t>();
+        std::vector<DataPoint> observables;
+        for (std::uint32_t i = 0; i < observableCount; i++) {
+            observables.push_back(WireCodec<DataPoint>::read(reader));
+        }
+        return Prediction(std::move(events), std::move(observables));
+    }
+}
@@ -0,0 +1,88 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#include "Messages/ProgEventMessage.h"
+
+namespace PCOE {
+    using Point = Point4D<MessageClock>;
+
+    static std::size_t pointSize(const Point& point) {
+        return 3 * sizeof(double) + sizeof(std::int64_t) + sizeof(std::uint32_t) +
+               point.getStates().size() * sizeof(double);
+    }
+
+    static void writePoint(std::ostream& os, const Point& point) {
+        const std::vector<double> states = point.getStates();
+        wireWrite(os, point.getLatitude());
+        wireWrite(os, point.getLongitude());
+        wireWrite(os, point.getAltitude());
+        wireWrite(os, static_cast<std::int64_t>(point.getTime().time_since_epoch().count()));
+        wireWrite(os, static_cast<std::uint32_t>(states.size()));
+        os.write(reinterpret_cast<const char*>(states.data()),
+                 static_cast<std::streamsize>(states.size() * sizeof(double)));
+    }
+
+    static Point readPoint(WireReader& reader) {
+        double lat = reader.read<double>();
+        double lon = reader.read<double>();
+        double alt = reader.read<double>();
+        MessageClock::time_point time(MessageClock::duration(reader.read<std::int64_t>()));
+        std::uint32_t stateCount = reader.read<std::uint32_t>();
+        if (stateCount > reader.remaining() / sizeof(double)) {
+            throw FormatError("Message truncated");
+        }
+        std::vector<double> states(stateCount);
+        reader.read(states.data(), stateCount);
+        return Point(lat, lon, alt, time, std::move(states));
+    }
+
+    std::size_t WireCodec<ProgEvent>::size(const ProgEvent& value) {
+        std::size_t size = sizeof(std::uint64_t) + WireCodec<std::string>::size(value.getTag()) +
+                           WireCodec<UData>::size(value.getTOE()) + 2 * sizeof(std::uint32_t);
+        for (const UData& state : value.getState()) {
+            size += WireCodec<UData>::size(state);
+        }
+        for (const Point& point : value.getPoints()) {
+            size += pointSize(point);
+        }
+        return size;
+    }
+
+    void WireCodec<ProgEvent>::write(std::ostream& os, const ProgEvent& value) {
+        const std::vector<UData>& state = value.getState();
+        const std::vector<Point> points = value.getPoints();
+        Expect(state.size() <= std::numeric_limits<std::uint32_t>::max(), "State size");
+        Expect(points.size() <= std::numeric_limits<std::uint32_t>::max(), "Point count");
+
+        wireWrite(os, static_cast<std::uint64_t>(value.getId()));
+        WireCodec<std::string>::write(os, value.getTag());
+        WireCodec<UData>::write(os, value.getTOE());
+        wireWrite(os, static_cast<std::uint32_t>(state.size()));
+        for (const UData& entry : state) {
+            WireCodec<UData>::write(os, entry);
+        }
+        wireWrite(os, static_cast<std::uint32_t>(points.size()));
+        for (const Point& point : points) {
+            writePoint(os, point);
+        }
+    }
+
+    ProgEvent WireCodec<ProgEvent>::read(WireReader& reader) {
+        MessageId id = static_cast<MessageId>(reader.read<std::uint64_t>());
+        std::string tag = reader.readString();
+        UData toe = WireCodec<UData>::read(reader);
+
+        std::uint32_t stateCount = reader.read<std::uint32_t>();
+        std::vector<UData> state;
+        for (std::uint32_t i = 0; i < stateCount; i++) {
+            state.push_back(WireCodec<UData>::read(reader));
+        }
+
+        std::uint32_t pointCount = reader.read<std::uint32_t>();
+        std::vector<Point> points;
+        for (std::uint32_t i = 0; i < pointCount; i++) {
+            points.push_back(readPoint(reader));
+        }
+        return ProgEvent(id, std::move(state), std::move(toe), std::move(points), std::move(tag));
+    }
+}
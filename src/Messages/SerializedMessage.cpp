@@ -0,0 +1,63 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#include <cstring>
+#include <stdexcept>
+
+#include "Messages/SerializedMessage.h"
+
+namespace PCOE {
+    static const std::uint64_t PayloadTypeMask = 0x0000FF0000000000L;
+    static const std::uint64_t DoubleVectorType = 0x0000C20000000000L;
+
+    template <class T>
+    static T readHeader(const char* header, std::size_t offset) {
+        T value;
+        std::memcpy(&value, header + offset, sizeof(T));
+        return value;
+    }
+
+    std::size_t SerializedMessage::readSize(const char* header) {
+        if (readHeader<std::uint16_t>(header, 0) != MessageWireVersion) {
+            throw FormatError("Unsupported message version");
+        }
+        std::size_t sourceLength = readHeader<std::uint16_t>(header, 2);
+        std::size_t payloadLength = readHeader<std::uint32_t>(header, 4);
+        return MessageHeaderSize + wireAlign(sourceLength) + wireAlign(payloadLength);
+    }
+
+    SerializedMessage::SerializedMessage(const char* buffer, std::size_t size) {
+        if (size < MessageHeaderSize) {
+            throw FormatError("Message truncated");
+        }
+        totalSize = readSize(buffer);
+        if (totalSize > size) {
+            throw FormatError("Message truncated");
+        }
+
+        sourceLength = readHeader<std::uint16_t>(buffer, 2);
+        payloadSize = readHeader<std::uint32_t>(buffer, 4);
+        id = static_cast<MessageId>(readHeader<std::uint64_t>(buffer, 8));
+        timestamp = Message::time_point(
+            Message::time_point::duration(readHeader<std::int64_t>(buffer, 16)));
+        source = buffer + MessageHeaderSize;
+        payload = source + wireAlign(sourceLength);
+    }
+
+    ConstMatrixView SerializedMessage::getDoubleVector() const {
+        if ((static_cast<std::uint64_t>(id) & PayloadTypeMask) != DoubleVectorType) {
+            throw std::domain_error("Message is not a vector of doubles");
+        }
+        WireReader reader = payloadReader();
+        std::size_t count = reader.read<std::uint32_t>();
+        reader.skip(sizeof(std::uint32_t));
+        if (count > reader.remaining() / sizeof(double)) {
+            throw FormatError("Message truncated");
+        }
+        const char* elements = payload + reader.position();
+        if (reinterpret_cast<std::uintptr_t>(elements) % alignof(double) != 0) {
+            throw FormatError("Message is not aligned");
+        }
+        return ConstMatrixView(reinterpret_cast<const double*>(elements), count, 1, 1);
+    }
+}
@@ -0,0 +1,153 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+#include "Contracts.h"
+#include "Messages/MessageFactory.h"
+#include "Messages/SharedMemoryPublisher.h"
+#include "ThreadSafeLog.h"
+
+namespace PCOE {
+    static const Log& log = Log::Instance();
+    static const std::string MODULE_NAME = "M-SHM";
+
+    // The poller yields for this many empty polls before it starts sleeping
+    // between polls, so that latency stays in microseconds while messages are
+    // flowing without spinning a core while the ring is idle.
+    static const unsigned int SpinPolls = 10000;
+    static const std::chrono::microseconds IdleSleep(100);
+
+    // The publisher whose polling thread is the current thread, if any.
+    static thread_local const SharedMemoryPublisher* pollingPublisher = nullptr;
+
+    SharedMemoryPublisher::SharedMemoryPublisher(const std::string& name, std::size_t capacity)
+        : ring(name, capacity), running(false) {}
+
+    SharedMemoryPublisher::SharedMemoryPublisher(const std::string& name)
+        : ring(name), running(false) {}
+
+    SharedMemoryPublisher::~SharedMemoryPublisher() {
+        running = false;
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+
+    void SharedMemoryPublisher::subscribe(IMessageProcessor* consumer,
+                                          std::string source,
+                                          MessageId id) {
+        std::lock_guard<std::recursive_mutex> guard(subs_mutex);
+        log.FormatLine(LOG_TRACE,
+                       MODULE_NAME,
+                       "Adding subscriber %x for source '%s' and id %x",
+                       consumer,
+                       source.c_str(),
+                       static_cast<std::uint64_t>(id));
+        subscribers[source].push_back(callback_pair(id, consumer));
+        if (!reader) {
+            reader = std::unique_ptr<SharedMemoryReader>(new SharedMemoryReader(ring));
+            running = true;
+            thread = std::thread(&SharedMemoryPublisher::run, this);
+        }
+    }
+
+    void SharedMemoryPublisher::unsubscribe(IMessageProcessor* consumer) {
+        std::lock_guard<std::recursive_mutex> guard(subs_mutex);
+        log.FormatLine(LOG_TRACE, MODULE_NAME, "Removing subscriber %x", consumer);
+        for (auto& i : subscribers) {
+            unsubscribe(consumer, i.first);
+        }
+    }
+
+    void SharedMemoryPublisher::unsubscribe(IMessageProcessor* consumer,
+                                            const std::string& source) {
+        std::lock_guard<std::recursive_mutex> guard(subs_mutex);
+        auto srcSubs = subscribers.find(source);
+        if (srcSubs == subscribers.end()) {
+            return;
+        }
+        auto& vec = (*srcSubs).second;
+        vec.erase(std::remove_if(vec.begin(),
+                                 vec.end(),
+                                 [consumer](const callback_pair& i) {
+                                     return i.second == consumer;
+                                 }),
+                  vec.end());
+    }
+
+    void SharedMemoryPublisher::publish(std::shared_ptr<Message> message) {
+        Expect(message != nullptr, "Null message");
+        if (pollingPublisher == this) {
+            // Only the polling thread makes room for this publisher's reader,
+            // so a subscriber waiting for room would wait forever.
+            if (!ring.tryWrite(*message)) {
+                throw std::runtime_error("Ring is full while publishing from a subscriber");
+            }
+            return;
+        }
+        ring.write(*message);
+    }
+
+    void SharedMemoryPublisher::run() {
+        pollingPublisher = this;
+        unsigned int idlePolls = 0;
+        std::vector<IMessageProcessor*> consumers;
+        while (running) {
+            bool read = false;
+            try {
+                std::shared_ptr<Message> message;
+                read = reader->tryRead([this, &message, &consumers](const SerializedMessage& m) {
+                    message = deserialize(m, consumers);
+                });
+                // Consumers are called after the reader has moved past the
+                // message, so that the space is free if they publish to the
+                // ring.
+                if (message) {
+                    for (IMessageProcessor* consumer : consumers) {
+                        consumer->processMessage(message);
+                    }
+                }
+            }
+            catch (const std::exception& ex) {
+                log.FormatLine(LOG_ERROR, MODULE_NAME, "Error reading message: %s", ex.what());
+                read = true;
+            }
+
+            if (read) {
+                idlePolls = 0;
+            }
+            else if (idlePolls < SpinPolls) {
+                ++idlePolls;
+                std::this_thread::yield();
+            }
+            else {
+                std::this_thread::sleep_for(IdleSleep);
+            }
+        }
+    }
+
+    std::shared_ptr<Message>
+    SharedMemoryPublisher::deserialize(const SerializedMessage& message,
+                                       std::vector<IMessageProcessor*>& consumers) {
+        consumers.clear();
+        {
+            std::lock_guard<std::recursive_mutex> guard(subs_mutex);
+            auto srcSubs = subscribers.find(message.getSource());
+            if (srcSubs == subscribers.end()) {
+                return nullptr;
+            }
+            for (const callback_pair& it : (*srcSubs).second) {
+                if (it.first == MessageId::All || it.first == message.getMessageId()) {
+                    consumers.push_back(it.second);
+                }
+            }
+        }
+        if (consumers.empty()) {
+            return nullptr;
+        }
+        return MessageFactory::instance().Create(message);
+    }
+}
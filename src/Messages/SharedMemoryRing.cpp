@@ -0,0 +1,292 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Contracts.h"
+#include "Messages/SharedMemoryRing.h"
+
+// The ring is shared between processes, so its atomics must not rely on a
+// process-local lock.
+static_assert(ATOMIC_INT_LOCK_FREE == 2 && ATOMIC_LLONG_LOCK_FREE == 2,
+              "Shared memory ring requires lock free atomics");
+
+namespace PCOE {
+    static const std::uint32_t RingMagic = 0x47534150;
+    static const std::uint32_t RingVersion = 2;
+    static const std::size_t CacheLine = 64;
+
+    struct SharedMemoryRing::Header {
+        struct Reader {
+            alignas(CacheLine) std::atomic<std::uint32_t> active;
+            std::atomic<std::int32_t> pid; // 0 while the reader is attaching
+            std::atomic<std::uint64_t> readPosition;
+        };
+
+        std::atomic<std::uint32_t> magic;
+        std::uint32_t version;
+        std::uint64_t capacity;
+        alignas(CacheLine) std::atomic<std::uint64_t> writePosition;
+        Reader readers[MaxReaders];
+    };
+
+    constexpr std::size_t SharedMemoryRing::MaxReaders;
+
+    const std::size_t SharedMemoryRing::HeaderSize =
+        (sizeof(SharedMemoryRing::Header) + CacheLine - 1) & ~(CacheLine - 1);
+
+    SharedMemoryRing::SharedMemoryRing(const std::string& name, std::size_t capacity)
+        : name(name),
+          owner(true),
+          mapping(nullptr),
+          mappingSize(0),
+          header(nullptr),
+          data(nullptr),
+          ringCapacity(capacity),
+          stream(&buffer) {
+        if (capacity < 4096 || (capacity & (capacity - 1)) != 0) {
+            throw std::domain_error("Capacity must be a power of two of at least 4096");
+        }
+
+        int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "shm_open");
+        }
+        std::size_t size = HeaderSize + capacity;
+        if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+            int error = errno;
+            close(fd);
+            shm_unlink(name.c_str());
+            throw std::system_error(error, std::generic_category(), "ftruncate");
+        }
+        try {
+            map(fd, size);
+        }
+        catch (...) {
+            shm_unlink(name.c_str());
+            throw;
+        }
+
+        header = new (mapping) Header();
+        header->version = RingVersion;
+        header->capacity = capacity;
+        header->writePosition.store(0, std::memory_order_relaxed);
+        for (Header::Reader& reader : header->readers) {
+            reader.active.store(0, std::memory_order_relaxed);
+            reader.pid.store(0, std::memory_order_relaxed);
+            reader.readPosition.store(0, std::memory_order_relaxed);
+        }
+        header->magic.store(RingMagic, std::memory_order_release);
+    }
+
+    SharedMemoryRing::SharedMemoryRing(const std::string& name)
+        : name(name),
+          owner(false),
+          mapping(nullptr),
+          mappingSize(0),
+          header(nullptr),
+          data(nullptr),
+          ringCapacity(0),
+          stream(&buffer) {
+        int fd = shm_open(name.c_str(), O_RDWR, 0600);
+        if (fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "shm_open");
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            int error = errno;
+            close(fd);
+            throw std::system_error(error, std::generic_category(), "fstat");
+        }
+        std::size_t size = static_cast<std::size_t>(info.st_size);
+        if (size < HeaderSize) {
+            close(fd);
+            throw std::runtime_error("Shared memory object is not a ring");
+        }
+        map(fd, size);
+
+        header = static_cast<Header*>(mapping);
+        if (header->magic.load(std::memory_order_acquire) != RingMagic ||
+            header->version != RingVersion || header->capacity != size - HeaderSize) {
+            munmap(mapping, mappingSize);
+            throw std::runtime_error("Shared memory object is not a ring");
+        }
+        ringCapacity = static_cast<std::size_t>(header->capacity);
+    }
+
+    SharedMemoryRing::~SharedMemoryRing() {
+        munmap(mapping, mappingSize);
+        if (owner) {
+            shm_unlink(name.c_str());
+        }
+    }
+
+    void SharedMemoryRing::map(int fd, std::size_t size) {
+        void* result = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        int error = errno;
+        close(fd);
+        if (result == MAP_FAILED) {
+            throw std::system_error(error, std::generic_category(), "mmap");
+        }
+        mapping = result;
+        mappingSize = size;
+        data = static_cast<char*>(mapping) + HeaderSize;
+    }
+
+    std::size_t SharedMemoryRing::readers() const {
+        std::size_t count = 0;
+        for (const Header::Reader& reader : header->readers) {
+            if (reader.active.load(std::memory_order_acquire) != 0) {
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    std::uint64_t SharedMemoryRing::oldestReadPosition(std::uint64_t writePosition) const {
+        std::uint64_t result = writePosition;
+        for (const Header::Reader& reader : header->readers) {
+            if (reader.active.load(std::memory_order_acquire) != 0) {
+                std::uint64_t position = reader.readPosition.load(std::memory_order_acquire);
+                if (position < result) {
+                    result = position;
+                }
+            }
+        }
+        return result;
+    }
+
+    bool SharedMemoryRing::reclaimReaders() {
+        bool reclaimed = false;
+        for (Header::Reader& reader : header->readers) {
+            if (reader.active.load(std::memory_order_acquire) == 0) {
+                continue;
+            }
+            std::int32_t pid = reader.pid.load(std::memory_order_acquire);
+            if (pid == 0 || kill(static_cast<pid_t>(pid), 0) == 0 || errno != ESRCH) {
+                continue;
+            }
+            // Clear the process id before the slot is released, so that a
+            // reader attaching to the slot is not mistaken for the dead one
+            if (reader.pid.compare_exchange_strong(pid, 0)) {
+                reader.active.store(0, std::memory_order_release);
+                reclaimed = true;
+            }
+        }
+        return reclaimed;
+    }
+
+    bool SharedMemoryRing::tryWrite(const Message& message) {
+        if (!owner) {
+            throw std::domain_error("Only the process that created a ring can write to it");
+        }
+        std::size_t size = message.getSerializedSize();
+        if (size > ringCapacity / 2) {
+            throw std::domain_error("Message too large for ring");
+        }
+
+        std::lock_guard<std::mutex> lock(writeMutex);
+        std::uint64_t position = header->writePosition.load(std::memory_order_relaxed);
+        std::size_t offset = static_cast<std::size_t>(position & (ringCapacity - 1));
+        std::size_t contiguous = ringCapacity - offset;
+        std::size_t required = size > contiguous ? contiguous + size : size;
+        if (position + required - oldestReadPosition(position) > ringCapacity) {
+            // Only look for readers whose process has exited once one of them
+            // is holding up the writer, so writes normally make no system
+            // calls.
+            if (!reclaimReaders() ||
+                position + required - oldestReadPosition(position) > ringCapacity) {
+                return false;
+            }
+        }
+
+        if (size > contiguous) {
+            // A zero version tells readers to continue reading at the start of
+            // the ring. Positions are multiples of 8, so there is always room
+            // for the marker.
+            std::memset(data + offset, 0, sizeof(std::uint64_t));
+            position += contiguous;
+            offset = 0;
+        }
+
+        buffer.reset(data + offset, size);
+        stream.clear();
+        message.serialize(stream);
+        Ensure(buffer.written() == size, "Serialized size");
+        header->writePosition.store(position + size, std::memory_order_release);
+        return true;
+    }
+
+    void SharedMemoryRing::write(const Message& message) {
+        while (!tryWrite(message)) {
+            std::this_thread::yield();
+        }
+    }
+
+    SharedMemoryReader::SharedMemoryReader(SharedMemoryRing& ring) : ring(ring), position(0) {
+        for (slot = 0; slot < SharedMemoryRing::MaxReaders; slot++) {
+            std::uint32_t expected = 0;
+            if (ring.header->readers[slot].active.compare_exchange_strong(expected, 1)) {
+                break;
+            }
+        }
+        if (slot == SharedMemoryRing::MaxReaders) {
+            throw std::runtime_error("Too many readers attached to ring");
+        }
+        position = ring.header->writePosition.load(std::memory_order_acquire);
+        ring.header->readers[slot].readPosition.store(position, std::memory_order_release);
+        ring.header->readers[slot].pid.store(getpid(), std::memory_order_release);
+    }
+
+    SharedMemoryReader::~SharedMemoryReader() {
+        ring.header->readers[slot].pid.store(0, std::memory_order_relaxed);
+        ring.header->readers[slot].active.store(0, std::memory_order_release);
+    }
+
+    std::size_t SharedMemoryReader::pending() const {
+        return static_cast<std::size_t>(
+            ring.header->writePosition.load(std::memory_order_acquire) - position);
+    }
+
+    const char* SharedMemoryReader::peek(std::size_t& available) {
+        for (;;) {
+            std::uint64_t end = ring.header->writePosition.load(std::memory_order_acquire);
+            if (position == end) {
+                return nullptr;
+            }
+            std::size_t offset = static_cast<std::size_t>(position & (ring.ringCapacity - 1));
+            std::size_t contiguous = ring.ringCapacity - offset;
+            std::uint16_t version;
+            std::memcpy(&version, ring.data + offset, sizeof(version));
+            if (version == 0) {
+                advance(contiguous);
+                continue;
+            }
+            std::size_t written = static_cast<std::size_t>(end - position);
+            available = written < contiguous ? written : contiguous;
+            return ring.data + offset;
+        }
+    }
+
+    void SharedMemoryReader::advance(std::size_t size) {
+        position += size;
+        ring.header->readers[slot].readPosition.store(position, std::memory_order_release);
+    }
+
+    void SharedMemoryReader::skipPending() {
+        position = ring.header->writePosition.load(std::memory_order_acquire);
+        ring.header->readers[slot].readPosition.store(position, std::memory_order_release);
+    }
+}
@@ -0,0 +1,60 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#include "Messages/UDataMessage.h"
+
+namespace PCOE {
+    constexpr std::size_t WireCodec<UData>::HeaderSize;
+
+    std::size_t WireCodec<UData>::size(const UData& value) {
+        return HeaderSize + value.size() * sizeof(double);
+    }
+
+    void WireCodec<UData>::write(std::ostream& os, const UData& value) {
+        Expect(value.npoints() <= std::numeric_limits<std::uint32_t>::max(), "Point count");
+        wireWrite(os, static_cast<std::uint8_t>(value.uncertainty()));
+        wireWrite(os, static_cast<std::uint8_t>(value.layout()));
+        wireWrite(os, static_cast<std::uint8_t>(value.dist()));
+        wireWrite(os, static_cast<std::uint8_t>(value.valid() ? 1 : 0));
+        wireWrite(os, static_cast<std::uint32_t>(value.npoints()));
+        wireWrite(os, static_cast<std::int64_t>(value.updated()));
+        if (value.size() > 0) {
+            os.write(reinterpret_cast<const char*>(&*value.begin()),
+                     static_cast<std::streamsize>(value.size() * sizeof(double)));
+        }
+    }
+
+    UData WireCodec<UData>::read(WireReader& reader) {
+        std::uint8_t uncertainty = reader.read<std::uint8_t>();
+        std::uint8_t layout = reader.read<std::uint8_t>();
+        std::uint8_t dist = reader.read<std::uint8_t>();
+        bool valid = reader.read<std::uint8_t>() != 0;
+        std::uint32_t npoints = reader.read<std::uint32_t>();
+        std::int64_t updated = reader.read<std::int64_t>();
+        if (uncertainty > static_cast<std::uint8_t>(UType::WSamples) ||
+            layout > static_cast<std::uint8_t>(SampleLayout::Columnar) ||
+            dist > DIST_UNIFORM) {
+            throw FormatError("Invalid UData");
+        }
+
+        UType type = static_cast<UType>(uncertainty);
+        bool pointSized = type == UType::MeanCovar || type == UType::Samples ||
+                          type == UType::WSamples;
+        if (pointSized && npoints > reader.remaining() / sizeof(double)) {
+            throw FormatError("Message truncated");
+        }
+
+        UData result(type);
+        result.npoints(npoints);
+        result.layout(static_cast<SampleLayout>(layout));
+        for (UData::iterator it = result.begin(); it != result.end(); ++it) {
+            *it = reader.read<double>();
+        }
+        result.dist(static_cast<DIST_TYPE>(dist));
+        result.updated(static_cast<UData::time_ticks>(updated));
+        if (!valid) {
+            result.invalidate();
+        }
+        return result;
+    }
+}
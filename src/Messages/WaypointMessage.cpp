@@ -4,6 +4,7 @@
 #include <iostream>
 
 #include "Messages/WaypointMessage.h"
+#include "Messages/WireFormat.h"
 
 namespace PCOE {
     WaypointMessage::WaypointMessage(PCOE::MessageId id,
@@ -15,7 +16,7 @@ namespace PCOE {
                                      double alt)
         : Message(id, source, timestamp), eta(eta), point(lat, lon, alt) {}
 
-    std::uint16_t WaypointMessage::getPayloadSize() const {
+    std::uint32_t WaypointMessage::getPayloadSize() const {
         return 32;
     }
 
@@ -28,4 +29,20 @@ namespace PCOE {
         os.write(reinterpret_cast<const char*>(&lon), sizeof(lon));
         os.write(reinterpret_cast<const char*>(&alt), sizeof(alt));
     }
+
+    std::unique_ptr<WaypointMessage>
+    WaypointMessage::deserialize(const SerializedMessage& message) {
+        WireReader reader = message.payloadReader();
+        time_point eta(time_point::duration(reader.read<std::int64_t>()));
+        double lat = reader.read<double>();
+        double lon = reader.read<double>();
+        double alt = reader.read<double>();
+        return std::unique_ptr<WaypointMessage>(new WaypointMessage(message.getMessageId(),
+                                                                    message.getSource(),
+                                                                    message.getTimestamp(),
+                                                                    eta,
+                                                                    lat,
+                                                                    lon,
+                                                                    alt));
+    }
 }
@@ -414,6 +414,212 @@ SystemModel::output_type BatteryModel::outputEqn(double,
     return z_new;
 }
 
+// Terms of the Redlich-Kister expansions that are written with (x^2 - x)
+// rather than (2x - 1) as the leading factor. The output equation uses
+// (x^2 - x) throughout, as does the state equation for the positive
+// electrode, but the state equation writes most negative electrode terms
+// with (2x - 1).
+static const unsigned ALL_QUADRATIC_TERMS = 0x1FFE;
+static const unsigned STATE_NEGATIVE_QUADRATIC_TERMS = (1u << 7) | (1u << 8);
+
+/**
+ * Evaluates the Redlich-Kister expansion sum_k A[k] * (2k * g(x) * (2x - 1)^(k - 1) +
+ * (2x - 1)^(k + 1)) / F of an electrode potential and its derivative with
+ * respect to the mole fraction x. g(x) is x^2 - x for the terms set in
+ * {@code quadratic} and 2x - 1 for the rest.
+ **/
+static double redlichKister(const double (&A)[13],
+                            double F,
+                            double x,
+                            unsigned quadratic,
+                            double& derivative) {
+    double y = 2 * x - 1;
+    double yPow[14];
+    yPow[0] = 1;
+    for (int k = 1; k < 14; k++) {
+        yPow[k] = yPow[k - 1] * y;
+    }
+
+    double value = A[0] * y;
+    derivative = 2 * A[0];
+    for (int k = 1; k < 13; k++) {
+        bool isQuadratic = (quadratic >> k) & 1;
+        double g = isQuadratic ? x * x - x : y;
+        double dg = isQuadratic ? y : 2;
+        value += A[k] * (2 * k * g * yPow[k - 1] + yPow[k + 1]);
+        double dgy = dg * yPow[k - 1];
+        if (k > 1) {
+            dgy += g * 2 * (k - 1) * yPow[k - 2];
+        }
+        derivative += A[k] * (2 * k * dgy + 2 * (k + 1) * yPow[k]);
+    }
+    derivative /= F;
+    return value / F;
+}
+
+// Battery State Jacobian
+void BatteryModel::stateJacobian(double,
+                                 const state_type& x,
+                                 const input_type& u,
+                                 double dt,
+                                 Matrix& F) const {
+    Expect(F.rows() == getStateSize() && F.cols() == getStateSize(),
+           "Jacobian size does not match model");
+    computeStateJacobian(x, u, dt, F);
+}
+
+void BatteryModel::stateJacobian(double,
+                                 const state_type& x,
+                                 const input_type& u,
+                                 double dt,
+                                 FixedMatrix<8, 8>& F) const {
+    computeStateJacobian(x, u, dt, F);
+}
+
+template <class TMatrix>
+void BatteryModel::computeStateJacobian(const state_type& x,
+                                        const input_type& u,
+                                        double dt,
+                                        TMatrix& F) const {
+    Expect(x.size() == getStateSize(), "State size does not match model");
+    const Parameters& p = parameters;
+
+    // Extract states
+    double Tb = x[0];
+    double Vo = x[1];
+    double Vsn = x[2];
+    double Vsp = x[3];
+    double qnS = x[5];
+    double qpS = x[7];
+
+    // Extract inputs
+    double P = u[0];
+
+    // Electrode potentials and their derivatives with respect to mole fraction
+    const double An[] = {p.An0, p.An1, p.An2, p.An3, p.An4, p.An5, p.An6,
+                         p.An7, p.An8, p.An9, p.An10, p.An11, p.An12};
+    const double Ap[] = {p.Ap0, p.Ap1, p.Ap2, p.Ap3, p.Ap4, p.Ap5, p.Ap6,
+                         p.Ap7, p.Ap8, p.Ap9, p.Ap10, p.Ap11, p.Ap12};
+    double xnS = qnS / p.qSMax;
+    double xpS = qpS / p.qSMax;
+    double logN = log((1 - xnS) / xnS);
+    double logP = log((1 - xpS) / xpS);
+    double dVen;
+    double dVep;
+    double Ven = p.U0n + redlichKister(An, p.F, xnS, STATE_NEGATIVE_QUADRATIC_TERMS, dVen) +
+                 p.R * Tb * logN / p.F;
+    double Vep = p.U0p + redlichKister(Ap, p.F, xpS, ALL_QUADRATIC_TERMS, dVep) +
+                 p.R * Tb * logP / p.F;
+    dVen -= p.R * Tb / (p.F * xnS * (1 - xnS));
+    dVep -= p.R * Tb / (p.F * xpS * (1 - xpS));
+
+    // Current and its gradient with respect to the state
+    double V = Vep - Vo - Vsn - Vsp - Ven;
+    double i = P / V;
+    double dV[8] = {p.R * (logP - logN) / p.F, -1, -1, -1, 0, -dVen / p.qSMax, 0, dVep / p.qSMax};
+    double di[8];
+    for (int k = 0; k < 8; k++) {
+        di[k] = -i / V * dV[k];
+    }
+
+    // Gradients of the nominal surface overpotentials. With
+    // s = J / (2 * J0), Vs = R * Tb * asinh(s) / (F * alpha).
+    double c = p.R / (p.F * p.alpha);
+    double Jn0 = p.kn * pow(xnS, p.alpha) * pow(1 - xnS, p.alpha);
+    double Jp0 = p.kp * pow(xpS, p.alpha) * pow(1 - xpS, p.alpha);
+    double sn = i / p.Sn / (2 * Jn0);
+    double sp = i / p.Sp / (2 * Jp0);
+    double dLogJn0 = p.alpha * (1 / xnS - 1 / (1 - xnS)) / p.qSMax;
+    double dLogJp0 = p.alpha * (1 / xpS - 1 / (1 - xpS)) / p.qSMax;
+    double dVsnNominal[8];
+    double dVspNominal[8];
+    for (int k = 0; k < 8; k++) {
+        double dsn = di[k] / (2 * p.Sn * Jn0) - (k == 5 ? sn * dLogJn0 : 0);
+        double dsp = di[k] / (2 * p.Sp * Jp0) - (k == 7 ? sp * dLogJp0 : 0);
+        dVsnNominal[k] = c * Tb * dsn / sqrt(1 + sn * sn);
+        dVspNominal[k] = c * Tb * dsp / sqrt(1 + sp * sp);
+    }
+    dVsnNominal[0] += c * asinh(sn);
+    dVspNominal[0] += c * asinh(sp);
+
+    // Diffusion rates between the bulk and surface volumes
+    double dBulk = dt / (p.VolB * p.tDiffusion);
+    double dSurface = dt / (p.VolS * p.tDiffusion);
+
+    for (std::size_t row = 0; row < 8; row++) {
+        for (std::size_t col = 0; col < 8; col++) {
+            F[row][col] = 0;
+        }
+    }
+    F[0][0] = 1;
+    for (std::size_t k = 0; k < 8; k++) {
+        F[1][k] = dt * p.Ro * di[k] / p.to;
+        F[2][k] = dt * dVsnNominal[k] / p.tsn;
+        F[3][k] = dt * dVspNominal[k] / p.tsp;
+        F[5][k] = -dt * di[k];
+        F[7][k] = dt * di[k];
+    }
+    F[1][1] += 1 - dt / p.to;
+    F[2][2] += 1 - dt / p.tsn;
+    F[3][3] += 1 - dt / p.tsp;
+    F[4][4] = 1 - dBulk;
+    F[4][5] = dSurface;
+    F[5][4] += dBulk;
+    F[5][5] += 1 - dSurface;
+    F[6][6] = 1 - dBulk;
+    F[6][7] = dSurface;
+    F[7][6] += dBulk;
+    F[7][7] += 1 - dSurface;
+}
+
+// Battery Output Jacobian
+void BatteryModel::outputJacobian(double, const state_type& x, Matrix& H) const {
+    Expect(H.rows() == getOutputSize() && H.cols() == getStateSize(),
+           "Jacobian size does not match model");
+    computeOutputJacobian(x, H);
+}
+
+void BatteryModel::outputJacobian(double, const state_type& x, FixedMatrix<2, 8>& H) const {
+    computeOutputJacobian(x, H);
+}
+
+template <class TMatrix>
+void BatteryModel::computeOutputJacobian(const state_type& x, TMatrix& H) const {
+    Expect(x.size() == getStateSize(), "State size does not match model");
+    const Parameters& p = parameters;
+
+    // Extract states
+    double Tb = x[0];
+    double qnS = x[5];
+    double qpS = x[7];
+
+    const double An[] = {p.An0, p.An1, p.An2, p.An3, p.An4, p.An5, p.An6,
+                         p.An7, p.An8, p.An9, p.An10, p.An11, p.An12};
+    const double Ap[] = {p.Ap0, p.Ap1, p.Ap2, p.Ap3, p.Ap4, p.Ap5, p.Ap6,
+                         p.Ap7, p.Ap8, p.Ap9, p.Ap10, p.Ap11, p.Ap12};
+    double xnS = qnS / p.qSMax;
+    double xpS = qpS / p.qSMax;
+    double dVen;
+    double dVep;
+    redlichKister(An, p.F, xnS, ALL_QUADRATIC_TERMS, dVen);
+    redlichKister(Ap, p.F, xpS, ALL_QUADRATIC_TERMS, dVep);
+    dVen -= p.R * Tb / (p.F * xnS * (1 - xnS));
+    dVep -= p.R * Tb / (p.F * xpS * (1 - xpS));
+
+    for (std::size_t row = 0; row < 2; row++) {
+        for (std::size_t col = 0; col < 8; col++) {
+            H[row][col] = 0;
+        }
+    }
+    H[OUT::TEMP][0] = 1;
+    H[OUT::VOLTS][0] = p.R * (log((1 - xpS) / xpS) - log((1 - xnS) / xnS)) / p.F;
+    H[OUT::VOLTS][1] = -1;
+    H[OUT::VOLTS][2] = -1;
+    H[OUT::VOLTS][3] = -1;
+    H[OUT::VOLTS][5] = -dVen / p.qSMax;
+    H[OUT::VOLTS][7] = dVep / p.qSMax;
+}
+
 // Battery Threshold Equation
 std::vector<bool> BatteryModel::thresholdEqn(double t, const state_type& x) const {
     // Compute based on voltage, so use output equation to get voltage
@@ -0,0 +1,64 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "Contracts.h"
+#include "Models/SystemModel.h"
+
+namespace PCOE {
+    /**
+     * Gets the finite difference step for a state value, scaled so that the
+     * truncation and round-off errors of a central difference are balanced.
+     **/
+    static double differenceStep(double value) {
+        static const double scale = std::cbrt(std::numeric_limits<double>::epsilon());
+        return scale * std::max(1.0, std::abs(value));
+    }
+
+    void SystemModel::stateJacobian(const double t,
+                                    const state_type& x,
+                                    const input_type& u,
+                                    const double dt,
+                                    Matrix& F) const {
+        Expect(x.size() == stateSize, "State size does not match model");
+        Expect(F.rows() == stateSize && F.cols() == stateSize, "Jacobian size does not match model");
+
+        noise_type zeroNoise(stateSize);
+        state_type xh = x;
+        for (std::size_t j = 0; j < stateSize; j++) {
+            double h = differenceStep(x[j]);
+            xh[j] = x[j] + h;
+            auto plus = stateEqn(t, xh, u, zeroNoise, dt);
+            xh[j] = x[j] - h;
+            auto minus = stateEqn(t, xh, u, zeroNoise, dt);
+            xh[j] = x[j];
+            for (std::size_t i = 0; i < stateSize; i++) {
+                F[i][j] = (plus[i] - minus[i]) / (2 * h);
+            }
+        }
+    }
+
+    void SystemModel::outputJacobian(const double t, const state_type& x, Matrix& H) const {
+        Expect(x.size() == stateSize, "State size does not match model");
+        Expect(H.rows() == outputs.size() && H.cols() == stateSize,
+               "Jacobian size does not match model");
+
+        noise_type zeroNoise(outputs.size());
+        state_type xh = x;
+        for (std::size_t j = 0; j < stateSize; j++) {
+            double h = differenceStep(x[j]);
+            xh[j] = x[j] + h;
+            auto plus = outputEqn(t, xh, zeroNoise);
+            xh[j] = x[j] - h;
+            auto minus = outputEqn(t, xh, zeroNoise);
+            xh[j] = x[j];
+            for (std::size_t i = 0; i < outputs.size(); i++) {
+                H[i][j] = (plus[i] - minus[i]) / (2 * h);
+            }
+        }
+    }
+}
@@ -0,0 +1,70 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#include <cstdint>
+#include <new>
+
+#include "Contracts.h"
+#include "MonotonicArena.h"
+
+namespace PCOE {
+    struct MonotonicArena::Block {
+        Block* next;
+        std::size_t size;
+    };
+
+    // Block data starts after the header, rounded up so that the first
+    // allocation in a block is maximally aligned.
+    static const std::size_t BlockHeaderSize =
+        (sizeof(void*) + sizeof(std::size_t) + alignof(std::max_align_t) - 1) &
+        ~(alignof(std::max_align_t) - 1);
+
+    MonotonicArena::MonotonicArena(std::size_t initialSize)
+        : head(nullptr),
+          current(nullptr),
+          end(nullptr),
+          nextSize(initialSize == 0 ? 4096 : initialSize),
+          usedBytes(0),
+          blocks(0) {
+        addBlock(nextSize);
+    }
+
+    MonotonicArena::~MonotonicArena() {
+        while (head != nullptr) {
+            Block* next = head->next;
+            ::operator delete(head);
+            head = next;
+        }
+    }
+
+    void* MonotonicArena::allocate(std::size_t size, std::size_t alignment) {
+        Expect((alignment & (alignment - 1)) == 0, "Alignment must be a power of two");
+        Expect(alignment <= alignof(std::max_align_t), "Alignment too large");
+
+        auto address = reinterpret_cast<std::uintptr_t>(current);
+        std::size_t padding = (alignment - (address & (alignment - 1))) & (alignment - 1);
+        if (size + padding > static_cast<std::size_t>(end - current)) {
+            // Blocks double in size so that an arena whose initial size was
+            // underestimated still needs few blocks.
+            nextSize *= 2;
+            addBlock(size > nextSize ? size : nextSize);
+            padding = 0;
+        }
+
+        void* result = current + padding;
+        current += padding + size;
+        usedBytes += size;
+        return result;
+    }
+
+    void MonotonicArena::addBlock(std::size_t size) {
+        void* memory = ::operator new(BlockHeaderSize + size);
+        Block* block = static_cast<Block*>(memory);
+        block->next = head;
+        block->size = size;
+        head = block;
+        current = static_cast<char*>(memory) + BlockHeaderSize;
+        end = current + size;
+        ++blocks;
+    }
+}
@@ -0,0 +1,200 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+
+#include "Contracts.h"
+#include "Messages/UDataMessage.h"
+#include "Observers/AsyncFleetObserver.h"
+
+namespace PCOE {
+    static const Log& log = Log::Instance();
+    static const std::string MODULE_NAME = "OBS-FLEET";
+
+    static const std::size_t NOT_QUEUED = std::numeric_limits<std::size_t>::max();
+
+    AsyncFleetObserver::AsyncFleetObserver(MessageBus& messageBus,
+                                           std::unique_ptr<BatchUnscentedKalmanFilter>&& f,
+                                           std::vector<std::string> srcs)
+        : bus(messageBus),
+          filter(std::move(f)),
+          sources(std::move(srcs)),
+          inputMsgs(sources.size()),
+          outputMsgs(sources.size()),
+          queuedIndices(sources.size(), NOT_QUEUED),
+          lastTimes(sources.size(), -INFINITY) {
+        Expect(filter, "Filter pointer is empty");
+        Expect(sources.size() == filter->getAssetCount(), "Source count does not match fleet");
+
+        const SystemModel& model = filter->getModel();
+        hasInputs = model.getInputs().size() > 0;
+        hasOutputs = model.getOutputs().size() > 0;
+
+        lock_guard guard(m);
+        for (std::size_t a = 0; a < sources.size(); a++) {
+            const std::string& source = sources[a];
+            bool inserted = assetIndices.insert(std::make_pair(source, a)).second;
+            Expect(inserted, "Duplicate source");
+            watchers.emplace_back(new MessageWatcher<double>(bus,
+                                                             source,
+                                                             model.getInputs(),
+                                                             MessageId::ModelInputVector));
+            watchers.emplace_back(new MessageWatcher<double>(bus,
+                                                             source,
+                                                             model.getOutputs(),
+                                                             MessageId::ModelOutputVector));
+            bus.subscribe(this, source, MessageId::ModelInputVector);
+            bus.subscribe(this, source, MessageId::ModelOutputVector);
+        }
+    }
+
+    AsyncFleetObserver::~AsyncFleetObserver() {
+        lock_guard guard(m);
+        bus.unsubscribe(this);
+    }
+
+    void AsyncFleetObserver::processMessage(const std::shared_ptr<Message>& message) {
+        {
+            lock_guard guard(m);
+            auto it = assetIndices.find(message->getSource());
+            Expect(it != assetIndices.end(), "Unexpected source");
+            std::size_t a = it->second;
+
+            switch (message->getMessageId()) {
+            case MessageId::ModelInputVector:
+                log.WriteLine(LOG_TRACE, MODULE_NAME, "Set input message");
+                inputMsgs[a] = message;
+                break;
+            case MessageId::ModelOutputVector:
+                log.WriteLine(LOG_TRACE, MODULE_NAME, "Set ouput message");
+                outputMsgs[a] = message;
+                break;
+            default:
+                Unreachable("Unexpected message type");
+            }
+
+            if ((inputMsgs[a] || !hasInputs) && (outputMsgs[a] || !hasOutputs)) {
+                auto imsgVec = std::dynamic_pointer_cast<DoubleVecMessage, Message>(inputMsgs[a]);
+                auto omsgVec = std::dynamic_pointer_cast<DoubleVecMessage, Message>(outputMsgs[a]);
+                auto tIn = hasInputs ? inputMsgs[a]->getTimestamp() : Message::time_point();
+                auto tOut = hasOutputs ? outputMsgs[a]->getTimestamp() : Message::time_point();
+                auto timestamp = std::max(tIn, tOut);
+                inputMsgs[a] = nullptr;
+                outputMsgs[a] = nullptr;
+
+                BatchUnscentedKalmanFilter::Update update{
+                    a,
+                    seconds(timestamp),
+                    hasInputs ? SystemModel::input_type(imsgVec->getValue())
+                              : SystemModel::input_type(0),
+                    hasOutputs ? SystemModel::output_type(omsgVec->getValue())
+                               : SystemModel::output_type(0)};
+
+                if (update.time <= lastTimes[a]) {
+                    log.WriteLine(LOG_DEBUG,
+                                  MODULE_NAME,
+                                  "Skipping asset step. Time has not advanced.");
+                }
+                else if (queuedIndices[a] != NOT_QUEUED) {
+                    log.WriteLine(LOG_DEBUG, MODULE_NAME, "Replacing queued asset step");
+                    lastTimes[a] = update.time;
+                    queued[queuedIndices[a]] = std::move(update);
+                    queuedTimes[queuedIndices[a]] = timestamp;
+                }
+                else {
+                    lastTimes[a] = update.time;
+                    queuedIndices[a] = queued.size();
+                    queued.push_back(std::move(update));
+                    queuedTimes.push_back(timestamp);
+                }
+            }
+
+            if (queued.empty()) {
+                return;
+            }
+        }
+        stepFleet();
+    }
+
+    void AsyncFleetObserver::stepFleet() {
+        // A thread that fails to acquire the step lock leaves its data in the
+        // queue for the thread holding it. The holder checks the queue again
+        // after releasing the step lock, so data queued just before the
+        // release is not stranded.
+        while (true) {
+            unique_lock stepLock(stepMutex, std::try_to_lock);
+            if (!stepLock.owns_lock()) {
+                return;
+            }
+
+            while (true) {
+                {
+                    lock_guard guard(m);
+                    if (queued.empty()) {
+                        break;
+                    }
+                    for (const auto& update : queued) {
+                        queuedIndices[update.asset] = NOT_QUEUED;
+                    }
+                    batch.swap(queued);
+                    batchTimes.swap(queuedTimes);
+                    queued.clear();
+                    queuedTimes.clear();
+                }
+
+                // Assets seen for the first time are initialized rather than
+                // stepped, and are removed from the batch
+                std::size_t stepCount = 0;
+                for (std::size_t i = 0; i < batch.size(); i++) {
+                    auto& update = batch[i];
+                    if (!filter->isInitialized(update.asset)) {
+                        log.FormatLine(LOG_TRACE,
+                                       MODULE_NAME,
+                                       "Initializing asset %s",
+                                       sources[update.asset].c_str());
+                        auto x = filter->getModel().initialize(update.u, update.z);
+                        filter->initialize(update.asset, update.time, x, update.u);
+                        continue;
+                    }
+                    if (stepCount != i) {
+                        batch[stepCount] = std::move(update);
+                        batchTimes[stepCount] = batchTimes[i];
+                    }
+                    stepCount++;
+                }
+                auto stepEnd = static_cast<decltype(batch)::difference_type>(stepCount);
+                batch.erase(batch.begin() + stepEnd, batch.end());
+                batchTimes.erase(batchTimes.begin() + stepEnd, batchTimes.end());
+
+                log.FormatLine(LOG_TRACE, MODULE_NAME, "Stepping %u assets", batch.size());
+                auto failed = filter->step(batch);
+
+                // Assets that failed to step keep their previous estimate,
+                // which has already been published
+                log.WriteLine(LOG_TRACE, MODULE_NAME, "Publishing observer results");
+                for (std::size_t i = 0; i < batch.size(); i++) {
+                    std::size_t a = batch[i].asset;
+                    if (std::find(failed.begin(), failed.end(), a) != failed.end()) {
+                        continue;
+                    }
+                    bus.publish(std::shared_ptr<Message>(
+                        new UDataVecMessage(MessageId::ModelStateEstimate,
+                                            sources[a],
+                                            batchTimes[i],
+                                            filter->getStateEstimate(a))));
+                }
+                batch.clear();
+                batchTimes.clear();
+            }
+
+            stepLock.unlock();
+            lock_guard guard(m);
+            if (queued.empty()) {
+                return;
+            }
+        }
+    }
+}
@@ -0,0 +1,418 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "Contracts.h"
+#include "Observers/BatchUnscentedKalmanFilter.h"
+#include "Observers/KalmanFilterTools.h"
+#include "ThreadSafeLog.h"
+
+namespace PCOE {
+    static const Log& log = Log::Instance();
+
+    // Other string constants
+    const std::string MODULE_NAME = "OBS-BUKF";
+
+    /**
+     * Computes the lower-triangular Cholesky factor of each lane of the
+     * n x n matrices stored in {@code A}, where element (i, j) of lane b is
+     * at [(i * n + j) * stride + b]. The upper triangle of {@code L} is
+     * zeroed.
+     *
+     * A lane that is not positive definite is marked in {@code failed}, and
+     * its factor is not meaningful. The other lanes are unaffected.
+     **/
+    static void batchChol(const double* A,
+                          std::size_t n,
+                          std::size_t stride,
+                          std::size_t lanes,
+                          double* L,
+                          char* failed) {
+        std::fill_n(failed, lanes, 0);
+        for (std::size_t j = 0; j < n; j++) {
+            for (std::size_t k = 0; k < j; k++) {
+                double* ljk = L + (j * n + k) * stride;
+                const double* ajk = A + (j * n + k) * stride;
+                for (std::size_t b = 0; b < lanes; b++) {
+                    ljk[b] = ajk[b];
+                }
+                for (std::size_t l = 0; l < k; l++) {
+                    const double* ljl = L + (j * n + l) * stride;
+                    const double* lkl = L + (k * n + l) * stride;
+                    for (std::size_t b = 0; b < lanes; b++) {
+                        ljk[b] -= ljl[b] * lkl[b];
+                    }
+                }
+                const double* lkk = L + (k * n + k) * stride;
+                for (std::size_t b = 0; b < lanes; b++) {
+                    ljk[b] /= lkk[b];
+                }
+            }
+
+            double* ljj = L + (j * n + j) * stride;
+            const double* ajj = A + (j * n + j) * stride;
+            for (std::size_t b = 0; b < lanes; b++) {
+                ljj[b] = ajj[b];
+            }
+            for (std::size_t l = 0; l < j; l++) {
+                const double* ljl = L + (j * n + l) * stride;
+                for (std::size_t b = 0; b < lanes; b++) {
+                    ljj[b] -= ljl[b] * ljl[b];
+                }
+            }
+            // A failed lane continues with a unit pivot so that it stays
+            // finite, which keeps the remaining kernels free of branches.
+            for (std::size_t b = 0; b < lanes; b++) {
+                if (!(ljj[b] > 0)) {
+                    failed[b] = 1;
+                    ljj[b] = 1;
+                }
+                ljj[b] = std::sqrt(ljj[b]);
+            }
+
+            for (std::size_t k = j + 1; k < n; k++) {
+                std::fill_n(L + (j * n + k) * stride, lanes, 0.0);
+            }
+        }
+    }
+
+    /**
+     * Computes result = offset + A * diag(w) * B' for each lane, where A and B
+     * hold {@code aRows} and {@code bRows} rows of sigma points. When
+     * {@code symmetric} is set, A and B must be the same matrix, and only the
+     * upper triangle is computed before being mirrored.
+     **/
+    static void batchSigmaPointProduct(const double* A,
+                                       std::size_t aRows,
+                                       const double* B,
+                                       std::size_t bRows,
+                                       const std::vector<double>& w,
+                                       const Matrix* offset,
+                                       bool symmetric,
+                                       std::size_t stride,
+                                       std::size_t lanes,
+                                       double* result) {
+        const std::size_t k = w.size();
+        for (std::size_t i = 0; i < aRows; i++) {
+            for (std::size_t j = symmetric ? i : 0; j < bRows; j++) {
+                double* rij = result + (i * bRows + j) * stride;
+                std::fill_n(rij, lanes, offset ? offset->at(i, j) : 0.0);
+                for (std::size_t p = 0; p < k; p++) {
+                    const double* aip = A + (i * k + p) * stride;
+                    const double* bjp = B + (j * k + p) * stride;
+                    for (std::size_t b = 0; b < lanes; b++) {
+                        rij[b] += w[p] * aip[b] * bjp[b];
+                    }
+                }
+            }
+        }
+        if (symmetric) {
+            for (std::size_t i = 0; i < aRows; i++) {
+                for (std::size_t j = 0; j < i; j++) {
+                    std::copy_n(result + (j * bRows + i) * stride,
+                                lanes,
+                                result + (i * bRows + j) * stride);
+                }
+            }
+        }
+    }
+
+    /**
+     * Computes the weighted mean of each row of sigma points in each lane and
+     * subtracts it from the row, leaving the deviations from the mean in
+     * {@code M}.
+     **/
+    static void batchCenterSigmaPoints(double* M,
+                                       std::size_t rows,
+                                       const std::vector<double>& w,
+                                       std::size_t stride,
+                                       std::size_t lanes,
+                                       double* mean) {
+        const std::size_t k = w.size();
+        for (std::size_t i = 0; i < rows; i++) {
+            double* mi = mean + i * stride;
+            std::fill_n(mi, lanes, 0.0);
+            for (std::size_t p = 0; p < k; p++) {
+                const double* mip = M + (i * k + p) * stride;
+                for (std::size_t b = 0; b < lanes; b++) {
+                    mi[b] += w[p] * mip[b];
+                }
+            }
+            for (std::size_t p = 0; p < k; p++) {
+                double* mip = M + (i * k + p) * stride;
+                for (std::size_t b = 0; b < lanes; b++) {
+                    mip[b] -= mi[b];
+                }
+            }
+        }
+    }
+
+    BatchUnscentedKalmanFilter::BatchUnscentedKalmanFilter(const SystemModel& m,
+                                                           std::size_t assetCount,
+                                                           const Matrix& Q,
+                                                           const Matrix& R)
+        : model(m), assetCount(assetCount), Q(Q), R(R) {
+        Expect(assetCount > 0, "Empty fleet");
+        Expect(Q.rows() == Q.cols(), "Q is not square");
+        Expect(Q.rows() == model.getStateSize(), "Size of Q does not match model state size");
+        Expect(R.rows() == R.cols(), "R is not square");
+        Expect(R.rows() == model.getOutputSize(), "Size of R does not match model output size");
+
+        const std::size_t stateSize = model.getStateSize();
+        const std::size_t outputSize = model.getOutputSize();
+        initSigmaPoints(stateSize, sigma);
+        const std::size_t sigmaPointCount = sigma.w.size();
+        sqrtQ = Q.chol();
+
+        initialized.resize(assetCount);
+        lastTime.resize(assetCount);
+        uPrev.resize(assetCount, model.getInputVector());
+        x.resize(stateSize * assetCount);
+        P.resize(stateSize * stateSize * assetCount);
+
+        ws.inBatch.resize(assetCount);
+        ws.xk = model.getStateVector();
+        ws.zeroNoise.resize(stateSize);
+        ws.zeroNoiseZ.resize(outputSize);
+        ws.wc.resize(sigmaPointCount);
+        ws.dt.resize(assetCount);
+        ws.failed.resize(assetCount);
+        ws.X.resize(stateSize * sigmaPointCount * assetCount);
+        ws.dX.resize(stateSize * sigmaPointCount * assetCount);
+        ws.dZ.resize(outputSize * sigmaPointCount * assetCount);
+        ws.xkk1.resize(stateSize * assetCount);
+        ws.zkk1.resize(outputSize * assetCount);
+        ws.Pkk1.resize(stateSize * stateSize * assetCount);
+        ws.Pzz.resize(outputSize * outputSize * assetCount);
+        ws.Pxz.resize(stateSize * outputSize * assetCount);
+        ws.Lzz.resize(outputSize * outputSize * assetCount);
+        ws.Kk.resize(stateSize * outputSize * assetCount);
+
+        log.FormatLine(LOG_INFO, MODULE_NAME, "Created batch UKF for %u assets", assetCount);
+    }
+
+    void BatchUnscentedKalmanFilter::initialize(std::size_t asset,
+                                                double t0,
+                                                const SystemModel::state_type& x0,
+                                                const SystemModel::input_type& u0) {
+        Expect(asset < assetCount, "Asset index out of range");
+        Expect(x0.size() == model.getStateSize(), "State size does not match model");
+        log.FormatLine(LOG_DEBUG, MODULE_NAME, "Initializing asset %u", asset);
+
+        const std::size_t stateSize = model.getStateSize();
+        lastTime[asset] = t0;
+        uPrev[asset] = u0;
+        for (std::size_t i = 0; i < stateSize; i++) {
+            x[i * assetCount + asset] = x0[i];
+            for (std::size_t j = 0; j < stateSize; j++) {
+                P[(i * stateSize + j) * assetCount + asset] = Q[i][j];
+            }
+        }
+        initialized[asset] = true;
+    }
+
+    std::vector<std::size_t>
+    BatchUnscentedKalmanFilter::step(const std::vector<Update>& updates) {
+        const std::size_t lanes = updates.size();
+        if (lanes == 0) {
+            return {};
+        }
+        log.FormatLine(LOG_DEBUG, MODULE_NAME, "Starting step of %u assets", lanes);
+
+        bool unique = true;
+        for (const auto& update : updates) {
+            Expect(update.asset < assetCount, "Asset index out of range");
+            Expect(initialized[update.asset], "Not initialized");
+            Expect(update.time - lastTime[update.asset] > 0, "Time has not advanced");
+            Expect(update.z.size() == model.getOutputSize(), "Output size does not match model");
+            unique = unique && !ws.inBatch[update.asset];
+            ws.inBatch[update.asset] = true;
+        }
+        for (const auto& update : updates) {
+            ws.inBatch[update.asset] = false;
+        }
+        Expect(unique, "Asset appears more than once in batch");
+
+        const std::size_t K = assetCount;
+        const std::size_t stateSize = model.getStateSize();
+        const std::size_t outputSize = model.getOutputSize();
+        const std::size_t sigmaPointCount = sigma.w.size();
+        Expect(stateSize + sigma.kappa > 0, "Non-positive sigma point spread");
+
+        // 1. Predict
+        // As in the single-asset filter, the sigma points of every asset are
+        // spread by the Cholesky factor of the process noise covariance
+        for (std::size_t b = 0; b < lanes; b++) {
+            ws.dt[b] = updates[b].time - lastTime[updates[b].asset];
+        }
+        computeSigmaPointWeights(stateSize, sigma);
+        double spread = sigma.alpha * std::sqrt(stateSize + sigma.kappa);
+        for (std::size_t i = 0; i < stateSize; i++) {
+            double* center = &ws.X[(i * sigmaPointCount) * K];
+            for (std::size_t b = 0; b < lanes; b++) {
+                center[b] = x[i * K + updates[b].asset];
+            }
+            for (std::size_t j = 0; j < stateSize; j++) {
+                double offset = spread * sqrtQ[i][j];
+                double* plus = &ws.X[(i * sigmaPointCount + j + 1) * K];
+                double* minus = &ws.X[(i * sigmaPointCount + j + stateSize + 1) * K];
+                for (std::size_t b = 0; b < lanes; b++) {
+                    plus[b] = center[b] + offset;
+                    minus[b] = center[b] - offset;
+                }
+            }
+        }
+
+        // Propagate sigma points through the state and output equations
+        for (std::size_t b = 0; b < lanes; b++) {
+            const Update& update = updates[b];
+            for (std::size_t p = 0; p < sigmaPointCount; p++) {
+                for (std::size_t i = 0; i < stateSize; i++) {
+                    ws.xk[i] = ws.X[(i * sigmaPointCount + p) * K + b];
+                }
+                auto xp = model.stateEqn(update.time,
+                                         ws.xk,
+                                         uPrev[update.asset],
+                                         ws.zeroNoise,
+                                         ws.dt[b]);
+                for (std::size_t i = 0; i < stateSize; i++) {
+                    ws.dX[(i * sigmaPointCount + p) * K + b] = xp[i];
+                }
+                auto zp = model.outputEqn(update.time, xp, ws.zeroNoiseZ);
+                for (std::size_t j = 0; j < outputSize; j++) {
+                    ws.dZ[(j * sigmaPointCount + p) * K + b] = zp[j];
+                }
+            }
+        }
+
+        // Recombine weighted sigma points to produce predicted state and
+        // measurement, leaving the deviations from them in dX and dZ
+        batchCenterSigmaPoints(ws.dX.data(), stateSize, sigma.w, K, lanes, ws.xkk1.data());
+        batchCenterSigmaPoints(ws.dZ.data(), outputSize, sigma.w, K, lanes, ws.zkk1.data());
+
+        // Covariance weights add the alpha/beta term to the central point, as
+        // the single-asset filter does
+        std::copy(sigma.w.begin(), sigma.w.end(), ws.wc.begin());
+        ws.wc[0] += 1 - sigma.alpha * sigma.alpha + sigma.beta;
+
+        // Predicted state and measurement covariance, and the state-output
+        // cross-covariance
+        batchSigmaPointProduct(ws.dX.data(),
+                               stateSize,
+                               ws.dX.data(),
+                               stateSize,
+                               ws.wc,
+                               &Q,
+                               true,
+                               K,
+                               lanes,
+                               ws.Pkk1.data());
+        batchSigmaPointProduct(ws.dZ.data(),
+                               outputSize,
+                               ws.dZ.data(),
+                               outputSize,
+                               ws.wc,
+                               &R,
+                               true,
+                               K,
+                               lanes,
+                               ws.Pzz.data());
+        batchSigmaPointProduct(ws.dX.data(),
+                               stateSize,
+                               ws.dZ.data(),
+                               outputSize,
+                               sigma.w,
+                               nullptr,
+                               false,
+                               K,
+                               lanes,
+                               ws.Pxz.data());
+
+        // 2. Update
+        // Compute Kalman gain Kk = Pxz * Pzz^-1 with the Cholesky factor of
+        // Pzz, solving all lanes side by side. Assets whose Pzz is not
+        // positive definite are left as they were.
+        batchChol(ws.Pzz.data(), outputSize, K, lanes, ws.Lzz.data(), ws.failed.data());
+        kalmanGain(ws.Lzz.data(), ws.Pxz.data(), ws.Kk.data(), stateSize, outputSize, K, lanes);
+
+        // Replace the predicted output with the innovation z - zkk1
+        for (std::size_t j = 0; j < outputSize; j++) {
+            for (std::size_t b = 0; b < lanes; b++) {
+                ws.zkk1[j * K + b] = updates[b].z[j] - ws.zkk1[j * K + b];
+            }
+        }
+
+        // Compute state estimate xkk1 + Kk * innovation
+        for (std::size_t i = 0; i < stateSize; i++) {
+            double* xi = &ws.xkk1[i * K];
+            for (std::size_t j = 0; j < outputSize; j++) {
+                const double* kij = &ws.Kk[(i * outputSize + j) * K];
+                const double* vj = &ws.zkk1[j * K];
+                for (std::size_t b = 0; b < lanes; b++) {
+                    xi[b] += kij[b] * vj[b];
+                }
+            }
+        }
+
+        // Compute covariance P = Pkk1 - Kk * Pzz * Kk', where Kk * Pzz = Pxz
+        for (std::size_t i = 0; i < stateSize; i++) {
+            for (std::size_t j = i; j < stateSize; j++) {
+                double* pij = &ws.Pkk1[(i * stateSize + j) * K];
+                for (std::size_t l = 0; l < outputSize; l++) {
+                    const double* pxz = &ws.Pxz[(i * outputSize + l) * K];
+                    const double* kjl = &ws.Kk[(j * outputSize + l) * K];
+                    for (std::size_t b = 0; b < lanes; b++) {
+                        pij[b] -= pxz[b] * kjl[b];
+                    }
+                }
+            }
+        }
+
+        // Scatter the lanes back to their assets
+        std::vector<std::size_t> failedAssets;
+        for (std::size_t b = 0; b < lanes; b++) {
+            std::size_t a = updates[b].asset;
+            if (ws.failed[b]) {
+                log.FormatLine(LOG_WARN,
+                               MODULE_NAME,
+                               "Output covariance of asset %u is not positive definite",
+                               a);
+                failedAssets.push_back(a);
+                continue;
+            }
+            for (std::size_t i = 0; i < stateSize; i++) {
+                x[i * K + a] = ws.xkk1[i * K + b];
+                for (std::size_t j = i; j < stateSize; j++) {
+                    double pij = ws.Pkk1[(i * stateSize + j) * K + b];
+                    P[(i * stateSize + j) * K + a] = pij;
+                    P[(j * stateSize + i) * K + a] = pij;
+                }
+            }
+            uPrev[a] = updates[b].u;
+            lastTime[a] = updates[b].time;
+        }
+        return failedAssets;
+    }
+
+    std::vector<UData> BatchUnscentedKalmanFilter::getStateEstimate(std::size_t asset) const {
+        Expect(asset < assetCount, "Asset index out of range");
+        const std::size_t stateSize = model.getStateSize();
+        std::vector<UData> state(stateSize);
+        for (std::size_t i = 0; i < stateSize; i++) {
+            state[i].uncertainty(UType::MeanCovar);
+            state[i].npoints(stateSize);
+            state[i][MEAN] = x[i * assetCount + asset];
+            std::vector<double> row(stateSize);
+            for (std::size_t j = 0; j < stateSize; j++) {
+                row[j] = P[(i * stateSize + j) * assetCount + asset];
+            }
+            state[i][COVAR()] = row;
+        }
+        return state;
+    }
+}
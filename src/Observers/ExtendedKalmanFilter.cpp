@@ -0,0 +1,179 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#include <string>
+#include <vector>
+
+#include "ConfigMap.h"
+#include "Contracts.h"
+#include "Observers/ExtendedKalmanFilter.h"
+#include "Observers/KalmanFilterTools.h"
+#include "ThreadSafeLog.h"
+#include "UData.h"
+
+namespace PCOE {
+    const static Log& log = Log::Instance();
+
+    // Configuration Keys
+    const std::string Q_KEY = "Observer.Q";
+    const std::string R_KEY = "Observer.R";
+
+    // Other string constants
+    const std::string MODULE_NAME = "OBS-EKF";
+
+    /**
+     * Replaces {@code A} with offset + (A + A') / 2. Products that are
+     * symmetric in exact arithmetic can differ from their transpose by
+     * rounding, which the Cholesky factorization would reject.
+     **/
+    static void symmetrize(Matrix& A, const Matrix& offset) {
+        for (std::size_t i = 0; i < A.rows(); i++) {
+            for (std::size_t j = i; j < A.cols(); j++) {
+                double value = offset[i][j] + 0.5 * (A[i][j] + A[j][i]);
+                A[i][j] = value;
+                A[j][i] = value;
+            }
+        }
+    }
+
+    ExtendedKalmanFilter::ExtendedKalmanFilter(const SystemModel& m) : Observer(m) {
+        xEstimated = model.getStateVector();
+        uPrev = model.getInputVector();
+
+        // Set up step workspace
+        std::size_t stateSize = model.getStateSize();
+        std::size_t outputSize = model.getOutputSize();
+        P.resize(stateSize, stateSize);
+        ws.zeroNoise.resize(stateSize);
+        ws.zeroNoiseZ.resize(outputSize);
+        ws.F.resize(stateSize, stateSize);
+        ws.H.resize(outputSize, stateSize);
+        ws.FP.resize(stateSize, stateSize);
+        ws.Pkk1.resize(stateSize, stateSize);
+        ws.Pxz.resize(stateSize, outputSize);
+        ws.Pzz.resize(outputSize, outputSize);
+        ws.Lzz.resize(outputSize, outputSize);
+        ws.Kk.resize(stateSize, outputSize);
+    }
+
+    ExtendedKalmanFilter::ExtendedKalmanFilter(const SystemModel& m, Matrix q, Matrix r)
+        : ExtendedKalmanFilter(m) {
+        Expect(q.rows() == q.cols(), "Q is not square");
+        Expect(q.rows() == model.getStateSize(), "Size of Q does not match model state size");
+        Expect(r.rows() == r.cols(), "R is not square");
+        Expect(r.rows() == model.getOutputSize(), "Size of R does not match model output size");
+
+        Q = std::move(q);
+        R = std::move(r);
+    }
+
+    ExtendedKalmanFilter::ExtendedKalmanFilter(const SystemModel& m, const ConfigMap& config)
+        : ExtendedKalmanFilter(m) {
+        requireKeys(config, {Q_KEY, R_KEY});
+
+        log.WriteLine(LOG_TRACE, MODULE_NAME, "Setting Q and R");
+        Q = readSquareMatrix(config, Q_KEY);
+        R = readSquareMatrix(config, R_KEY);
+        Require(Q.rows() == model.getStateSize(), "Size of Q does not match model state size");
+        Require(R.rows() == model.getOutputSize(), "Size of R does not match model output size");
+
+        log.WriteLine(LOG_INFO, MODULE_NAME, "Created EKF");
+    }
+
+    void ExtendedKalmanFilter::initialize(double t0,
+                                          const SystemModel::state_type& x0,
+                                          const SystemModel::input_type& u0) {
+        log.WriteLine(LOG_DEBUG, MODULE_NAME, "Initializing");
+
+        // Initialize time, state, inputs
+        lastTime = t0;
+        xEstimated = x0;
+        uPrev = u0;
+
+        // Initialize P
+        P = Q;
+
+        // Set initialized flag
+        initialized = true;
+        log.WriteLine(LOG_DEBUG, MODULE_NAME, "Initialize completed");
+    }
+
+    void ExtendedKalmanFilter::step(double timestamp,
+                                    const SystemModel::input_type& u,
+                                    const SystemModel::output_type& z) {
+        log.WriteLine(LOG_DEBUG, MODULE_NAME, "Starting step");
+        Expect(isInitialized(), "Not initialized");
+        Expect(timestamp - lastTime > 0, "Time has not advanced");
+
+        // Update time
+        double dt = timestamp - lastTime;
+        lastTime = timestamp;
+
+        const std::size_t stateSize = model.getStateSize();
+        const std::size_t outputSize = model.getOutputSize();
+
+        // 1. Predict
+        log.WriteLine(LOG_TRACE, MODULE_NAME, "Starting step - predict");
+
+        // Linearize about the current estimate, then propagate the estimate
+        model.stateJacobian(timestamp, xEstimated, uPrev, dt, ws.F);
+        auto xkk1 = model.stateEqn(timestamp, xEstimated, uPrev, ws.zeroNoise, dt);
+
+        // Predicted state covariance Pkk1 = F * P * F' + Q
+        Matrix::multiply(ws.F, P, ws.FP);
+        Matrix::multiplyTransposed(ws.FP, ws.F, ws.Pkk1);
+        symmetrize(ws.Pkk1, Q);
+
+        // Predicted output, linearized about the predicted state
+        model.outputJacobian(timestamp, xkk1, ws.H);
+        auto zkk1 = model.outputEqn(timestamp, xkk1, ws.zeroNoiseZ);
+
+        // State-output cross-covariance Pxz = Pkk1 * H', and output
+        // covariance Pzz = H * Pkk1 * H' + R = H * Pxz + R
+        Matrix::multiplyTransposed(ws.Pkk1, ws.H, ws.Pxz);
+        Matrix::multiply(ws.H, ws.Pxz, ws.Pzz);
+        symmetrize(ws.Pzz, R);
+
+        // 2. Update
+        log.WriteLine(LOG_TRACE, MODULE_NAME, "Starting step - update");
+
+        // Compute Kalman gain Kk = Pxz * Pzz^-1 with the Cholesky factor of Pzz
+        ws.Pzz.chol(ws.Lzz);
+        kalmanGain(ws.Lzz, ws.Pxz, ws.Kk);
+
+        // Compute state estimate
+        for (std::size_t i = 0; i < stateSize; i++) {
+            double correction = 0;
+            for (std::size_t j = 0; j < outputSize; j++) {
+                correction += ws.Kk[i][j] * (z[j] - zkk1[j]);
+            }
+            xEstimated[i] = xkk1[i] + correction;
+        }
+
+        // Compute covariance P = Pkk1 - Kk * Pzz * Kk', where Kk * Pzz = Pxz
+        for (std::size_t i = 0; i < stateSize; i++) {
+            for (std::size_t j = i; j < stateSize; j++) {
+                double sum = ws.Pkk1[i][j];
+                for (std::size_t l = 0; l < outputSize; l++) {
+                    sum -= ws.Pxz[i][l] * ws.Kk[j][l];
+                }
+                P[i][j] = sum;
+                P[j][i] = sum;
+            }
+        }
+
+        // Update uOld
+        uPrev = u;
+    }
+
+    std::vector<UData> ExtendedKalmanFilter::getStateEstimate() const {
+        std::vector<UData> state(model.getStateSize());
+        for (unsigned int i = 0; i < model.getStateSize(); i++) {
+            state[i].uncertainty(UType::MeanCovar);
+            state[i].npoints(model.getStateSize());
+            state[i][MEAN] = xEstimated[i];
+            state[i][COVAR()] = static_cast<std::vector<double>>(P.rowView(i));
+        }
+        return state;
+    }
+}
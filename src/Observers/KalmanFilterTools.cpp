@@ -0,0 +1,75 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+#include "ConfigMap.h"
+#include "Contracts.h"
+#include "Observers/KalmanFilterTools.h"
+
+namespace PCOE {
+    Matrix readSquareMatrix(const ConfigMap& config, const std::string& key) {
+        auto& values = config.getVector(key);
+        auto dim = static_cast<std::size_t>(std::sqrt(values.size()));
+        Require(dim * dim == values.size(), "Values can not describe a square matrix");
+        Matrix result(dim, dim);
+        for (std::size_t row = 0; row < dim; row++) {
+            for (std::size_t col = 0; col < dim; col++) {
+                result[row][col] = std::stod(values[row * dim + col]);
+            }
+        }
+        return result;
+    }
+
+    void kalmanGain(const Matrix& Lzz, const Matrix& Pxz, Matrix& K) {
+        Expect(Lzz.rows() == Lzz.cols(), "Cholesky factor is not square");
+        Expect(Pxz.cols() == Lzz.rows(), "Cross-covariance does not match output size");
+        Expect(K.rows() == Pxz.rows() && K.cols() == Pxz.cols(), "Gain is not the right size");
+        kalmanGain(Lzz.getData(), Pxz.getData(), K.getData(), Pxz.rows(), Pxz.cols(), 1, 1);
+    }
+
+    void kalmanGain(const double* Lzz,
+                    const double* Pxz,
+                    double* K,
+                    std::size_t stateSize,
+                    std::size_t outputSize,
+                    std::size_t stride,
+                    std::size_t lanes) {
+        for (std::size_t i = 0; i < stateSize; i++) {
+            // Forward substitution, L * y = Pxz(i, :)'
+            for (std::size_t j = 0; j < outputSize; j++) {
+                double* kij = K + (i * outputSize + j) * stride;
+                std::copy_n(Pxz + (i * outputSize + j) * stride, lanes, kij);
+                for (std::size_t l = 0; l < j; l++) {
+                    const double* ljl = Lzz + (j * outputSize + l) * stride;
+                    const double* kil = K + (i * outputSize + l) * stride;
+                    for (std::size_t b = 0; b < lanes; b++) {
+                        kij[b] -= ljl[b] * kil[b];
+                    }
+                }
+                const double* ljj = Lzz + (j * outputSize + j) * stride;
+                for (std::size_t b = 0; b < lanes; b++) {
+                    kij[b] /= ljj[b];
+                }
+            }
+
+            // Back substitution, L' * K(i, :)' = y
+            for (std::size_t j = outputSize; j-- > 0;) {
+                double* kij = K + (i * outputSize + j) * stride;
+                for (std::size_t l = j + 1; l < outputSize; l++) {
+                    const double* llj = Lzz + (l * outputSize + j) * stride;
+                    const double* kil = K + (i * outputSize + l) * stride;
+                    for (std::size_t b = 0; b < lanes; b++) {
+                        kij[b] -= llj[b] * kil[b];
+                    }
+                }
+                const double* ljj = Lzz + (j * outputSize + j) * stride;
+                for (std::size_t b = 0; b < lanes; b++) {
+                    kij[b] /= ljj[b];
+                }
+            }
+        }
+    }
+}
@@ -1,14 +1,20 @@
-// Copyright (c) 2017-2018 United States Government as represented by the
+// Copyright (c) 2017-2019 United States Government as represented by the
 // Administrator of the National Aeronautics and Space Administration.
 // All Rights Reserved.
 #include <algorithm>
 #include <cmath>
+#include <functional>
+#include <limits>
 #include <numeric>
+#include <stdexcept>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "ConfigMap.h"
+#include "MatrixDecomposition.h"
 #include "Observers/ParticleFilter.h"
+#include "StringUtils.h"
 #include "UData.h"
 
 namespace PCOE {
@@ -23,12 +29,33 @@ namespace PCOE {
     const std::string PN_KEY = "Observer.ProcessNoise";
     const std::string SN_KEY = "Observer.SensorNoise";
     const std::string NEFF_KEY = "Observer.MinEffective";
+    const std::string THREADS_KEY = "Observer.ThreadCount";
+    const std::string RESAMPLING_KEY = "Observer.Resampling";
+    const std::string KLD_BIN_KEY = "Observer.KLD.BinSize";
+    const std::string KLD_MIN_KEY = "Observer.KLD.MinParticleCount";
+    const std::string KLD_MAX_KEY = "Observer.KLD.MaxParticleCount";
+    const std::string KLD_EPSILON_KEY = "Observer.KLD.Epsilon";
+    const std::string KLD_QUANTILE_KEY = "Observer.KLD.Quantile";
+
+    // Default KLD-sampling error bound and the standard normal quantile for
+    // delta = 0.01
+    const double KLD_DEFAULT_EPSILON = 0.05;
+    const double KLD_DEFAULT_QUANTILE = 2.326;
+
+    // Smallest number of particles worth handing to a separate thread
+    const std::size_t MIN_PARTICLES_PER_THREAD = 64;
 
     // Other string constants
     const std::string MODULE_NAME = "OBS-PF";
 
-    ParticleFilter::ParticleFilter(const SystemModel& m) : Observer(m) {
+    ParticleFilter::ParticleFilter(const SystemModel& m)
+        : Observer(m),
+          resamplingScheme(ResamplingScheme::Systematic),
+          adaptive(false),
+          logNormalizer(NAN),
+          sensorCovarianceValid(false) {
         uPrev = model.getInputVector();
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
     }
 
     ParticleFilter::ParticleFilter(const SystemModel& m,
@@ -48,10 +75,7 @@ namespace PCOE {
         sensorNoiseVariance = sensorNoise;
         setSensorCovariance();
 
-        // Set up sigma point matrices and weights for x
-        particles.X.resize(model.getStateSize(), particleCount);
-        particles.Z.resize(model.getOutputSize(), particleCount);
-        particles.w.resize(particleCount);
+        allocateParticles();
     }
 
     ParticleFilter::ParticleFilter(const SystemModel& m, const ConfigMap& config)
@@ -61,10 +85,7 @@ namespace PCOE {
         // Set N
         particleCount = static_cast<std::size_t>(config.getUInt64(N_KEY));
         setMinEffective(particleCount / 3);
-
-        particles.X.resize(model.getStateSize(), particleCount);
-        particles.Z.resize(model.getOutputSize(), particleCount);
-        particles.w.resize(particleCount);
+        allocateParticles();
 
         // Set process noise variance
         log.WriteLine(LOG_TRACE, MODULE_NAME, "Setting process noise variance vector");
@@ -90,6 +111,50 @@ namespace PCOE {
             setMinEffective(static_cast<std::size_t>(config.getDouble(NEFF_KEY)));
         }
 
+        // Set thread count (optional)
+        if (config.hasKey(THREADS_KEY)) {
+            setThreadCount(static_cast<std::size_t>(config.getUInt64(THREADS_KEY)));
+        }
+
+        // Set resampling scheme (optional)
+        if (config.hasKey(RESAMPLING_KEY)) {
+            std::string scheme = config.getString(RESAMPLING_KEY);
+            toLower(scheme);
+            if (scheme == "systematic") {
+                setResamplingScheme(ResamplingScheme::Systematic);
+            }
+            else if (scheme == "stratified") {
+                setResamplingScheme(ResamplingScheme::Stratified);
+            }
+            else if (scheme == "residual") {
+                setResamplingScheme(ResamplingScheme::Residual);
+            }
+            else if (scheme == "multinomial") {
+                setResamplingScheme(ResamplingScheme::Multinomial);
+            }
+            else {
+                throw std::domain_error("Unknown resampling scheme '" + scheme + "'");
+            }
+        }
+
+        // Set KLD-sampling (optional)
+        if (config.hasKey(KLD_BIN_KEY)) {
+            requireKeys(config, {KLD_MIN_KEY, KLD_MAX_KEY});
+            KLDSampling params;
+            params.binSize = config.getDoubleVector(KLD_BIN_KEY);
+            params.minCount = static_cast<std::size_t>(config.getUInt64(KLD_MIN_KEY));
+            params.maxCount = static_cast<std::size_t>(config.getUInt64(KLD_MAX_KEY));
+            params.epsilon = KLD_DEFAULT_EPSILON;
+            if (config.hasKey(KLD_EPSILON_KEY)) {
+                params.epsilon = config.getDouble(KLD_EPSILON_KEY);
+            }
+            params.quantile = KLD_DEFAULT_QUANTILE;
+            if (config.hasKey(KLD_QUANTILE_KEY)) {
+                params.quantile = config.getDouble(KLD_QUANTILE_KEY);
+            }
+            enableKLDSampling(params);
+        }
+
         Ensure(processNoiseVariance.size() == model.getStateSize(),
                "Process noise variance vector size does not match model state vector size");
         Ensure(sensorNoiseVariance.size() == model.getOutputSize(),
@@ -103,14 +168,17 @@ namespace PCOE {
         log.WriteLine(LOG_DEBUG, MODULE_NAME, "Initializing");
         // TODO (JW): This contract is now stated in the constructor, so it
         //            should be guaranteed here. Consider removing.
-        Expect(particles.X.rows() == model.getStateSize(),
-               "particles.X row count does not match model state size");
-        Expect(particles.X.cols() == particleCount,
-               "particles.X col count does not match particle count");
+        Expect(particles.X.rows() == particleCount,
+               "particles.X row count does not match particle count");
+        Expect(particles.X.cols() == model.getStateSize(),
+               "particles.X col count does not match model state size");
 
         // Set up random number generator
         std::random_device rDevice;
         rng.seed(rDevice());
+        for (auto& blockRng : blockRngs) {
+            blockRng.seed(rng());
+        }
 
         // Initialize time, state, inputs
         lastTime = t0;
@@ -120,14 +188,16 @@ namespace PCOE {
         std::vector<double> zeroNoiseZ(model.getOutputSize(), 0);
 
         // Initialize particles
+        SystemModel::output_type z0 = model.outputEqn(t0, x0, zeroNoiseZ);
+        std::vector<double> x0Values = x0.vec();
         for (size_t p = 0; p < particleCount; p++) {
-            particles.X.col(p, x0.vec());
-            SystemModel::output_type z0 = model.getOutputVector();
-            std::vector<double> zeroNoise(model.getOutputSize(), 0);
-            z0 = model.outputEqn(t0, x0, zeroNoise);
-            particles.Z.col(p, z0.vec());
+            particles.X.row(p, x0Values);
+            for (std::size_t j = 0; j < z0.size(); j++) {
+                particles.Z[j][p] = z0[j];
+            }
             // Set w all equal, since we aren't adding any noise
             particles.w[p] = 1.0 / particleCount;
+            particles.logW[p] = -std::log(static_cast<double>(particleCount));
         }
 
         initialized = true;
@@ -140,108 +210,396 @@ namespace PCOE {
         log.WriteLine(LOG_DEBUG, MODULE_NAME, "Starting step");
         Expect(initialized, "Step before initialization");
         Expect(newT - lastTime > 0, "Time has not advanced");
+        Expect(sensorCovarianceValid, "Sensor covariance is not positive definite");
 
         double dt = newT - lastTime;
         lastTime = newT;
 
-        std::vector<double> noise(model.getStateSize());
-        std::vector<double> zeroNoise(model.getOutputSize());
+        // Propagate contiguous blocks of particles in parallel. Each block
+        // uses its own random number generator, so results do not depend on
+        // how the blocks are scheduled. The worker threads are started on the
+        // first step that needs them and reused after that.
+        std::size_t blockCount = std::min(
+            threadCount,
+            std::max<std::size_t>(1, particleCount / MIN_PARTICLES_PER_THREAD));
+        std::size_t blockSize = (particleCount + blockCount - 1) / blockCount;
+        if (blockCount > 1 && !workers) {
+            workers.reset(new WorkerPool(threadCount - 1));
+        }
+        auto propagateBlock = [&](std::size_t b) {
+            std::size_t begin = std::min(particleCount, b * blockSize);
+            std::size_t end = std::min(particleCount, begin + blockSize);
+            propagate(newT, dt, begin, end, blockRngs[b]);
+        };
+        if (blockCount > 1) {
+            workers->run(blockCount, propagateBlock);
+        }
+        else {
+            propagateBlock(0);
+        }
+
+        // Update weights in the log domain to avoid underflow when the
+        // likelihood of every particle is small.
+        logLikelihood(z, likelihoodBuffer);
         for (std::size_t p = 0; p < particleCount; p++) {
-            generateProcessNoise(noise);
+            particles.logW[p] += likelihoodBuffer[p];
+        }
+
+        resample(normalize());
+        uPrev = u;
+    }
+
+    void ParticleFilter::propagate(double t,
+                                   double dt,
+                                   std::size_t begin,
+                                   std::size_t end,
+                                   std::mt19937& gen) {
+        const std::size_t stateSize = model.getStateSize();
+        const std::size_t outputSize = model.getOutputSize();
+        std::vector<double> noise(stateSize);
+        std::vector<double> zeroNoise(outputSize);
+        auto x = model.getStateVector();
+        for (std::size_t p = begin; p < end; p++) {
+            // Each particle is a contiguous row of particles.X
+            auto row = particles.X[p];
+            for (std::size_t i = 0; i < stateSize; i++) {
+                x[i] = row[i];
+            }
 
             // Generate new particle
-            auto xNew =
-                SystemModel::state_type(static_cast<std::vector<double>>(particles.X.col(p)));
-            xNew = model.stateEqn(newT, xNew, uPrev, noise, dt);
-            particles.X.col(p, xNew.vec());
-            auto zNew = model.outputEqn(newT, xNew, zeroNoise);
-            particles.Z.col(p, zNew.vec());
+            generateProcessNoise(noise, gen);
+            x = model.stateEqn(t, x, uPrev, noise, dt);
+            for (std::size_t i = 0; i < stateSize; i++) {
+                row[i] = x[i];
+            }
 
-            // Set weight
-            particles.w[p] = likelihood(z, zNew);
-            particles.w[p] = likelihood(z, zNew);
+            auto zNew = model.outputEqn(t, x, zeroNoise);
+            for (std::size_t j = 0; j < outputSize; j++) {
+                particles.Z[j][p] = zNew[j];
+            }
         }
+    }
 
-        normalize();
-        resample();
-        uPrev = u;
+    void ParticleFilter::setThreadCount(std::size_t value) {
+        Expect(value > 0, "Thread count must be positive");
+        if (value != threadCount) {
+            workers.reset();
+        }
+        threadCount = value;
+        blockRngs.resize(threadCount);
+        for (auto& blockRng : blockRngs) {
+            blockRng.seed(rng());
+        }
+    }
+
+    void ParticleFilter::enableKLDSampling(const KLDSampling& params) {
+        Expect(params.binSize.size() == model.getStateSize(),
+               "Bin size vector size does not match model state vector size");
+        Expect(std::all_of(params.binSize.begin(),
+                           params.binSize.end(),
+                           [](double b) { return b > 0; }),
+               "Bin sizes must be positive");
+        Expect(params.minCount > 0, "Minimum particle count must be positive");
+        Expect(params.minCount <= params.maxCount,
+               "Minimum particle count is greater than maximum particle count");
+        Expect(params.epsilon > 0, "KLD error bound must be positive");
+        kld = params;
+        adaptive = true;
+    }
+
+    void ParticleFilter::allocateParticles() {
+        particles.X.resize(particleCount, model.getStateSize());
+        particles.Z.resize(model.getOutputSize(), particleCount);
+        particles.w.resize(particleCount);
+        particles.logW.resize(particleCount);
+        resampled.X.resize(particleCount, model.getStateSize());
+        resampled.Z.resize(model.getOutputSize(), particleCount);
+        likelihoodBuffer.resize(particleCount);
+        innovationBuffer.resize(particleCount);
+        resampleIndices.reserve(particleCount);
+        setThreadCount(threadCount);
     }
 
     std::vector<UData> ParticleFilter::getStateEstimate() const {
         std::vector<UData> state(model.getStateSize());
         for (unsigned int i = 0; i < model.getStateSize(); i++) {
             state[i].uncertainty(UType::WeightedSamples);
+            state[i].layout(SampleLayout::Columnar);
             state[i].npoints(particleCount);
-            for (std::size_t p = 0; p < particleCount; p++) {
-                state[i][SAMPLE(p)] = particles.X[i][p];
-                state[i][WEIGHT(p)] = particles.w[p];
-            }
+            state[i].samples() = particles.X.colView(i);
+            std::copy(particles.w.begin(), particles.w.end(), state[i].weights().data());
         }
         return state;
     }
 
-    // Normalize particle weighs
-    void ParticleFilter::normalize() {
-        // Compute sum of weights
-        double sumWeights = std::accumulate(particles.w.begin(), particles.w.end(), 0.0);
-        for (size_t p = 0; p < particles.w.size(); p++) {
-            particles.w[p] /= sumWeights;
+    // Normalize particle weights
+    double ParticleFilter::normalize() {
+        // Streaming log-sum-exp: sum and sumSquares hold the sums of
+        // exp(logW - maxLogW) and exp(2 * (logW - maxLogW)), rescaled whenever
+        // a new maximum is found.
+        double maxLogW = -std::numeric_limits<double>::infinity();
+        double sum = 0;
+        double sumSquares = 0;
+        for (std::size_t p = 0; p < particleCount; p++) {
+            double logW = particles.logW[p];
+            if (logW > maxLogW) {
+                double scale = std::exp(maxLogW - logW);
+                sum = sum * scale + 1.0;
+                sumSquares = sumSquares * scale * scale + 1.0;
+                maxLogW = logW;
+            }
+            else {
+                double wp = std::exp(logW - maxLogW);
+                sum += wp;
+                sumSquares += wp * wp;
+            }
         }
+        double logSum = maxLogW + std::log(sum);
+        Ensure(std::isfinite(logSum), "Particle weights are not finite");
+
+        for (std::size_t p = 0; p < particleCount; p++) {
+            particles.logW[p] -= logSum;
+            particles.w[p] = std::exp(particles.logW[p]);
+        }
+
+        // Effective sample size: 1/sum(w^2), where w = exp(logW - maxLogW) / sum
+        return sum * sum / sumSquares;
     }
 
     // Resample particles
-    void ParticleFilter::resample() {
-        // Compute effective sample size: 1/sum(w^2)
-        double nEffective = 0;
-        for (size_t p = 0; p < particles.w.size(); p++) {
-            nEffective += particles.w[p] * particles.w[p];
+    void ParticleFilter::resample(double nEffective) {
+        if (adaptive) {
+            kldResample();
+        }
+        else if (nEffective < minEffective) {
+            selectParticles(resamplingScheme,
+                            particles.w,
+                            particleCount,
+                            rng,
+                            resampleIndices,
+                            likelihoodBuffer);
         }
-        nEffective = 1.0 / nEffective;
+        else {
+            return;
+        }
+        applyResample();
+    }
 
-        if (nEffective < minEffective) {
-            systematicResample();
+    /**
+     * Selects {@code count} indices by walking the CDF of {@code w} with the
+     * non-decreasing sequence of points {@code u(p)} in [0, 1).
+     **/
+    template <class Points>
+    static void walkCdf(const std::vector<double>& w,
+                        std::size_t count,
+                        Points u,
+                        std::vector<std::size_t>& indices) {
+        indices.resize(count);
+        std::size_t i = 0;
+        double cdf = w[0];
+        for (std::size_t p = 0; p < count; p++) {
+            double up = u(p);
+            while (up > cdf && i < w.size() - 1) {
+                i += 1;
+                cdf += w[i];
+            }
+            indices[p] = i;
+        }
+    }
+
+    /**
+     * Draws {@code count} indices independently from the unnormalized
+     * cumulative weights {@code cdf}, appending them to {@code indices}.
+     **/
+    static void drawFromCdf(const std::vector<double>& cdf,
+                            std::size_t count,
+                            std::mt19937& rng,
+                            std::vector<std::size_t>& indices) {
+        std::uniform_real_distribution<> distribution(0, cdf.back());
+        for (std::size_t p = 0; p < count; p++) {
+            auto it = std::upper_bound(cdf.begin(), cdf.end(), distribution(rng));
+            auto i = static_cast<std::size_t>(it - cdf.begin());
+            indices.push_back(std::min(i, cdf.size() - 1));
         }
     }
 
-    void ParticleFilter::systematicResample() {
+    static void systematicResample(const std::vector<double>& w,
+                                   std::size_t count,
+                                   std::mt19937& rng,
+                                   std::vector<std::size_t>& indices) {
         // Resamples the particles to be distributed around the higher-weight particles,
         // to increase the effective number of particles and reduce degeneracy.
         // Note that particle weights must be normalized before calling this function.
+        // A single random offset is shared by all of the points.
+        std::uniform_real_distribution<> distribution(0, 1.0 / count);
+        double u1 = distribution(rng);
+        double n = static_cast<double>(count);
+        walkCdf(w, count, [&](std::size_t p) { return u1 + p / n; }, indices);
+    }
 
-        // Copy particles
-        Particles newParticles = particles;
+    static void stratifiedResample(const std::vector<double>& w,
+                                   std::size_t count,
+                                   std::mt19937& rng,
+                                   std::vector<std::size_t>& indices) {
+        // Draws one point uniformly from each of count equal strata
+        std::uniform_real_distribution<> distribution(0, 1.0);
+        double n = static_cast<double>(count);
+        walkCdf(w, count, [&](std::size_t p) { return (p + distribution(rng)) / n; }, indices);
+    }
 
-        // Construct CDF
-        std::vector<double> cumSum(particles.w.size());
-        std::partial_sum(particles.w.begin(), particles.w.end(), cumSum.begin());
-        size_t i = 1;
+    static void residualResample(const std::vector<double>& w,
+                                 std::size_t count,
+                                 std::mt19937& rng,
+                                 std::vector<std::size_t>& indices,
+                                 std::vector<double>& cdf) {
+        // Keeps floor(N * w) copies of each particle, then draws the remaining
+        // particles from the residual weights.
+        indices.clear();
+        double n = static_cast<double>(count);
+        double cumulativeResidual = 0;
+        for (std::size_t i = 0; i < w.size(); i++) {
+            double expected = n * w[i];
+            double copies = std::floor(expected);
+            indices.insert(indices.end(), static_cast<std::size_t>(copies), i);
+            cumulativeResidual += expected - copies;
+            cdf[i] = cumulativeResidual;
+        }
 
-        // Draw starting point from U[0,1/particleCount]
-        std::uniform_real_distribution<> distribution(0, 1.0 / particleCount);
-        double u1 = distribution(rng);
+        // Rounding in the weights could produce one particle too many
+        indices.resize(std::min(indices.size(), count));
+        std::size_t remaining = count - indices.size();
+        if (remaining > 0) {
+            drawFromCdf(cdf, remaining, rng, indices);
+        }
+    }
 
-        double u;
-        for (size_t p = 0; p < particleCount; p++) {
-            // Move along CDF
-            u = u1 + (p - 1.0) / particleCount;
-            while (u > cumSum[i]) {
-                i += 1;
+    static void multinomialResample(const std::vector<double>& w,
+                                    std::size_t count,
+                                    std::mt19937& rng,
+                                    std::vector<std::size_t>& indices,
+                                    std::vector<double>& cdf) {
+        // Draws each particle independently in proportion to the weights
+        indices.clear();
+        std::partial_sum(w.begin(), w.end(), cdf.begin());
+        drawFromCdf(cdf, count, rng, indices);
+    }
+
+    void ParticleFilter::selectParticles(ResamplingScheme scheme,
+                                         const std::vector<double>& w,
+                                         std::size_t count,
+                                         std::mt19937& rng,
+                                         std::vector<std::size_t>& indices,
+                                         std::vector<double>& buffer) {
+        Expect(!w.empty(), "No weights to select from");
+        buffer.resize(w.size());
+        switch (scheme) {
+        case ResamplingScheme::Systematic:
+            systematicResample(w, count, rng, indices);
+            break;
+        case ResamplingScheme::Stratified:
+            stratifiedResample(w, count, rng, indices);
+            break;
+        case ResamplingScheme::Residual:
+            residualResample(w, count, rng, indices, buffer);
+            break;
+        case ResamplingScheme::Multinomial:
+            multinomialResample(w, count, rng, indices, buffer);
+            break;
+        default:
+            Unreachable("Unknown resampling scheme");
+        }
+    }
+
+    /**
+     * Computes the number of particles needed to bound the KL divergence of a
+     * posterior occupying {@code k} bins, using the Wilson-Hilferty
+     * approximation of the chi-square quantile.
+     **/
+    static double kldBound(std::size_t k, double epsilon, double quantile) {
+        if (k < 2) {
+            return 0;
+        }
+        double a = 2.0 / (9.0 * (k - 1));
+        double b = 1.0 - a + std::sqrt(a) * quantile;
+        return (k - 1) / (2.0 * epsilon) * b * b * b;
+    }
+
+    void ParticleFilter::kldResample() {
+        std::partial_sum(particles.w.begin(), particles.w.end(), likelihoodBuffer.begin());
+        std::uniform_real_distribution<> distribution(0, likelihoodBuffer.back());
+
+        const std::size_t stateSize = particles.X.cols();
+        std::vector<std::int64_t> bin(stateSize);
+        kldBins.clear();
+        resampleIndices.clear();
+        double target = static_cast<double>(kld.minCount);
+        while (resampleIndices.size() < kld.maxCount &&
+               (resampleIndices.size() < kld.minCount || resampleIndices.size() < target)) {
+            auto it = std::upper_bound(likelihoodBuffer.begin(),
+                                       likelihoodBuffer.end(),
+                                       distribution(rng));
+            auto i = static_cast<std::size_t>(it - likelihoodBuffer.begin());
+            i = std::min(i, particleCount - 1);
+            resampleIndices.push_back(i);
+
+            // Find the bin of the drawn particle
+            auto x = particles.X[i];
+            for (std::size_t k = 0; k < stateSize; k++) {
+                bin[k] = static_cast<std::int64_t>(std::floor(x[k] / kld.binSize[k]));
+            }
+            if (kldBins.insert(bin).second) {
+                target = kldBound(kldBins.size(), kld.epsilon, kld.quantile);
             }
-            // Reassign particle
-            newParticles.X.col(p, particles.X.col(i));
-            newParticles.Z.col(p, particles.Z.col(i));
         }
+        log.FormatLine(LOG_TRACE,
+                       MODULE_NAME,
+                       "KLD-sampling drew %u particles from %u bins",
+                       resampleIndices.size(),
+                       kldBins.size());
+    }
 
-        // Reassign weights so that all equal
-        for (size_t p = 0; p < particleCount; p++) {
-            newParticles.w[p] = 1.0 / particleCount;
+    void ParticleFilter::applyResample() {
+        const std::size_t newCount = resampleIndices.size();
+        const std::size_t stateSize = particles.X.cols();
+        const std::size_t outputSize = particles.Z.rows();
+        if (resampled.X.rows() != newCount) {
+            resampled.X.resize(newCount, stateSize);
+            resampled.Z.resize(outputSize, newCount);
         }
 
-        // Copy over resampled particles
-        particles = newParticles;
+        for (std::size_t p = 0; p < newCount; p++) {
+            std::size_t i = resampleIndices[p];
+            auto src = particles.X[i];
+            auto dst = resampled.X[p];
+            for (std::size_t k = 0; k < stateSize; k++) {
+                dst[k] = src[k];
+            }
+            for (std::size_t j = 0; j < outputSize; j++) {
+                resampled.Z[j][p] = particles.Z[j][i];
+            }
+        }
+
+        // Swap buffers instead of copying the resampled particles back
+        swap(particles.X, resampled.X);
+        swap(particles.Z, resampled.Z);
+
+        if (newCount != particleCount) {
+            particleCount = newCount;
+            particles.w.resize(particleCount);
+            particles.logW.resize(particleCount);
+            likelihoodBuffer.resize(particleCount);
+            innovationBuffer.resize(particleCount);
+        }
+
+        // Reassign weights so that all equal
+        double logWeight = -std::log(static_cast<double>(particleCount));
+        for (std::size_t p = 0; p < particleCount; p++) {
+            particles.w[p] = 1.0 / particleCount;
+            particles.logW[p] = logWeight;
+        }
     }
 
-    void ParticleFilter::generateProcessNoise(std::vector<double>& noise) {
+    void ParticleFilter::generateProcessNoise(std::vector<double>& noise, std::mt19937& gen) {
         // TODO (JW): The first contract is the one originally checked, but the
         //            second is the one actually required by the for loop. They
         //            should be the same anyway. Consider removing check on
@@ -251,31 +609,83 @@ namespace PCOE {
                "Noise size does not match process noise variance size");
         for (size_t n = 0; n < processNoiseVariance.size(); n++) {
             std::normal_distribution<> distribution(0, sqrt(processNoiseVariance[n]));
-            noise[n] = distribution(rng);
+            noise[n] = distribution(gen);
         }
     }
 
-    double ParticleFilter::likelihood(const SystemModel::output_type& zActual,
-                                      const SystemModel::output_type& zPredicted) {
-        // Compute innovation
-        Matrix zA(zActual.size(), 1);
-        Matrix zP(zActual.size(), 1);
-        zA.col(0, zActual.vec());
-        zP.col(0, zPredicted.vec());
-        Matrix I = zA - zP;
-        Matrix expArgument = -0.5 * I.transpose() * R.inverse() * I;
-        double lh = 1.0 / pow(2.0 * PI, zActual.size() / 2.0) * 1.0 / sqrt(R.determinant()) *
-                    exp(expArgument[0][0]);
-        return lh;
+    void ParticleFilter::logLikelihood(const SystemModel::output_type& zActual,
+                                       std::vector<double>& result) {
+        const std::size_t outputCount = particles.Z.rows();
+        Expect(zActual.size() == outputCount, "Output size does not match particle outputs");
+        Expect(result.size() == particleCount, "Result size does not match particle count");
+
+        // Accumulate the squared Mahalanobis distance of each particle in
+        // result. Row i of the whitened innovation is the dot product of row i
+        // of RInvChol with the innovation, evaluated for all particles at once
+        // so that the inner loops run over contiguous rows of particles.Z.
+        // The row is built in innovationBuffer, since result may be
+        // likelihoodBuffer.
+        std::fill(result.begin(), result.end(), 0.0);
+        const double* L = RInvChol.getData();
+        const double* Z = particles.Z.getData();
+        for (std::size_t i = 0; i < outputCount; i++) {
+            std::fill(innovationBuffer.begin(), innovationBuffer.end(), 0.0);
+            for (std::size_t k = 0; k <= i; k++) {
+                const double c = L[i * outputCount + k];
+                const double zk = zActual[k];
+                const double* Zk = Z + k * particleCount;
+                for (std::size_t p = 0; p < particleCount; p++) {
+                    innovationBuffer[p] += c * (zk - Zk[p]);
+                }
+            }
+            for (std::size_t p = 0; p < particleCount; p++) {
+                result[p] += innovationBuffer[p] * innovationBuffer[p];
+            }
+        }
+
+        for (std::size_t p = 0; p < particleCount; p++) {
+            result[p] = logNormalizer - 0.5 * result[p];
+        }
     }
 
     void ParticleFilter::setSensorCovariance() {
+        const std::size_t n = sensorNoiseVariance.size();
         // Resize R and fill with 0s
-        R = Matrix(sensorNoiseVariance.size(), sensorNoiseVariance.size(), 0);
+        R = Matrix(n, n, 0);
         // Fill diagonals
-        for (std::size_t i = 0; i < sensorNoiseVariance.size(); i++) {
+        for (std::size_t i = 0; i < n; i++) {
             R[i][i] = sensorNoiseVariance[i];
         }
+
+        // Precompute the inverse of the Cholesky factor L of R, so that the
+        // likelihood exponent -0.5 * I' * R^-1 * I becomes -0.5 * |L^-1 * I|^2,
+        // and the log normalizer -0.5 * (n * log(2 pi) + log(det(R))), where
+        // log(det(R)) is twice the sum of the logs of the diagonal of L.
+        CholeskyDecomposition cholR;
+        try {
+            cholR.factorize(R);
+        }
+        catch (std::domain_error&) {
+            log.WriteLine(LOG_WARN, MODULE_NAME, "Sensor covariance is not positive definite");
+            sensorCovarianceValid = false;
+            return;
+        }
+
+        const Matrix& chol = cholR.getLower();
+        RInvChol = Matrix(n, n, 0);
+        for (std::size_t j = 0; j < n; j++) {
+            RInvChol[j][j] = 1.0 / chol[j][j];
+            for (std::size_t i = j + 1; i < n; i++) {
+                double sum = 0;
+                for (std::size_t k = j; k < i; k++) {
+                    sum += chol[i][k] * RInvChol[k][j];
+                }
+                RInvChol[i][j] = -sum / chol[i][i];
+            }
+        }
+        double logDeterminant = cholR.logDeterminant();
+        logNormalizer = -0.5 * (n * std::log(2.0 * PI) + logDeterminant);
+        sensorCovarianceValid = true;
     }
 
     SystemModel::state_type ParticleFilter::weightedMean(const Matrix& M,
@@ -283,15 +693,8 @@ namespace PCOE {
         Expect(M.rows() == model.getStateSize(), "M rows does not match model state size");
         Expect(M.cols() == weights.size(), "M cols does not match weights size");
 
-        Matrix W = Matrix(weights.size(), 1);
-        W.col(0, weights);
-
-        Matrix wMean = M * W;
-
         auto result = model.getStateVector();
-        for (std::size_t i = 0; i < result.size(); i++) {
-            result[i] = wMean[0][i];
-        }
+        Matrix::weightedMean(M, weights.data(), result.data());
         return result;
     }
 }
@@ -0,0 +1,372 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "ConfigMap.h"
+#include "Contracts.h"
+#include "Observers/KalmanFilterTools.h"
+#include "Observers/SquareRootUnscentedKalmanFilter.h"
+#include "ThreadSafeLog.h"
+#include "UData.h"
+
+namespace PCOE {
+    const static Log& log = Log::Instance();
+
+    // Configuration Keys
+    const std::string Q_KEY = "Observer.Q";
+    const std::string R_KEY = "Observer.R";
+    const std::string K_KEY = "Observer.kappa";
+    const std::string A_KEY = "Observer.alpha";
+    const std::string B_KEY = "Observer.beta";
+
+    // Other string constants
+    const std::string MODULE_NAME = "OBS-SRUKF";
+
+    /**
+     * Computes the QR decomposition of {@code C} in place using Householder
+     * reflections, and stores the transpose of the upper-triangular factor in
+     * the lower triangle of {@code L}. Since C' * C = R' * R, {@code L} is
+     * then a lower-triangular square root of C' * C. The diagonal of
+     * {@code L} is made positive.
+     **/
+    static void qrLower(Matrix& C, Matrix& L) {
+        const std::size_t rows = C.rows();
+        const std::size_t cols = C.cols();
+        for (std::size_t k = 0; k < cols; k++) {
+            double norm = 0;
+            for (std::size_t i = k; i < rows; i++) {
+                norm += C[i][k] * C[i][k];
+            }
+            norm = std::sqrt(norm);
+            if (!(norm > 0)) {
+                continue;
+            }
+
+            // Householder vector v = x - alpha * e1, stored in column k
+            double alpha = C[k][k] > 0 ? -norm : norm;
+            C[k][k] -= alpha;
+            double vNorm2 = 0;
+            for (std::size_t i = k; i < rows; i++) {
+                vNorm2 += C[i][k] * C[i][k];
+            }
+
+            // Apply the reflection to the remaining columns
+            for (std::size_t j = k + 1; j < cols; j++) {
+                double dot = 0;
+                for (std::size_t i = k; i < rows; i++) {
+                    dot += C[i][k] * C[i][j];
+                }
+                double factor = 2.0 * dot / vNorm2;
+                for (std::size_t i = k; i < rows; i++) {
+                    C[i][j] -= factor * C[i][k];
+                }
+            }
+            C[k][k] = alpha;
+        }
+
+        for (std::size_t i = 0; i < cols; i++) {
+            double sign = C[i][i] < 0 ? -1.0 : 1.0;
+            for (std::size_t j = 0; j < cols; j++) {
+                L[j][i] = j >= i ? sign * C[i][j] : 0.0;
+            }
+        }
+    }
+
+    /**
+     * Performs a rank-one update of the lower-triangular Cholesky factor
+     * {@code L} in place, such that L * L' becomes L * L' + weight * v * v'.
+     * A negative weight performs a downdate. {@code v} is overwritten.
+     **/
+    static void cholUpdate(Matrix& L, std::vector<double>& v, double weight) {
+        const std::size_t n = L.rows();
+        const double sign = weight < 0 ? -1.0 : 1.0;
+        const double scale = std::sqrt(std::abs(weight));
+        for (std::size_t i = 0; i < n; i++) {
+            v[i] *= scale;
+        }
+
+        for (std::size_t k = 0; k < n; k++) {
+            double lkk = L[k][k];
+            double r2 = lkk * lkk + sign * v[k] * v[k];
+            if (!(r2 > 0)) {
+                throw std::domain_error("Cholesky downdate is not positive definite");
+            }
+            double r = std::sqrt(r2);
+            double c = r / lkk;
+            double s = v[k] / lkk;
+            L[k][k] = r;
+            for (std::size_t i = k + 1; i < n; i++) {
+                L[i][k] = (L[i][k] + sign * s * v[i]) / c;
+                v[i] = c * v[i] - s * L[i][k];
+            }
+        }
+    }
+
+    SquareRootUnscentedKalmanFilter::SquareRootUnscentedKalmanFilter(const SystemModel& m)
+        : Observer(m) {
+        xEstimated = model.getStateVector();
+        uPrev = model.getInputVector();
+        zEstimated = model.getOutputVector();
+
+        // Set up sigma point matrices and weights for x
+        initSigmaPoints(model.getStateSize(), sigmaX);
+
+        // Set up step workspace
+        std::size_t stateSize = model.getStateSize();
+        std::size_t outputSize = model.getOutputSize();
+        std::size_t sigmaPointCount = sigmaX.M.cols();
+        S.resize(stateSize, stateSize);
+        ws.x = model.getStateVector();
+        ws.zeroNoise.resize(stateSize);
+        ws.zeroNoiseZ.resize(outputSize);
+        ws.xkk1.resize(stateSize);
+        ws.zkk1.resize(outputSize);
+        ws.v.resize(stateSize);
+        ws.vz.resize(outputSize);
+        ws.dX.resize(stateSize, sigmaPointCount);
+        ws.dZ.resize(outputSize, sigmaPointCount);
+        ws.Cx.resize(sigmaPointCount - 1 + stateSize, stateSize);
+        ws.Cz.resize(sigmaPointCount - 1 + outputSize, outputSize);
+        ws.Sz.resize(outputSize, outputSize);
+        ws.Pxz.resize(stateSize, outputSize);
+        ws.Kk.resize(stateSize, outputSize);
+    }
+
+    SquareRootUnscentedKalmanFilter::SquareRootUnscentedKalmanFilter(const SystemModel& m,
+                                                                     const Matrix& Q,
+                                                                     const Matrix& R)
+        : SquareRootUnscentedKalmanFilter(m) {
+        setNoiseCovariance(Q, R);
+    }
+
+    SquareRootUnscentedKalmanFilter::SquareRootUnscentedKalmanFilter(const SystemModel& m,
+                                                                     const ConfigMap& config)
+        : SquareRootUnscentedKalmanFilter(m) {
+        requireKeys(config, {Q_KEY, R_KEY});
+
+        log.WriteLine(LOG_TRACE, MODULE_NAME, "Setting Q and R");
+        setNoiseCovariance(readSquareMatrix(config, Q_KEY), readSquareMatrix(config, R_KEY));
+
+        // Set kappa (optional)
+        if (config.hasKey(K_KEY)) {
+            setKappa(config.getDouble(K_KEY));
+        }
+        // Set alpha (optional)
+        if (config.hasKey(A_KEY)) {
+            setAlpha(config.getDouble(A_KEY));
+        }
+        // Set beta (optional)
+        if (config.hasKey(B_KEY)) {
+            setBeta(config.getDouble(B_KEY));
+        }
+
+        log.WriteLine(LOG_INFO, MODULE_NAME, "Created SRUKF");
+    }
+
+    void SquareRootUnscentedKalmanFilter::setNoiseCovariance(const Matrix& Q, const Matrix& R) {
+        Expect(Q.rows() == Q.cols(), "Q is not square");
+        Expect(Q.rows() == model.getStateSize(), "Size of Q does not match model state size");
+        Expect(R.rows() == R.cols(), "R is not square");
+        Expect(R.rows() == model.getOutputSize(), "Size of R does not match model output size");
+
+        sqrtQ = Q.chol();
+        sqrtR = R.chol();
+    }
+
+    void SquareRootUnscentedKalmanFilter::initialize(double t0,
+                                                     const SystemModel::state_type& x0,
+                                                     const SystemModel::input_type& u0) {
+        log.WriteLine(LOG_DEBUG, MODULE_NAME, "Initializing");
+
+        // Initialize time, state, inputs
+        lastTime = t0;
+        xEstimated = x0;
+        uPrev = u0;
+
+        // Initialize S as the square root of Q
+        S = sqrtQ;
+
+        // Compute corresponding output estimate
+        zEstimated = model.outputEqn(lastTime, xEstimated, ws.zeroNoiseZ);
+
+        // Set initialized flag
+        initialized = true;
+        log.WriteLine(LOG_DEBUG, MODULE_NAME, "Initialize completed");
+    }
+
+    void SquareRootUnscentedKalmanFilter::step(double timestamp,
+                                               const SystemModel::input_type& u,
+                                               const SystemModel::output_type& z) {
+        log.WriteLine(LOG_DEBUG, MODULE_NAME, "Starting step");
+        Expect(isInitialized(), "Not initialized");
+        Expect(timestamp - lastTime > 0, "Time has not advanced");
+
+        // Update time
+        double dt = timestamp - lastTime;
+        lastTime = timestamp;
+
+        const std::size_t stateSize = model.getStateSize();
+        const std::size_t outputSize = model.getOutputSize();
+        const std::size_t sigmaPointCount = sigmaX.M.cols();
+
+        // 1. Predict
+        log.WriteLine(LOG_TRACE, MODULE_NAME, "Starting step - predict");
+
+        // Compute sigma points directly from the square root of P
+        computeSigmaPointsFromRoot(xEstimated.data(), xEstimated.size(), S, sigmaX);
+
+        // Propagate sigma points through the state and output equations
+        for (std::size_t k = 0; k < sigmaPointCount; k++) {
+            for (std::size_t i = 0; i < stateSize; i++) {
+                ws.x[i] = sigmaX.M[i][k];
+            }
+            auto x = model.stateEqn(timestamp, ws.x, uPrev, ws.zeroNoise, dt);
+            for (std::size_t i = 0; i < stateSize; i++) {
+                ws.dX[i][k] = x[i];
+            }
+            auto zkk1 = model.outputEqn(timestamp, x, ws.zeroNoiseZ);
+            for (std::size_t j = 0; j < outputSize; j++) {
+                ws.dZ[j][k] = zkk1[j];
+            }
+        }
+
+        // Recombine weighted sigma points to produce predicted state and
+        // measurement, leaving the deviations from them in dX and dZ
+        for (std::size_t i = 0; i < stateSize; i++) {
+            double mean = 0;
+            for (std::size_t k = 0; k < sigmaPointCount; k++) {
+                mean += sigmaX.w[k] * ws.dX[i][k];
+            }
+            ws.xkk1[i] = mean;
+            for (std::size_t k = 0; k < sigmaPointCount; k++) {
+                ws.dX[i][k] -= mean;
+            }
+        }
+        for (std::size_t j = 0; j < outputSize; j++) {
+            double mean = 0;
+            for (std::size_t k = 0; k < sigmaPointCount; k++) {
+                mean += sigmaX.w[k] * ws.dZ[j][k];
+            }
+            ws.zkk1[j] = mean;
+            for (std::size_t k = 0; k < sigmaPointCount; k++) {
+                ws.dZ[j][k] -= mean;
+            }
+        }
+
+        // The non-central sigma points share a positive weight, while the
+        // central covariance weight, which includes the alpha/beta term, may
+        // be negative and is applied as a rank-one update or downdate.
+        const double w1 = sigmaX.w[1];
+        const double wc0 = sigmaX.w[0] + 1 - sigmaX.alpha * sigmaX.alpha + sigmaX.beta;
+        Expect(w1 > 0, "Non-central sigma point weights must be positive");
+        const double sqrtW1 = std::sqrt(w1);
+        const bool centralUpdate = wc0 < 0 || wc0 > 0;
+
+        // Predicted state covariance root: S = qr([sqrt(w1) * dX(:, 1:2n), sqrt(Q)]),
+        // followed by an update with the central deviation
+        for (std::size_t k = 1; k < sigmaPointCount; k++) {
+            for (std::size_t i = 0; i < stateSize; i++) {
+                ws.Cx[k - 1][i] = sqrtW1 * ws.dX[i][k];
+            }
+        }
+        for (std::size_t j = 0; j < stateSize; j++) {
+            for (std::size_t i = 0; i < stateSize; i++) {
+                ws.Cx[sigmaPointCount - 1 + j][i] = sqrtQ[i][j];
+            }
+        }
+        qrLower(ws.Cx, S);
+        if (centralUpdate) {
+            for (std::size_t i = 0; i < stateSize; i++) {
+                ws.v[i] = ws.dX[i][0];
+            }
+            cholUpdate(S, ws.v, wc0);
+        }
+
+        // Predicted output covariance root, computed the same way with sqrt(R)
+        for (std::size_t k = 1; k < sigmaPointCount; k++) {
+            for (std::size_t j = 0; j < outputSize; j++) {
+                ws.Cz[k - 1][j] = sqrtW1 * ws.dZ[j][k];
+            }
+        }
+        for (std::size_t l = 0; l < outputSize; l++) {
+            for (std::size_t j = 0; j < outputSize; j++) {
+                ws.Cz[sigmaPointCount - 1 + l][j] = sqrtR[j][l];
+            }
+        }
+        qrLower(ws.Cz, ws.Sz);
+        if (centralUpdate) {
+            for (std::size_t j = 0; j < outputSize; j++) {
+                ws.vz[j] = ws.dZ[j][0];
+            }
+            cholUpdate(ws.Sz, ws.vz, wc0);
+        }
+
+        // 2. Update
+        log.WriteLine(LOG_TRACE, MODULE_NAME, "Starting step - update");
+
+        // Compute state-output cross-covariance matrix. As in the UKF, it
+        // uses the mean weights, without the alpha/beta term.
+        const double w0 = sigmaX.w[0];
+        for (std::size_t i = 0; i < stateSize; i++) {
+            for (std::size_t j = 0; j < outputSize; j++) {
+                double sum = w0 * ws.dX[i][0] * ws.dZ[j][0];
+                for (std::size_t k = 1; k < sigmaPointCount; k++) {
+                    sum += w1 * ws.dX[i][k] * ws.dZ[j][k];
+                }
+                ws.Pxz[i][j] = sum;
+            }
+        }
+
+        // Compute Kalman gain Kk = Pxz * (Sz * Sz')^-1 with two triangular
+        // solves for each row of Kk
+        kalmanGain(ws.Sz, ws.Pxz, ws.Kk);
+
+        // Compute state estimate
+        for (std::size_t i = 0; i < stateSize; i++) {
+            double correction = 0;
+            for (std::size_t j = 0; j < outputSize; j++) {
+                correction += ws.Kk[i][j] * (z[j] - ws.zkk1[j]);
+            }
+            xEstimated[i] = ws.xkk1[i] + correction;
+        }
+
+        // Compute output estimate
+        zEstimated = model.outputEqn(timestamp, xEstimated, ws.zeroNoiseZ);
+
+        // Update the covariance root with a downdate by each column of
+        // U = Kk * Sz, since P = Pkk1 - U * U'
+        for (std::size_t l = 0; l < outputSize; l++) {
+            for (std::size_t i = 0; i < stateSize; i++) {
+                double sum = 0;
+                for (std::size_t j = l; j < outputSize; j++) {
+                    sum += ws.Kk[i][j] * ws.Sz[j][l];
+                }
+                ws.v[i] = sum;
+            }
+            cholUpdate(S, ws.v, -1.0);
+        }
+
+        // Update uOld
+        uPrev = u;
+    }
+
+    Matrix SquareRootUnscentedKalmanFilter::getStateCovariance() const {
+        return S * S.transpose();
+    }
+
+    std::vector<UData> SquareRootUnscentedKalmanFilter::getStateEstimate() const {
+        Matrix P = getStateCovariance();
+        std::vector<UData> state(model.getStateSize());
+        for (unsigned int i = 0; i < model.getStateSize(); i++) {
+            state[i].uncertainty(UType::MeanCovar);
+            state[i].npoints(model.getStateSize());
+            state[i][MEAN] = xEstimated[i];
+            state[i][COVAR()] = static_cast<std::vector<double>>(P.rowView(i));
+        }
+        return state;
+    }
+}
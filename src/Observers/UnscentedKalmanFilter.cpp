@@ -1,4 +1,4 @@
-// Copyright (c) 2016-2018 United States Government as represented by the
+// Copyright (c) 2016-2019 United States Government as represented by the
 // Administrator of the National Aeronautics and Space Administration.
 // All Rights Reserved.
 #include <algorithm>
@@ -8,6 +8,7 @@
 
 #include "ConfigMap.h"
 #include "Exceptions.h"
+#include "Observers/KalmanFilterTools.h"
 #include "Observers/UnscentedKalmanFilter.h"
 #include "ThreadSafeLog.h"
 #include "UData.h"
@@ -31,12 +32,62 @@ namespace PCOE {
         zEstimated = model.getOutputVector();
 
         // Set up sigma point matrices and weights for x
-        sigmaX.M.resize(model.getStateSize(), 2 * model.getStateSize() + 1);
-        sigmaX.w.resize(2 * model.getStateSize() + 1);
+        initSigmaPoints(model.getStateSize(), sigmaX);
 
-        sigmaX.kappa = 3.0 - model.getStateSize();
-        sigmaX.alpha = 1;
-        sigmaX.beta = 0;
+        // Set up step workspace
+        std::size_t stateSize = model.getStateSize();
+        std::size_t outputSize = model.getOutputSize();
+        std::size_t sigmaPointCount = sigmaX.M.cols();
+        ws.x = model.getStateVector();
+        ws.zeroNoise.resize(stateSize);
+        ws.zeroNoiseZ.resize(outputSize);
+        ws.xkk1.resize(stateSize);
+        ws.zkk1.resize(outputSize);
+        ws.dX.resize(stateSize, sigmaPointCount);
+        ws.dZ.resize(outputSize, sigmaPointCount);
+        ws.Pkk1.resize(stateSize, stateSize);
+        ws.Pzz.resize(outputSize, outputSize);
+        ws.Pxz.resize(stateSize, outputSize);
+        ws.Lzz.resize(outputSize, outputSize);
+        ws.Kk.resize(stateSize, outputSize);
+    }
+
+    /**
+     * Computes result = A * diag(w) * B', where the columns of A and B are
+     * sigma points, evaluated as dot products of contiguous rows of A and B.
+     **/
+    static void sigmaPointProduct(const Matrix& A,
+                                  const std::vector<double>& w,
+                                  const Matrix& B,
+                                  Matrix& result) {
+        const std::size_t k = w.size();
+        const double* a = A.getData();
+        const double* b = B.getData();
+        for (std::size_t i = 0; i < A.rows(); i++) {
+            const double* ai = a + i * k;
+            auto resultRow = result[i];
+            for (std::size_t j = 0; j < B.rows(); j++) {
+                const double* bj = b + j * k;
+                double sum = 0.0;
+                for (std::size_t p = 0; p < k; p++) {
+                    sum += w[p] * ai[p] * bj[p];
+                }
+                resultRow[j] = sum;
+            }
+        }
+    }
+
+    /**
+     * Subtracts the mean of each row of {@code M} from the row, leaving the
+     * deviations from the mean in {@code M}.
+     **/
+    static void centerSigmaPoints(Matrix& M, const std::vector<double>& mean) {
+        for (std::size_t i = 0; i < M.rows(); i++) {
+            auto row = M[i];
+            for (std::size_t p = 0; p < M.cols(); p++) {
+                row[p] -= mean[i];
+            }
+        }
     }
 
     UnscentedKalmanFilter::UnscentedKalmanFilter(const SystemModel& m, Matrix q, Matrix r)
@@ -137,7 +188,9 @@ namespace PCOE {
         double dt = timestamp - lastTime;
         lastTime = timestamp;
 
-        std::size_t sigmaPointCount = sigmaX.M.cols();
+        const std::size_t stateSize = model.getStateSize();
+        const std::size_t outputSize = model.getOutputSize();
+        const std::size_t sigmaPointCount = sigmaX.M.cols();
 
         // 1. Predict
         log.WriteLine(LOG_TRACE, MODULE_NAME, "Starting step - predict");
@@ -145,76 +198,66 @@ namespace PCOE {
         // Compute sigma points for current state estimate
         computeSigmaPoints(xEstimated, Q, sigmaX);
 
-        // Propagate sigma points through state equation
-        Matrix Xkk1(model.getStateSize(), sigmaPointCount);
-        std::vector<double> zeroNoise(model.getStateSize());
-        for (unsigned int i = 0; i < sigmaPointCount; i++) {
-            auto x = SystemModel::state_type(static_cast<std::vector<double>>(sigmaX.M.col(i)));
-            x = model.stateEqn(timestamp, x, uPrev, zeroNoise, dt);
-            Xkk1.col(i, x.vec());
-        }
-
-        // Recombine weighted sigma points to produce predicted state and covariance
-        std::vector<double> xkk1 =
-            static_cast<std::vector<double>>(Xkk1.weightedMean(Matrix(sigmaX.w)));
-        Matrix Pkk1 = Xkk1.weightedCovariance(Matrix(sigmaX.w), sigmaX.alpha, sigmaX.beta) + Q;
-
-        // Propagate sigma points through output equation
-        Matrix Zkk1(model.getOutputSize(), sigmaPointCount);
-        for (unsigned int i = 0; i < sigmaPointCount; i++) {
-            auto zkk1 = model.outputEqn(timestamp,
-                                        SystemModel::state_type(
-                                            static_cast<std::vector<double>>(Xkk1.col(i))),
-                                        zeroNoise);
-            Zkk1.col(i, zkk1.vec());
+        // Propagate sigma points through the state and output equations
+        for (std::size_t k = 0; k < sigmaPointCount; k++) {
+            for (std::size_t i = 0; i < stateSize; i++) {
+                ws.x[i] = sigmaX.M[i][k];
+            }
+            auto x = model.stateEqn(timestamp, ws.x, uPrev, ws.zeroNoise, dt);
+            for (std::size_t i = 0; i < stateSize; i++) {
+                ws.dX[i][k] = x[i];
+            }
+            auto zkk1 = model.outputEqn(timestamp, x, ws.zeroNoiseZ);
+            for (std::size_t j = 0; j < outputSize; j++) {
+                ws.dZ[j][k] = zkk1[j];
+            }
         }
 
-        // Recombine weighted sigma points to produce predicted measurement and covariance
-        std::vector<double> zkk1 =
-            static_cast<std::vector<double>>(Zkk1.weightedMean(Matrix(sigmaX.w)));
-        Matrix Pzz = Zkk1.weightedCovariance(Matrix(sigmaX.w), sigmaX.alpha, sigmaX.beta) + R;
+        // Recombine weighted sigma points to produce predicted state and
+        // measurement and their covariances. The alpha/beta term is added to
+        // the covariance weight of the central point.
+        double centralWeight = 1 - sigmaX.alpha * sigmaX.alpha + sigmaX.beta;
+        Matrix::weightedMoments(ws.dX, sigmaX.w.data(), ws.xkk1.data(), ws.Pkk1, centralWeight);
+        Matrix::weightedMoments(ws.dZ, sigmaX.w.data(), ws.zkk1.data(), ws.Pzz, centralWeight);
+        ws.Pkk1 += Q;
+        ws.Pzz += R;
 
         // 2. Update
         log.WriteLine(LOG_TRACE, MODULE_NAME, "Starting step - update");
 
-        // Compute state-output cross-covariance matrix
-        Matrix Pxz(model.getStateSize(), model.getOutputSize());
-        for (unsigned int i = 0; i < sigmaPointCount; i++) {
-            Matrix columnx(model.getStateSize(), 1);
-            Matrix columnz(model.getOutputSize(), 1);
-            columnx.col(0, Xkk1.col(i));
-            columnz.col(0, Zkk1.col(i));
-
-            Matrix xkk1m(model.getStateSize(), 1);
-            Matrix zkk1m(model.getOutputSize(), 1);
-            xkk1m.col(0, xkk1);
-            zkk1m.col(0, zkk1);
-
-            Matrix diffx = columnx - xkk1m;
-            Matrix diffzT = (columnz - zkk1m).transpose();
-            Matrix temp = diffx * diffzT;
-            Pxz = Pxz + temp * sigmaX.w[i];
-        }
+        // Compute state-output cross-covariance matrix from the deviations
+        // of the sigma points from the predicted state and measurement
+        centerSigmaPoints(ws.dX, ws.xkk1);
+        centerSigmaPoints(ws.dZ, ws.zkk1);
+        sigmaPointProduct(ws.dX, sigmaX.w, ws.dZ, ws.Pxz);
 
-        // Compute Kalman gain
-        Matrix Kk = Pxz * Pzz.inverse();
+        // Compute Kalman gain Kk = Pxz * Pzz^-1 with the Cholesky factor of Pzz
+        ws.Pzz.chol(ws.Lzz);
+        kalmanGain(ws.Lzz, ws.Pxz, ws.Kk);
 
         // Compute state estimate
-        Matrix xkk1m(model.getStateSize(), 1);
-        Matrix zkk1m(model.getOutputSize(), 1);
-        Matrix zm(model.getOutputSize(), 1);
-        xkk1m.col(0, xkk1);
-        zkk1m.col(0, zkk1);
-        zm.col(0, z.vec());
-        Matrix xk1m = xkk1m + Kk * (zm - zkk1m);
-        xEstimated = SystemModel::state_type(static_cast<std::vector<double>>(xk1m.col(0)));
+        for (std::size_t i = 0; i < stateSize; i++) {
+            double correction = 0;
+            for (std::size_t j = 0; j < outputSize; j++) {
+                correction += ws.Kk[i][j] * (z[j] - ws.zkk1[j]);
+            }
+            xEstimated[i] = ws.xkk1[i] + correction;
+        }
 
         // Compute output estimate
-        std::vector<double> zeroNoiseZ(model.getOutputSize());
-        zEstimated = model.outputEqn(timestamp, xEstimated, zeroNoiseZ);
-
-        // Compute covariance
-        P = Pkk1 - Kk * Pzz * Kk.transpose();
+        zEstimated = model.outputEqn(timestamp, xEstimated, ws.zeroNoiseZ);
+
+        // Compute covariance P = Pkk1 - Kk * Pzz * Kk', where Kk * Pzz = Pxz
+        for (std::size_t i = 0; i < stateSize; i++) {
+            for (std::size_t j = i; j < stateSize; j++) {
+                double sum = ws.Pkk1[i][j];
+                for (std::size_t l = 0; l < outputSize; l++) {
+                    sum -= ws.Pxz[i][l] * ws.Kk[j][l];
+                }
+                P[i][j] = sum;
+                P[j][i] = sum;
+            }
+        }
 
         // Update uOld
         uPrev = u;
@@ -224,62 +267,7 @@ namespace PCOE {
                                                    const Matrix& Pxx,
                                                    SigmaPoints& sigma) {
         log.WriteLine(LOG_TRACE, MODULE_NAME, "Computing sigma points");
-
-        // Assumes that sigma points have been set up correctly within the constructor
-        auto stateSize = mx.size();
-        auto sigmaPointCount = sigma.M.cols();
-
-        // First sigma point is the mean
-        for (unsigned int i = 0; i < stateSize; i++) {
-            sigma.M[i][0] = mx[i];
-        }
-
-        // Compute a matrix square root using Cholesky decomposition
-        Matrix nkPxx = Pxx;
-        for (unsigned int i = 0; i < nkPxx.rows(); i++) {
-            for (unsigned int j = 0; j < nkPxx.cols(); j++) {
-                nkPxx[i][j] *= (stateSize + sigma.kappa);
-            }
-        }
-        Matrix matrixSq = nkPxx.chol();
-
-        // For sigma points 2 to n+1, it is mx + ith column of matrix square root
-        for (unsigned int i = 0; i < stateSize; i++) {
-            // Set column
-            for (unsigned int j = 0; j < stateSize; j++) {
-                sigma.M[i][j + 1] = mx[i] + matrixSq[i][j];
-            }
-        }
-
-        // For sigma points n+2 to 2n+1, it is mx - ith column of matrix square root
-        for (unsigned int i = 0; i < stateSize; i++) {
-            // Set column
-            for (unsigned int j = 0; j < stateSize; j++) {
-                sigma.M[i][j + stateSize + 1] = mx[i] - matrixSq[i][j];
-            }
-        }
-
-        // w(1) is kappa/(n+kappa)
-        sigma.w[0] = sigma.kappa / (stateSize + sigma.kappa);
-
-        // Rest of w are 0.5/(n+kappa)
-        for (unsigned int i = 1; i < sigmaPointCount; i++) {
-            sigma.w[i] = 0.5 / (stateSize + sigma.kappa);
-        }
-
-        // Scale the sigma points
-        // 1. Xi' = X0 + alpha*(Xi-X0)
-        Matrix X0 = sigma.M.col(0);
-        for (unsigned int i = 1; i < sigmaPointCount; i++) {
-            sigma.M.col(i, X0 + sigma.alpha * (sigma.M.col(i) - X0));
-        }
-
-        // 2. W0' = W0/alpha^2 + (1/alpha^2-1)
-        //    Wi' = Wi/alpha^2
-        sigma.w[0] = sigma.w[0] / sigma.alpha / sigma.alpha + (1 / sigma.alpha / sigma.alpha - 1);
-        for (unsigned int i = 1; i < sigmaPointCount; i++) {
-            sigma.w[i] = sigma.w[i] / sigma.alpha / sigma.alpha;
-        }
+        PCOE::computeSigmaPoints(mx.data(), mx.size(), Pxx, sigma);
     }
 
     std::vector<UData> UnscentedKalmanFilter::getStateEstimate() const {
@@ -288,7 +276,7 @@ namespace PCOE {
             state[i].uncertainty(UType::MeanCovar);
             state[i].npoints(model.getStateSize());
             state[i][MEAN] = xEstimated[i];
-            state[i][COVAR()] = static_cast<std::vector<double>>(P.row(i));
+            state[i][COVAR()] = static_cast<std::vector<double>>(P.rowView(i));
         }
         return state;
     }
@@ -46,18 +46,22 @@ namespace PCOE {
         Expect(m != nullptr, "Unexpected message type");
 
         log.WriteLine(LOG_TRACE, MODULE_NAME, "Starting prediction");
-        Prediction prediction = pred->predict(seconds(m->getTimestamp()), m->getValue());
+        auto prediction = std::make_shared<const Prediction>(
+            pred->predict(seconds(m->getTimestamp()), m->getValue()));
         log.FormatLine(LOG_TRACE, MODULE_NAME, "Publishing events for source %s", source.c_str());
         if (batchEvents) {
             auto pMsg = std::shared_ptr<PredictionMessage>(
-                new PredictionMessage(source, m->getTimestamp(), std::move(prediction)));
+                new PredictionMessage(source, m->getTimestamp(), prediction));
             bus.publish(pMsg);
             log.WriteLine(LOG_TRACE, MODULE_NAME, "Publishing prediction");
         }
         else {
-            for (const auto& event : prediction.getEvents()) {
+            // Each event message shares ownership of the whole prediction
+            // rather than copying its event.
+            for (const auto& event : prediction->getEvents()) {
+                std::shared_ptr<const ProgEvent> shared(prediction, &event);
                 auto peMsg = std::shared_ptr<ProgEventMessage>(
-                    new ProgEventMessage(event.getId(), source, m->getTimestamp(), event));
+                    new ProgEventMessage(event.getId(), source, m->getTimestamp(), shared));
                 bus.publish(peMsg);
                 log.FormatLine(LOG_TRACE,
                                MODULE_NAME,
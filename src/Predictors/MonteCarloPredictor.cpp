@@ -1,13 +1,16 @@
 // Copyright (c) 2016-2018 United States Government as represented by the
 // Administrator of the National Aeronautics and Space Administration.
 // All Rights Reserved.
+#include <memory>
 #include <random>
 #include <string>
 #include <vector>
 
+#include "AliasTable.h"
 #include "Contracts.h"
 #include "Exceptions.h"
 #include "Matrix.h"
+#include "MonotonicArena.h"
 #include "Predictors/MonteCarloPredictor.h"
 #include "ThreadSafeLog.h"
 
@@ -56,16 +59,6 @@ namespace PCOE {
         log.WriteLine(LOG_INFO, MODULE_NAME, "MonteCarloPredictor created");
     }
 
-    UData::time_ticks getLowestTimestamp(const std::vector<UData>& data) {
-        UData::time_ticks result = std::numeric_limits<UData::time_ticks>::max();
-        for (const UData& entry : data) {
-            if (entry.updated() < result) {
-                result = entry.updated();
-            }
-        }
-        return result;
-    }
-
     Prediction MonteCarloPredictor::predict(double time_s, const std::vector<UData>& state) {
         log.WriteLine(LOG_TRACE, MODULE_NAME, "Starting prediction");
         // TODO (MD): This is setup for only a single event to predict, need to extend to multiple
@@ -81,24 +74,36 @@ namespace PCOE {
         auto savePts = savePointProvider.getSavePts();
         auto eventNames = model.getEvents();
 
-        std::vector<UData> eventToe(eventNames.size());
-        for (auto&& toe : eventToe) {
-            toe.uncertainty(UType::Samples);
-            toe.npoints(sampleCount);
-        }
+        // All of the samples in the prediction are allocated from a single
+        // arena sized for the whole prediction, which is freed at once when
+        // the last part of the prediction is destroyed.
+        std::size_t observableCount = model.getObservables().size();
+        std::size_t udataCount = eventNames.size() * (savePts.size() + 1) +
+                                 observableCount * (savePts.size() + 1);
+        // Each UData briefly holds a single value before it is resized to hold
+        // the samples, so one extra double is reserved for each.
+        std::size_t arenaSize = udataCount * (sampleCount + 1) * sizeof(double);
+        UData::allocator_type allocator(std::make_shared<MonotonicArena>(arenaSize));
+
+        std::vector<UData> eventToe;
+        eventToe.reserve(eventNames.size());
         std::vector<std::vector<UData>> eventStates(eventNames.size());
-        for (auto&& eventState : eventStates) {
-            eventState.resize(savePts.size());
-            for (auto&& elem : eventState) {
-                elem.uncertainty(UType::Samples);
-                elem.npoints(sampleCount);
+        for (std::size_t eventId = 0; eventId < eventNames.size(); eventId++) {
+            eventToe.emplace_back(UType::Samples, allocator);
+            eventToe.back().npoints(sampleCount);
+            eventStates[eventId].reserve(savePts.size());
+            for (std::size_t i = 0; i < savePts.size(); i++) {
+                eventStates[eventId].emplace_back(UType::Samples, allocator);
+                eventStates[eventId].back().npoints(sampleCount);
             }
         }
-        std::vector<DataPoint> observables(model.getObservables().size());
-        for (auto& observable : observables) {
-            observable.setUncertainty(UType::Samples);
-            observable.setNumTimes(savePts.size());
-            observable.setNPoints(sampleCount);
+        std::vector<DataPoint> observables;
+        observables.reserve(observableCount);
+        for (std::size_t i = 0; i < observableCount; i++) {
+            observables.emplace_back(allocator);
+            observables.back().setUncertainty(UType::Samples);
+            observables.back().setNumTimes(static_cast<unsigned int>(savePts.size()));
+            observables.back().setNPoints(sampleCount);
         }
         auto stateTimestamp = getLowestTimestamp(state);
 
@@ -129,6 +134,14 @@ namespace PCOE {
             PxxChol = Matrix(model.getStateSize(), model.getStateSize());
         }
 
+        // Weighted samples are drawn through an alias table built once for
+        // all of the samples, so that each draw takes constant time
+        // regardless of the number of weighted samples.
+        AliasTable sampleIndex;
+        if (state.front().uncertainty() == UType::WSamples) {
+            sampleIndex.build(state.front().weights());
+        }
+
 /* OpenMP info
  * If the application is built with OpenMP, the predictor below operates in parallel.
  * The only shared memory between threads is data (ProgData). Writebacks are only done
@@ -156,14 +169,16 @@ namespace PCOE {
                 // Now we have mean vector (x) and covariance matrix (Pxx). We can use that to
                 // sample a realization of the state. I need to generate a vector of random numbers,
                 // size of the state vector Create standard normal distribution
-                Matrix xRandom(model.getStateSize(), 1);
+                std::vector<double> xRandom(model.getStateSize());
                 static std::normal_distribution<> standardDistribution(0, 1);
                 for (unsigned int xIndex = 0; xIndex < model.getStateSize(); xIndex++) {
-                    xRandom[xIndex][0] = standardDistribution(generator);
+                    xRandom[xIndex] = standardDistribution(generator);
                 }
                 // Update with mean and covariance
-                xRandom = xMean + PxxChol * xRandom;
-                x = SystemModel::state_type(static_cast<std::vector<double>>(xRandom.col(0)));
+                for (unsigned int xIndex = 0; xIndex < model.getStateSize(); xIndex++) {
+                    x[xIndex] = xMean[xIndex][0];
+                }
+                PxxChol.multiplyAdd(xRandom.data(), x.data());
             }
             else if (state.front().uncertainty() == UType::Samples) {
                 for (size_t j = 0; j < state.size(); j++) {
@@ -171,20 +186,10 @@ namespace PCOE {
                 }
             }
             else if (state.front().uncertainty() == UType::WSamples) {
-                //  blocked weighted bootstrap
-                static std::uniform_real_distribution<> uniformDistribution(0, 1);
-                auto step = uniformDistribution(generator);
-
                 // Assumes that data is coupled- same sample for all states
-                size_t k = 0;
-                double weight = 0.0;
-                while (weight < step) {
-                    weight = (weight + state[0].get(WEIGHT(k)));
-                    k = (k + 1) % state[0].size();
-                }
-
+                std::size_t k = sampleIndex(generator);
                 for (size_t j = 0; j < state.size(); j++) {
-                    x[j] = state[j].get(SAMPLE((k - 1) % state[j].size()));
+                    x[j] = state[j].get(SAMPLE(k));
                 }
             }
 
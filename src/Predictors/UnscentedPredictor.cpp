@@ -0,0 +1,278 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "Contracts.h"
+#include "Matrix.h"
+#include "Predictors/UnscentedPredictor.h"
+#include "ThreadSafeLog.h"
+
+namespace PCOE {
+    static const Log& log = Log::Instance();
+
+    // Configuration Keys
+    const std::string HORIZON_KEY = "Predictor.Horizon";
+    const std::string KAPPA_KEY = "Predictor.kappa";
+    const std::string ALPHA_KEY = "Predictor.alpha";
+    const std::string BETA_KEY = "Predictor.beta";
+
+    // Other string constants
+    const std::string MODULE_NAME = "PRED-UT";
+
+    /**
+     * Computes the mean and covariance of the state from the uncertainty
+     * representation provided by the observer.
+     **/
+    static void stateMoments(const std::vector<UData>& state,
+                             std::vector<double>& mean,
+                             Matrix& covar) {
+        std::size_t n = state.size();
+        mean.assign(n, 0.0);
+        covar = Matrix(n, n);
+
+        switch (state.front().uncertainty()) {
+        case UType::Point:
+            for (std::size_t i = 0; i < n; i++) {
+                mean[i] = state[i].get(VALUE);
+            }
+            break;
+        case UType::MeanSD:
+            for (std::size_t i = 0; i < n; i++) {
+                mean[i] = state[i].get(MEAN);
+                covar[i][i] = state[i].get(SD) * state[i].get(SD);
+            }
+            break;
+        case UType::MeanCovar:
+            for (std::size_t i = 0; i < n; i++) {
+                mean[i] = state[i].get(MEAN);
+                covar.row(i, state[i].getVec(COVAR(0)));
+            }
+            break;
+        case UType::Samples:
+        case UType::WSamples: {
+            // Assumes that data is coupled- same sample for all states
+            bool weighted = state.front().uncertainty() == UType::WSamples;
+            std::size_t sampleCount = state.front().npoints();
+            Expect(sampleCount > 0, "Empty sample set");
+            std::vector<double> w(sampleCount, 1.0 / sampleCount);
+            if (weighted) {
+                ConstMatrixView weights = state[0].weights();
+                double sum = 0;
+                for (std::size_t k = 0; k < sampleCount; k++) {
+                    w[k] = weights[k];
+                    sum += w[k];
+                }
+                for (auto& wk : w) {
+                    wk /= sum;
+                }
+            }
+            Matrix samples(n, sampleCount);
+            for (std::size_t i = 0; i < n; i++) {
+                ConstMatrixView values = state[i].samples();
+                auto row = samples[i];
+                for (std::size_t k = 0; k < sampleCount; k++) {
+                    row[k] = values[k];
+                }
+            }
+            Matrix::weightedMoments(samples, w.data(), mean.data(), covar);
+            break;
+        }
+        default:
+            Unreachable("Unsupported uncertainty type");
+        }
+    }
+
+    /**
+     * Determines whether every element of a matrix is zero, as is the
+     * covariance of a state without uncertainty.
+     **/
+    static bool isZero(const Matrix& m) {
+        for (std::size_t i = 0; i < m.rows(); i++) {
+            for (std::size_t j = 0; j < m.cols(); j++) {
+                if (std::abs(m[i][j]) > 0.0) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Recombines the values of a scalar at each sigma point into a UData with
+     * mean and standard deviation.
+     **/
+    static void recombine(const std::vector<double>& y, const SigmaPoints& sigma, UData& result) {
+        double mean = 0;
+        for (std::size_t i = 0; i < y.size(); i++) {
+            mean += sigma.w[i] * y[i];
+        }
+
+        double sd;
+        if (std::any_of(y.begin(), y.end(), [](double v) { return std::isinf(v); })) {
+            // At least one sigma point never reached the event within the horizon
+            mean = INFINITY;
+            sd = INFINITY;
+        }
+        else {
+            sd = std::sqrt(std::max(0.0, sigmaPointVariance(y, sigma, mean)));
+        }
+        result[MEAN] = mean;
+        result[SD] = sd;
+    }
+
+    UnscentedPredictor::UnscentedPredictor(const PrognosticsModel& m,
+                                           LoadEstimator& le,
+                                           const TrajectoryService& trajService,
+                                           const ConfigMap& config)
+        : Predictor(m, le, trajService, config) {
+        requireKeys(config, {HORIZON_KEY});
+
+        horizon = static_cast<double>(config.getUInt32(HORIZON_KEY));
+        initSigmaPoints(model.getStateSize(), sigma);
+
+        // Set kappa (optional)
+        if (config.hasKey(KAPPA_KEY)) {
+            sigma.kappa = config.getDouble(KAPPA_KEY);
+        }
+        // Set alpha (optional)
+        if (config.hasKey(ALPHA_KEY)) {
+            sigma.alpha = config.getDouble(ALPHA_KEY);
+        }
+        // Set beta (optional)
+        if (config.hasKey(BETA_KEY)) {
+            sigma.beta = config.getDouble(BETA_KEY);
+        }
+
+        Ensure(horizon > 0, "Non-positive horizon");
+        Ensure(model.getStateSize() + sigma.kappa > 0, "Non-positive sigma point spread");
+        log.WriteLine(LOG_INFO, MODULE_NAME, "UnscentedPredictor created");
+    }
+
+    Prediction UnscentedPredictor::predict(double time_s, const std::vector<UData>& state) {
+        log.WriteLine(LOG_TRACE, MODULE_NAME, "Starting prediction");
+        Expect(state.size() == model.getStateSize(), "State size does not match model");
+
+        auto savePts = savePointProvider.getSavePts();
+        auto eventNames = model.getEvents();
+        auto observableCount = model.getObservables().size();
+        auto stateTimestamp = getLowestTimestamp(state);
+
+        // 1. Compute sigma points of the current state distribution
+        std::vector<double> xMean;
+        Matrix Pxx;
+        stateMoments(state, xMean, Pxx);
+        if (isZero(Pxx)) {
+            // A state without spread, such as a Point, has no Cholesky
+            // factor. Every sigma point is the mean.
+            computeSigmaPointsFromRoot(xMean, Matrix(xMean.size(), xMean.size()), sigma);
+        }
+        else {
+            computeSigmaPoints(xMean, Pxx, sigma);
+        }
+        std::size_t sigmaPointCount = sigma.M.cols();
+
+        // Values of each event and observable at each sigma point, indexed as
+        // [event][sigma point] and [event or observable][save point][sigma point]
+        std::vector<std::vector<double>> toe(eventNames.size(),
+                                             std::vector<double>(sigmaPointCount, INFINITY));
+        std::vector<std::vector<std::vector<double>>> eventStateValues(
+            eventNames.size(),
+            std::vector<std::vector<double>>(savePts.size(),
+                                             std::vector<double>(sigmaPointCount, NAN)));
+        std::vector<std::vector<std::vector<double>>> observableValues(
+            observableCount,
+            std::vector<std::vector<double>>(savePts.size(),
+                                             std::vector<double>(sigmaPointCount, NAN)));
+
+        // 2. Simulate each sigma point until time limit reached
+        std::vector<double> zeroNoise(model.getStateSize());
+        for (std::size_t i = 0; i < sigmaPointCount; i++) {
+            log.FormatLine(LOG_TRACE, MODULE_NAME, "Prediction sigma point %u", i);
+            auto x = SystemModel::state_type(sigma.M.colView(i));
+
+            std::vector<double>::size_type savePtIndex = 0;
+            double timeOfCurrentSavePt = std::numeric_limits<double>::infinity();
+            auto currentSavePt = savePts.begin();
+            if (currentSavePt != savePts.end()) {
+                timeOfCurrentSavePt = seconds(*currentSavePt);
+            }
+
+            for (double t_s = time_s; t_s <= time_s + horizon; t_s += model.getDefaultTimeStep()) {
+                PrognosticsModel::input_type loadEstimate =
+                    static_cast<PrognosticsModel::input_type>(loadEstimator.estimateLoad(t_s));
+
+                // Check threshold at time t and set timeOfEvent if reaching for first time
+                auto thresholdMet = model.thresholdEqn(t_s, x);
+                std::size_t thresholdsMet = 0;
+                for (std::size_t eventId = 0; eventId < eventNames.size(); eventId++) {
+                    if (thresholdMet[eventId]) {
+                        if (std::isinf(toe[eventId][i])) {
+                            toe[eventId][i] = t_s;
+                        }
+                        thresholdsMet++;
+                    }
+                }
+
+                if (savePtIndex < savePts.size() && t_s > timeOfCurrentSavePt) {
+                    ++currentSavePt;
+                    if (currentSavePt != savePts.end()) {
+                        timeOfCurrentSavePt = seconds(*currentSavePt);
+                    }
+
+                    auto observablesEstimate = model.observablesEqn(t_s, x);
+                    for (std::size_t p = 0; p < observablesEstimate.size(); p++) {
+                        observableValues[p][savePtIndex][i] = observablesEstimate[p];
+                    }
+
+                    auto eventStatesEstimate = model.eventStateEqn(x);
+                    for (std::size_t eventId = 0; eventId < eventNames.size(); eventId++) {
+                        eventStateValues[eventId][savePtIndex][i] = eventStatesEstimate[eventId];
+                    }
+
+                    savePtIndex++;
+                }
+
+                if (thresholdsMet == eventNames.size()) {
+                    // All thresholds met- stop simulating for sigma point
+                    break;
+                }
+
+                // Update state for t to t+dt
+                x = model.stateEqn(t_s, x, loadEstimate, zeroNoise, model.getDefaultTimeStep());
+            }
+        }
+
+        // 3. Recombine weighted sigma points
+        log.WriteLine(LOG_TRACE, MODULE_NAME, "Recombining sigma points");
+        std::vector<ProgEvent> events;
+        for (std::size_t eventId = 0; eventId < eventNames.size(); eventId++) {
+            UData eventToe(UType::MeanSD);
+            recombine(toe[eventId], sigma, eventToe);
+            eventToe.updated(stateTimestamp);
+
+            std::vector<UData> eventState(savePts.size(), UData(UType::MeanSD));
+            for (std::size_t savePtIndex = 0; savePtIndex < savePts.size(); savePtIndex++) {
+                recombine(eventStateValues[eventId][savePtIndex], sigma, eventState[savePtIndex]);
+            }
+
+            events.push_back(
+                ProgEvent(eventNames[eventId], std::move(eventState), std::move(eventToe)));
+        }
+
+        std::vector<DataPoint> observables(observableCount);
+        for (std::size_t p = 0; p < observableCount; p++) {
+            observables[p].setUncertainty(UType::MeanSD);
+            observables[p].setNumTimes(static_cast<unsigned int>(savePts.size()));
+            for (std::size_t savePtIndex = 0; savePtIndex < savePts.size(); savePtIndex++) {
+                recombine(observableValues[p][savePtIndex], sigma, observables[p][savePtIndex]);
+            }
+        }
+
+        log.WriteLine(LOG_TRACE, MODULE_NAME, "Prediction complete");
+        return Prediction(std::move(events), std::move(observables));
+    }
+}
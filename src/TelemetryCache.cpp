@@ -0,0 +1,143 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include "Contracts.h"
+#include "Exceptions.h"
+#include "TelemetryCache.h"
+
+namespace PCOE {
+    static const std::uint32_t CacheMagic = 0x47535443;
+    static const std::uint16_t CacheVersion = 1;
+    static const std::size_t BlockRows = 4096;
+
+    // The header is followed by the column names, each terminated by a null
+    // character and padded together to a multiple of 8 bytes, and then by the
+    // values of each column in turn.
+    struct CacheHeader {
+        std::uint32_t magic;
+        std::uint16_t version;
+        std::uint16_t reserved;
+        std::uint32_t columns;
+        std::uint32_t namesSize;
+        std::uint64_t rows;
+    };
+
+    static std::size_t align8(std::size_t size) {
+        return (size + 7) & ~static_cast<std::size_t>(7);
+    }
+
+    TelemetryCache::TelemetryCache(const std::string& filename)
+        : file(filename), rows(0), values(nullptr) {
+        if (file.size() < sizeof(CacheHeader)) {
+            throw FormatError("Not a telemetry cache");
+        }
+        CacheHeader header;
+        std::memcpy(&header, file.data(), sizeof(header));
+        if (header.magic != CacheMagic || header.version != CacheVersion) {
+            throw FormatError("Not a telemetry cache");
+        }
+
+        std::size_t dataOffset = sizeof(CacheHeader) + align8(header.namesSize);
+        rows = static_cast<std::size_t>(header.rows);
+        if (dataOffset > file.size()) {
+            throw FormatError("Telemetry cache truncated");
+        }
+        std::size_t available = (file.size() - dataOffset) / sizeof(double);
+        if (header.columns != 0 && available / header.columns < rows) {
+            throw FormatError("Telemetry cache truncated");
+        }
+
+        const char* name = file.data() + sizeof(CacheHeader);
+        const char* namesEnd = name + header.namesSize;
+        for (std::uint32_t i = 0; i < header.columns; i++) {
+            const char* nameEnd = std::find(name, namesEnd, '\0');
+            if (nameEnd == namesEnd) {
+                throw FormatError("Telemetry cache truncated");
+            }
+            columns.push_back(std::string(name, nameEnd));
+            name = nameEnd + 1;
+        }
+        values = reinterpret_cast<const double*>(file.data() + dataOffset);
+    }
+
+    void TelemetryCache::create(TelemetryReader& reader, const std::string& filename) {
+        reader.rewind();
+        const std::vector<std::string>& names = reader.getColumnNames();
+        std::size_t columnCount = names.size();
+        std::size_t rowCount = reader.countRows();
+
+        std::string namesBlock;
+        for (const std::string& name : names) {
+            namesBlock += name;
+            namesBlock.push_back('\0');
+        }
+        CacheHeader header = {CacheMagic,
+                              CacheVersion,
+                              0,
+                              static_cast<std::uint32_t>(columnCount),
+                              static_cast<std::uint32_t>(namesBlock.size()),
+                              rowCount};
+        namesBlock.resize(align8(namesBlock.size()), '\0');
+
+        std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+        out.exceptions(std::ios::failbit | std::ios::badbit);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(namesBlock.data(), static_cast<std::streamsize>(namesBlock.size()));
+        std::size_t dataOffset = sizeof(header) + namesBlock.size();
+
+        // Rows are transposed a block at a time and each column of the block is
+        // written at its final position in the file.
+        std::vector<double> block(columnCount * BlockRows);
+        std::vector<double> row;
+        std::size_t blockStart = 0;
+        std::size_t blockSize = 0;
+        while (blockStart + blockSize < rowCount && reader.next(row)) {
+            for (std::size_t c = 0; c < columnCount; c++) {
+                block[c * BlockRows + blockSize] = row[c];
+            }
+            ++blockSize;
+            if (blockSize == BlockRows || blockStart + blockSize == rowCount) {
+                for (std::size_t c = 0; c < columnCount; c++) {
+                    std::size_t offset = dataOffset + (c * rowCount + blockStart) * sizeof(double);
+                    out.seekp(static_cast<std::streamoff>(offset));
+                    out.write(reinterpret_cast<const char*>(&block[c * BlockRows]),
+                              static_cast<std::streamsize>(blockSize * sizeof(double)));
+                }
+                blockStart += blockSize;
+                blockSize = 0;
+            }
+        }
+        Ensure(blockStart == rowCount, "Read all counted rows");
+        reader.rewind();
+    }
+
+    ConstMatrixView TelemetryCache::getColumn(std::size_t column) const {
+        if (column >= columns.size()) {
+            throw std::out_of_range("Column does not exist");
+        }
+        return ConstMatrixView(values + column * rows, rows, 1, 1);
+    }
+
+    void TelemetryCache::getRow(std::size_t row, std::vector<double>& result) const {
+        if (row >= rows) {
+            throw std::out_of_range("Row does not exist");
+        }
+        result.resize(columns.size());
+        for (std::size_t c = 0; c < columns.size(); c++) {
+            result[c] = values[c * rows + row];
+        }
+    }
+
+    std::size_t TelemetryCache::findRow(double time) const {
+        if (columns.empty()) {
+            return rows;
+        }
+        return static_cast<std::size_t>(std::lower_bound(values, values + rows, time) - values);
+    }
+}
@@ -0,0 +1,275 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PCOE_TELEMETRY_SSE2
+#include <emmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+#include "Exceptions.h"
+#include "StringUtils.h"
+#include "TelemetryReader.h"
+
+namespace PCOE {
+    static const double NaN = std::numeric_limits<double>::quiet_NaN();
+
+    // Powers of ten that are exactly representable as doubles.
+    static const double Pow10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                   1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                   1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+#ifdef PCOE_TELEMETRY_SSE2
+    static inline unsigned int countTrailingZeros(unsigned int mask) {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return static_cast<unsigned int>(index);
+#else
+        return static_cast<unsigned int>(__builtin_ctz(mask));
+#endif
+    }
+#endif
+
+    /**
+     * Finds the first delimiter or newline at or after {@p p}, or {@p end}
+     * if there is neither. Sixteen bytes are compared at a time where SSE2 is
+     * available.
+     **/
+    static const char* findSeparator(const char* p, const char* end, char delimiter) {
+#ifdef PCOE_TELEMETRY_SSE2
+        const __m128i delimiters = _mm_set1_epi8(delimiter);
+        const __m128i newlines = _mm_set1_epi8('\n');
+        while (end - p >= 16) {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+            __m128i matches = _mm_or_si128(_mm_cmpeq_epi8(chunk, delimiters),
+                                           _mm_cmpeq_epi8(chunk, newlines));
+            unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(matches));
+            if (mask != 0) {
+                return p + countTrailingZeros(mask);
+            }
+            p += 16;
+        }
+#endif
+        while (p != end && *p != delimiter && *p != '\n') {
+            ++p;
+        }
+        return p;
+    }
+
+    static const char* findNewline(const char* p, const char* end) {
+        auto size = static_cast<std::size_t>(end - p);
+        auto result = static_cast<const char*>(std::memchr(p, '\n', size));
+        return result == nullptr ? end : result;
+    }
+
+    static bool isBlank(const char* first, const char* last) {
+        for (; first != last; ++first) {
+            if (*first != ' ' && *first != '\t' && *first != '\r') {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static inline bool isDigit(char c) {
+        return static_cast<unsigned char>(c - '0') <= 9;
+    }
+
+    /**
+     * Parses a number with {@code strtod}, for numbers that the fast path in
+     * {@code parseDouble} cannot parse exactly.
+     **/
+    static const char* parseDoubleSlow(const char* first, const char* last, double& value) {
+        char buffer[64];
+        std::size_t length = static_cast<std::size_t>(last - first);
+        if (length >= sizeof(buffer)) {
+            length = sizeof(buffer) - 1;
+        }
+        std::memcpy(buffer, first, length);
+        buffer[length] = '\0';
+        char* parsed;
+        double result = std::strtod(buffer, &parsed);
+        if (parsed == buffer) {
+            return first;
+        }
+        value = result;
+        return first + (parsed - buffer);
+    }
+
+    /**
+     * Parses a decimal number at the start of [first, last) in the manner of
+     * {@code std::from_chars}, returning a pointer past the number, or
+     * {@p first} if there is no number.
+     *
+     * @remarks
+     * Numbers with at most 19 significant digits, a mantissa that fits in a
+     * double and a decimal exponent within 22 of zero, which covers nearly
+     * all telemetry, are converted exactly with one multiplication or
+     * division. Other numbers fall back to {@code strtod}.
+     **/
+    static const char* parseDouble(const char* first, const char* last, double& value) {
+        const char* p = first;
+        bool negative = false;
+        if (p != last && (*p == '-' || *p == '+')) {
+            negative = *p == '-';
+            ++p;
+        }
+
+        std::uint64_t mantissa = 0;
+        int significant = 0;
+        int exponent = 0;
+        bool truncated = false;
+        bool digits = false;
+        for (; p != last && isDigit(*p); ++p) {
+            digits = true;
+            if (significant < 19) {
+                mantissa = mantissa * 10 + static_cast<std::uint64_t>(*p - '0');
+                significant += mantissa != 0 ? 1 : 0;
+            }
+            else {
+                ++exponent;
+                truncated = true;
+            }
+        }
+        if (p != last && *p == '.') {
+            for (++p; p != last && isDigit(*p); ++p) {
+                digits = true;
+                if (significant < 19) {
+                    mantissa = mantissa * 10 + static_cast<std::uint64_t>(*p - '0');
+                    significant += mantissa != 0 ? 1 : 0;
+                    --exponent;
+                }
+                else {
+                    truncated = true;
+                }
+            }
+        }
+        if (!digits) {
+            if (p != last && (*p == 'n' || *p == 'N' || *p == 'i' || *p == 'I')) {
+                return parseDoubleSlow(first, last, value);
+            }
+            return first;
+        }
+        if (p != last && (*p == 'e' || *p == 'E')) {
+            const char* e = p + 1;
+            bool negativeExponent = false;
+            if (e != last && (*e == '-' || *e == '+')) {
+                negativeExponent = *e == '-';
+                ++e;
+            }
+            if (e != last && isDigit(*e)) {
+                int x = 0;
+                for (; e != last && isDigit(*e); ++e) {
+                    if (x < 100000) {
+                        x = x * 10 + (*e - '0');
+                    }
+                }
+                exponent += negativeExponent ? -x : x;
+                p = e;
+            }
+        }
+
+        if (truncated || mantissa > (std::uint64_t(1) << 53) || exponent < -22 || exponent > 22) {
+            return parseDoubleSlow(first, p, value);
+        }
+        double result = static_cast<double>(mantissa);
+        result = exponent < 0 ? result / Pow10[-exponent] : result * Pow10[exponent];
+        value = negative ? -result : result;
+        return p;
+    }
+
+    TelemetryReader::TelemetryReader(const std::string& filename, char delimiter)
+        : file(filename),
+          delimiter(delimiter),
+          begin(file.data()),
+          position(file.data()),
+          end(file.data() + file.size()) {
+        while (position != end && (*position == '\n' || *position == '\r')) {
+            ++position;
+        }
+        if (position == end) {
+            throw FormatError("Telemetry file has no header");
+        }
+
+        const char* lineEnd = findNewline(position, end);
+        while (position != lineEnd) {
+            const char* fieldEnd = findSeparator(position, lineEnd, delimiter);
+            std::string name(position, fieldEnd);
+            trimSpace(name);
+            columns.push_back(name);
+            position = fieldEnd == lineEnd ? lineEnd : fieldEnd + 1;
+        }
+        position = lineEnd == end ? end : lineEnd + 1;
+        begin = position;
+    }
+
+    bool TelemetryReader::next(std::vector<double>& row) {
+        while (position != end && (*position == '\n' || *position == '\r')) {
+            ++position;
+        }
+        if (position == end) {
+            return false;
+        }
+
+        row.resize(columns.size());
+        const char* p = position;
+        std::size_t column = 0;
+        for (; column < columns.size(); ++column) {
+            while (p != end && *p == ' ') {
+                ++p;
+            }
+            double value = NaN;
+            const char* parsed = parseDouble(p, end, value);
+            const char* fieldEnd = parsed;
+            if (fieldEnd == end || *fieldEnd != delimiter) {
+                fieldEnd = findSeparator(fieldEnd, end, delimiter);
+            }
+            if (parsed == p && !isBlank(p, fieldEnd)) {
+                throw FormatError("Invalid number in telemetry file");
+            }
+            row[column] = value;
+
+            p = fieldEnd;
+            if (p == end || *p == '\n') {
+                ++column;
+                break;
+            }
+            ++p;
+        }
+        for (; column < columns.size(); ++column) {
+            row[column] = NaN;
+        }
+
+        p = findNewline(p, end);
+        position = p == end ? end : p + 1;
+        return true;
+    }
+
+    void TelemetryReader::rewind() {
+        position = begin;
+    }
+
+    std::size_t TelemetryReader::countRows() const {
+        std::size_t rows = 0;
+        const char* p = begin;
+        while (p != end) {
+            const char* lineEnd = findNewline(p, end);
+            for (const char* c = p; c != lineEnd; ++c) {
+                if (*c != '\r') {
+                    ++rows;
+                    break;
+                }
+            }
+            p = lineEnd == end ? end : lineEnd + 1;
+        }
+        return rows;
+    }
+}
@@ -17,26 +17,34 @@
  *     All Rights Reserved.
  **/
 
+#include <algorithm>
+#include <cfloat>
 #include <chrono>
 #include <cmath>
+#include <cstddef>
+#include <limits>
 #include <stdexcept>
-#include <unordered_map>
 
 #include "UData.h"
 
 namespace PCOE {
-    static UDataInterface* getInterface(const UType ut) {
+    /**
+     * Gets the number of data elements used to represent the given
+     * uncertainty type with the given number of points.
+     **/
+    static std::vector<double>::size_type dataSize(const UType ut,
+                                                   const std::vector<double>::size_type npoints) {
         switch (ut) {
         case UType::Point:
-            return new PointInterface();
+            return 1;
         case UType::MeanSD:
-            return new MeanSDInterface();
+            return 2;
         case UType::MeanCovar:
-            return new MeanCovarInterface();
+            return npoints + 1;
         case UType::Samples:
-            return new SamplesInterface();
+            return npoints;
         case UType::WSamples:
-            return new WSamplesInterface();
+            return npoints * 2;
         default:
             throw std::domain_error("Invalid UTYPE");
         }
@@ -48,52 +56,35 @@ namespace PCOE {
 
     UData::UData() : UData(UType::Point) {}
 
-    UData::UData(const UType ut)
-        : m_data(),
+    UData::UData(const UType ut) : UData(ut, allocator_type()) {}
+
+    UData::UData(const UType ut, const allocator_type& allocator)
+        : m_data(allocator),
           m_dist(DIST_UNKNOWN),
-          m_interface(nullptr),
           m_npoints(1),
           m_uncertainty(ut),
+          m_layout(SampleLayout::Interleaved),
           m_updated(),
           m_valid(false) {
-        // Set Uncertainty. Initializes uType and interface
-        uncertainty(ut);
+        m_data.resize(dataSize(ut, m_npoints), NAN);
     }
 
     UData::UData(double value) : UData(UType::Point) {
         m_data[0] = value;
     }
 
-    UData::UData(const UData& other) : m_interface(nullptr) {
-        m_dist = other.m_dist;
-        m_data = other.m_data;
-        m_uncertainty = other.m_uncertainty;
-        m_npoints = other.m_npoints;
-        m_valid = other.m_valid;
-        m_updated = other.m_updated;
-        uncertainty(m_uncertainty);
-    }
-
-    UData::UData(UData&& other) : UData() {
-        swap(*this, other);
-    }
-
     UData& UData::operator=(UData other) {
         swap(*this, other);
         return *this;
     }
 
-    UData::~UData() {
-        delete m_interface;
-    }
-
     void swap(UData& a, UData& b) {
         using std::swap;
         swap(a.m_dist, b.m_dist);
         swap(a.m_data, b.m_data);
         swap(a.m_uncertainty, b.m_uncertainty);
+        swap(a.m_layout, b.m_layout);
         swap(a.m_npoints, b.m_npoints);
-        swap(a.m_interface, b.m_interface);
         swap(a.m_valid, b.m_valid);
         swap(a.m_updated, b.m_updated);
     }
@@ -111,6 +102,17 @@ namespace PCOE {
         if (m_data.size() != other.m_data.size()) {
             return false;
         }
+        if (columnar() != other.columnar()) {
+            // Weighted samples in different layouts are compared by key
+            for (size_type key = 0; key < m_data.size(); key++) {
+                double a = get(key);
+                double b = other.get(key);
+                if (a < b || a > b || std::isnan(a) != std::isnan(b)) {
+                    return false;
+                }
+            }
+            return true;
+        }
         if (m_data == other.m_data) {
             return true;
         }
@@ -121,7 +123,7 @@ namespace PCOE {
         // objects contain nothing except NaNs. This is necessary because NaN
         // does not compare equal to itself, causing the equality check above
         // to fail.
-        for (std::vector<double>::size_type i = 0; i < m_data.size(); i++) {
+        for (size_type i = 0; i < m_data.size(); i++) {
             if (!std::isnan(m_data[i]) || !std::isnan(other.m_data[i])) {
                 return false;
             }
@@ -138,16 +140,88 @@ namespace PCOE {
     //*------------------------------*
 
     void UData::npoints(const size_type value) {
+        if (columnar()) {
+            // The weights follow the samples, so they move when the number
+            // of samples changes
+            storage_type data(dataSize(m_uncertainty, value), NAN, m_data.get_allocator());
+            auto count = static_cast<std::ptrdiff_t>(std::min(value, m_npoints));
+            auto oldWeights = m_data.begin() + static_cast<std::ptrdiff_t>(m_npoints);
+            std::copy(m_data.begin(), m_data.begin() + count, data.begin());
+            std::copy(oldWeights,
+                      oldWeights + count,
+                      data.begin() + static_cast<std::ptrdiff_t>(value));
+            m_data.swap(data);
+        }
+        else {
+            m_data.resize(dataSize(m_uncertainty, value), NAN);
+        }
         m_npoints = value;
-        m_interface->setup(m_npoints, m_data);
     }
 
     void UData::uncertainty(const UType value) {
-        delete m_interface;
-
+        m_data.resize(dataSize(value, m_npoints), NAN);
         m_uncertainty = value;
-        m_interface = getInterface(value);
-        m_interface->setup(m_npoints, m_data);
+    }
+
+    void UData::layout(const SampleLayout value) {
+        if (m_layout == value) {
+            return;
+        }
+        if (m_uncertainty == UType::WSamples) {
+            storage_type data(m_data.size(), 0.0, m_data.get_allocator());
+            for (size_type i = 0; i < m_npoints; i++) {
+                if (value == SampleLayout::Columnar) {
+                    data[i] = m_data[SAMPLE(i)];
+                    data[m_npoints + i] = m_data[WEIGHT(i)];
+                }
+                else {
+                    data[SAMPLE(i)] = m_data[i];
+                    data[WEIGHT(i)] = m_data[m_npoints + i];
+                }
+            }
+            m_data.swap(data);
+        }
+        m_layout = value;
+    }
+
+    ConstMatrixView UData::samples() const {
+        switch (m_uncertainty) {
+        case UType::Samples:
+            return ConstMatrixView(m_data.data(), m_npoints, 1, 1);
+        case UType::WSamples:
+            return ConstMatrixView(m_data.data(), m_npoints, 1, columnar() ? 1 : 2);
+        default:
+            throw std::domain_error("UData does not contain samples");
+        }
+    }
+
+    MatrixView UData::samples() {
+        ConstMatrixView view = static_cast<const UData&>(*this).samples();
+        touch();
+        return MatrixView(const_cast<double*>(view.data()), view.rows(), 1, view.rowStride());
+    }
+
+    ConstMatrixView UData::weights() const {
+        if (m_uncertainty != UType::WSamples) {
+            throw std::domain_error("UData does not contain weighted samples");
+        }
+        if (columnar()) {
+            return ConstMatrixView(m_data.data() + m_npoints, m_npoints, 1, 1);
+        }
+        return ConstMatrixView(m_data.data() + 1, m_npoints, 1, 2);
+    }
+
+    MatrixView UData::weights() {
+        ConstMatrixView view = static_cast<const UData&>(*this).weights();
+        touch();
+        return MatrixView(const_cast<double*>(view.data()), view.rows(), 1, view.rowStride());
+    }
+
+    void UData::touch() {
+        using namespace std::chrono;
+        m_updated = static_cast<time_ticks>(
+            time_point_cast<microseconds>(clock::now()).time_since_epoch().count());
+        m_valid = true;
     }
 
     //*------------------------------*
@@ -176,11 +250,16 @@ namespace PCOE {
     }
 
     void UData::set(const size_type key, const double value) {
-        using namespace std::chrono;
-        m_interface->set(key, value, m_data);
-        m_updated = static_cast<time_ticks>(
-            time_point_cast<microseconds>(clock::now()).time_since_epoch().count());
-        m_valid = true;
+        if (m_uncertainty == UType::MeanSD && key == SD &&
+            value < std::numeric_limits<double>::epsilon()) {
+            // A standard deviation of zero is stored as the smallest
+            // positive double
+            m_data.at(key) = DBL_MIN;
+        }
+        else {
+            m_data.at(storageIndex(key)) = value;
+        }
+        touch();
     }
 
     //*------------------------------*
@@ -188,18 +267,20 @@ namespace PCOE {
     //*------------------------------*
 
     std::pair<double, double> UData::getPair(const size_type key) const {
-        if (size() - key < 2) {
+        if (key >= size() || size() - key < 2) {
             throw std::out_of_range("Not enough elements after the specified key");
         }
-        return m_interface->getPair(key, m_data);
+        return std::make_pair(m_data[storageIndex(key)], m_data[storageIndex(key + 1)]);
     }
 
     void UData::setPair(const size_type key, const std::pair<double, double>& value) {
-        using namespace std::chrono;
-        m_interface->setPair(key, value, m_data);
-        m_updated = static_cast<time_ticks>(
-            time_point_cast<microseconds>(clock::now()).time_since_epoch().count());
-        m_valid = true;
+        if (m_data.size() > key) {
+            m_data[storageIndex(key)] = value.first;
+        }
+        if (m_data.size() > key + 1) {
+            m_data[storageIndex(key + 1)] = value.second;
+        }
+        touch();
     }
 
     //*------------------------------*
@@ -207,14 +288,34 @@ namespace PCOE {
     //*------------------------------*
 
     std::vector<double> UData::getVec(const size_type key) const {
-        return m_interface->getVec(key, m_data);
+        if (key >= m_data.size()) {
+            return std::vector<double>();
+        }
+        if (columnar()) {
+            std::vector<double> result(m_data.size() - key);
+            for (size_type i = 0; i < result.size(); i++) {
+                result[i] = m_data[storageIndex(key + i)];
+            }
+            return result;
+        }
+        return std::vector<double>(m_data.begin() + static_cast<std::ptrdiff_t>(key),
+                                   m_data.end());
     }
 
     void UData::setVec(const size_type key, const std::vector<double>& value) {
-        using namespace std::chrono;
-        m_interface->setVec(key, value, m_data);
-        m_updated = static_cast<time_ticks>(
-            time_point_cast<microseconds>(clock::now()).time_since_epoch().count());
-        m_valid = true;
+        if (key < m_data.size()) {
+            auto count = std::min(value.size(), m_data.size() - key);
+            if (columnar()) {
+                for (size_type i = 0; i < count; i++) {
+                    m_data[storageIndex(key + i)] = value[i];
+                }
+            }
+            else {
+                std::copy(value.begin(),
+                          value.begin() + static_cast<std::ptrdiff_t>(count),
+                          m_data.begin() + static_cast<std::ptrdiff_t>(key));
+            }
+        }
+        touch();
     }
 }
@@ -0,0 +1,94 @@
+// Copyright (c) 2016-2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#include <cmath>
+#include <vector>
+
+#include "Contracts.h"
+#include "UnscentedTransform.h"
+
+namespace PCOE {
+    void initSigmaPoints(std::size_t n, SigmaPoints& sigma) {
+        sigma.M.resize(n, 2 * n + 1);
+        sigma.w.resize(2 * n + 1);
+        sigma.sqrtP.resize(n, n);
+
+        sigma.kappa = 3.0 - n;
+        sigma.alpha = 1;
+        sigma.beta = 0;
+    }
+
+    void computeSigmaPoints(const std::vector<double>& mx, const Matrix& Pxx, SigmaPoints& sigma) {
+        computeSigmaPoints(mx.data(), mx.size(), Pxx, sigma);
+    }
+
+    void computeSigmaPoints(const double* mx, std::size_t n, const Matrix& Pxx, SigmaPoints& sigma) {
+        // Compute a matrix square root using Cholesky decomposition
+        Pxx.chol(sigma.sqrtP);
+        computeSigmaPointsFromRoot(mx, n, sigma.sqrtP, sigma);
+    }
+
+    void computeSigmaPointsFromRoot(const std::vector<double>& mx,
+                                    const Matrix& sqrtPxx,
+                                    SigmaPoints& sigma) {
+        computeSigmaPointsFromRoot(mx.data(), mx.size(), sqrtPxx, sigma);
+    }
+
+    void computeSigmaPointsFromRoot(const double* mx,
+                                    std::size_t n,
+                                    const Matrix& sqrtPxx,
+                                    SigmaPoints& sigma) {
+        // Assumes that sigma points have been set up correctly by initSigmaPoints
+        auto stateSize = n;
+        auto sigmaPointCount = sigma.M.cols();
+        Expect(sigma.M.rows() == stateSize, "Sigma point rows do not match state size");
+        Expect(sigmaPointCount == 2 * stateSize + 1, "Sigma point count is not 2n+1");
+        Expect(stateSize + sigma.kappa > 0, "Non-positive sigma point spread");
+
+        // The square root of (n + kappa) * Pxx
+        double spread = std::sqrt(stateSize + sigma.kappa);
+
+        // The first sigma point is the mean. Sigma points 2 to n+1 are mx plus
+        // the ith column of the matrix square root, and n+2 to 2n+1 are mx
+        // minus the ith column. Each offset is scaled by alpha.
+        for (std::size_t i = 0; i < stateSize; i++) {
+            auto row = sigma.M[i];
+            auto sqrtRow = sqrtPxx[i];
+            row[0] = mx[i];
+            for (std::size_t j = 0; j < stateSize; j++) {
+                double offset = sigma.alpha * spread * sqrtRow[j];
+                row[j + 1] = mx[i] + offset;
+                row[j + stateSize + 1] = mx[i] - offset;
+            }
+        }
+
+        computeSigmaPointWeights(stateSize, sigma);
+    }
+
+    void computeSigmaPointWeights(std::size_t n, SigmaPoints& sigma) {
+        Expect(sigma.w.size() == 2 * n + 1, "Weight count is not 2n+1");
+
+        // W0 = kappa/(n+kappa), and the rest of w are 0.5/(n+kappa), scaled as
+        //    W0' = W0/alpha^2 + (1/alpha^2-1)
+        //    Wi' = Wi/alpha^2
+        double alpha2 = sigma.alpha * sigma.alpha;
+        sigma.w[0] = sigma.kappa / (n + sigma.kappa) / alpha2 + (1 / alpha2 - 1);
+        for (std::size_t i = 1; i < sigma.w.size(); i++) {
+            sigma.w[i] = 0.5 / (n + sigma.kappa) / alpha2;
+        }
+    }
+
+    double sigmaPointVariance(const std::vector<double>& y, const SigmaPoints& sigma, double mean) {
+        Expect(y.size() == sigma.w.size(), "Value count does not match sigma point count");
+        double result = 0;
+        for (std::size_t i = 0; i < y.size(); i++) {
+            double diff = y[i] - mean;
+            result += sigma.w[i] * diff * diff;
+        }
+
+        // Offset with alpha term
+        double diff0 = y[0] - mean;
+        result += (1 - sigma.alpha * sigma.alpha + sigma.beta) * diff0 * diff0;
+        return result;
+    }
+}
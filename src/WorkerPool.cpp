@@ -0,0 +1,99 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#include "WorkerPool.h"
+#include "Contracts.h"
+
+namespace PCOE {
+    WorkerPool::WorkerPool(std::size_t threadCount)
+        : task(nullptr), taskCount(0), pending(0), generation(0), stopping(false) {
+        threads.reserve(threadCount);
+        for (std::size_t i = 0; i < threadCount; i++) {
+            threads.emplace_back(&WorkerPool::work, this, i + 1);
+        }
+    }
+
+    WorkerPool::~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        ready.notify_all();
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    void WorkerPool::run(std::size_t count, const task_type& t) {
+        Expect(count <= threads.size() + 1, "Task count exceeds thread count");
+        if (count == 0) {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            task = &t;
+            taskCount = count;
+            pending = count - 1;
+            error = nullptr;
+            ++generation;
+        }
+        ready.notify_all();
+
+        std::exception_ptr result;
+        try {
+            t(0);
+        }
+        catch (...) {
+            result = std::current_exception();
+        }
+
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [this] { return pending == 0; });
+        if (!result) {
+            result = error;
+        }
+        task = nullptr;
+        error = nullptr;
+        lock.unlock();
+
+        if (result) {
+            std::rethrow_exception(result);
+        }
+    }
+
+    void WorkerPool::work(std::size_t index) {
+        std::size_t seen = 0;
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            ready.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) {
+                return;
+            }
+            seen = generation;
+            // Workers beyond the size of the current batch sit it out. run
+            // does not wait for them, so they may skip a batch entirely.
+            if (index >= taskCount) {
+                continue;
+            }
+
+            const task_type& t = *task;
+            lock.unlock();
+            std::exception_ptr e;
+            try {
+                t(index);
+            }
+            catch (...) {
+                e = std::current_exception();
+            }
+            lock.lock();
+
+            if (e && !error) {
+                error = e;
+            }
+            if (--pending == 0) {
+                done.notify_one();
+            }
+        }
+    }
+}
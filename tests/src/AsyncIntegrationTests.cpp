@@ -7,6 +7,7 @@
 #include <iomanip>
 #include <map>
 #include <sstream>
+#include <thread>
 #include <vector>
 
 #include "Messages/MessageBus.h"
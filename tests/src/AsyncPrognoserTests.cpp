@@ -61,6 +61,7 @@ namespace AsyncPrognoserTests {
 
             // Setup request
             Request request(time);
+            request.waiting = true;
             unique_lock requests_lock(processMessageMut);
             requests.push(&request);
             // Publish Message
@@ -70,7 +71,6 @@ namespace AsyncPrognoserTests {
             requests_lock.unlock();
 
             unique_lock lock(request.mut);
-            request.waiting = true;
             while (request.waiting) {
                 request.condition.wait(lock);
             }
@@ -161,6 +161,7 @@ namespace AsyncPrognoserTests {
         data[MessageId::TestOutput0] = Datum<double>(3);
         TestComm comm(bus);
         comm.init(data);
+        bus.waitAll();
 
         // Step
         auto newTime = addOneSecond(data[MessageId::TestInput0].getTime());
@@ -188,6 +189,7 @@ namespace AsyncPrognoserTests {
         data2[MessageId::TestOutput0] = Datum<double>(3);
         TestComm comm2(bus2);
         comm2.init(data2);
+        bus2.waitAll();
 
         // Step
         auto newTime2 = addOneSecond(data2[MessageId::TestInput0].getTime());
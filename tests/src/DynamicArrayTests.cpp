@@ -1,32 +1,34 @@
 // Copyright (c) 2018-2019 United States Government as represented by the
 // Administrator of the National Aeronautics and Space Administration.
 // All Rights Reserved.
+#include <stdexcept>
+
 #include "DynamicArray.h"
 #include "MockClasses.h"
 #include "Test.h"
 
-// TODO (JW): Total bytes allocated by std::vector is not predictable or
-//            consistent between platforms. Need to replace std::vector in the
-//            implementation of DynamicArray and uncomment allocation asserts
-//            in these tests.
-
 using namespace PCOE;
 using namespace PCOE::Test;
 
 namespace DynamicArrayTests {
     using test_type = double;
+    const std::size_t large = 20;
 
     void construct_empty() {
         TestAllocator<test_type> alloc;
-        DynamicArray<test_type, TestAllocator<test_type>> arr;
-        // Assert::AreEqual(8, *alloc.totalAllocated, "Allocation size");
+        DynamicArray<test_type, TestAllocator<test_type>> arr(0, alloc);
+        Assert::AreEqual(0, *alloc.totalAllocated, "Allocation size");
     }
 
     void construct() {
         TestAllocator<test_type> alloc;
         std::size_t size = 4;
         DynamicArray<test_type, TestAllocator<test_type>> arr(size, alloc);
-        // Assert::AreEqual(8 + size * sizeof(test_type), *alloc.totalAllocated, "Allocation size");
+        Assert::AreEqual(0, *alloc.totalAllocated, "Inline allocation size");
+
+        DynamicArray<test_type, TestAllocator<test_type>> arr1(large, alloc);
+        Assert::AreEqual(large * sizeof(test_type), *alloc.totalAllocated, "Allocation size");
+        Assert::AreEqual(0.0, arr1[large - 1], 1e-15, "Default value");
     }
 
     void construct_copy() {
@@ -34,9 +36,17 @@ namespace DynamicArrayTests {
         std::size_t size = 4;
 
         DynamicArray<test_type, TestAllocator<test_type>> arr0(size, alloc);
+        arr0[3] = 1.0;
         DynamicArray<test_type, TestAllocator<test_type>> arr1(arr0);
-        // Assert::AreEqual(2 * (8 + size * sizeof(test_type)), *alloc.totalAllocated, "Allocation
-        // size");
+        Assert::AreEqual(0, *alloc.totalAllocated, "Inline allocation size");
+        Assert::IsTrue(arr0 == arr1, "Inline copy");
+
+        DynamicArray<test_type, TestAllocator<test_type>> arr2(large, alloc);
+        arr2[large - 1] = 2.0;
+        DynamicArray<test_type, TestAllocator<test_type>> arr3(arr2);
+        Assert::AreEqual(2 * large * sizeof(test_type), *alloc.totalAllocated, "Allocation size");
+        Assert::IsTrue(arr2 == arr3, "Copy");
+        Assert::IsTrue(arr2.data() != arr3.data(), "Copy storage");
     }
 
     void construct_move() {
@@ -44,9 +54,44 @@ namespace DynamicArrayTests {
         std::size_t size = 4;
 
         DynamicArray<test_type, TestAllocator<test_type>> arr0(size, alloc);
+        arr0[3] = 1.0;
         DynamicArray<test_type, TestAllocator<test_type>> arr1(std::move(arr0));
-        // Assert::AreEqual(16 + size * sizeof(test_type), *alloc.totalAllocated, "Allocation
-        // size");
+        Assert::AreEqual(size, arr1.size(), "Inline move size");
+        Assert::AreEqual(1.0, arr1[3], 1e-15, "Inline move value");
+        Assert::IsTrue(arr0.empty(), "Moved from");
+
+        DynamicArray<test_type, TestAllocator<test_type>> arr2(large, alloc);
+        const test_type* data = arr2.data();
+        DynamicArray<test_type, TestAllocator<test_type>> arr3(std::move(arr2));
+        Assert::AreEqual(large * sizeof(test_type), *alloc.totalAllocated, "Allocation size");
+        Assert::IsTrue(arr3.data() == data, "Move storage");
+    }
+
+    void assign_swap() {
+        DynamicArray<test_type> small({1.0, 2.0});
+        DynamicArray<test_type> big(large);
+        big.fill(3.0);
+
+        swap(small, big);
+        Assert::AreEqual(large, small.size(), "Swapped size");
+        Assert::AreEqual(3.0, small[large - 1], 1e-15, "Swapped value");
+        Assert::AreEqual(2, big.size(), "Swapped inline size");
+        Assert::AreEqual(2.0, big[1], 1e-15, "Swapped inline value");
+
+        DynamicArray<test_type> other(large);
+        const test_type* data = other.data();
+        other.swap(small);
+        Assert::IsTrue(small.data() == data, "Swapped storage");
+
+        big = other;
+        Assert::IsTrue(big == other, "Assigned");
+        Assert::IsTrue(big != small, "Not equal");
+        try {
+            big.at(large);
+            Assert::Fail("Index out of range");
+        }
+        catch (const std::out_of_range&) {
+        }
     }
 
     void at() {
@@ -104,6 +149,28 @@ namespace DynamicArrayTests {
         Assert::AreEqual(5.0, arr.back(), 1e-15, "back 2");
     }
 
+    void reverse() {
+        TestAllocator<test_type> alloc;
+        for (std::size_t size : {std::size_t(4), large}) {
+            DynamicArray<test_type, TestAllocator<test_type>> arr(size, alloc);
+            for (std::size_t i = 0; i < size; i++) {
+                arr[i] = static_cast<test_type>(i);
+            }
+
+            std::size_t i = size;
+            for (auto it = arr.rbegin(); it != arr.rend(); ++it) {
+                Assert::AreEqual(arr[--i], *it, 1e-15, "rbegin");
+            }
+            Assert::AreEqual(0, i, "rbegin count");
+
+            i = size;
+            for (auto it = arr.crbegin(); it != arr.crend(); ++it) {
+                Assert::AreEqual(arr[--i], *it, 1e-15, "crbegin");
+            }
+            Assert::AreEqual(0, i, "crbegin count");
+        }
+    }
+
     void empty() {
         TestAllocator<test_type> alloc;
         std::size_t size = 4;
@@ -133,5 +200,7 @@ namespace DynamicArrayTests {
         context.AddTest("index", DynamicArrayTests::index, "Dynamic Array");
         context.AddTest("front", DynamicArrayTests::front, "Dynamic Array");
         context.AddTest("back", DynamicArrayTests::back, "Dynamic Array");
+        context.AddTest("reverse", DynamicArrayTests::reverse, "Dynamic Array");
+        context.AddTest("assign_swap", DynamicArrayTests::assign_swap, "Dynamic Array");
     }
 }
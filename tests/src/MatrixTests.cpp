@@ -1,11 +1,15 @@
 // Copyright (c) 2016-2019 United States Government as represented by the
 // Administrator of the National Aeronautics and Space Administration.
 // All Rights Reserved.
+#include <cmath>
 #include <iostream>
 #include <random>
 #include <sstream>
 
+#include "FixedMatrix.h"
 #include "Matrix.h"
+#include "MatrixDecomposition.h"
+#include "Models/SystemModel.h"
 #include "Test.h"
 
 using namespace PCOE;
@@ -904,6 +908,168 @@ namespace MatrixTests {
         }
     }
 
+    void multiply_blocked() {
+        // Sizes that do not divide evenly into the register tiles or cache
+        // blocks used by the multiplication kernels
+        const std::size_t m = 7;
+        const std::size_t k = 131;
+        const std::size_t n = 261;
+        Matrix a(m, k);
+        Matrix b(k, n);
+        Matrix bt(n, k);
+        Matrix at(k, m);
+        for (std::size_t i = 0; i < k; ++i) {
+            for (std::size_t j = 0; j < m; ++j) {
+                a[j][i] = at[i][j] = dist(rng);
+            }
+            for (std::size_t j = 0; j < n; ++j) {
+                b[i][j] = bt[j][i] = dist(rng);
+            }
+        }
+
+        Matrix e(m, n);
+        for (std::size_t i = 0; i < m; ++i) {
+            for (std::size_t j = 0; j < n; ++j) {
+                for (std::size_t p = 0; p < k; ++p) {
+                    e[i][j] += a[i][p] * b[p][j];
+                }
+            }
+        }
+
+        Matrix r(m, n);
+        Matrix::multiply(a, b, r);
+        Assert::AreEqual(e, r, "Unexpected value after blocked multiplication");
+        Assert::AreEqual(e, a * b, "Unexpected value after multiplication");
+        Assert::AreEqual(e, a.multiplyTransposed(bt), "Unexpected value for A * B'");
+        Assert::AreEqual(e, at.transposeMultiply(b), "Unexpected value for A' * B");
+
+        Matrix bCol = b.col(0);
+        std::vector<double> x(static_cast<std::vector<double>>(bCol));
+        std::vector<double> y(m, 1.0);
+        a.multiplyAdd(x.data(), y.data(), 2.0);
+        for (std::size_t i = 0; i < m; ++i) {
+            Assert::AreEqual(1.0 + 2.0 * e[i][0], y[i], 1e-9, "Unexpected value for gemv");
+        }
+
+        std::vector<double> z(m, 0.5);
+        Matrix::axpy(m, -2.0, z.data(), y.data());
+        for (std::size_t i = 0; i < m; ++i) {
+            Assert::AreEqual(2.0 * e[i][0], y[i], 1e-9, "Unexpected value for axpy");
+        }
+
+        try {
+            Matrix::multiply(a, b, a);
+            Assert::Fail("Failed to throw on incompatible result.");
+        }
+        catch (const std::domain_error&) {
+        }
+    }
+
+    void expressions() {
+        Matrix a(2, 2, {1, 2, 3, 4});
+        Matrix b(2, 2, {5, 6, 7, 8});
+        const Matrix c(2, 2, {-1, 0, 1, 2});
+
+        Matrix r = a + 2.0 * b - c / 2.0;
+        Assert::AreEqual(Matrix(2, 2, {11.5, 14, 16.5, 19}), r, "Compound expression");
+        r = -c + 1.0;
+        Assert::AreEqual(Matrix(2, 2, {2, 1, 0, -1}), r, "Negation");
+
+        // Assigning an expression that refers to the destination
+        r = a;
+        r = r * 3.0 - a;
+        Assert::AreEqual(a * 2.0, r, "Aliased assignment");
+        r += a - b;
+        Assert::AreEqual(Matrix(2, 2, {-2, 0, 2, 4}), r, "Compound assignment");
+
+        // Assigning to a matrix of a different size
+        Matrix resized(3, 1);
+        resized = a + b;
+        Assert::AreEqual(Matrix(2, 2, {6, 8, 10, 12}), resized, "Resizing assignment");
+
+        // Products with expression operands are evaluated eagerly
+        Assert::AreEqual((a + b) * c, Matrix(a + b) * c, "Product of expression");
+        Assert::AreEqual(c * (a - b), c * Matrix(a - b), "Product with expression");
+
+        // Temporaries are kept alive by the expression
+        auto e = a * b + c;
+        Matrix tmp(2, 2, {1, 1, 1, 1});
+        Assert::AreEqual(Matrix(a * b) + c, Matrix(e), "Expression of temporary");
+        auto f = Matrix(a) - 1.0;
+        Assert::AreEqual(a - tmp, Matrix(f), "Expression of moved matrix");
+
+        // Members of Matrix evaluate the expression first
+        Assert::AreEqual(Matrix(a + b).transpose(), (a + b).transpose(), "Transpose");
+        Assert::AreEqual(Matrix(a + c).inverse(), (a + c).inverse(), "Inverse");
+        Assert::AreEqual(Matrix(a - b).determinant(), (a - b).determinant(), 1e-12, "Determinant");
+        Assert::AreEqual(12.0, (a + b).at(1, 1), 1e-15, "Element");
+
+        try {
+            Matrix bad = a + Matrix(2, 3);
+            Assert::Fail("Failed to throw on different sizes.");
+        }
+        catch (const std::domain_error&) {
+        }
+    }
+
+    void views() {
+        Matrix a(3, 3, {1, 2, 3, 4, 5, 6, 7, 8, 9});
+        const Matrix& ca = a;
+
+        ConstMatrixView column = ca.colView(1);
+        Assert::AreEqual(3ul, column.rows(), "Column rows");
+        Assert::AreEqual(1ul, column.cols(), "Column cols");
+        Assert::AreEqual(8.0, column[2], 1e-15, "Column element");
+        Assert::AreEqual(Matrix(3, 1, {2, 5, 8}), Matrix(column), "Column");
+        Assert::AreEqual(ca.col(1), Matrix(column), "Column matches col");
+
+        ConstMatrixView row = ca.rowView(2);
+        Assert::AreEqual(Matrix(1, 3, {7, 8, 9}), Matrix(row), "Row");
+        std::vector<double> rowValues = static_cast<std::vector<double>>(row);
+        Assert::AreEqual(3ul, rowValues.size(), "Row vector size");
+        Assert::AreEqual(9.0, rowValues[2], 1e-15, "Row vector element");
+
+        ConstMatrixView block = ca.blockView(1, 1, 2, 2);
+        Assert::AreEqual(Matrix(2, 2, {5, 6, 8, 9}), Matrix(block), "Block");
+        Assert::AreEqual(9.0, block[3], 1e-15, "Block element");
+
+        // Views take part in element-wise expressions
+        Matrix b(2, 2, {1, 1, 1, 1});
+        Matrix sum = block + 2.0 * b;
+        Assert::AreEqual(Matrix(2, 2, {7, 8, 10, 11}), sum, "Block expression");
+        Matrix colSum = a.colView(0) + a.colView(2);
+        Assert::AreEqual(Matrix(3, 1, {4, 10, 16}), colSum, "Column expression");
+
+        // Assigning to a view writes through to the matrix
+        a.colView(0) = Matrix(3, 1, {-1, -2, -3});
+        Assert::AreEqual(Matrix(3, 3, {-1, 2, 3, -2, 5, 6, -3, 8, 9}), a, "Column assignment");
+        a.blockView(0, 1, 2, 2) += b;
+        Assert::AreEqual(Matrix(3, 3, {-1, 3, 4, -2, 6, 7, -3, 8, 9}), a, "Block update");
+        a.rowView(2) = a.rowView(0);
+        Assert::AreEqual(Matrix(3, 3, {-1, 3, 4, -2, 6, 7, -1, 3, 4}), a, "Row copy");
+        MatrixView diagonal(&a[0][0], 3, 1, 4);
+        diagonal *= 2.0;
+        Assert::AreEqual(Matrix(3, 3, {-2, 3, 4, -2, 12, 7, -1, 3, 8}), a, "Strided update");
+
+        // State vectors can be constructed directly from a column
+        StateVector x(a.colView(1));
+        Assert::AreEqual(3ul, x.size(), "State vector size");
+        Assert::AreEqual(12.0, x[1], 1e-15, "State vector element");
+
+        try {
+            a.blockView(2, 2, 2, 1);
+            Assert::Fail("Created a block view outside of the matrix.");
+        }
+        catch (const std::out_of_range&) {
+        }
+        try {
+            a.colView(0) = b;
+            Assert::Fail("Assigned a matrix of a different size to a view.");
+        }
+        catch (const std::domain_error&) {
+        }
+    }
+
     void multiply_scalar() {
         const std::size_t m = 20;
         const std::size_t n = 10;
@@ -1309,6 +1475,24 @@ namespace MatrixTests {
                 }
             }
         }
+
+        // Transposing into an existing matrix, with sizes that span several
+        // tiles
+        Matrix matrix(37, 19);
+        for (std::size_t j = 0; j < 37; ++j) {
+            for (std::size_t k = 0; k < 19; ++k) {
+                matrix[j][k] = dist(rng);
+            }
+        }
+        Matrix result(19, 37);
+        matrix.transpose(result);
+        Assert::AreEqual(matrix.transpose(), result, "Unexpected value");
+        try {
+            matrix.transpose(matrix);
+            Assert::Fail("Failed to throw on wrong size.");
+        }
+        catch (const std::domain_error&) {
+        }
     }
 
     void identity() {
@@ -1329,6 +1513,141 @@ namespace MatrixTests {
         Assert::AreEqual(e, a, "Unexpected value");
     }
 
+    static void assertNear(const Matrix& expected, const Matrix& actual, double delta) {
+        Assert::AreEqual(expected.rows(), actual.rows(), "Unexpected row count");
+        Assert::AreEqual(expected.cols(), actual.cols(), "Unexpected column count");
+        for (std::size_t i = 0; i < expected.rows(); ++i) {
+            for (std::size_t j = 0; j < expected.cols(); ++j) {
+                Assert::AreEqual(expected.at(i, j), actual.at(i, j), delta, "Unexpected value");
+            }
+        }
+    }
+
+    void luDecomposition() {
+        Matrix matrix(3, 3, {3, 5, 7, 19, 17, 13, 11, 3, 1});
+        LUDecomposition lu(matrix);
+        Assert::IsFalse(lu.isSingular(), "Matrix reported as singular");
+        Assert::AreEqual(-356, lu.determinant(), 1e-12, "Determinant");
+        Assert::AreEqual(std::log(356.0), lu.logDeterminant(), 1e-12, "Log determinant");
+        Assert::AreEqual(-1, lu.determinantSign(), "Determinant sign");
+
+        Matrix b(3, 2, {1, 0, 2, 1, 3, -1});
+        Matrix x = lu.solve(b);
+        assertNear(b, matrix * x, 1e-12);
+        assertNear(Matrix::identity(3), matrix * lu.inverse(), 1e-12);
+
+        // Refactoring a matrix of the same size reuses the decomposition
+        for (std::size_t iteration = 0; iteration < ITERATIONS; ++iteration) {
+            Matrix m(8, 8);
+            for (std::size_t i = 0; i < 8; ++i) {
+                for (std::size_t j = 0; j < 8; ++j) {
+                    m[i][j] = dist(rng);
+                }
+            }
+            lu.factorize(m);
+            Matrix y(8, 1);
+            for (std::size_t i = 0; i < 8; ++i) {
+                y[i][0] = dist(rng);
+            }
+            x = Matrix(8, 1);
+            lu.solve(y, x);
+            assertNear(y, m * x, 1e-8);
+            Assert::AreEqual(std::log(std::abs(m.determinant())),
+                             lu.logDeterminant(),
+                             1e-9,
+                             "Random log determinant");
+        }
+
+        Matrix singular(2, 2, {1, 2, 2, 4});
+        lu.factorize(singular);
+        Assert::IsTrue(lu.isSingular(), "Singular matrix not detected");
+        try {
+            lu.inverse();
+            Assert::Fail("Failed to throw on singular matrix.");
+        }
+        catch (const std::domain_error&) {
+        }
+        try {
+            singular.inverse();
+            Assert::Fail("Failed to throw on singular matrix.");
+        }
+        catch (const std::domain_error&) {
+        }
+    }
+
+    void choleskyDecomposition() {
+        Matrix matrix(3, 3, {25, 15, -5, 15, 18, 0, -5, 0, 11});
+        CholeskyDecomposition chol(matrix);
+        Assert::AreEqual(matrix.chol(), chol.getLower(), "Unexpected factor");
+        Assert::AreEqual(matrix.determinant(), chol.determinant(), 1e-9, "Determinant");
+        Assert::AreEqual(std::log(matrix.determinant()),
+                         chol.logDeterminant(),
+                         1e-12,
+                         "Log determinant");
+
+        Matrix b(3, 2, {1, 0, 2, 1, 3, -1});
+        assertNear(b, matrix * chol.solve(b), 1e-12);
+        assertNear(matrix.inverse(), chol.inverse(), 1e-12);
+
+        // Solving in place
+        Matrix x = b;
+        chol.solve(x, x);
+        assertNear(b, matrix * x, 1e-12);
+
+        try {
+            chol.factorize(Matrix(2, 2, {1, 2, 2, 1}));
+            Assert::Fail("Failed to throw on indefinite matrix.");
+        }
+        catch (const std::domain_error&) {
+        }
+    }
+
+    void fixedMatrix() {
+        FixedMatrix<2, 3> a({1, 2, 3, 4, 5, 6});
+        FixedMatrix<3, 2> b({7, 8, 9, 10, 11, 12});
+        Assert::AreEqual(2u, a.rows(), "Unexpected row count");
+        Assert::AreEqual(3u, a.cols(), "Unexpected column count");
+
+        // Products match the dynamic matrix
+        Matrix expected = static_cast<Matrix>(a) * static_cast<Matrix>(b);
+        FixedMatrix<2, 2> product = a * b;
+        Assert::AreEqual(expected, static_cast<Matrix>(product), "Unexpected product");
+        Assert::IsTrue(FixedMatrix<2, 2>(expected) == product, "Conversion from Matrix");
+        Assert::AreEqual(static_cast<Matrix>(a).transpose(),
+                         static_cast<Matrix>(a.transpose()),
+                         "Unexpected transpose");
+
+        FixedMatrix<2, 3> sum = a + a - a * 0.5;
+        Assert::AreEqual(7.5, sum[1][1], 1e-15, "Unexpected sum");
+        Assert::AreEqual(1.5, sum.at(0, 0), 1e-15, "Unexpected sum");
+
+        FixedMatrix<3, 3> spd({25, 15, -5, 15, 18, 0, -5, 0, 11});
+        Assert::AreEqual(static_cast<Matrix>(spd).chol(),
+                         static_cast<Matrix>(spd.chol()),
+                         "Unexpected Cholesky factor");
+        FixedMatrix<3, 2> x = spd.cholSolve(b);
+        FixedMatrix<3, 2> bx = spd * x;
+        for (std::size_t i = 0; i < 3; ++i) {
+            for (std::size_t j = 0; j < 2; ++j) {
+                Assert::AreEqual(b[i][j], bx[i][j], 1e-12, "Unexpected solution");
+            }
+        }
+        Assert::IsTrue(FixedMatrix<3, 3>::identity() * spd == spd, "Unexpected identity");
+
+        try {
+            FixedMatrix<2, 2> wrong(Matrix(2, 3));
+            Assert::Fail("Failed to throw on wrong size.");
+        }
+        catch (const std::domain_error&) {
+        }
+        try {
+            FixedMatrix<2, 2>({1, 2, 2, 1}).chol();
+            Assert::Fail("Failed to throw on indefinite matrix.");
+        }
+        catch (const std::domain_error&) {
+        }
+    }
+
     void weightedmean() {
         Matrix matrix(3, 2, {1, 2, 3, 4, 5, 6});
         Matrix w(2, 1, {0.2, 0.8});
@@ -1358,6 +1677,45 @@ namespace MatrixTests {
 
         Assert::AreEqual(e, a, "Unexpected value");
 
+        // The alpha/beta term is applied once, to the first column
+        Matrix scaled = matrix.weightedCovariance(w, 0.5, 2);
+        for (std::size_t i = 0; i < 3; i++) {
+            for (std::size_t j = 0; j < 3; j++) {
+                Assert::AreEqual(1.92, scaled[i][j], 1e-12, "Unexpected scaled value");
+            }
+        }
+
+        Matrix samples(2, 3, {1, 2, 6, 0, 4, 2});
+        std::vector<double> weights = {0.25, 0.25, 0.5};
+        std::vector<double> mean(2);
+        Matrix covar(2, 2);
+        Matrix::weightedMoments(samples, weights.data(), mean.data(), covar);
+        Assert::AreEqual(3.75, mean[0], 1e-12, "Unexpected mean");
+        Assert::AreEqual(2.0, mean[1], 1e-12, "Unexpected mean");
+        Assert::AreEqual(5.1875, covar[0][0], 1e-12, "Unexpected variance");
+        Assert::AreEqual(0.5, covar[0][1], 1e-12, "Unexpected covariance");
+        Assert::AreEqual(0.5, covar[1][0], 1e-12, "Unexpected covariance");
+        Assert::AreEqual(2.0, covar[1][1], 1e-12, "Unexpected variance");
+
+        // Sigma point weights, where the central weight is negative and the
+        // running sum of the weights reaches zero, on large values
+        Matrix sigma(2, 5, {1e6, 1e6 + 1, 1e6 - 1, 1e6, 1e6, 5, 5, 5, 7, 3});
+        std::vector<double> sigmaWeights = {-1.0, 0.5, 0.5, 0.5, 0.5};
+        Matrix::weightedMoments(sigma, sigmaWeights.data(), mean.data(), covar, 0.5);
+        Assert::AreEqual(1e6, mean[0], 1e-9, "Unexpected sigma mean");
+        Assert::AreEqual(5.0, mean[1], 1e-12, "Unexpected sigma mean");
+        Assert::AreEqual(1.0, covar[0][0], 1e-9, "Unexpected sigma variance");
+        Assert::AreEqual(0.0, covar[0][1], 1e-9, "Unexpected sigma covariance");
+        Assert::AreEqual(4.0, covar[1][1], 1e-12, "Unexpected sigma variance");
+
+        Matrix wrongSize(2, 3);
+        try {
+            Matrix::weightedMoments(samples, weights.data(), mean.data(), wrongSize);
+            Assert::Fail("Computed covariance into a matrix of the wrong size");
+        }
+        catch (const std::domain_error&) {
+        }
+
         Matrix w2(3, 1, {0.2, 0.8, 0});
         Matrix w3(1, 1, {0.2});
         try {
@@ -1421,6 +1779,9 @@ namespace MatrixTests {
         context.AddTest("subtract_matrix", subtract_matrix, "Matrix");
         context.AddTest("subtract_salar", subtract_salar, "Matrix");
         context.AddTest("multiply_matrix", multiply_matrix, "Matrix");
+        context.AddTest("multiply_blocked", multiply_blocked, "Matrix");
+        context.AddTest("expressions", expressions, "Matrix");
+        context.AddTest("views", views, "Matrix");
         context.AddTest("multiply_scalar", multiply_scalar, "Matrix");
         context.AddTest("divide_scalar", divide_scalar, "Matrix");
         context.AddTest("modulo_by_scalar", modulo_by_scalar, "Matrix");
@@ -1439,6 +1800,9 @@ namespace MatrixTests {
         context.AddTest("identity", identity, "Matrix");
         // Special operations
         context.AddTest("cholesky", cholesky, "Matrix");
+        context.AddTest("lu decomposition", luDecomposition, "Matrix");
+        context.AddTest("cholesky decomposition", choleskyDecomposition, "Matrix");
+        context.AddTest("fixed matrix", fixedMatrix, "Matrix");
         context.AddTest("weightedmean", weightedmean, "Matrix");
         context.AddTest("weightedcovariance", weightedcovariance, "Matrix");
         // Stream insertion
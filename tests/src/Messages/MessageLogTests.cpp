@@ -0,0 +1,208 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "Messages/MessageBus.h"
+#include "Messages/MessageRecorder.h"
+#include "Messages/MessageReplayer.h"
+#include "Messages/ScalarMessage.h"
+#include "Messages/VectorMessage.h"
+#include "Test.h"
+
+using namespace PCOE;
+using namespace PCOE::Test;
+
+namespace MessageLogTests {
+    const std::string src = "test";
+    const MessageClock::time_point start = MessageClock::time_point(std::chrono::hours(1000));
+
+    std::string logPath(const std::string& test) {
+        return "gsap-test-" + std::to_string(getpid()) + "-" + test;
+    }
+
+    void removeLog(const std::string& path) {
+        std::remove(MessageLog::indexPath(path).c_str());
+        for (std::uint32_t i = 0; std::remove(MessageLog::segmentPath(path, i).c_str()) == 0;
+             ++i) {
+        }
+    }
+
+    std::shared_ptr<Message> makeMessage(int i, std::chrono::milliseconds spacing) {
+        return std::shared_ptr<Message>(
+            new DoubleMessage(MessageId::TestInput0, src, start + i * spacing, i));
+    }
+
+    class ListProcessor final : public IMessageProcessor {
+    public:
+        void processMessage(const std::shared_ptr<Message>& message) override {
+            std::lock_guard<std::mutex> lock(mutex);
+            messages.push_back(message);
+        }
+
+        std::mutex mutex;
+        std::vector<std::shared_ptr<Message>> messages;
+    };
+
+    void recordReplay() {
+        const std::string path = logPath("record");
+        {
+            MessageBus bus(std::launch::deferred);
+            MessageRecorder recorder(bus, path);
+            recorder.record(src);
+            for (int i = 0; i < 10; i++) {
+                bus.publish(makeMessage(i, std::chrono::milliseconds(10)));
+                bus.publish(std::shared_ptr<Message>(
+                    new DoubleMessage(MessageId::TestInput0, "other", start, -1.0)));
+            }
+            bus.publish(std::shared_ptr<Message>(new DoubleVecMessage(MessageId::ModelStateVector,
+                                                                      src,
+                                                                      start,
+                                                                      {1.0, 2.0, 3.0})));
+            bus.waitAll();
+            Assert::AreEqual(11, recorder.messageCount(), "Messages recorded");
+            Assert::AreEqual(1, recorder.segmentCount(), "Segments written");
+        }
+
+        MessageReplayer replayer(path);
+        Assert::AreEqual(start.time_since_epoch().count(),
+                         replayer.getStartTime().time_since_epoch().count(),
+                         "Start time");
+        for (int i = 0; i < 10; i++) {
+            auto message = replayer.next();
+            Assert::IsNotNull(message.get(), "Message replayed");
+            Assert::AreEqual(src, message->getSource(), "Source");
+            auto scalar = dynamic_cast<DoubleMessage*>(message.get());
+            Assert::IsNotNull(scalar, "Message type");
+            Assert::AreEqual(i, scalar->getValue(), 0.0, "Value");
+        }
+
+        double element = 0.0;
+        bool read = replayer.read([&element](const SerializedMessage& message) {
+            element = message.getDoubleVector()[1];
+        });
+        Assert::IsTrue(read, "Read vector");
+        Assert::AreEqual(2.0, element, 0.0, "Vector element");
+        Assert::IsNull(replayer.next().get(), "End of log");
+
+        replayer.rewind();
+        Assert::IsNotNull(replayer.next().get(), "Rewind");
+        removeLog(path);
+    }
+
+    void seek() {
+        const std::string path = logPath("seek");
+        const auto spacing = std::chrono::milliseconds(100);
+        {
+            MessageBus bus(std::launch::deferred);
+            MessageRecorder recorder(bus, path, 4096, std::chrono::seconds(1));
+            for (int i = 0; i < 1000; i++) {
+                recorder.processMessage(makeMessage(i, spacing));
+            }
+            Assert::IsTrue(recorder.segmentCount() > 1, "Multiple segments");
+        }
+
+        MessageReplayer replayer(path);
+        replayer.seek(start + std::chrono::seconds(70));
+        auto message = replayer.next();
+        Assert::AreEqual(700, dynamic_cast<DoubleMessage&>(*message).getValue(), 0.0, "Exact");
+
+        replayer.seek(start + std::chrono::milliseconds(4250));
+        message = replayer.next();
+        Assert::AreEqual(43, dynamic_cast<DoubleMessage&>(*message).getValue(), 0.0, "Between");
+
+        replayer.seek(start - std::chrono::seconds(1));
+        message = replayer.next();
+        Assert::AreEqual(0, dynamic_cast<DoubleMessage&>(*message).getValue(), 0.0, "Before");
+
+        replayer.seek(start + std::chrono::seconds(100));
+        Assert::IsNull(replayer.next().get(), "After end");
+
+        std::size_t count = 0;
+        replayer.rewind();
+        while (replayer.next() != nullptr) {
+            ++count;
+        }
+        Assert::AreEqual(1000, count, "All segments read");
+        removeLog(path);
+    }
+
+    void outOfOrder() {
+        const std::string path = logPath("order");
+        const auto spacing = std::chrono::milliseconds(100);
+        std::vector<int> order;
+        {
+            MessageBus bus(std::launch::deferred);
+            MessageRecorder recorder(bus, path, 4096, std::chrono::seconds(1));
+            // Every fifth message arrives three seconds late
+            for (int i = 0; i < 500; i++) {
+                int value = i % 5 == 0 && i >= 30 ? i - 30 : i;
+                order.push_back(value);
+                recorder.processMessage(makeMessage(value, spacing));
+            }
+
+            // Messages larger than a segment are dropped
+            std::vector<double> large(1024);
+            recorder.processMessage(std::shared_ptr<Message>(
+                new DoubleVecMessage(MessageId::ModelStateVector, src, start, large)));
+            Assert::AreEqual(500, recorder.messageCount(), "Large message dropped");
+        }
+
+        MessageReplayer replayer(path);
+        for (int t = 0; t < 500; t += 7) {
+            auto expected = order.begin();
+            while (expected != order.end() && *expected < t) {
+                ++expected;
+            }
+            replayer.seek(start + t * spacing);
+            auto message = replayer.next();
+            Assert::AreEqual(*expected,
+                             dynamic_cast<DoubleMessage&>(*message).getValue(),
+                             0.0,
+                             "First message at or after time");
+        }
+        removeLog(path);
+    }
+
+    void pacing() {
+        const std::string path = logPath("pacing");
+        const auto spacing = std::chrono::milliseconds(20);
+        {
+            MessageBus bus(std::launch::deferred);
+            MessageRecorder recorder(bus, path);
+            for (int i = 0; i < 11; i++) {
+                recorder.processMessage(makeMessage(i, spacing));
+            }
+        }
+
+        MessageReplayer replayer(path);
+        MessageBus bus(std::launch::deferred);
+        ListProcessor listener;
+        bus.subscribe(&listener, src);
+
+        auto begin = std::chrono::steady_clock::now();
+        Assert::AreEqual(11, replayer.replay(bus, 2.0), "Scaled replay count");
+        auto elapsed = std::chrono::steady_clock::now() - begin;
+        Assert::IsTrue(elapsed >= std::chrono::milliseconds(100), "Scaled pacing");
+
+        replayer.rewind();
+        Assert::AreEqual(11, replayer.replay(bus, 0.0), "Unpaced replay count");
+        bus.waitAll();
+        Assert::AreEqual(22, listener.messages.size(), "Messages published");
+        bus.unsubscribe(&listener);
+        removeLog(path);
+    }
+
+    void registerTests(TestContext& context) {
+        context.AddTest("Record and Replay", MessageLogTests::recordReplay, "Message Log");
+        context.AddTest("Seek", MessageLogTests::seek, "Message Log");
+        context.AddTest("Out of Order", MessageLogTests::outOfOrder, "Message Log");
+        context.AddTest("Pacing", MessageLogTests::pacing, "Message Log");
+    }
+}
@@ -0,0 +1,373 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include "Exceptions.h"
+#include "Messages/EmptyMessage.h"
+#include "Messages/MessageFactory.h"
+#include "Messages/PredictionMessage.h"
+#include "Messages/ProgEventMessage.h"
+#include "Messages/ScalarMessage.h"
+#include "Messages/SerializedMessage.h"
+#include "Messages/UDataMessage.h"
+#include "Messages/VectorMessage.h"
+#include "Messages/WaypointMessage.h"
+#include "Test.h"
+
+using namespace PCOE;
+using namespace PCOE::Test;
+
+namespace MessageSerializationTests {
+    const std::string src = "test";
+    const MessageClock::time_point timestamp(MessageClock::duration(1234567));
+
+    std::string serialize(const Message& message) {
+        std::ostringstream os;
+        message.serialize(os);
+        return os.str();
+    }
+
+    std::vector<std::uint64_t> alignedBuffer(const std::string& bytes) {
+        std::vector<std::uint64_t> buffer((bytes.size() + 7) / 8);
+        std::memcpy(buffer.data(), bytes.data(), bytes.size());
+        return buffer;
+    }
+
+    template <class T>
+    std::unique_ptr<T> roundTrip(const Message& message) {
+        std::istringstream is(serialize(message));
+        std::unique_ptr<Message> result = MessageFactory::instance().deserialize(is);
+        Assert::IsTrue(result != nullptr, "Deserialized message");
+        Assert::IsTrue(result->getMessageId() == message.getMessageId(), "Message id");
+        Assert::AreEqual(message.getSource(), result->getSource(), "Message source");
+        Assert::IsTrue(result->getTimestamp() == message.getTimestamp(), "Message timestamp");
+        T* typed = dynamic_cast<T*>(result.get());
+        Assert::IsTrue(typed != nullptr, "Message type");
+        result.release();
+        return std::unique_ptr<T>(typed);
+    }
+
+    void header() {
+        DoubleMessage message(MessageId::TestInput0, src, timestamp, 4.2);
+        std::string bytes = serialize(message);
+        Assert::AreEqual(message.getSerializedSize(), bytes.size(), "Serialized size");
+        Assert::AreEqual(0, bytes.size() % 8, "Serialized size alignment");
+
+        std::vector<std::uint64_t> buffer = alignedBuffer(bytes);
+        SerializedMessage view(reinterpret_cast<const char*>(buffer.data()), bytes.size());
+        Assert::IsTrue(view.getMessageId() == MessageId::TestInput0, "View id");
+        Assert::AreEqual(src, view.getSource(), "View source");
+        Assert::IsTrue(view.getTimestamp() == timestamp, "View timestamp");
+        Assert::AreEqual(sizeof(double), view.getPayloadSize(), "View payload size");
+        Assert::AreEqual(bytes.size(), view.size(), "View size");
+        Assert::AreEqual(0,
+                         (view.getPayload() - reinterpret_cast<const char*>(buffer.data())) % 8,
+                         "Payload alignment");
+    }
+
+    void scalar() {
+        auto d =
+            roundTrip<DoubleMessage>(DoubleMessage(MessageId::TestInput0, src, timestamp, 4.2));
+        Assert::AreEqual(4.2, d->getValue(), 0.0, "Double value");
+
+        auto u8 = roundTrip<U8Message>(
+            U8Message(static_cast<MessageId>(0x6272110000000000L), src, timestamp, 17));
+        Assert::AreEqual(17, u8->getValue(), "U8 value");
+
+        auto i64 = roundTrip<I64Message>(
+            I64Message(static_cast<MessageId>(0x6272240000000000L), src, timestamp, -5));
+        Assert::AreEqual(-5, i64->getValue(), "I64 value");
+
+        roundTrip<EmptyMessage>(EmptyMessage(MessageId::Start, src, timestamp));
+
+        auto wp = roundTrip<WaypointMessage>(
+            WaypointMessage(MessageId::RouteSetWP, src, timestamp, timestamp, 1.0, 2.0, 3.0));
+        Assert::IsTrue(wp->getEta() == timestamp, "Waypoint ETA");
+        Assert::AreEqual(1.0, wp->getLatitude(), 0.0, "Waypoint latitude");
+        Assert::AreEqual(2.0, wp->getLongitude(), 0.0, "Waypoint longitude");
+        Assert::AreEqual(3.0, wp->getAltitude(), 0.0, "Waypoint altitude");
+    }
+
+    void vector() {
+        std::vector<double> values(10000);
+        for (std::size_t i = 0; i < values.size(); i++) {
+            values[i] = static_cast<double>(i) / 3.0;
+        }
+        DoubleVecMessage message(MessageId::ModelStateVector, src, timestamp, values);
+        Assert::IsTrue(message.getSerializedSize() > 65536, "Payload larger than 16 bits");
+
+        auto result = roundTrip<DoubleVecMessage>(message);
+        Assert::AreEqual(values.size(), result->getValue().size(), "Vector size");
+        for (std::size_t i = 0; i < values.size(); i++) {
+            Assert::AreEqual(values[i], result->getValue()[i], 0.0, "Vector value");
+        }
+
+        auto empty = roundTrip<I16VecMessage>(
+            I16VecMessage(static_cast<MessageId>(0x6272820000000000L), src, timestamp, {}));
+        Assert::AreEqual(0, empty->getValue().size(), "Empty vector size");
+    }
+
+    void vectorView() {
+        std::vector<double> values = {1.0, 2.5, -3.0};
+        std::string bytes =
+            serialize(DoubleVecMessage(MessageId::ModelStateVector, src, timestamp, values));
+        std::vector<std::uint64_t> buffer = alignedBuffer(bytes);
+        const char* data = reinterpret_cast<const char*>(buffer.data());
+
+        SerializedMessage message(data, bytes.size());
+        ConstMatrixView view = message.getDoubleVector();
+        Assert::AreEqual(3, view.rows(), "View rows");
+        Assert::AreEqual(1, view.cols(), "View cols");
+        for (std::size_t i = 0; i < values.size(); i++) {
+            Assert::AreEqual(values[i], view[i], 0.0, "View value");
+        }
+        Assert::IsTrue(reinterpret_cast<const char*>(view.data()) > data &&
+                           reinterpret_cast<const char*>(view.data()) < data + bytes.size(),
+                       "View refers to the buffer");
+
+        std::string scalarBytes =
+            serialize(DoubleMessage(MessageId::TestInput0, src, timestamp, 1.0));
+        std::vector<std::uint64_t> scalarBuffer = alignedBuffer(scalarBytes);
+        SerializedMessage scalar(reinterpret_cast<const char*>(scalarBuffer.data()),
+                                 scalarBytes.size());
+        try {
+            scalar.getDoubleVector();
+            Assert::Fail("Got vector view of a scalar message");
+        }
+        catch (const std::domain_error&) {
+        }
+    }
+
+    void udataVector() {
+        UData point(4.2);
+        point.dist(DIST_GAUSSIAN);
+
+        UData covar(UType::MeanCovar);
+        covar.npoints(2);
+        covar[MEAN] = 1.0;
+        covar[COVAR(0)] = 2.0;
+        covar[COVAR(1)] = 3.0;
+
+        UData samples(UType::WSamples);
+        samples.npoints(3);
+        samples.layout(SampleLayout::Columnar);
+        for (std::size_t i = 0; i < 3; i++) {
+            samples[SAMPLE(i)] = static_cast<double>(i);
+            samples[WEIGHT(i)] = 0.1 * static_cast<double>(i + 1);
+        }
+
+        UData invalid(UType::MeanSD);
+
+        std::vector<UData> state = {point, covar, samples, invalid};
+        auto result = roundTrip<UDataVecMessage>(
+            UDataVecMessage(MessageId::ModelStateEstimate, src, timestamp, state));
+        const std::vector<UData>& values = result->getValue();
+        Assert::AreEqual(state.size(), values.size(), "State size");
+        for (std::size_t i = 0; i < state.size(); i++) {
+            Assert::IsTrue(state[i] == values[i], "UData value");
+            Assert::IsTrue(state[i].uncertainty() == values[i].uncertainty(), "UData type");
+            Assert::AreEqual(state[i].updated(), values[i].updated(), "UData updated");
+            Assert::AreEqual(state[i].valid(), values[i].valid(), "UData valid");
+        }
+        Assert::IsTrue(values[0].dist() == DIST_GAUSSIAN, "UData distribution");
+        Assert::IsTrue(values[2].layout() == SampleLayout::Columnar, "UData layout");
+        Assert::AreEqual(0.3, values[2].get(WEIGHT(2)), 1e-15, "UData weight");
+    }
+
+    ProgEvent makeEvent() {
+        UData toe(UType::Samples);
+        toe.npoints(2);
+        toe[0] = 100.0;
+        toe[1] = 200.0;
+        std::vector<UData> state = {UData(1.0), UData(2.0)};
+        std::vector<Point4D<MessageClock>> points = {
+            Point4D<MessageClock>(1.0, 2.0, 3.0, timestamp, {4.0, 5.0})};
+        return ProgEvent(MessageId::BatteryEod, state, toe, points, "tag");
+    }
+
+    void checkEvent(const ProgEvent& expected, const ProgEvent& actual) {
+        Assert::IsTrue(expected.getId() == actual.getId(), "Event id");
+        Assert::AreEqual(expected.getTag(), actual.getTag(), "Event tag");
+        Assert::IsTrue(expected.getTOE() == actual.getTOE(), "Event TOE");
+        Assert::AreEqual(expected.getState().size(), actual.getState().size(), "Event state size");
+        for (std::size_t i = 0; i < expected.getState().size(); i++) {
+            Assert::IsTrue(expected.getState()[i] == actual.getState()[i], "Event state");
+        }
+        const auto& expectedPoints = expected.getPoints();
+        const auto& actualPoints = actual.getPoints();
+        Assert::AreEqual(expectedPoints.size(), actualPoints.size(), "Event point count");
+        for (std::size_t i = 0; i < expectedPoints.size(); i++) {
+            Assert::AreEqual(expectedPoints[i].getLatitude(),
+                             actualPoints[i].getLatitude(),
+                             0.0,
+                             "Point latitude");
+            Assert::AreEqual(expectedPoints[i].getAltitude(),
+                             actualPoints[i].getAltitude(),
+                             0.0,
+                             "Point altitude");
+            Assert::IsTrue(expectedPoints[i].getTime() == actualPoints[i].getTime(), "Point time");
+            Assert::IsTrue(expectedPoints[i].getStates() == actualPoints[i].getStates(),
+                           "Point states");
+        }
+    }
+
+    void progEvent() {
+        ProgEvent event = makeEvent();
+        auto result = roundTrip<ProgEventMessage>(
+            ProgEventMessage(MessageId::BatteryEod, src, timestamp, event));
+        checkEvent(event, result->getValue());
+    }
+
+    void prediction() {
+        DataPoint observable;
+        observable.setUncertainty(UType::MeanSD);
+        observable.setNumTimes(2);
+        for (std::size_t i = 0; i <= 2; i++) {
+            observable[i][MEAN] = static_cast<double>(i);
+            observable[i][SD] = 0.5;
+        }
+        Prediction value({makeEvent(), makeEvent()}, {observable});
+
+        auto result = roundTrip<PredictionMessage>(PredictionMessage(src, timestamp, value));
+        const Prediction& actual = result->getValue();
+        Assert::AreEqual(2, actual.getEvents().size(), "Event count");
+        checkEvent(value.getEvents()[1], actual.getEvents()[1]);
+        Assert::AreEqual(1, actual.getObservables().size(), "Observable count");
+        const DataPoint& actualObservable = actual.getObservables()[0];
+        Assert::IsTrue(actualObservable.getUncertainty() == UType::MeanSD, "Observable type");
+        Assert::AreEqual(2, actualObservable.getNumTimes(), "Observable times");
+        for (std::size_t i = 0; i <= 2; i++) {
+            Assert::IsTrue(actualObservable[i] == observable[i], "Observable value");
+        }
+    }
+
+    void sharedPayload() {
+        std::vector<double> values = {1.0, 2.0, 3.0};
+        const double* data = values.data();
+        DoubleVecMessage moved(MessageId::ModelStateVector, src, timestamp, std::move(values));
+        Assert::IsTrue(moved.getValue().data() == data, "Vector moved into message");
+
+        DoubleVecMessage shared(MessageId::ModelStateVector,
+                                src,
+                                timestamp,
+                                moved.getSharedValue());
+        Assert::IsTrue(&shared.getValue() == &moved.getValue(), "Vector shared by messages");
+
+        auto prediction =
+            std::make_shared<const Prediction>(Prediction({makeEvent(), makeEvent()}, {}));
+        std::weak_ptr<const Prediction> weak = prediction;
+        const ProgEvent& event = prediction->getEvents()[1];
+        ProgEventMessage eMsg(MessageId::BatteryEod,
+                              src,
+                              timestamp,
+                              std::shared_ptr<const ProgEvent>(prediction, &event));
+        Assert::IsTrue(&eMsg.getValue() == &event, "Event shared by message");
+        {
+            PredictionMessage pMsg(src, timestamp, prediction);
+            Assert::IsTrue(&pMsg.getValue() == prediction.get(), "Prediction shared by message");
+            prediction.reset();
+        }
+        Assert::IsFalse(weak.expired(), "Event message keeps prediction alive");
+        checkEvent(makeEvent(), eMsg.getValue());
+    }
+
+    void stream() {
+        std::ostringstream os;
+        DoubleMessage(MessageId::TestInput0, src, timestamp, 1.0).serialize(os);
+        EmptyMessage(MessageId::Stop, "other", timestamp).serialize(os);
+        DoubleVecMessage(MessageId::ModelStateVector, src, timestamp, {1.0, 2.0}).serialize(os);
+
+        std::istringstream is(os.str());
+        MessageFactory& factory = MessageFactory::instance();
+        Assert::IsTrue(factory.deserialize(is)->getMessageId() == MessageId::TestInput0, "First");
+        Assert::AreEqual("other", factory.deserialize(is)->getSource(), "Second");
+        Assert::IsTrue(factory.deserialize(is)->getMessageId() == MessageId::ModelStateVector,
+                       "Third");
+        Assert::IsTrue(factory.deserialize(is) == nullptr, "End of stream");
+    }
+
+    void malformed() {
+        std::string bytes = serialize(DoubleVecMessage(MessageId::ModelStateVector,
+                                                       src,
+                                                       timestamp,
+                                                       {1.0, 2.0, 3.0}));
+        MessageFactory& factory = MessageFactory::instance();
+        try {
+            factory.deserialize(bytes.data(), bytes.size() - 8);
+            Assert::Fail("Deserialized truncated message");
+        }
+        catch (const FormatError&) {
+        }
+
+        std::string badVersion = bytes;
+        badVersion[0] = 2;
+        try {
+            factory.deserialize(badVersion.data(), badVersion.size());
+            Assert::Fail("Deserialized unsupported version");
+        }
+        catch (const FormatError&) {
+        }
+
+        std::string badCount = bytes;
+        std::uint32_t count = 1000;
+        std::memcpy(&badCount[MessageHeaderSize + 8], &count, sizeof(count));
+        try {
+            factory.deserialize(badCount.data(), badCount.size());
+            Assert::Fail("Deserialized vector with bad count");
+        }
+        catch (const FormatError&) {
+        }
+
+        // Streams reject payload lengths that are too large or not present
+        for (std::uint32_t length : {0xFFFFFFF0u, 0x00300000u}) {
+            std::string badLength = bytes;
+            std::memcpy(&badLength[4], &length, sizeof(length));
+            std::istringstream is(badLength);
+            try {
+                factory.deserialize(is);
+                Assert::Fail("Deserialized message with bad length from stream");
+            }
+            catch (const FormatError&) {
+            }
+        }
+
+        std::string unknown = serialize(ProgEventMessage(
+            static_cast<MessageId>(0x6272380000001234L), src, timestamp, makeEvent()));
+        try {
+            factory.deserialize(unknown.data(), unknown.size());
+            Assert::Fail("Deserialized unregistered message");
+        }
+        catch (const std::out_of_range&) {
+        }
+
+        factory.Register<ProgEventMessage>(static_cast<MessageId>(0x6272380000001234L));
+        auto registered = factory.deserialize(unknown.data(), unknown.size());
+        Assert::IsTrue(dynamic_cast<ProgEventMessage*>(registered.get()) != nullptr,
+                       "Registered message type");
+    }
+
+    void registerTests(TestContext& context) {
+        context.AddTest("Header", MessageSerializationTests::header, "Message Serialization");
+        context.AddTest("Scalar", MessageSerializationTests::scalar, "Message Serialization");
+        context.AddTest("Vector", MessageSerializationTests::vector, "Message Serialization");
+        context.AddTest("Vector View",
+                        MessageSerializationTests::vectorView,
+                        "Message Serialization");
+        context.AddTest("UData Vector",
+                        MessageSerializationTests::udataVector,
+                        "Message Serialization");
+        context.AddTest("ProgEvent", MessageSerializationTests::progEvent, "Message Serialization");
+        context.AddTest("Prediction",
+                        MessageSerializationTests::prediction,
+                        "Message Serialization");
+        context.AddTest("Shared Payload",
+                        MessageSerializationTests::sharedPayload,
+                        "Message Serialization");
+        context.AddTest("Stream", MessageSerializationTests::stream, "Message Serialization");
+        context.AddTest("Malformed", MessageSerializationTests::malformed, "Message Serialization");
+    }
+}
@@ -0,0 +1,337 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "Messages/MessageBridge.h"
+#include "Messages/MessageBus.h"
+#include "Messages/ScalarMessage.h"
+#include "Messages/SharedMemoryPublisher.h"
+#include "Messages/SharedMemoryRing.h"
+#include "Messages/VectorMessage.h"
+#include "Test.h"
+
+using namespace PCOE;
+using namespace PCOE::Test;
+
+namespace SharedMemoryTests {
+    const std::string src = "test";
+
+    std::string ringName(const std::string& test) {
+        return "/gsap-test-" + std::to_string(getpid()) + "-" + test;
+    }
+
+    class CountingProcessor final : public IMessageProcessor {
+    public:
+        void processMessage(const std::shared_ptr<Message>& message) override {
+            auto scalar = dynamic_cast<DoubleMessage*>(message.get());
+            if (scalar != nullptr) {
+                last = scalar->getValue();
+            }
+            ++count;
+        }
+
+        bool waitFor(int expected) {
+            auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+            while (count < expected && std::chrono::steady_clock::now() < timeout) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            return count == expected;
+        }
+
+        std::atomic<int> count{0};
+        std::atomic<double> last{0.0};
+    };
+
+    /**
+     * Publishes replies to the publisher it is subscribed to.
+     **/
+    class ReplyingProcessor final : public IMessageProcessor {
+    public:
+        explicit ReplyingProcessor(SharedMemoryPublisher& publisher) : publisher(publisher) {}
+
+        void processMessage(const std::shared_ptr<Message>&) override {
+            std::vector<double> payload(200);
+            for (int i = 0; i < 3; i++) {
+                try {
+                    publisher.publish(std::shared_ptr<Message>(new DoubleVecMessage(
+                        MessageId::ModelOutputVector, src, MessageClock::now(), payload)));
+                    ++replies;
+                }
+                catch (const std::runtime_error&) {
+                    ++failures;
+                }
+            }
+            ++count;
+        }
+
+        SharedMemoryPublisher& publisher;
+        std::atomic<int> count{0};
+        std::atomic<int> replies{0};
+        std::atomic<int> failures{0};
+    };
+
+    void readWrite() {
+        SharedMemoryRing ring(ringName("rw"), 4096);
+        SharedMemoryReader reader(ring);
+        Assert::AreEqual(1, ring.readers(), "Reader count");
+        Assert::IsFalse(reader.tryRead([](const SerializedMessage&) {}), "Empty ring");
+
+        ring.write(DoubleVecMessage(MessageId::ModelStateVector,
+                                    src,
+                                    MessageClock::now(),
+                                    {1.0, 2.0, 3.0}));
+        std::vector<double> values;
+        bool read = reader.tryRead([&values](const SerializedMessage& message) {
+            Assert::AreEqual(src, message.getSource(), "Source");
+            ConstMatrixView view = message.getDoubleVector();
+            values = static_cast<std::vector<double>>(view);
+        });
+        Assert::IsTrue(read, "Read message");
+        Assert::AreEqual(3, values.size(), "Value count");
+        Assert::AreEqual(3.0, values[2], 0.0, "Value");
+        Assert::AreEqual(0, reader.pending(), "Nothing pending");
+        Assert::IsFalse(reader.tryRead([](const SerializedMessage&) {}), "Ring drained");
+    }
+
+    void wrap() {
+        SharedMemoryRing ring(ringName("wrap"), 4096);
+        SharedMemoryReader reader(ring);
+        std::vector<double> payload(20);
+        for (int i = 0; i < 500; i++) {
+            payload[0] = i;
+            ring.write(
+                DoubleVecMessage(MessageId::ModelStateVector, src, MessageClock::now(), payload));
+            double first = -1.0;
+            reader.tryRead([&first](const SerializedMessage& message) {
+                first = message.getDoubleVector()[0];
+            });
+            Assert::AreEqual(i, first, 0.0, "Message order");
+        }
+    }
+
+    void full() {
+        SharedMemoryRing ring(ringName("full"), 4096);
+        DoubleMessage message(MessageId::TestInput0, src, MessageClock::now(), 1.0);
+        for (int i = 0; i < 1000; i++) {
+            Assert::IsTrue(ring.tryWrite(message), "Write without readers");
+        }
+
+        SharedMemoryReader reader(ring);
+        std::size_t written = 0;
+        while (ring.tryWrite(message)) {
+            ++written;
+        }
+        Assert::AreEqual(4096 / message.getSerializedSize(), written, "Messages that fit");
+        Assert::IsTrue(reader.tryRead([](const SerializedMessage&) {}), "Read one");
+        Assert::IsTrue(ring.tryWrite(message), "Write after read");
+
+        try {
+            std::vector<double> large(1024);
+            ring.tryWrite(
+                DoubleVecMessage(MessageId::ModelStateVector, src, MessageClock::now(), large));
+            Assert::Fail("Wrote message larger than half the ring");
+        }
+        catch (const std::domain_error&) {
+        }
+    }
+
+    void crossProcess() {
+        const int count = 1000;
+        const std::string name = ringName("process");
+        SharedMemoryRing ring(name, 1 << 16);
+
+        pid_t child = fork();
+        Assert::IsTrue(child >= 0, "fork");
+        if (child == 0) {
+            int status = 1;
+            try {
+                SharedMemoryRing opened(name);
+                SharedMemoryReader reader(opened);
+                int received = 0;
+                double sum = 0.0;
+                auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+                while (received < count && std::chrono::steady_clock::now() < timeout) {
+                    reader.tryRead([&](const SerializedMessage& message) {
+                        sum += message.payloadReader().read<double>();
+                        ++received;
+                    });
+                }
+                status = received == count && sum > count * (count - 1) / 2.0 - 0.5 ? 0 : 2;
+            }
+            catch (...) {
+                status = 3;
+            }
+            _exit(status);
+        }
+
+        auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (ring.readers() == 0 && std::chrono::steady_clock::now() < timeout) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        for (int i = 0; i < count; i++) {
+            ring.write(DoubleMessage(MessageId::TestInput0, src, MessageClock::now(), i));
+        }
+
+        int status = 0;
+        waitpid(child, &status, 0);
+        Assert::IsTrue(WIFEXITED(status), "Child exited");
+        Assert::AreEqual(0, WEXITSTATUS(status), "Child received all messages");
+    }
+
+    void deadReader() {
+        const std::string name = ringName("dead");
+        SharedMemoryRing ring(name, 4096);
+
+        // The child attaches a reader and exits without destroying it, as a
+        // crashed reader would
+        pid_t child = fork();
+        Assert::IsTrue(child >= 0, "fork");
+        if (child == 0) {
+            int status = 1;
+            try {
+                SharedMemoryRing* opened = new SharedMemoryRing(name);
+                new SharedMemoryReader(*opened);
+                status = 0;
+            }
+            catch (...) {
+                status = 2;
+            }
+            _exit(status);
+        }
+
+        int status = 0;
+        waitpid(child, &status, 0);
+        Assert::IsTrue(WIFEXITED(status), "Child exited");
+        Assert::AreEqual(0, WEXITSTATUS(status), "Child attached a reader");
+        Assert::AreEqual(1, ring.readers(), "Reader left attached");
+
+        DoubleMessage message(MessageId::TestInput0, src, MessageClock::now(), 1.0);
+        for (int i = 0; i < 1000; i++) {
+            Assert::IsTrue(ring.tryWrite(message), "Write past dead reader");
+        }
+        Assert::AreEqual(0, ring.readers(), "Dead reader detached");
+
+        // Readers in live processes still hold up the writer
+        SharedMemoryReader reader(ring);
+        std::size_t written = 0;
+        while (ring.tryWrite(message)) {
+            ++written;
+        }
+        Assert::AreEqual(4096 / message.getSerializedSize(), written, "Messages that fit");
+        Assert::AreEqual(1, ring.readers(), "Live reader attached");
+    }
+
+    void bridge() {
+        MessageBus producerBus;
+        MessageBus consumerBus;
+        SharedMemoryPublisher writer(ringName("bridge"), 1 << 16);
+        SharedMemoryPublisher reader(ringName("bridge"));
+        MessageBridge out(producerBus, writer);
+        MessageBridge in(consumerBus, reader);
+        out.exportMessages(src, MessageId::TestInput0);
+        in.importMessages(src, MessageId::TestInput0);
+
+        CountingProcessor listener;
+        consumerBus.subscribe(&listener, src, MessageId::TestInput0);
+
+        producerBus.publish(std::shared_ptr<Message>(
+            new DoubleMessage(MessageId::TestInput0, src, MessageClock::now(), 4.2)));
+        producerBus.publish(std::shared_ptr<Message>(
+            new DoubleMessage(MessageId::TestInput1, src, MessageClock::now(), 1.0)));
+        producerBus.waitAll();
+        Assert::IsTrue(listener.waitFor(1), "Bridged message received");
+        consumerBus.waitAll();
+        Assert::AreEqual(4.2, listener.last, 0.0, "Bridged value");
+        consumerBus.unsubscribe(&listener);
+
+        try {
+            reader.publish(std::shared_ptr<Message>(
+                new DoubleMessage(MessageId::TestInput0, src, MessageClock::now(), 1.0)));
+            Assert::Fail("Published to an opened ring");
+        }
+        catch (const std::domain_error&) {
+        }
+    }
+
+    void corrupt() {
+        const std::string name = ringName("corrupt");
+        SharedMemoryRing ring(name, 4096);
+        SharedMemoryReader reader(ring);
+        DoubleMessage message(MessageId::TestInput0, src, MessageClock::now(), 1.0);
+        ring.write(message);
+        ring.write(message);
+
+        // Overwrite the version of the first message in the shared memory
+        std::ostringstream os;
+        message.serialize(os);
+        std::string bytes = os.str();
+        int fd = shm_open(name.c_str(), O_RDWR, 0);
+        Assert::IsTrue(fd >= 0, "shm_open");
+        struct stat st;
+        fstat(fd, &st);
+        std::size_t size = static_cast<std::size_t>(st.st_size);
+        void* mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        Assert::IsTrue(mapping != MAP_FAILED, "mmap");
+        char* begin = static_cast<char*>(mapping);
+        char* found = std::search(begin, begin + size, bytes.begin(), bytes.end());
+        Assert::IsTrue(found != begin + size, "Message in shared memory");
+        found[0] = 7;
+        munmap(mapping, size);
+
+        try {
+            reader.tryRead([](const SerializedMessage&) {});
+            Assert::Fail("Read invalid message");
+        }
+        catch (const FormatError&) {
+        }
+        Assert::AreEqual(0, reader.pending(), "Skipped to writer");
+        Assert::IsFalse(reader.tryRead([](const SerializedMessage&) {}), "Nothing left");
+
+        ring.write(message);
+        Assert::IsTrue(reader.tryRead([](const SerializedMessage&) {}), "Read after skip");
+    }
+
+    void reentrant() {
+        SharedMemoryPublisher publisher(ringName("reentrant"), 4096);
+        ReplyingProcessor replier(publisher);
+        publisher.subscribe(&replier, src, MessageId::TestInput0);
+
+        for (int i = 1; i <= 2; i++) {
+            publisher.publish(std::shared_ptr<Message>(
+                new DoubleMessage(MessageId::TestInput0, src, MessageClock::now(), 1.0)));
+            auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+            while (replier.count < i && std::chrono::steady_clock::now() < timeout) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            Assert::AreEqual(i, replier.count.load(), "Message received");
+        }
+        Assert::AreEqual(4, replier.replies.load(), "Replies that fit");
+        Assert::AreEqual(2, replier.failures.load(), "Replies while full");
+    }
+
+    void registerTests(TestContext& context) {
+        context.AddTest("Read and Write", SharedMemoryTests::readWrite, "Shared Memory");
+        context.AddTest("Wrap", SharedMemoryTests::wrap, "Shared Memory");
+        context.AddTest("Full", SharedMemoryTests::full, "Shared Memory");
+        context.AddTest("Cross Process", SharedMemoryTests::crossProcess, "Shared Memory");
+        context.AddTest("Dead Reader", SharedMemoryTests::deadReader, "Shared Memory");
+        context.AddTest("Bridge", SharedMemoryTests::bridge, "Shared Memory");
+        context.AddTest("Corrupt", SharedMemoryTests::corrupt, "Shared Memory");
+        context.AddTest("Reentrant", SharedMemoryTests::reentrant, "Shared Memory");
+    }
+}
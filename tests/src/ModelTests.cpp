@@ -1,11 +1,13 @@
 // Copyright (c) 2018-2019 United States Government as represented by the
 // Administrator of the National Aeronautics and Space Administration.
 // All Rights Reserved.
+#include <cmath>
 #include <iostream>
 
 #include "Test.h"
 
 #include "Models/BatteryModel.h"
+#include "Matrix.h"
 #include "Models/SystemModel.h"
 #include "Tank3.h"
 
@@ -261,6 +263,50 @@ namespace ModelTests {
         Assert::AreEqual(0, observables.size());
     }
 
+    void testBatteryJacobians() {
+        // Create battery model
+        BatteryModel battery = BatteryModel();
+
+        // Initialize, and discharge for a while so that every state is away
+        // from its initial value
+        auto u0 = BatteryModel::input_type({0.4});
+        auto z0 = BatteryModel::output_type({20, 4.0});
+        auto x = battery.initialize(u0, z0);
+        auto u = BatteryModel::input_type({8});
+        std::vector<double> zeroNoise(8);
+        for (int i = 0; i < 100; i++) {
+            x = battery.stateEqn(i, x, u, zeroNoise, 1);
+        }
+
+        // The analytic Jacobians should match the finite difference
+        // approximations of the base class
+        Matrix F(8, 8);
+        Matrix Fd(8, 8);
+        battery.stateJacobian(0, x, u, 1, F);
+        battery.SystemModel::stateJacobian(0, x, u, 1, Fd);
+        for (std::size_t i = 0; i < 8; i++) {
+            for (std::size_t j = 0; j < 8; j++) {
+                Assert::AreEqual(Fd[i][j],
+                                 F[i][j],
+                                 1e-5 * std::abs(Fd[i][j]) + 1e-12,
+                                 "State Jacobian");
+            }
+        }
+
+        Matrix H(2, 8);
+        Matrix Hd(2, 8);
+        battery.outputJacobian(0, x, H);
+        battery.SystemModel::outputJacobian(0, x, Hd);
+        for (std::size_t i = 0; i < 2; i++) {
+            for (std::size_t j = 0; j < 8; j++) {
+                Assert::AreEqual(Hd[i][j],
+                                 H[i][j],
+                                 1e-5 * std::abs(Hd[i][j]) + 1e-12,
+                                 "Output Jacobian");
+            }
+        }
+    }
+
     void registerTests(PCOE::Test::TestContext& context) {
         context.AddTest("Tank Initialization", testTankInitialize, "Model Tank");
         context.AddTest("Tank State Eqn", testTankStateEqn, "Model Tank");
@@ -272,5 +318,6 @@ namespace ModelTests {
         context.AddTest("Battery Output Eqn", testBatteryOutputEqn, "Model Battery");
         context.AddTest("Battery Threshold Eqn", testBatteryThresholdEqn, "Model Battery");
         context.AddTest("Battery Predicted Output Eqn", testBatteryPredictedOutputEqn, "Model Battery");
+        context.AddTest("Battery Jacobians", testBatteryJacobians, "Model Battery");
     }
 }
@@ -0,0 +1,88 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "DataPoint.h"
+#include "MonotonicArena.h"
+#include "Test.h"
+#include "UData.h"
+
+using namespace PCOE;
+using namespace PCOE::Test;
+
+namespace MonotonicArenaTests {
+    void allocate() {
+        MonotonicArena arena(64);
+        Assert::AreEqual(1, arena.blockCount(), "Initial block count");
+        Assert::AreEqual(0, arena.used(), "Initial used");
+
+        char* c = static_cast<char*>(arena.allocate(1, 1));
+        double* d = static_cast<double*>(arena.allocate(sizeof(double), alignof(double)));
+        Assert::IsNotNull(c, "Byte allocation");
+        Assert::AreEqual(0,
+                         reinterpret_cast<std::uintptr_t>(d) % alignof(double),
+                         "Double alignment");
+        Assert::AreEqual(1, arena.blockCount(), "Block count after small allocations");
+        Assert::AreEqual(1 + sizeof(double), arena.used(), "Used after small allocations");
+
+        *d = 1.5;
+        void* large = arena.allocate(1024);
+        Assert::AreEqual(2, arena.blockCount(), "Block count after large allocation");
+        Assert::AreEqual(0,
+                         reinterpret_cast<std::uintptr_t>(large) % alignof(std::max_align_t),
+                         "Default alignment");
+        Assert::AreEqual(1.5, *d, 0.0, "Earlier allocation preserved");
+    }
+
+    void allocator() {
+        auto arena = std::make_shared<MonotonicArena>(1024);
+        ArenaAllocator<double> alloc(arena);
+        std::vector<double, ArenaAllocator<double>> values(alloc);
+        values.reserve(16);
+        Assert::AreEqual(16 * sizeof(double), arena->used(), "Vector allocated in arena");
+
+        std::vector<double, ArenaAllocator<double>> copy(values);
+        Assert::IsTrue(copy.get_allocator() == ArenaAllocator<double>(), "Copy is on the heap");
+        Assert::IsTrue(ArenaAllocator<int>(alloc) == alloc, "Rebound allocator");
+        Assert::IsTrue(ArenaAllocator<double>() != alloc, "Heap allocator");
+    }
+
+    void udata() {
+        std::weak_ptr<MonotonicArena> weak;
+        UData moved;
+        {
+            auto arena = std::make_shared<MonotonicArena>();
+            weak = arena;
+            UData u(UType::Samples, UData::allocator_type(arena));
+            u.npoints(10);
+            u[SAMPLE(3)] = 4.0;
+            Assert::IsTrue(u.allocator().getArena() == arena, "UData allocated in arena");
+
+            UData copy(u);
+            Assert::IsNull(copy.allocator().getArena().get(), "Copied UData on the heap");
+            Assert::AreEqual(4.0, copy[SAMPLE(3)], 0.0, "Copied value");
+
+            DataPoint point{UData::allocator_type(arena)};
+            point.setUncertainty(UType::Samples);
+            point.setNumTimes(3);
+            point.setNPoints(10);
+            Assert::IsTrue(point[3].allocator().getArena() == arena, "DataPoint in arena");
+
+            moved = std::move(u);
+        }
+        Assert::IsFalse(weak.expired(), "Moved UData keeps arena alive");
+        Assert::AreEqual(4.0, moved[SAMPLE(3)], 0.0, "Moved value");
+        moved = UData();
+        Assert::IsTrue(weak.expired(), "Arena freed with last UData");
+    }
+
+    void registerTests(TestContext& context) {
+        context.AddTest("Allocate", MonotonicArenaTests::allocate, "Monotonic Arena");
+        context.AddTest("Allocator", MonotonicArenaTests::allocator, "Monotonic Arena");
+        context.AddTest("UData", MonotonicArenaTests::udata, "Monotonic Arena");
+    }
+}
@@ -5,7 +5,9 @@
 #include <utility>
 
 #include "Messages/ScalarMessage.h"
+#include "Messages/UDataMessage.h"
 #include "MockClasses.h"
+#include "Observers/AsyncFleetObserver.h"
 #include "Observers/AsyncObserver.h"
 #include "Test.h"
 
@@ -62,8 +64,57 @@ namespace AsyncObserverTests {
                          "obs didn't produce state estimate after two sets of data");
     }
 
+    void fleetProcessMessage() {
+        MessageBus bus;
+        TestPrognosticsModel tm;
+        const std::string src0 = "test0";
+        const std::string src1 = "test1";
+
+        Matrix Q(2, 2);
+        Q[0][0] = 1e-4;
+        Q[1][1] = 1e-4;
+        Matrix R(1, 1);
+        R[0][0] = 1e-2;
+        std::unique_ptr<BatchUnscentedKalmanFilter> filter(
+            new BatchUnscentedKalmanFilter(tm, 2, Q, R));
+
+        MessageCounter listener0(bus, src0, MessageId::ModelStateEstimate);
+        MessageCounter listener1(bus, src1, MessageId::ModelStateEstimate);
+        AsyncFleetObserver fleetObs(bus, std::move(filter), {src0, src1});
+
+        auto publishSet = [&bus](const std::string& src) {
+            bus.publish(std::shared_ptr<Message>(
+                new DoubleMessage(MessageId::TestInput0, src, MessageClock::now(), 1.0)));
+            bus.publish(std::shared_ptr<Message>(
+                new DoubleMessage(MessageId::TestInput1, src, MessageClock::now(), 2.0)));
+            bus.publish(std::shared_ptr<Message>(
+                new DoubleMessage(MessageId::TestOutput0, src, MessageClock::now(), 3.0)));
+            bus.waitAll();
+        };
+
+        // The first set of data for each asset initializes it
+        publishSet(src0);
+        publishSet(src1);
+        Assert::AreEqual(0, listener0.getCount(), "obs produced state estimate on init (0)");
+        Assert::AreEqual(0, listener1.getCount(), "obs produced state estimate on init (1)");
+
+        publishSet(src0);
+        Assert::AreEqual(1, listener0.getCount(), "obs didn't step asset 0");
+        Assert::AreEqual(0, listener1.getCount(), "obs stepped asset 1 without data");
+
+        publishSet(src1);
+        publishSet(src0);
+        Assert::AreEqual(2, listener0.getCount(), "obs didn't step asset 0 again");
+        Assert::AreEqual(1, listener1.getCount(), "obs didn't step asset 1");
+
+        auto estimate = std::dynamic_pointer_cast<UDataVecMessage>(listener1.getLastMessage());
+        Assert::IsTrue(estimate != nullptr, "Unexpected state estimate message type");
+        Assert::AreEqual(2, estimate->getValue().size(), "Unexpected state size");
+    }
+
     void registerTests(TestContext& context) {
         context.AddTest("construct", constructor, "AsyncObserver");
         context.AddTest("processMessage", processMessage, "AsyncObserver");
+        context.AddTest("fleet processMessage", fleetProcessMessage, "AsyncObserver");
     }
 }
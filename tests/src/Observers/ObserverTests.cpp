@@ -1,17 +1,26 @@
 // Copyright (c) 2018-2019 United States Government as represented by the
 // Administrator of the National Aeronautics and Space Administration.
 // All Rights Reserved.
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <memory>
 #include <sstream>
 
 #include "Test.h"
 
 #include "Matrix.h"
 #include "Models/BatteryModel.h"
+#include "Observers/BatchUnscentedKalmanFilter.h"
+#include "Observers/ExtendedKalmanFilter.h"
+#include "Observers/FixedExtendedKalmanFilter.h"
+#include "Observers/ObserverFactory.h"
 #include "Observers/ParticleFilter.h"
+#include "Observers/SquareRootUnscentedKalmanFilter.h"
 #include "Observers/UnscentedKalmanFilter.h"
 #include "Tank3.h"
 #include "ThreadSafeLog.h"
+#include "UnscentedTransform.h"
 
 using namespace PCOE;
 using namespace PCOE::Test;
@@ -161,6 +170,102 @@ namespace ObserverTests {
         UKF.step(t, u, z);
     }
 
+    void testUKFTankStepAlphaBeta() {
+        Tank3 TankModel = Tank3();
+        TankModel.parameters.K1 = 1;
+        TankModel.parameters.K2 = 2;
+        TankModel.parameters.K3 = 3;
+        TankModel.parameters.R1 = 1;
+        TankModel.parameters.R2 = 2;
+        TankModel.parameters.R3 = 3;
+        TankModel.parameters.R1c2 = 1;
+        TankModel.parameters.R2c3 = 2;
+
+        auto u = TankModel.getInputVector();
+        u[0] = 1;
+        u[1] = 1;
+        u[2] = 1;
+        auto x = TankModel.getStateVector();
+        x[0] = 1;
+        x[1] = 2;
+        x[2] = 3;
+        auto z = TankModel.getOutputVector();
+        z[0] = 1.1;
+        z[1] = 0.9;
+        z[2] = 1.2;
+
+        const std::size_t n = TankModel.getStateSize();
+        const std::size_t m = TankModel.getOutputSize();
+        Matrix Q(n, n);
+        for (std::size_t i = 0; i < n; i++) {
+            Q[i][i] = 1e-2;
+        }
+        Matrix R(m, m);
+        for (std::size_t i = 0; i < m; i++) {
+            R[i][i] = 1e-2;
+        }
+
+        const double alpha = 0.9;
+        const double beta = 2;
+        UnscentedKalmanFilter UKF(TankModel, Q, R);
+        UKF.setAlpha(alpha);
+        UKF.setBeta(beta);
+        UKF.initialize(0, x, u);
+        UKF.step(0.1, u, z);
+
+        // Reference step with the same weights. The alpha/beta term is added
+        // to the central point of the covariances, and the cross-covariance
+        // uses the mean weights.
+        SigmaPoints sigma;
+        initSigmaPoints(n, sigma);
+        sigma.alpha = alpha;
+        sigma.beta = beta;
+        computeSigmaPoints(x.data(), x.size(), Q, sigma);
+        const std::size_t count = sigma.M.cols();
+        Matrix X(n, count);
+        Matrix Z(m, count);
+        std::vector<double> zeroNoise(n);
+        for (std::size_t k = 0; k < count; k++) {
+            auto xk = TankModel.getStateVector();
+            for (std::size_t i = 0; i < n; i++) {
+                xk[i] = sigma.M[i][k];
+            }
+            xk = TankModel.stateEqn(0.1, xk, u, zeroNoise, 0.1);
+            auto zk = TankModel.outputEqn(0.1, xk, zeroNoise);
+            X.col(k, xk.vec());
+            Z.col(k, zk.vec());
+        }
+        Matrix w(sigma.w);
+        Matrix xMean = X.weightedMean(w);
+        Matrix zMean = Z.weightedMean(w);
+        Matrix Pxx = Q;
+        Matrix Pzz = R;
+        Matrix Pxz(n, m);
+        double alphaTerm = 1 - alpha * alpha + beta;
+        for (std::size_t k = 0; k < count; k++) {
+            Matrix dx = X.col(k) - xMean;
+            Matrix dz = Z.col(k) - zMean;
+            double wc = sigma.w[k] + (k == 0 ? alphaTerm : 0.0);
+            Pxx += dx * dx.transpose() * wc;
+            Pzz += dz * dz.transpose() * wc;
+            Pxz += dx * dz.transpose() * sigma.w[k];
+        }
+        Matrix K = Pxz * Pzz.inverse();
+        Matrix zActual(m, 1);
+        zActual.col(0, z.vec());
+        Matrix xExpected = xMean + K * (zActual - zMean);
+        Matrix PExpected = Pxx - K * Pzz * K.transpose();
+
+        auto estimate = UKF.getStateEstimate();
+        const Matrix& P = UKF.getStateCovariance();
+        for (std::size_t i = 0; i < n; i++) {
+            Assert::AreEqual(xExpected[i][0], estimate[i].get(MEAN), 1e-9, "State mean");
+            for (std::size_t j = 0; j < n; j++) {
+                Assert::AreEqual(PExpected[i][j], P[i][j], 1e-9, "State covariance");
+            }
+        }
+    }
+
     void testUKFTankGetInputs() {
         // Create Tank model
         Tank3 TankModel = Tank3();
@@ -523,11 +628,452 @@ namespace ObserverTests {
         PF.step(t, u, z);
     }
 
+    void testSRUKFBatteryFromConfig() {
+        ConfigMap paramMap;
+        std::vector<std::string> qStrings;
+        for (int i = 0; i < 8; i++) {
+            for (int j = 0; j < 8; j++) {
+                qStrings.push_back(i == j ? "1e-10" : "0");
+            }
+        }
+        paramMap.set("Observer.Q", qStrings);
+        std::vector<std::string> rStrings;
+        for (int i = 0; i < 2; i++) {
+            for (int j = 0; j < 2; j++) {
+                rStrings.push_back(i == j ? "1e-2" : "0");
+            }
+        }
+        paramMap.set("Observer.R", rStrings);
+        paramMap.set("Observer.alpha", "1");
+
+        BatteryModel battery;
+        SquareRootUnscentedKalmanFilter srukf(battery, paramMap);
+
+        // Create an SRUKF with bad R and ensure throws error
+        rStrings.pop_back();
+        paramMap.set("Observer.R", rStrings);
+        try {
+            SquareRootUnscentedKalmanFilter srukf2(battery, paramMap);
+            Assert::Fail();
+        }
+        catch (...) {
+        }
+    }
+
+    void testSRUKFTankStepAlphaBeta() {
+        Tank3 TankModel = Tank3();
+        TankModel.parameters.K1 = 1;
+        TankModel.parameters.K2 = 2;
+        TankModel.parameters.K3 = 3;
+        TankModel.parameters.R1 = 1;
+        TankModel.parameters.R2 = 2;
+        TankModel.parameters.R3 = 3;
+        TankModel.parameters.R1c2 = 1;
+        TankModel.parameters.R2c3 = 2;
+
+        auto u = TankModel.getInputVector();
+        u[0] = 1;
+        u[1] = 1;
+        u[2] = 1;
+        auto x = TankModel.getStateVector();
+        x[0] = 1;
+        x[1] = 2;
+        x[2] = 3;
+        auto z = TankModel.getOutputVector();
+        z[0] = 1.1;
+        z[1] = 0.9;
+        z[2] = 1.2;
+
+        const std::size_t n = TankModel.getStateSize();
+        const std::size_t m = TankModel.getOutputSize();
+        Matrix Q(n, n);
+        for (std::size_t i = 0; i < n; i++) {
+            Q[i][i] = 1e-2;
+        }
+        Matrix R(m, m);
+        for (std::size_t i = 0; i < m; i++) {
+            R[i][i] = 1e-2;
+        }
+
+        // Both filters start from P = Q, so the first step uses the same sigma
+        // points. Both add the alpha/beta term to the central covariance
+        // weight once, so their estimates should agree to round-off.
+        const double alpha = 0.9;
+        const double beta = 2;
+        UnscentedKalmanFilter ukf(TankModel, Q, R);
+        SquareRootUnscentedKalmanFilter srukf(TankModel, Q, R);
+        ukf.setAlpha(alpha);
+        ukf.setBeta(beta);
+        srukf.setAlpha(alpha);
+        srukf.setBeta(beta);
+        ukf.initialize(0, x, u);
+        srukf.initialize(0, x, u);
+        ukf.step(0.1, u, z);
+        srukf.step(0.1, u, z);
+
+        auto expected = ukf.getStateEstimate();
+        auto actual = srukf.getStateEstimate();
+        const Matrix& PExpected = ukf.getStateCovariance();
+        Matrix P = srukf.getStateCovariance();
+        for (std::size_t i = 0; i < n; i++) {
+            Assert::AreEqual(expected[i].get(MEAN), actual[i].get(MEAN), 1e-9, "State mean");
+            for (std::size_t j = 0; j < n; j++) {
+                Assert::AreEqual(PExpected[i][j], P[i][j], 1e-9, "State covariance");
+            }
+        }
+    }
+
+    void testSRUKFBatteryStep() {
+        BatteryModel battery = BatteryModel();
+        auto u0 = BatteryModel::input_type({0});
+        auto z0 = BatteryModel::output_type({20, 4.2});
+        auto x = battery.initialize(u0, z0);
+        auto u = battery.getInputVector();
+
+        Matrix Q(battery.getStateSize(), battery.getStateSize());
+        for (unsigned int i = 0; i < battery.getStateSize(); i++) {
+            Q[i][i] = 1e-10;
+        }
+        Matrix R(battery.getOutputSize(), battery.getOutputSize());
+        for (unsigned int i = 0; i < battery.getOutputSize(); i++) {
+            R[i][i] = 1e-2;
+        }
+
+        // The square-root filter should track the standard UKF
+        UnscentedKalmanFilter ukf(battery, Q, R);
+        SquareRootUnscentedKalmanFilter srukf(battery, Q, R);
+
+        std::vector<double> zNoise(battery.getOutputSize(), 0.01);
+        std::vector<double> xNoise(battery.getStateSize());
+
+        double dt = 1;
+        double t = 0;
+        ukf.initialize(t, x, u);
+        srukf.initialize(t, x, u);
+
+        u[0] = 1;
+        for (int step = 0; step < 10; step++) {
+            t += dt;
+            x = battery.stateEqn(t, x, u, xNoise, dt);
+            auto z = battery.outputEqn(t, x, zNoise);
+            ukf.step(t, u, z);
+            srukf.step(t, u, z);
+        }
+
+        auto expected = ukf.getStateEstimate();
+        auto actual = srukf.getStateEstimate();
+        Assert::AreEqual(expected.size(), actual.size(), "State size");
+        for (std::size_t i = 0; i < expected.size(); i++) {
+            double mean = expected[i].get(MEAN);
+            Assert::AreEqual(mean,
+                             actual[i].get(MEAN),
+                             1e-6 * std::max(1.0, std::abs(mean)),
+                             "State mean");
+        }
+
+        // P = S * S' must be symmetric with a positive diagonal
+        Matrix P = srukf.getStateCovariance();
+        const Matrix& S = srukf.getStateCovarianceRoot();
+        for (std::size_t i = 0; i < P.rows(); i++) {
+            Assert::IsTrue(P.at(i, i) > 0, "Covariance diagonal");
+            for (std::size_t j = i + 1; j < P.cols(); j++) {
+                Assert::AreEqual(0.0, S.at(i, j), 1e-15, "Root is lower triangular");
+                Assert::AreEqual(P.at(i, j), P.at(j, i), 1e-15, "Covariance symmetry");
+            }
+        }
+    }
+
+    void testBatchUKFBatteryStep() {
+        BatteryModel battery = BatteryModel();
+        auto u0 = BatteryModel::input_type({0});
+        auto z0 = BatteryModel::output_type({20, 4.2});
+        auto x0 = battery.initialize(u0, z0);
+
+        Matrix Q(battery.getStateSize(), battery.getStateSize());
+        for (unsigned int i = 0; i < battery.getStateSize(); i++) {
+            Q[i][i] = 1e-10;
+        }
+        Matrix R(battery.getOutputSize(), battery.getOutputSize());
+        for (unsigned int i = 0; i < battery.getOutputSize(); i++) {
+            R[i][i] = 1e-2;
+        }
+
+        // Each asset of the batch should track a separate filter
+        const std::size_t assetCount = 3;
+        BatchUnscentedKalmanFilter batch(battery, assetCount, Q, R);
+        std::vector<UnscentedKalmanFilter> filters;
+        std::vector<BatteryModel::state_type> x(assetCount, x0);
+        std::vector<double> t(assetCount, 0);
+        for (std::size_t a = 0; a < assetCount; a++) {
+            filters.emplace_back(battery, Q, R);
+            filters[a].initialize(0, x0, u0);
+            batch.initialize(a, 0, x0, u0);
+        }
+
+        std::vector<double> zNoise(battery.getOutputSize(), 0.01);
+        std::vector<double> xNoise(battery.getStateSize());
+        for (int step = 0; step < 10; step++) {
+            // Step all assets on even steps, and only the first two on odd
+            std::vector<BatchUnscentedKalmanFilter::Update> updates;
+            for (std::size_t a = 0; a < (step % 2 == 0 ? assetCount : 2); a++) {
+                auto u = BatteryModel::input_type({1.0 + a});
+                t[a] += 1;
+                x[a] = battery.stateEqn(t[a], x[a], u, xNoise, 1);
+                auto z = battery.outputEqn(t[a], x[a], zNoise);
+                filters[a].step(t[a], u, z);
+                updates.push_back({a, t[a], u, z});
+            }
+            Assert::IsTrue(batch.step(updates).empty(), "Failed assets");
+        }
+
+        for (std::size_t a = 0; a < assetCount; a++) {
+            auto expected = filters[a].getStateEstimate();
+            auto actual = batch.getStateEstimate(a);
+            Assert::AreEqual(expected.size(), actual.size(), "State size");
+            for (std::size_t i = 0; i < expected.size(); i++) {
+                double mean = expected[i].get(MEAN);
+                Assert::AreEqual(mean,
+                                 actual[i].get(MEAN),
+                                 1e-6 * std::max(1.0, std::abs(mean)),
+                                 "State mean");
+            }
+        }
+
+        // An asset whose output covariance can not be factored fails on its
+        // own, and the rest of the batch is stepped
+        auto u = BatteryModel::input_type({1});
+        auto z = BatteryModel::output_type({20, 4.2});
+        BatchUnscentedKalmanFilter pair(battery, 2, Q, R);
+        auto xBad = x0;
+        xBad[0] = NAN;
+        pair.initialize(0, 0, x0, u0);
+        pair.initialize(1, 0, xBad, u0);
+        std::vector<BatchUnscentedKalmanFilter::Update> pairUpdates = {{0, 1, u, z},
+                                                                       {1, 1, u, z}};
+        auto failed = pair.step(pairUpdates);
+        Assert::AreEqual(1, failed.size(), "Failed asset count");
+        Assert::AreEqual(1, failed[0], "Failed asset");
+        for (const auto& value : pair.getStateEstimate(0)) {
+            Assert::IsTrue(std::isfinite(value.get(MEAN)), "Good asset estimate is finite");
+        }
+
+        // An asset may only appear once in a batch
+        std::vector<BatchUnscentedKalmanFilter::Update> duplicate = {{0, 100, u, z},
+                                                                     {0, 101, u, z}};
+        try {
+            batch.step(duplicate);
+            Assert::Fail("Stepped duplicate asset");
+        }
+        catch (const std::exception&) {
+        }
+    }
+
+    void testEKFTankStep() {
+        // Create Tank model
+        Tank3 TankModel = Tank3();
+        TankModel.parameters.K1 = 1;
+        TankModel.parameters.K2 = 2;
+        TankModel.parameters.K3 = 3;
+        TankModel.parameters.R1 = 1;
+        TankModel.parameters.R2 = 2;
+        TankModel.parameters.R3 = 3;
+        TankModel.parameters.R1c2 = 1;
+        TankModel.parameters.R2c3 = 2;
+
+        auto u = TankModel.getInputVector();
+        u[0] = 1;
+        u[1] = 1;
+        u[2] = 1;
+        auto x = TankModel.getStateVector();
+
+        Matrix Q(3, 3);
+        Matrix R(3, 3);
+        for (unsigned int i = 0; i < 3; i++) {
+            Q[i][i] = 1e-5;
+            R[i][i] = 1e-2;
+        }
+
+        // The tank model is linear and has no analytic Jacobians, so the EKF
+        // with finite difference Jacobians should match a linear Kalman filter
+        double dt = 0.1;
+        Matrix F = Matrix(3, 3, {1, 0, 0, 0, 1, 0, 0, 0, 1}) +
+                   dt * Matrix(3, 3, {-2, 0.5, 0, 1, -1, 1.0 / 6, 0, 0.25, -5.0 / 18});
+        Matrix H(3, 3, {1, 0, 0, 0, 0.5, 0, 0, 0, 1.0 / 3});
+        Matrix xKF(3, 1);
+        Matrix PKF = Q;
+
+        ExtendedKalmanFilter ekf(TankModel, Q, R);
+        double t = 0;
+        ekf.initialize(t, x, u);
+
+        // Make sure can't step without incrementing time
+        auto z = TankModel.getOutputVector();
+        try {
+            ekf.step(t, u, z);
+            Assert::Fail("Step without incrementing time");
+        }
+        catch (...) {
+        }
+
+        std::vector<double> ns(3, 0.001);
+        std::vector<double> no(3, 0.01);
+        std::vector<double> zeroNoise(3);
+        for (int step = 0; step < 10; step++) {
+            t += dt;
+            x = TankModel.stateEqn(t, x, u, ns, dt);
+            z = TankModel.outputEqn(t, x, no);
+            ekf.step(t, u, z);
+
+            // Reference Kalman filter
+            auto xPrev = TankModel.getStateVector();
+            for (std::size_t i = 0; i < 3; i++) {
+                xPrev[i] = xKF[i][0];
+            }
+            auto xkk1 = TankModel.stateEqn(t, xPrev, u, zeroNoise, dt);
+            Matrix xPred(3, 1);
+            Matrix zMeas(3, 1);
+            for (std::size_t i = 0; i < 3; i++) {
+                xPred[i][0] = xkk1[i];
+                zMeas[i][0] = z[i];
+            }
+            Matrix Pkk1 = F * PKF * F.transpose() + Q;
+            Matrix K = Pkk1 * H.transpose() * (H * Pkk1 * H.transpose() + R).inverse();
+            xKF = xPred + K * (zMeas - H * xPred);
+            PKF = Pkk1 - K * H * Pkk1;
+        }
+
+        auto actual = ekf.getStateEstimate();
+        for (std::size_t i = 0; i < 3; i++) {
+            Assert::AreEqual(xKF[i][0], actual[i].get(MEAN), 1e-8, "State mean");
+            for (std::size_t j = 0; j < 3; j++) {
+                Assert::AreEqual(PKF[i][j], ekf.getStateCovariance()[i][j], 1e-12, "Covariance");
+            }
+        }
+    }
+
+    void testEKFBatteryStep() {
+        BatteryModel battery = BatteryModel();
+        auto u0 = BatteryModel::input_type({0});
+        auto z0 = BatteryModel::output_type({20, 4.2});
+        auto x = battery.initialize(u0, z0);
+        auto u = battery.getInputVector();
+
+        // Create an EKF from the factory
+        ConfigMap config;
+        std::vector<std::string> qStrings;
+        for (int i = 0; i < 8; i++) {
+            for (int j = 0; j < 8; j++) {
+                qStrings.push_back(i == j ? "1e-10" : "0");
+            }
+        }
+        config.set("Observer.Q", qStrings);
+        config.set("Observer.R", {"1e-2", "0", "0", "1e-2"});
+        std::unique_ptr<Observer> ekf(ObserverFactory::instance().Create("EKF", battery, config));
+
+        // For this mildly non-linear model, the EKF should track the UKF
+        Matrix Q(battery.getStateSize(), battery.getStateSize());
+        for (unsigned int i = 0; i < battery.getStateSize(); i++) {
+            Q[i][i] = 1e-10;
+        }
+        Matrix R(battery.getOutputSize(), battery.getOutputSize());
+        for (unsigned int i = 0; i < battery.getOutputSize(); i++) {
+            R[i][i] = 1e-2;
+        }
+        SquareRootUnscentedKalmanFilter srukf(battery, Q, R);
+
+        double t = 0;
+        ekf->initialize(t, x, u);
+        srukf.initialize(t, x, u);
+
+        std::vector<double> zNoise(battery.getOutputSize(), 0.01);
+        std::vector<double> xNoise(battery.getStateSize());
+        u[0] = 1;
+        for (int step = 0; step < 10; step++) {
+            t += 1;
+            x = battery.stateEqn(t, x, u, xNoise, 1);
+            auto z = battery.outputEqn(t, x, zNoise);
+            ekf->step(t, u, z);
+            srukf.step(t, u, z);
+        }
+
+        auto expected = srukf.getStateEstimate();
+        auto actual = ekf->getStateEstimate();
+        for (std::size_t i = 0; i < expected.size(); i++) {
+            double mean = expected[i].get(MEAN);
+            Assert::AreEqual(mean,
+                             actual[i].get(MEAN),
+                             1e-4 * std::max(1.0, std::abs(mean)),
+                             "State mean");
+        }
+    }
+
+    void testFixedEKFBatteryStep() {
+        BatteryModel battery = BatteryModel();
+        auto u0 = BatteryModel::input_type({0});
+        auto z0 = BatteryModel::output_type({20, 4.2});
+        auto x = battery.initialize(u0, z0);
+        auto u = battery.getInputVector();
+
+        Matrix Q(battery.getStateSize(), battery.getStateSize());
+        for (unsigned int i = 0; i < battery.getStateSize(); i++) {
+            Q[i][i] = 1e-10;
+        }
+        Matrix R(battery.getOutputSize(), battery.getOutputSize());
+        for (unsigned int i = 0; i < battery.getOutputSize(); i++) {
+            R[i][i] = 1e-2;
+        }
+        ExtendedKalmanFilter ekf(battery, Q, R);
+        FixedExtendedKalmanFilter<BatteryModel> fixedEkf(battery, Q, R);
+
+        double t = 0;
+        ekf.initialize(t, x, u);
+        fixedEkf.initialize(t, x, u);
+
+        std::vector<double> zNoise(battery.getOutputSize(), 0.01);
+        std::vector<double> xNoise(battery.getStateSize());
+        u[0] = 1;
+        for (int step = 0; step < 10; step++) {
+            t += 1;
+            x = battery.stateEqn(t, x, u, xNoise, 1);
+            auto z = battery.outputEqn(t, x, zNoise);
+            ekf.step(t, u, z);
+            fixedEkf.step(t, u, z);
+        }
+
+        // Both filters run the same algorithm, so they should agree to
+        // round-off
+        auto expected = ekf.getStateEstimate();
+        auto actual = fixedEkf.getStateEstimate();
+        const Matrix& expectedP = ekf.getStateCovariance();
+        auto actualP = static_cast<Matrix>(fixedEkf.getStateCovariance());
+        for (std::size_t i = 0; i < expected.size(); i++) {
+            double mean = expected[i].get(MEAN);
+            Assert::AreEqual(mean,
+                             actual[i].get(MEAN),
+                             1e-9 * std::max(1.0, std::abs(mean)),
+                             "State mean");
+            for (std::size_t j = 0; j < expected.size(); j++) {
+                Assert::AreEqual(expectedP[i][j],
+                                 actualP[i][j],
+                                 1e-9 * std::max(1e-10, std::abs(expectedP[i][j])),
+                                 "State covariance");
+            }
+        }
+
+        try {
+            FixedExtendedKalmanFilter<BatteryModel> bad(battery, R, R);
+            Assert::Fail("Failed to throw on wrong size Q");
+        }
+        catch (const std::domain_error&) {
+        }
+    }
+
     void registerTests(TestContext& context) {
         context.AddCategoryInitializer("Observer", observerTestsInit);
         // UKF Tank tests
         context.AddTest("UKF Initialize for Tank", testUKFTankInitialize, "Observer");
         context.AddTest("UKF Step for Tank", testUKFTankStep, "Observer");
+        context.AddTest("UKF Step with Alpha and Beta", testUKFTankStepAlphaBeta, "Observer");
         context.AddTest("UKF Tank Get Inputs", testUKFTankGetInputs, "Observer");
         
         // UKF Battery tests
@@ -536,5 +1082,20 @@ namespace ObserverTests {
                         "Observer");
         context.AddTest("UKF Initialization for Battery", testUKFBatteryInitialize, "Observer");
         context.AddTest("UKF Step for Battery", testUKFBatteryStep, "Observer");
+
+        // SRUKF Battery tests
+        context.AddTest("SRUKF Battery Construction from ConfigMap",
+                        testSRUKFBatteryFromConfig,
+                        "Observer");
+        context.AddTest("SRUKF Step for Battery", testSRUKFBatteryStep, "Observer");
+        context.AddTest("SRUKF Step with Alpha and Beta", testSRUKFTankStepAlphaBeta, "Observer");
+
+        // EKF tests
+        context.AddTest("EKF Step for Tank", testEKFTankStep, "Observer");
+        context.AddTest("EKF Step for Battery", testEKFBatteryStep, "Observer");
+        context.AddTest("Fixed EKF Step for Battery", testFixedEKFBatteryStep, "Observer");
+
+        // Batch UKF tests
+        context.AddTest("Batch UKF Step for Battery", testBatchUKFBatteryStep, "Observer");
     }
 }
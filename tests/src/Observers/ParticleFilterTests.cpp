@@ -1,6 +1,12 @@
 // Copyright (c) 2017-2019 United States Government as represented by the
 // Administrator of the National Aeronautics and Space Administration.
 // All Rights Reserved.
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
 #include "ConfigMap.h"
 #include "Exceptions.h"
 #include "Models/BatteryModel.h"
@@ -13,6 +19,22 @@ using namespace PCOE;
 using namespace PCOE::Test;
 
 namespace ParticleFilterTests {
+    /**
+     * Creates a Tank3 model with the parameters used by the step tests.
+     **/
+    static Tank3 createTank3() {
+        Tank3 test;
+        test.parameters.K1 = 1;
+        test.parameters.K2 = 2;
+        test.parameters.K3 = 3;
+        test.parameters.R1 = 1;
+        test.parameters.R2 = 2;
+        test.parameters.R3 = 3;
+        test.parameters.R1c2 = 1;
+        test.parameters.R2c3 = 2;
+        return test;
+    }
+
     void ctor() {
         // Create Tank3 model
         Tank3 test = Tank3();
@@ -75,10 +97,12 @@ namespace ParticleFilterTests {
         theMap.set("Observer.ProcessNoise", {"1", "1", "1", "1", "1", "1", "1", "1"});
         theMap.set("Observer.SensorNoise", {"1", "1"});
         theMap.set("Observer.MinEffective", "100");
+        theMap.set("Observer.ThreadCount", "2");
 
         BatteryModel battery;
 
         ParticleFilter pf = ParticleFilter(battery, theMap);
+        Assert::AreEqual(2, pf.getThreadCount(), "Thread count");
     }
 
     void PFinitialize() {
@@ -111,17 +135,7 @@ namespace ParticleFilterTests {
 
     void step() {
         // Create Tank3 model
-        Tank3 test = Tank3();
-
-        // Set parameter values
-        test.parameters.K1 = 1;
-        test.parameters.K2 = 2;
-        test.parameters.K3 = 3;
-        test.parameters.R1 = 1;
-        test.parameters.R2 = 2;
-        test.parameters.R3 = 3;
-        test.parameters.R1c2 = 1;
-        test.parameters.R2c3 = 2;
+        Tank3 test = createTank3();
 
         // Initialize its
         auto u = test.getInputVector();
@@ -166,6 +180,247 @@ namespace ParticleFilterTests {
         pf.step(t1, u, z);
     }
 
+    void stepSingularSensorCovariance() {
+        Tank3 test = Tank3();
+        auto u = test.getInputVector();
+        auto z = test.getOutputVector();
+        auto x = test.initialize(u, z);
+
+        std::vector<double> processNoise = {1.0, 1.0, 2.0};
+        std::vector<double> sensorNoise = {0.0, 1.0, 2.0};
+
+        ParticleFilter pf = ParticleFilter(test, 20, processNoise, sensorNoise);
+        pf.initialize(0, x, u);
+        try {
+            pf.step(1, u, z);
+            Assert::Fail("step() did not catch singular sensor covariance.");
+        }
+        catch (AssertException&) {
+        }
+    }
+
+    void stepSmallSensorNoise() {
+        Tank3 test = createTank3();
+        auto u = test.getInputVector();
+        auto z = test.getOutputVector();
+        auto x = test.initialize(u, z);
+
+        // The linear likelihood of every particle underflows to zero with
+        // this little sensor noise, so the weights must be handled in the log
+        // domain.
+        std::vector<double> processNoise = {1.0, 1.0, 1.0};
+        std::vector<double> sensorNoise = {1e-12, 1e-12, 1e-12};
+
+        std::size_t N = 100;
+        ParticleFilter pf = ParticleFilter(test, N, processNoise, sensorNoise);
+        pf.setMinEffective(0);
+        pf.initialize(0, x, u);
+        pf.step(1, u, z);
+
+        std::vector<UData> stateEstimate = pf.getStateEstimate();
+        double sum = 0;
+        for (std::size_t p = 0; p < N; p++) {
+            double w = stateEstimate[0][WEIGHT(p)];
+            Assert::IsTrue(std::isfinite(w), "Weight is not finite");
+            sum += w;
+        }
+        Assert::AreEqual(1.0, sum, 1e-9, "Weights are not normalized");
+    }
+
+    void stepWeights() {
+        Tank3 test = createTank3();
+        auto u = test.getInputVector();
+        auto x = test.getStateVector();
+        x[0] = 1.0;
+        x[1] = 2.0;
+        x[2] = 3.0;
+        auto zeroNoise = std::vector<double>(test.getOutputSize());
+        auto z = test.outputEqn(0, x, zeroNoise);
+
+        std::vector<double> processNoise = {0.5, 0.5, 0.5};
+        std::vector<double> sensorNoise = {1.0, 2.0, 4.0};
+
+        std::size_t N = 50;
+        ParticleFilter pf = ParticleFilter(test, N, processNoise, sensorNoise);
+        pf.setMinEffective(0);
+        pf.initialize(0, x, u);
+        const double t1 = 1;
+        pf.step(t1, u, z);
+
+        // Without resampling, the weight of each particle is proportional to
+        // the Gaussian density of the actual output given the output of the
+        // particle, evaluated here directly from the diagonal of R. The
+        // normalizing constant is the same for every particle and cancels.
+        std::vector<UData> stateEstimate = pf.getStateEstimate();
+        std::vector<double> logW(N);
+        double maxLogW = -INFINITY;
+        for (std::size_t p = 0; p < N; p++) {
+            auto xp = test.getStateVector();
+            for (std::size_t i = 0; i < xp.size(); i++) {
+                xp[i] = stateEstimate[i][SAMPLE(p)];
+            }
+            auto zp = test.outputEqn(t1, xp, zeroNoise);
+            for (std::size_t j = 0; j < zp.size(); j++) {
+                double e = z[j] - zp[j];
+                logW[p] -= 0.5 * e * e / sensorNoise[j];
+            }
+            maxLogW = std::max(maxLogW, logW[p]);
+        }
+        double sum = 0;
+        for (std::size_t p = 0; p < N; p++) {
+            sum += std::exp(logW[p] - maxLogW);
+        }
+        for (std::size_t p = 0; p < N; p++) {
+            double expected = std::exp(logW[p] - maxLogW) / sum;
+            Assert::AreEqual(expected, stateEstimate[0][WEIGHT(p)], 1e-9, "Particle weight");
+        }
+    }
+
+    void parallelStep() {
+        Tank3 test = createTank3();
+        auto u = test.getInputVector();
+        auto z = test.getOutputVector();
+        auto x = test.initialize(u, z);
+
+        std::vector<double> processNoise = {1e-2, 1e-2, 1e-2};
+        std::vector<double> sensorNoise = {1.0, 1.0, 1.0};
+
+        // Enough particles that every thread gets a block, with a minimum
+        // effective count that forces a resample on every step.
+        std::size_t N = 1000;
+        ParticleFilter pf = ParticleFilter(test, N, processNoise, sensorNoise);
+        pf.setThreadCount(4);
+        pf.setMinEffective(N + 1);
+        pf.initialize(0, x, u);
+        for (int t = 1; t <= 5; t++) {
+            pf.step(t, u, z);
+        }
+
+        // With small process noise and no input, the particles stay near the
+        // initial state.
+        std::vector<UData> stateEstimate = pf.getStateEstimate();
+        for (std::size_t i = 0; i < stateEstimate.size(); i++) {
+            double mean = 0;
+            for (std::size_t p = 0; p < N; p++) {
+                double sample = stateEstimate[i][SAMPLE(p)];
+                Assert::IsTrue(std::isfinite(sample), "Sample is not finite");
+                mean += sample * stateEstimate[i][WEIGHT(p)];
+            }
+            Assert::AreEqual(x[i], mean, 1.0, "State estimate mean");
+        }
+    }
+
+    void resamplingSchemes() {
+        Tank3 test = createTank3();
+        auto u = test.getInputVector();
+        auto z = test.getOutputVector();
+        auto x = test.initialize(u, z);
+
+        std::vector<std::string> schemes = {"Systematic", "stratified", "residual", "multinomial"};
+        std::vector<ResamplingScheme> expected = {ResamplingScheme::Systematic,
+                                                  ResamplingScheme::Stratified,
+                                                  ResamplingScheme::Residual,
+                                                  ResamplingScheme::Multinomial};
+        for (std::size_t s = 0; s < schemes.size(); s++) {
+            ConfigMap config;
+            config.set("Observer.ParticleCount", "300");
+            config.set("Observer.ProcessNoise", {"1e-2", "1e-2", "1e-2"});
+            config.set("Observer.SensorNoise", {"1", "1", "1"});
+            config.set("Observer.MinEffective", "301");
+            config.set("Observer.Resampling", schemes[s]);
+
+            ParticleFilter pf = ParticleFilter(test, config);
+            Assert::IsTrue(expected[s] == pf.getResamplingScheme(), "Resampling scheme");
+            pf.initialize(0, x, u);
+            for (int t = 1; t <= 3; t++) {
+                pf.step(t, u, z);
+            }
+
+            // Resampling keeps the particle count and leaves equal weights
+            Assert::AreEqual(300, pf.getParticleCount(), "Particle count");
+            std::vector<UData> stateEstimate = pf.getStateEstimate();
+            for (std::size_t p = 0; p < 300; p++) {
+                Assert::AreEqual(1.0 / 300, stateEstimate[0][WEIGHT(p)], 1e-12, "Weight");
+            }
+        }
+
+        ConfigMap badConfig;
+        badConfig.set("Observer.ParticleCount", "300");
+        badConfig.set("Observer.ProcessNoise", {"1", "1", "1"});
+        badConfig.set("Observer.SensorNoise", {"1", "1", "1"});
+        badConfig.set("Observer.Resampling", "bogus");
+        try {
+            ParticleFilter pf = ParticleFilter(test, badConfig);
+            Assert::Fail("Constructor did not catch unknown resampling scheme");
+        }
+        catch (std::domain_error&) {
+        }
+    }
+
+    void selectionDistribution() {
+        // One dominant particle and three equally weighted others
+        std::vector<double> w = {0.7, 0.1, 0.1, 0.1};
+        const std::size_t count = 10000;
+        std::vector<ResamplingScheme> schemes = {ResamplingScheme::Systematic,
+                                                 ResamplingScheme::Stratified,
+                                                 ResamplingScheme::Residual,
+                                                 ResamplingScheme::Multinomial};
+        std::mt19937 rng(42);
+        std::vector<std::size_t> indices;
+        std::vector<double> buffer;
+        for (ResamplingScheme scheme : schemes) {
+            ParticleFilter::selectParticles(scheme, w, count, rng, indices, buffer);
+            Assert::AreEqual(count, indices.size(), "Selected particle count");
+
+            std::vector<double> frequency(w.size(), 0.0);
+            for (std::size_t i : indices) {
+                Assert::IsTrue(i < w.size(), "Selected index out of range");
+                frequency[i] += 1.0 / count;
+            }
+
+            // Each particle is selected in proportion to its weight
+            for (std::size_t i = 0; i < w.size(); i++) {
+                Assert::AreEqual(w[i], frequency[i], 0.02, "Selection frequency");
+            }
+        }
+    }
+
+    void kldSampling() {
+        Tank3 test = createTank3();
+        auto u = test.getInputVector();
+        auto z = test.getOutputVector();
+        auto x = test.initialize(u, z);
+
+        ConfigMap config;
+        config.set("Observer.ParticleCount", "2000");
+        config.set("Observer.ProcessNoise", {"1e-6", "1e-6", "1e-6"});
+        config.set("Observer.SensorNoise", {"1", "1", "1"});
+        config.set("Observer.KLD.BinSize", {"0.1", "0.1", "0.1"});
+        config.set("Observer.KLD.MinParticleCount", "200");
+        config.set("Observer.KLD.MaxParticleCount", "5000");
+
+        ParticleFilter pf = ParticleFilter(test, config);
+        Assert::IsTrue(pf.isAdaptive(), "KLD-sampling not enabled");
+        pf.initialize(0, x, u);
+
+        // With almost no process noise the particles occupy at most a few
+        // neighboring bins, so the particle count shrinks to the minimum.
+        pf.step(1, u, z);
+        Assert::AreEqual(200, pf.getParticleCount(), "Particle count with narrow posterior");
+        Assert::AreEqual(200, pf.getStateEstimate()[0].npoints(), "Estimate sample count");
+
+        // A wide posterior grows the particle count up to the maximum
+        ConfigMap wideConfig = config;
+        wideConfig.set("Observer.ProcessNoise", {"1", "1", "1"});
+        wideConfig.set("Observer.KLD.BinSize", {"0.01", "0.01", "0.01"});
+        ParticleFilter widePf = ParticleFilter(test, wideConfig);
+        widePf.initialize(0, x, u);
+        widePf.step(1, u, z);
+        widePf.step(2, u, z);
+        Assert::IsTrue(widePf.getParticleCount() > 2000, "Particle count did not grow");
+        Assert::IsTrue(widePf.getParticleCount() <= 5000, "Particle count exceeds maximum");
+    }
+
     void getStateEstimate() {
         // Create Tank3 model
         Tank3 test = Tank3();
@@ -199,6 +454,15 @@ namespace ParticleFilterTests {
         context.AddTest("ConfigMap Constructor", ConfigMapCtor, "Particle Filter");
         context.AddTest("Initialize", PFinitialize, "Particle Filter");
         context.AddTest("Step", step, "Particle Filter");
+        context.AddTest("Step with Singular Sensor Covariance",
+                        stepSingularSensorCovariance,
+                        "Particle Filter");
+        context.AddTest("Step with Small Sensor Noise", stepSmallSensorNoise, "Particle Filter");
+        context.AddTest("Step Weights", stepWeights, "Particle Filter");
+        context.AddTest("Parallel Step", parallelStep, "Particle Filter");
+        context.AddTest("Resampling Schemes", resamplingSchemes, "Particle Filter");
+        context.AddTest("Selection Distribution", selectionDistribution, "Particle Filter");
+        context.AddTest("KLD-Sampling", kldSampling, "Particle Filter");
         context.AddTest("Get State Estimate", getStateEstimate, "Particle Filter");
     }
 }
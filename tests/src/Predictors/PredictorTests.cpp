@@ -1,6 +1,7 @@
 // Copyright (c) 2018-2019 United States Government as represented by the
 // Administrator of the National Aeronautics and Space Administration.
 // All Rights Reserved.
+#include <cmath>
 #include <iostream>
 #include <memory>
 #include <vector>
@@ -12,6 +13,7 @@
 #include "Models/BatteryModel.h"
 #include "Models/PrognosticsModelFactory.h"
 #include "Predictors/MonteCarloPredictor.h"
+#include "Predictors/UnscentedPredictor.h"
 #include "Test.h"
 #include "UData.h"
 
@@ -83,6 +85,65 @@ namespace PredictorTests {
         for (unsigned int i = 0; i < toe.npoints(); i++) {
             meanEOD += toe[i] / toe.npoints();
         }
+
+        // All of the samples share one arena, sized so that it needs only a
+        // single block
+        auto arena = toe.allocator().getArena();
+        Assert::IsNotNull(arena.get(), "Samples not allocated in arena");
+        Assert::AreEqual(1, arena->blockCount(), "Arena block count");
+        for (const UData& eventState : eod.getState()) {
+            Assert::IsTrue(eventState.allocator().getArena() == arena, "Event state arena");
+        }
+        for (const DataPoint& observable : prediction.getObservables()) {
+            Assert::IsTrue(observable[0].allocator().getArena() == arena, "Observable arena");
+        }
+    }
+
+    void testMonteCarloWeightedSamples() {
+        ConfigMap configMap;
+        configMap.set("Predictor.SampleCount", "20");
+        configMap.set("Predictor.Horizon", "5000");
+        configMap.set("Model.ProcessNoise", std::vector<std::string>(8, "0"));
+        configMap.set("Predictor.LoadEstimator", std::vector<std::string>({"const"}));
+        configMap.set("LoadEstimator.Loading", std::vector<std::string>({"8"}));
+
+        BatteryModel battery;
+        auto u0 = BatteryModel::input_type({0});
+        auto xFull = battery.initialize(u0, BatteryModel::output_type({20, 4.2}));
+        auto xLow = battery.initialize(u0, BatteryModel::output_type({20, 3.9}));
+
+        TestLoadEstimator le(configMap);
+        TrajectoryService ts;
+        MonteCarloPredictor MCP(battery, le, ts, configMap);
+
+        // Only the fully charged particle has weight. Without process
+        // noise, every sample should reach EOD at the same time.
+        std::vector<UData> state(battery.getStateSize());
+        for (unsigned int i = 0; i < battery.getStateSize(); i++) {
+            state[i].uncertainty(UType::WSamples);
+            state[i].layout(SampleLayout::Columnar);
+            state[i].npoints(3);
+            for (std::size_t p = 0; p < 3; p++) {
+                state[i][SAMPLE(p)] = p == 1 ? xFull[i] : xLow[i];
+                state[i][WEIGHT(p)] = p == 1 ? 1.0 : 0.0;
+            }
+        }
+
+        Prediction prediction = MCP.predict(0, state);
+        auto& toe = prediction.getEvents()[0].getTOE();
+        Assert::AreEqual(20, toe.npoints(), "Unexpected sample count");
+        for (unsigned int i = 1; i < toe.npoints(); i++) {
+            Assert::AreEqual(toe[0], toe[i], 1e-9, "Drew a sample with zero weight");
+        }
+
+        // Moving the weight to a partially charged particle moves EOD earlier
+        for (unsigned int i = 0; i < battery.getStateSize(); i++) {
+            state[i][WEIGHT(0)] = 1.0;
+            state[i][WEIGHT(1)] = 0.0;
+        }
+        Prediction lowPrediction = MCP.predict(0, state);
+        auto& lowToe = lowPrediction.getEvents()[0].getTOE();
+        Assert::IsTrue(lowToe[0] < toe[0], "EOD of partially charged particle is not earlier");
     }
 
     // Test error cases with config parameters
@@ -108,7 +169,88 @@ namespace PredictorTests {
         // Create MonteCarloPredictor for battery
         MonteCarloPredictor MCP(battery, le, ts, configMap);
     }
-    
+
+    void testUnscentedBatteryPredict() {
+        // Set up configMap
+        ConfigMap configMap;
+        configMap.set("Predictor.Horizon", "5000");
+        configMap.set("Predictor.LoadEstimator", std::vector<std::string>({"const"}));
+        configMap.set("LoadEstimator.Loading", std::vector<std::string>({"8"}));
+
+        BatteryModel battery;
+        auto u0 = BatteryModel::input_type({0});
+        auto z0 = BatteryModel::output_type({20, 4.2});
+        auto x = battery.initialize(u0, z0);
+
+        TestLoadEstimator le(configMap);
+        TrajectoryService ts;
+
+        // Create UnscentedPredictor for battery
+        UnscentedPredictor UTP(battery, le, ts, configMap);
+
+        // Set up inputs for predict function
+        std::vector<UData> state(battery.getStateSize());
+        for (unsigned int i = 0; i < battery.getStateSize(); i++) {
+            state[i].uncertainty(UType::MeanCovar);
+            state[i].npoints(battery.getStateSize());
+            state[i][MEAN] = x[i];
+            std::vector<double> covariance(battery.getStateSize(), 1e-10);
+            covariance[i] = 1e-5;
+            state[i].setVec(COVAR(0), covariance);
+        }
+
+        Prediction prediction = UTP.predict(0, state);
+
+        Assert::AreEqual(1, prediction.getEvents().size(), "Event count");
+        auto& toe = prediction.getEvents()[0].getTOE();
+        Assert::AreEqual(UType::MeanSD, toe.uncertainty(), "TOE uncertainty type");
+        Assert::IsTrue(std::isfinite(toe[MEAN]), "TOE mean not finite");
+        Assert::IsTrue(toe[MEAN] > 0 && toe[MEAN] < 5000, "TOE mean out of range");
+        Assert::IsTrue(toe[SD] >= 0, "TOE standard deviation negative");
+
+        // Uncorrelated state uncertainty is also accepted
+        for (unsigned int i = 0; i < battery.getStateSize(); i++) {
+            state[i] = UData(UType::MeanSD);
+            state[i][MEAN] = x[i];
+            state[i][SD] = std::sqrt(1e-5);
+        }
+        Prediction sdPrediction = UTP.predict(0, state);
+        auto& sdToe = sdPrediction.getEvents()[0].getTOE();
+        Assert::AreEqual(toe[MEAN], sdToe[MEAN], 10.0, "TOE mean with uncorrelated state");
+
+        // A point state has no spread, so every sigma point is the same
+        for (unsigned int i = 0; i < battery.getStateSize(); i++) {
+            state[i] = UData(x[i]);
+        }
+        Prediction pointPrediction = UTP.predict(0, state);
+        auto& pointToe = pointPrediction.getEvents()[0].getTOE();
+        Assert::AreEqual(toe[MEAN], pointToe[MEAN], 10.0, "TOE mean with point state");
+        Assert::AreEqual(0.0, pointToe[SD], 1e-9, "TOE standard deviation with point state");
+    }
+
+    // Test error cases with config parameters
+    void testUnscentedBatteryConfig() {
+        ConfigMap configMap;
+        configMap.set("Predictor.LoadEstimator", std::vector<std::string>({"const"}));
+        configMap.set("LoadEstimator.Loading", std::vector<std::string>({"8"}));
+
+        BatteryModel battery;
+        ConstLoadEstimator le(configMap);
+        TrajectoryService ts;
+
+        try {
+            UnscentedPredictor UTP(battery, le, ts, configMap);
+            Assert::Fail("Created predictor without horizon");
+        }
+        catch (std::range_error&) {
+        }
+
+        configMap.set("Predictor.Horizon", "5000");
+        configMap.set("Predictor.alpha", "0.5");
+        configMap.set("Predictor.beta", "2");
+        UnscentedPredictor UTP(battery, le, ts, configMap);
+    }
+
     void registerTests(TestContext& context) {
         context.AddCategoryInitializer("Predictor", predictorTestInit);
         context.AddTest("Monte Carlo Predictor Configuration for Battery",
@@ -117,5 +259,14 @@ namespace PredictorTests {
         context.AddTest("Monte Carlo Prediction for Battery",
                         testMonteCarloBatteryPredict,
                         "Predictor");
+        context.AddTest("Monte Carlo Prediction from Weighted Samples",
+                        testMonteCarloWeightedSamples,
+                        "Predictor");
+        context.AddTest("Unscented Predictor Configuration for Battery",
+                        testUnscentedBatteryConfig,
+                        "Predictor");
+        context.AddTest("Unscented Prediction for Battery",
+                        testUnscentedBatteryPredict,
+                        "Predictor");
     }
 }
@@ -1,6 +1,10 @@
 // Copyright (c) 2018-2019 United States Government as represented by the
 // Administrator of the National Aeronautics and Space Administration.
 // All Rights Reserved.
+#include <random>
+#include <vector>
+
+#include "AliasTable.h"
 #include "StatisticalTools.h"
 #include "Test.h"
 
@@ -60,9 +64,43 @@ namespace StatisticalToolsTests {
         Assert::AreEqual(1, calculatecdf(arr, size, 10), 1e-15, "CDF calculation incorrect");
     }
 
+    void aliasTable() {
+        std::vector<double> weights = {1, 0, 3, 4};
+        AliasTable table(ConstMatrixView(weights.data(), weights.size(), 1, 1));
+        Assert::AreEqual(4, table.size(), "Unexpected size");
+
+        // Every part of [0, 1) maps to an index
+        std::vector<double> counts(weights.size());
+        const std::size_t steps = 8000;
+        for (std::size_t i = 0; i < steps; i++) {
+            counts[table.sample((i + 0.5) / steps)] += 1.0 / steps;
+        }
+        Assert::AreEqual(0.125, counts[0], 1e-9, "Unexpected frequency of index 0");
+        Assert::AreEqual(0.0, counts[1], 1e-9, "Drew an index with zero weight");
+        Assert::AreEqual(0.375, counts[2], 1e-9, "Unexpected frequency of index 2");
+        Assert::AreEqual(0.5, counts[3], 1e-9, "Unexpected frequency of index 3");
+
+        // Rebuild from strided weights
+        std::vector<double> pairs = {5, 0, 6, 1, 7, 0};
+        table.build(ConstMatrixView(pairs.data() + 1, 3, 1, 2));
+        std::mt19937 rng(1);
+        for (std::size_t i = 0; i < 100; i++) {
+            Assert::AreEqual(1, table(rng), "Drew an index with zero weight");
+        }
+
+        try {
+            std::vector<double> zeros = {0, 0};
+            table.build(ConstMatrixView(zeros.data(), zeros.size(), 1, 1));
+            Assert::Fail("Built a table with zero total weight");
+        }
+        catch (const std::domain_error&) {
+        }
+    }
+
     void registerTests(TestContext& context) {
         context.AddTest("Calculate Mean", calculateMean, "Statistical Tools");
         context.AddTest("Calculate Standard Deviation", calculateStDv, "Statistical Tools");
         context.AddTest("Calculate CDF", calculateCDF, "Statistical Tools");
+        context.AddTest("Alias Table", aliasTable, "Statistical Tools");
     }
 }
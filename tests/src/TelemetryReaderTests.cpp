@@ -0,0 +1,198 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "Exceptions.h"
+#include "TelemetryCache.h"
+#include "TelemetryReader.h"
+#include "Test.h"
+
+using namespace PCOE;
+using namespace PCOE::Test;
+
+namespace TelemetryReaderTests {
+    std::string writeFile(const std::string& name, const std::string& contents) {
+        std::string filename = "gsap-test-telemetry-" + name;
+        std::ofstream file(filename, std::ios::binary);
+        file << contents;
+        return filename;
+    }
+
+    void read() {
+        std::string filename = writeFile("read.csv",
+                                         "Timestamp, power, temperature, voltage\r\n"
+                                         "0.00, 0.00, 20.00, 4.10\r\n"
+                                         "\r\n"
+                                         "1.5,-2e3,3.2(V),+.25\r\n"
+                                         "2,,nan\n"
+                                         "123456789012.125,0.1234567890123456789,1e-30,7,8\n"
+                                         "3, 4, 5, 6");
+        {
+            TelemetryReader reader(filename);
+            Assert::AreEqual(4, reader.columnCount(), "Column count");
+            Assert::AreEqual("temperature", reader.getColumnNames()[2], "Column name");
+            Assert::AreEqual(5, reader.countRows(), "Row count");
+
+            std::vector<double> row;
+            Assert::IsTrue(reader.next(row), "Row 0");
+            Assert::AreEqual(4, row.size(), "Row size");
+            Assert::AreEqual(4.1, row[3], 0.0, "Row 0 voltage");
+
+            Assert::IsTrue(reader.next(row), "Row 1");
+            Assert::AreEqual(1.5, row[0], 0.0, "Decimal");
+            Assert::AreEqual(-2000.0, row[1], 0.0, "Exponent");
+            Assert::AreEqual(3.2, row[2], 0.0, "Trailing units");
+            Assert::AreEqual(0.25, row[3], 0.0, "Leading sign and point");
+
+            Assert::IsTrue(reader.next(row), "Row 2");
+            Assert::AreEqual(2.0, row[0], 0.0, "Integer");
+            Assert::IsNaN(row[1], "Empty field");
+            Assert::IsNaN(row[2], "NaN field");
+            Assert::IsNaN(row[3], "Missing field");
+
+            Assert::IsTrue(reader.next(row), "Row 3");
+            Assert::AreEqual(123456789012.125, row[0], 0.0, "Large");
+            Assert::AreEqual(std::strtod("0.1234567890123456789", nullptr),
+                             row[1],
+                             0.0,
+                             "Many digits");
+            Assert::AreEqual(1e-30, row[2], 0.0, "Small exponent");
+            Assert::AreEqual(7.0, row[3], 0.0, "Extra field ignored");
+
+            Assert::IsTrue(reader.next(row), "Row 4");
+            Assert::AreEqual(6.0, row[3], 0.0, "No trailing newline");
+            Assert::IsFalse(reader.next(row), "End of file");
+
+            reader.rewind();
+            Assert::IsTrue(reader.next(row), "Rewind");
+            Assert::AreEqual(20.0, row[2], 0.0, "Rewound row");
+        }
+        std::remove(filename.c_str());
+    }
+
+    void precision() {
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<double> mantissa(-1.0, 1.0);
+        std::uniform_int_distribution<int> exponent(-40, 40);
+        std::string contents = "a,b\n";
+        std::vector<std::string> fields;
+        char buffer[64];
+        for (int i = 0; i < 1000; i++) {
+            const char* format = i % 2 == 0 ? "%.17g" : "%.6f";
+            std::snprintf(buffer, sizeof(buffer), format, std::ldexp(mantissa(rng), exponent(rng)));
+            fields.push_back(buffer);
+            contents += "0," + fields.back() + "\n";
+        }
+        std::string filename = writeFile("precision.csv", contents);
+        {
+            TelemetryReader reader(filename);
+            std::vector<double> row;
+            for (const std::string& field : fields) {
+                Assert::IsTrue(reader.next(row), "Row");
+                Assert::AreEqual(std::strtod(field.c_str(), nullptr), row[1], 0.0, field);
+            }
+        }
+        std::remove(filename.c_str());
+    }
+
+    void delimiterAndErrors() {
+        std::string filename = writeFile("tabs.tsv",
+                                         "time\tvalue with a long name\n"
+                                         "1\t2\n"
+                                         "2\tabc\n");
+        {
+            TelemetryReader reader(filename, '\t');
+            Assert::AreEqual("value with a long name", reader.getColumnNames()[1], "Column name");
+            std::vector<double> row;
+            Assert::IsTrue(reader.next(row), "Row 0");
+            Assert::AreEqual(2.0, row[1], 0.0, "Tab delimited value");
+            try {
+                reader.next(row);
+                Assert::Fail("Read invalid number");
+            }
+            catch (const FormatError&) {
+            }
+        }
+        std::remove(filename.c_str());
+
+        filename = writeFile("empty.csv", "\n\n");
+        try {
+            TelemetryReader reader(filename);
+            Assert::Fail("Read file without header");
+        }
+        catch (const FormatError&) {
+        }
+        std::remove(filename.c_str());
+    }
+
+    void cache() {
+        const std::size_t rows = 10000;
+        std::string contents = "time,x,y\n";
+        char buffer[64];
+        for (std::size_t i = 0; i < rows; i++) {
+            std::snprintf(buffer, sizeof(buffer), "%zu.5,%zu,%g\n", i, i * 2, i * 0.25);
+            contents += buffer;
+            if (i % 1000 == 0) {
+                contents += "\n";
+            }
+        }
+        std::string filename = writeFile("cache.csv", contents);
+        std::string cacheName = writeFile("cache.bin", "");
+        {
+            TelemetryReader reader(filename);
+            TelemetryCache::create(reader, cacheName);
+
+            TelemetryCache cache(cacheName);
+            Assert::AreEqual(3, cache.columnCount(), "Column count");
+            Assert::AreEqual(rows, cache.rowCount(), "Row count");
+            Assert::AreEqual("y", cache.getColumnNames()[2], "Column name");
+
+            ConstMatrixView x = cache.getColumn(1);
+            Assert::AreEqual(rows, x.rows(), "Column length");
+            Assert::AreEqual(0.0, x[0], 0.0, "First value");
+            Assert::AreEqual(9999.0 * 2, x[rows - 1], 0.0, "Last value");
+
+            std::vector<double> row;
+            cache.getRow(5000, row);
+            Assert::AreEqual(5000.5, row[0], 0.0, "Row time");
+            Assert::AreEqual(1250.0, row[2], 0.0, "Row value");
+
+            Assert::AreEqual(7001, cache.findRow(7000.75), "Find between rows");
+            Assert::AreEqual(7000, cache.findRow(7000.5), "Find exact row");
+            Assert::AreEqual(0, cache.findRow(-1.0), "Find before start");
+            Assert::AreEqual(rows, cache.findRow(1e9), "Find after end");
+
+            try {
+                cache.getColumn(3);
+                Assert::Fail("Got missing column");
+            }
+            catch (const std::out_of_range&) {
+            }
+            try {
+                TelemetryCache notCache(filename);
+                Assert::Fail("Opened CSV file as cache");
+            }
+            catch (const FormatError&) {
+            }
+        }
+        std::remove(filename.c_str());
+        std::remove(cacheName.c_str());
+    }
+
+    void registerTests(TestContext& context) {
+        context.AddTest("Read", TelemetryReaderTests::read, "Telemetry");
+        context.AddTest("Precision", TelemetryReaderTests::precision, "Telemetry");
+        context.AddTest("Delimiter and Errors",
+                        TelemetryReaderTests::delimiterAndErrors,
+                        "Telemetry");
+        context.AddTest("Cache", TelemetryReaderTests::cache, "Telemetry");
+    }
+}
@@ -634,6 +634,63 @@ namespace UDataTests {
         Assert::AreEqual(10, size);
     }
 
+    void wSamplesColumnar() {
+        UData interleaved(UType::WSamples);
+        interleaved.npoints(4);
+        for (std::size_t i = 0; i < 4; i++) {
+            interleaved[SAMPLE(i)] = 10.0 + i;
+            interleaved[WEIGHT(i)] = 0.1 * (i + 1);
+        }
+        ConstMatrixView interleavedWeights = interleaved.weights();
+        Assert::AreEqual(2, interleavedWeights.rowStride(), "Interleaved weight stride");
+        Assert::AreEqual(0.3, interleavedWeights[2], 1e-12, "Interleaved weight");
+
+        UData ud = interleaved;
+        ud.layout(SampleLayout::Columnar);
+        Assert::AreEqual(SampleLayout::Columnar, ud.layout(), "Unexpected layout");
+        Assert::IsTrue(ud == interleaved, "Layouts do not compare equal");
+        Assert::AreEqual(11.0, ud[SAMPLE(1)], 1e-12, "Sample key");
+        Assert::AreEqual(0.2, ud[WEIGHT(1)], 1e-12, "Weight key");
+        Assert::AreEqual(12.0, ud.getPair(PAIR(2)).first, 1e-12, "Pair sample");
+        Assert::AreEqual(0.3, ud.getPair(PAIR(2)).second, 1e-12, "Pair weight");
+        Assert::AreEqual(interleaved.getVec(SAMPLE(1)), ud.getVec(SAMPLE(1)), "getVec");
+
+        // Samples and weights are contiguous
+        ConstMatrixView samples = static_cast<const UData&>(ud).samples();
+        ConstMatrixView weights = static_cast<const UData&>(ud).weights();
+        Assert::AreEqual(1, samples.rowStride(), "Sample stride");
+        Assert::AreEqual(1, weights.rowStride(), "Weight stride");
+        Assert::AreEqual(13.0, samples.data()[3], 1e-12, "Contiguous sample");
+        Assert::AreEqual(0.4, weights.data()[3], 1e-12, "Contiguous weight");
+        Assert::AreEqual(10.0, *ud.begin(), 1e-12, "Storage order");
+
+        // Writes through keys and views land in the same place
+        ud.set(WEIGHT(3), 0.5);
+        Assert::AreEqual(0.5, weights[3], 1e-12, "Weight set by key");
+        ud.samples()[0] = 9.0;
+        Assert::AreEqual(9.0, ud[SAMPLE(0)], 1e-12, "Sample set by view");
+
+        // Changing the number of points keeps the weights with their samples
+        ud.npoints(6);
+        Assert::AreEqual(12, ud.size(), "Unexpected size");
+        Assert::AreEqual(0.5, ud[WEIGHT(3)], 1e-12, "Weight after growing");
+        Assert::IsTrue(std::isnan(ud[WEIGHT(5)]), "New weight is not NaN");
+        ud.npoints(2);
+        Assert::AreEqual(11.0, ud[SAMPLE(1)], 1e-12, "Sample after shrinking");
+        Assert::AreEqual(0.2, ud[WEIGHT(1)], 1e-12, "Weight after shrinking");
+
+        ud.layout(SampleLayout::Interleaved);
+        Assert::AreEqual(0.2, ud.getVec()[3], 1e-12, "Interleaved after conversion");
+
+        try {
+            UData point(1.0);
+            point.weights();
+            Assert::Fail("Got weights of a point");
+        }
+        catch (const std::domain_error&) {
+        }
+    }
+
     void registerTests(PCOE::Test::TestContext& context) {
         context.AddTest("construct_default", construct_default, "UData");
         context.AddTest("construct_type", construct_type, "UData");
@@ -662,5 +719,6 @@ namespace UDataTests {
         context.AddTest("percentiles", percentiles, "UData");
         context.AddTest("samples", samples, "UData");
         context.AddTest("wSamples", wSamples, "UData");
+        context.AddTest("wSamples columnar", wSamplesColumnar, "UData");
     }
 }
@@ -0,0 +1,75 @@
+// Copyright (c) 2019 United States Government as represented by the
+// Administrator of the National Aeronautics and Space Administration.
+// All Rights Reserved.
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "Contracts.h"
+#include "Test.h"
+#include "WorkerPool.h"
+
+using namespace PCOE;
+using namespace PCOE::Test;
+
+namespace WorkerPoolTests {
+    void run() {
+        WorkerPool pool(3);
+        Assert::AreEqual(3, pool.size(), "Thread count");
+
+        std::vector<std::thread::id> ids(4);
+        std::vector<int> counts(4, 0);
+        for (int step = 0; step < 100; step++) {
+            pool.run(4, [&](std::size_t i) {
+                ids[i] = std::this_thread::get_id();
+                counts[i]++;
+            });
+        }
+        for (std::size_t i = 0; i < counts.size(); i++) {
+            Assert::AreEqual(100, counts[i], "Task run once per batch");
+        }
+        Assert::IsTrue(ids[0] == std::this_thread::get_id(), "First task on calling thread");
+
+        // Smaller batches leave the extra workers idle
+        counts.assign(4, 0);
+        pool.run(2, [&](std::size_t i) { counts[i]++; });
+        Assert::AreEqual(1, counts[1], "Second task in small batch");
+        Assert::AreEqual(0, counts[2], "Idle worker");
+
+        try {
+            pool.run(5, [](std::size_t) {});
+            Assert::Fail("Ran more tasks than threads");
+        }
+        catch (AssertException&) {
+        }
+    }
+
+    void exceptions() {
+        WorkerPool pool(2);
+        int completed = 0;
+        try {
+            pool.run(3, [&](std::size_t i) {
+                if (i == 2) {
+                    throw std::runtime_error("Task failed");
+                }
+                if (i == 1) {
+                    completed++;
+                }
+            });
+            Assert::Fail("Task exception not rethrown");
+        }
+        catch (const std::runtime_error&) {
+        }
+        Assert::AreEqual(1, completed, "Other tasks completed");
+
+        // The pool is still usable after a task throws
+        int count = 0;
+        pool.run(1, [&](std::size_t) { count++; });
+        Assert::AreEqual(1, count, "Run after exception");
+    }
+
+    void registerTests(TestContext& context) {
+        context.AddTest("Run", WorkerPoolTests::run, "Worker Pool");
+        context.AddTest("Exceptions", WorkerPoolTests::exceptions, "Worker Pool");
+    }
+}
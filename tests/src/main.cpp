@@ -67,6 +67,20 @@ namespace MessageBusTests {
     void registerTests(TestContext& context);
 }
 
+namespace MonotonicArenaTests {
+    void registerTests(TestContext& context);
+}
+
+#ifndef _WIN32
+namespace MessageLogTests {
+    void registerTests(TestContext& context);
+}
+#endif
+
+namespace MessageSerializationTests {
+    void registerTests(TestContext& context);
+}
+
 namespace MessageWatcherTests {
     void registerTests(TestContext& context);
 }
@@ -91,10 +105,20 @@ namespace PredictorTests {
     void registerTests(TestContext& context);
 }
 
+#ifndef _WIN32
+namespace SharedMemoryTests {
+    void registerTests(TestContext& context);
+}
+#endif
+
 namespace StatisticalToolsTests {
     void registerTests(TestContext& context);
 }
 
+namespace TelemetryReaderTests {
+    void registerTests(TestContext& context);
+}
+
 namespace TrajectoryServiceTests {
     void registerTests(TestContext& context);
 }
@@ -103,6 +127,10 @@ namespace UDataTests {
     void registerTests(TestContext& context);
 }
 
+namespace WorkerPoolTests {
+    void registerTests(TestContext& context);
+}
+
 int main() {
     TestContext context;
     
@@ -119,14 +147,25 @@ int main() {
     LoadEstimatorTests::registerTests(context);
     MatrixTests::registerTests(context);
     MessageBusTests::registerTests(context);
+#ifndef _WIN32
+    MessageLogTests::registerTests(context);
+#endif
+    MessageSerializationTests::registerTests(context);
     MessageWatcherTests::registerTests(context);
     ModelBasedPrognoserTests::registerTests(context);
     ModelTests::registerTests(context);
+    MonotonicArenaTests::registerTests(context);
     ObserverTests::registerTests(context);
     ParticleFilterTests::registerTests(context);
+    PredictorTests::registerTests(context);
+#ifndef _WIN32
+    SharedMemoryTests::registerTests(context);
+#endif
     StatisticalToolsTests::registerTests(context);
+    TelemetryReaderTests::registerTests(context);
     TrajectoryServiceTests::registerTests(context);
     UDataTests::registerTests(context);
+    WorkerPoolTests::registerTests(context);
     
     // Integration Tests
     SyncIntegrationTests::registerTests(context);